@@ -35,6 +35,15 @@ enum D2C_CollisionPattern
 	COLLISION_PATTERN_SMALL_NO_PRESENCE   = 5,
 };
 
+// D2Moo only: instruction set used to OR-reduce the collision masks of a bounding box, see COLLISION_GetMaskRowKernel
+enum D2C_CollisionSimdLevel
+{
+	COLLISION_SIMD_SCALAR = 0,
+	COLLISION_SIMD_SSE2 = 1,
+	COLLISION_SIMD_AVX2 = 2,
+	COLLISION_SIMD_COUNT
+};
+
 enum D2C_CollisionMaskFlags : uint16_t
 {
 	COLLIDE_NONE = 0x0000,
@@ -94,6 +103,12 @@ D2COMMON_DLL_DECL void __stdcall COLLISION_ResetMask(D2ActiveRoomStrc* pRoom, in
 D2COMMON_DLL_DECL uint16_t __stdcall COLLISION_CheckMaskWithSizeXY(D2ActiveRoomStrc* pRoom, int nX, int nY, unsigned int nSizeX, unsigned int nSizeY, uint16_t nMask);
 //D2Common.0x6FD41B40
 uint16_t __fastcall COLLISION_CheckCollisionMaskForBoundingBox(D2RoomCollisionGridStrc* pCollisionGrid, D2BoundingBoxStrc* pBoundingBox, uint16_t nMask);
+// Returns the OR of the nWidth masks starting at pRow. Kernels may read up to pReadLimit (excluded) past the row, the extra cells are ignored.
+using CollisionMaskRowKernel = uint16_t(__fastcall*)(const uint16_t* pRow, int32_t nWidth, const uint16_t* pReadLimit);
+// Helper function: Returns the best instruction set supported by the CPU and OS
+int __fastcall COLLISION_GetSupportedSimdLevel();
+// Helper function: Returns the kernel for nSimdLevel, which must be supported by the CPU
+CollisionMaskRowKernel __fastcall COLLISION_GetMaskRowKernel(int nSimdLevel);
 //D2Common.0x6FD41BE0
 int __fastcall COLLISION_AdaptBoundingBoxToGrid(D2ActiveRoomStrc* pRoom, D2BoundingBoxStrc* pBoundingBox, D2BoundingBoxStrc* pBoundingBoxes);
 //D2Common.0x6FD41CA0
@@ -10,12 +10,15 @@
 #include "DataTbls/AnimTbls.h"
 #include "DataTbls/ArenaTbls.h"
 #include "DataTbls/BeltsTbls.h"
+#include "DataTbls/BinTbls.h"
+#include "DataTbls/CalcProgram.h"
 #include "DataTbls/DataTbls.h"
 #include "DataTbls/FieldTbls.h"
 #include "DataTbls/HoradricCube.h"
 #include "DataTbls/InvTbls.h"
 #include "DataTbls/ItemsTbls.h"
 #include "DataTbls/LevelsTbls.h"
+#include "DataTbls/LinkTbls.h"
 #include "DataTbls/MissilesTbls.h"
 #include "DataTbls/MonsterTbls.h"
 #include "DataTbls/ObjectsTbls.h"
@@ -523,6 +526,11 @@ struct D2DataTablesStrc
 	D2CompositTxt* pCompositTxt;						//0x10C0
 	D2ObjModeDataTbl pObjModeDataTables;				//0x10C4
 	D2PlrModeDataTbl pPlrModeDataTables;				//0x10D4
+	D2CalcProgramCacheStrc* pSkillsCodePrograms;		//0x10E4 D2Moo only
+	D2CalcProgramCacheStrc* pSkillDescCodePrograms;		//0x10E8 D2Moo only
+	D2CalcProgramCacheStrc* pMissCodePrograms;			//0x10EC D2Moo only
+	D2CalcProgramCacheStrc* pItemsCodePrograms;			//0x10F0 D2Moo only
+	D2AffixCandidatesStrc* pAffixCandidates;			//0x10F4 D2Moo only, see DATATBLS_GetMagicAffixCandidates
 };
 
 // D2Common.0x6FDE9600
@@ -101,6 +101,11 @@ enum D2C_InventoryGrids
 	INVGRID_INVENTORY,
 };
 
+enum D2C_InventoryGridConstants
+{
+	INVENTORY_GRID_MAX_MASK_WIDTH = 32,	// D2Moo only, wider grids have no row masks
+};
+
 enum D2TradeStates
 {
 	TRADESTATE_OTHERNOROOM,
@@ -115,6 +120,7 @@ struct D2InventoryGridStrc
 	uint8_t nGridHeight;					//0x09
 	uint16_t pad0x0A;						//0x0A
 	D2UnitStrc** ppItems;					//0x0C
+	uint32_t* pRowMasks;					//0x10 D2Moo only, bit x of row y is set when ppItems has an item at x, y. Allocated after ppItems, nullptr for wide grids
 };
 
 struct D2CorpseStrc
@@ -194,6 +200,12 @@ D2COMMON_DLL_DECL D2UnitStrc* __stdcall INVENTORY_GetLastItem(D2InventoryStrc* p
 D2COMMON_DLL_DECL BOOL __stdcall INVENTORY_GetFreePosition(D2InventoryStrc* pInventory, D2UnitStrc* pItem, int nInventoryRecordId, int* pFreeX, int* pFreeY, uint8_t nPage);
 //D2Common.0x6FD8EAF0
 D2InventoryGridStrc* __fastcall INVENTORY_GetGrid(D2InventoryStrc* pInventory, int nInventoryGrid, D2InventoryGridInfoStrc* pInventoryGridInfo);
+// Helper function: Allocates the cells and row masks of the grid
+void __fastcall INVENTORY_AllocGridCells(D2InventoryStrc* pInventory, D2InventoryGridStrc* pInventoryGrid);
+// Helper function: Sets the cells of the rectangle to pItem (or nullptr), and updates the row masks
+void __fastcall INVENTORY_SetGridCells(D2InventoryGridStrc* pInventoryGrid, int nX, int nY, int nWidth, int nHeight, D2UnitStrc* pItem);
+// Helper function: Copies the cells and row masks of a grid of the same size
+void __fastcall INVENTORY_CopyGridCells(D2InventoryGridStrc* pDestination, const D2InventoryGridStrc* pSource);
 //D2Common.0x6FD8EC70
 BOOL __fastcall INVENTORY_CanItemBePlacedAtPos(D2InventoryGridStrc* pInventoryGrid, int nX, int nY, uint8_t nItemWidth, uint8_t nItemHeight);
 //D2Common.0x6FD8ECF0
@@ -114,6 +114,32 @@ struct D2SkillStrc
 	int32_t nQuantity;							//0x30
 	D2UnitGUID nOwnerGUID;						//0x34 -1 = Native Skill
 	int32_t nCharges;							//0x38
+	int32_t nStatBonusLevels;					//0x3C D2Moo only: cached by SKILLS_GetBonusSkillLevel, see D2SkillListStrc::dwBonusLevelsStamp
+	int32_t nNonClassBonusLevels;				//0x40 D2Moo only: STAT_ITEM_NONCLASSSKILL, capped when read
+	uint32_t dwBonusLevelsStamp;				//0x44 D2Moo only
+};
+
+// D2Moo only: (skill id, owner GUID) -> skill lookup table of a skill list, used by SKILLS_GetSkill instead of walking the list.
+// Open addressing with Robin Hood insertion and backward shift deletion. The list is still used for iteration and keeps its order.
+// Only the first skill of the list with a given id and owner is indexed, so that lookups return the same skill as the linear search.
+struct D2SkillIndexSlotStrc
+{
+	D2SkillStrc* pSkill;					//0x00 nullptr if the slot is empty
+	int32_t nSkillId;						//0x04
+	D2UnitGUID nOwnerGUID;					//0x08
+};
+
+struct D2SkillIndexStrc
+{
+	D2SkillIndexSlotStrc* pSlots;			//0x00
+	uint32_t nCapacity;						//0x04 Power of 2
+	uint32_t nHashShift;					//0x08 32 - log2(nCapacity)
+	uint32_t nCount;						//0x0C
+};
+
+enum D2C_SkillIndexConstants
+{
+	SKILLINDEX_MIN_CAPACITY = 16,			// Monsters rarely have more than 8 skills
 };
 
 struct D2SkillListStrc
@@ -124,6 +150,8 @@ struct D2SkillListStrc
 	D2SkillStrc* pRightSkill;				//0x0C
 	D2SkillStrc* pUsedSkill;				//0x10
 	uint32_t unk014;						//0x14
+	D2SkillIndexStrc tSkillIndex;			//0x18 D2Moo only
+	uint32_t dwBonusLevelsStamp;			//0x28 D2Moo only: changed when a stat giving skill levels changes, the levels cached in the skills are valid while their stamp matches
 };
 
 struct D2SkillTreeChartStrc
@@ -239,6 +267,10 @@ D2COMMON_DLL_DECL D2SkillsTxt* __fastcall SKILLS_GetSkillsTxtRecordFromSkill(D2S
 D2COMMON_DLL_DECL int __stdcall SKILLS_GetShrineSkillLevelBonus(D2UnitStrc* pUnit);
 //D2Common.0x6FDB1580
 int __fastcall SKILLS_GetBonusSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill);
+// Helper function: Returns TRUE for the stats read by SKILLS_GetBonusSkillLevel
+BOOL __fastcall SKILLS_IsBonusSkillLevelStat(int nStatId);
+// Helper function: Must be called when one of the stats of SKILLS_IsBonusSkillLevelStat changes for the unit
+void __fastcall SKILLS_InvalidateBonusSkillLevels(D2UnitStrc* pUnit);
 //D2Common.0x6FDB1700 (#10968)
 D2COMMON_DLL_DECL int __stdcall SKILLS_GetSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill, BOOL bBonus);
 //D2Common.0x6FDB1750 (#11029)
@@ -289,6 +321,14 @@ D2COMMON_DLL_DECL int __stdcall SKILLS_GetRequiredLevelBasedOnCurrent(D2UnitStrc
 D2COMMON_DLL_DECL BOOL __stdcall SKILLS_CheckRequiredSkills(D2UnitStrc* pUnit, int nSkillId);
 //D2Common.0x6FDB1F80
 D2SkillStrc* __fastcall SKILLS_GetSkill(D2UnitStrc* pUnit, int nSkillId, D2UnitGUID nOwnerGUID);
+// Helper function
+D2SkillStrc* __fastcall SKILLS_FindSkillInIndex(const D2SkillIndexStrc* pIndex, int nSkillId, D2UnitGUID nOwnerGUID);
+// Helper function: Moves the skills of the index to pSlots, which holds nCapacity slots (a power of 2). Returns the previous slots.
+D2SkillIndexSlotStrc* __fastcall SKILLS_ResizeSkillIndex(D2SkillIndexStrc* pIndex, D2SkillIndexSlotStrc* pSlots, uint32_t nCapacity);
+// Helper function: Does nothing if a skill with the same id and owner is already indexed. The index must have a free slot.
+void __fastcall SKILLS_InsertSkillInIndex(D2SkillIndexStrc* pIndex, D2SkillStrc* pSkill);
+// Helper function: pSkill must already be unlinked from the list starting at pFirstSkill, the next skill of the list with the same id and owner is indexed instead
+void __fastcall SKILLS_RemoveSkillFromIndex(D2SkillIndexStrc* pIndex, D2SkillStrc* pFirstSkill, D2SkillStrc* pSkill);
 //D2Common.0x6FDB1FC0 (#10989)
 D2COMMON_DLL_DECL BOOL __stdcall SKILLS_CheckRequiredAttributes(D2UnitStrc* pUnit, int nSkillId);
 //D2Common.0x6FDB2110 (#10999)
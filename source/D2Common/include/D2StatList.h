@@ -492,6 +492,23 @@ struct D2StatListExStrc : public D2StatListStrc
 	uint32_t* StatFlags;					//0x58 8bytes per states
 	StatListValueChangeFunc pfOnValueChanged;		//0x5C
 	D2GameStrc* pGame;						//0x60
+	struct D2StatListIndexStrc* pStatIndex;	//0x64 D2Moo only
+};
+
+// D2Moo only: maps each stat id to the first entry of FullStats and Stats with this stat id, so that reading a stat does not binary search the whole array.
+// Values are read from the arrays themselves, so only inserting or removing stats changes the index.
+// Since many places insert or remove stats directly, the range of the stat is checked against its neighbours on each read instead of tracking changes,
+// and the index is rebuilt when it does not match anymore (usually on the first read after a change).
+struct D2StatListIndexStrc
+{
+	int32_t nStatIds;						// Stat ids >= nStatIds are not indexed
+	uint16_t* pFullStatsFirstIndex;			// [nStatIds + 1], nullptr until first used
+	uint16_t* pStatsFirstIndex;				// [nStatIds + 1], nullptr until first used
+};
+
+enum D2C_StatListIndexConstants
+{
+	STATLIST_INDEX_MIN_STATS = 16,			// Smaller arrays are binary searched
 };
 #pragma pack()
 
@@ -522,6 +539,11 @@ int __fastcall STATLIST_GetTotalStat_6FDB63E0(D2StatListStrc* pStatList, D2SLaye
 int __fastcall sub_6FDB64A0(D2StatListExStrc* pStatListEx, D2SLayerStatIdStrc::PackedType nLayer_StatId, D2ItemStatCostTxt* pItemStatCostTxtRecord, D2UnitStrc* pUnit);
 //D2Common.0x6FDB6920
 D2StatStrc* __fastcall STATLIST_FindStat_6FDB6920(D2StatsArrayStrc* pStatArray, D2SLayerStatIdStrc::PackedType nLayer_StatId);
+// Helper function: Fills pFirstIndex[0..nStatIds] with the index of the first stat of pStatArray having each stat id (or the index following the previous stat id)
+void __fastcall STATLIST_BuildStatsArrayIndex(const D2StatsArrayStrc* pStatArray, uint16_t* pFirstIndex, int32_t nStatIds);
+// Helper function: Finds a stat using an index built by STATLIST_BuildStatsArrayIndex.
+// Sets *pIndexValid to FALSE (and returns nullptr) if pStatArray changed in a way that invalidates the index of this stat.
+D2StatStrc* __fastcall STATLIST_FindStatInIndexedArray(D2StatsArrayStrc* pStatArray, const uint16_t* pFirstIndex, int32_t nStatIds, D2SLayerStatIdStrc::PackedType nLayer_StatId, BOOL* pIndexValid);
 //D2Common.0x6FDB6970
 D2StatStrc* __fastcall STATLIST_InsertStatOrFail_6FDB6970(void* pMemPool, D2StatsArrayStrc* pStatsArray, D2SLayerStatIdStrc::PackedType nLayer_StatId);
 //D2Common.0x6FDB6A30
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <D2BasicTypes.h>
+#include <Fog.h>
+
+// D2Moo only: .bin tables stored as loose "DATA\GLOBAL\EXCEL\<name>.mbin" files that are mapped in memory and used in place.
+// The records follow a versioned header, aligned so that they can be used directly from the mapped view. The views are mapped copy-on-write,
+// since some loaders patch the records after loading them.
+// The files are written from the records loaded by DATATBLS_CompileTxt when they are missing (or when the .txt files are compiled), then used
+// on the next starts. They are mapped and checked by a pool of threads at the start of DATATBLS_LoadAllTxts, while the loaders, which depend
+// on the linkers of each other, still run in their original order.
+// The header also stores the size of the .bin file the records were read from and the last write time of the .mpq (or loose file) holding it,
+// both known without reading the .bin. A file whose .bin changed since, or that was written by another version, is rebuilt.
+// A file that does not match its own header and checksum, or the layout of its table, halts the game instead of being used.
+// Enabled with the D2_MAPPED_BIN_TABLES=1 environment variable.
+
+#pragma pack(1)
+
+enum D2C_MappedBinConstants
+{
+	MAPPEDBIN_MAGIC = 0x42543244, // "D2TB"
+	MAPPEDBIN_VERSION = 3,
+	MAPPEDBIN_MAX_FILES = 128,
+	MAPPEDBIN_MAX_THREADS = 8,
+};
+
+struct D2MappedBinHeaderStrc
+{
+	uint32_t dwMagic;					//0x00
+	uint16_t nVersion;					//0x04
+	uint16_t nHeaderSize;				//0x06
+	uint32_t nRecordSize;				//0x08
+	int32_t nRecordCount;				//0x0C
+	uint32_t dwLayoutHash;				//0x10 Hash of the D2BinFieldStrc of the table, see DATATBLS_GetBinLayoutHash
+	uint32_t dwChecksum;				//0x14 Checksum of the records
+	uint32_t nSourceSize;				//0x18 Size of the .bin file
+	uint32_t dwSourceWriteTime;			//0x1C Last write time of the file holding the .bin, in seconds since 1970. The header keeps the records 32 bytes aligned
+};
+
+#pragma pack()
+
+// Helper function: Reads the D2_MAPPED_BIN_TABLES environment variable, then maps and checks every .mbin file with a pool of threads
+void __fastcall DATATBLS_PrefetchMappedBins();
+// Helper function: Unmaps the prefetched files that were not used by any table
+void __fastcall DATATBLS_ReleaseUnusedMappedBins();
+// Helper function: Returns the records of the mapped .mbin of the table, or nullptr if there is none or if it must be rebuilt
+void* __fastcall DATATBLS_GetMappedBin(HD2ARCHIVE hArchive, const char* szName, D2BinFieldStrc* pTbl, size_t dwSize, int* pRecordCount);
+// Helper function: Writes the .mbin of the table from the records read from its .bin file, does nothing unless mapped tables are enabled
+void __fastcall DATATBLS_WriteMappedBin(HD2ARCHIVE hArchive, const char* szName, D2BinFieldStrc* pTbl, const void* pRecords, int nRecordCount, size_t dwSize);
+// Helper function: Returns FALSE if pRecords do not come from a mapped .mbin
+BOOL __fastcall DATATBLS_UnloadMappedBin(void* pRecords);
+// Helper function
+uint32_t __fastcall DATATBLS_GetBinLayoutHash(D2BinFieldStrc* pTbl, size_t dwSize);
+// Helper function
+uint32_t __fastcall DATATBLS_GetMappedBinChecksum(const void* pRecords, size_t nSize);
+// Helper function: Logs the time spent loading a table since pStartTime, does nothing unless mapped tables are enabled
+void __fastcall DATATBLS_TraceTableLoadTime(const char* szName, int nRecordCount, const LARGE_INTEGER* pStartTime, const char* szSource);
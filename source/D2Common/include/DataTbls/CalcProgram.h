@@ -0,0 +1,71 @@
+#pragma once
+
+#include <D2BasicTypes.h>
+#include <Fog.h>
+#include <Calc.h>
+
+// D2Moo only: formulas of the code buffers compiled to register bytecode.
+// The evaluation stack is simulated at compile time: constant sub-expressions are folded, table callbacks are resolved to their function pointers,
+// and each remaining operation becomes an instruction reading and writing the register matching its stack slot.
+// Running a program gives the same result as DATATBLS_CalcEvaluateExpression on the same buffer, including its stack overflow and underflow behaviours.
+// Everything lives in D2Common, so that it still runs with the original Fog.dll.
+
+enum D2C_CalcProgramConstants
+{
+	CALC_PROGRAM_MAX_INSTRUCTIONS = 128,
+	CALC_ZERO_REGISTER = Fog64IntStack::nCapacity,          // Always 0, read by the pops of an empty stack
+	CALC_DISCARD_REGISTER = Fog64IntStack::nCapacity + 1,   // Written by the pushes of a full stack
+	CALC_REGISTERS_COUNT = Fog64IntStack::nCapacity + 2,
+};
+
+struct D2CalcInstructionStrc;
+struct D2CalcRunContextStrc;
+
+typedef const D2CalcInstructionStrc*(__fastcall* CalcInstructionHandler_t)(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext);
+
+struct D2CalcInstructionStrc
+{
+	CalcInstructionHandler_t pfHandler;      // Runs the instruction and returns the next one, or nullptr once the result is known
+	uint8_t nDestination;
+	uint8_t nOperands[3];
+	union
+	{
+		int32_t nValue;                      // Constant, or parameter of fpParamCallBack
+		CalcFogCallBack_t fpCallBack;
+	};
+};
+
+struct D2CalcProgramStrc
+{
+	CalcFogCallBack2_t fpParamCallBack;
+	int32_t nInstructions;
+	D2CalcInstructionStrc tInstructions[CALC_PROGRAM_MAX_INSTRUCTIONS];
+};
+
+#pragma pack(1)
+
+// Programs compiled from the formulas of a code buffer, by offset of the formula in the buffer
+struct D2CalcProgramCacheStrc
+{
+	const FOGASTNodeStrc* pCode;						//0x00
+	uint32_t nCodeSize;									//0x04
+	D2CalcProgramCacheStrc* pPrevious;					//0x08 Cache replaced by this one, freed with it
+	D2CalcProgramStrc* volatile pPrograms[1];			//0x0C nCodeSize entries, compiled on first use
+};
+
+#pragma pack()
+
+// Helper function: Size of the beginning of pProgram actually used, for callers keeping a copy of the program
+inline size_t DATATBLS_CalcGetProgramSize(const D2CalcProgramStrc* pProgram)
+{
+	return offsetof(D2CalcProgramStrc, tInstructions) + pProgram->nInstructions * sizeof(D2CalcInstructionStrc);
+}
+
+// Helper function: Returns FALSE if the formula needs more than CALC_PROGRAM_MAX_INSTRUCTIONS instructions, it must then be evaluated with DATATBLS_CalcEvaluateExpression
+BOOL __fastcall DATATBLS_CalcCompileProgram(const FOGASTNodeStrc* pExpressionBuffer, int32_t nExpressionBufferSize, CalcFogCallBack2_t fpParamCallBack, D2CalcCallbackInfoStrc* pTableData, int nTableSize, D2CalcProgramStrc* pOutProgram);
+// Helper function
+int __fastcall DATATBLS_CalcRunProgram(const D2CalcProgramStrc* pProgram, void* pUserData);
+// Helper function: Same result as DATATBLS_CalcEvaluateExpression(&pCode[nCalc], nCodeSize - nCalc, ...), using the program compiled from the formula
+int __fastcall DATATBLS_EvaluateCalcProgram(D2CalcProgramCacheStrc** ppCache, const FOGASTNodeStrc* pCode, uint32_t nCodeSize, uint32_t nCalc, CalcFogCallBack2_t fpParamCallBack, D2CalcCallbackInfoStrc* pTableData, int nTableSize, void* pUserData);
+// Helper function
+void __fastcall DATATBLS_FreeCalcProgramCache(D2CalcProgramCacheStrc** ppCache);
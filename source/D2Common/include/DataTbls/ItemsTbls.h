@@ -579,6 +579,32 @@ struct D2MagicAffixDataTbl							//sgptDataTable + 0xEC8
 	D2MagicAffixTxt* pAutoMagic;					//0x10
 };
 
+// D2Moo only: magic and rare affixes that can spawn on each type of item, in the order of their tables.
+// Magic affixes are also split in bands of levels, see DATATBLS_GetMagicAffixCandidates.
+enum D2C_AffixCandidatesConstants
+{
+	AFFIXCANDIDATES_LEVEL_BAND_SHIFT = 3,			// Bands of 8 levels
+	AFFIXCANDIDATES_LEVEL_BANDS = 13,				// Levels 0 to 95, then 96 and above
+};
+
+enum D2C_AffixCandidatesLists
+{
+	AFFIXCANDIDATES_MAGICSUFFIX = 0,
+	AFFIXCANDIDATES_MAGICPREFIX = AFFIXCANDIDATES_MAGICSUFFIX + AFFIXCANDIDATES_LEVEL_BANDS,
+	AFFIXCANDIDATES_AUTOMAGIC = AFFIXCANDIDATES_MAGICPREFIX + AFFIXCANDIDATES_LEVEL_BANDS,
+	AFFIXCANDIDATES_RARESUFFIX = AFFIXCANDIDATES_AUTOMAGIC + AFFIXCANDIDATES_LEVEL_BANDS,
+	AFFIXCANDIDATES_RAREPREFIX,
+	AFFIXCANDIDATES_LISTS,
+};
+
+struct D2AffixCandidatesStrc
+{
+	int32_t nBuckets;								//0x00 Items with the same types share their lists
+	int16_t* pItemBuckets;							//0x04 Bucket of each items.txt record
+	int32_t* pListStarts;							//0x08 nBuckets * AFFIXCANDIDATES_LISTS + 1 offsets in pAffixes
+	uint16_t* pAffixes;								//0x0C Index of the affix from the start of its table (suffixes, prefixes or automagic)
+};
+
 struct D2RuneDataTbl								//sgptDataTable + 0xEDC
 {
 	int nRunesTxtRecordCount;						//0x00
@@ -633,6 +659,19 @@ void __fastcall DATATBLS_UnloadRareSuffix_PrefixTxt();
 D2COMMON_DLL_DECL D2RareAffixDataTbl* __fastcall DATATBLS_GetRareAffixDataTables();
 //D2Common.0x6FD58490 (#10606)
 D2COMMON_DLL_DECL D2RareAffixTxt* __stdcall DATATBLS_GetRareAffixTxtRecord(int nId);
+// Helper function: Fills pCandidates->pItemBuckets (one entry per items.txt record) and pCandidates->nBuckets, pBucketItems receives the first item of each bucket
+int __fastcall DATATBLS_BuildAffixCandidateBuckets(D2AffixCandidatesStrc* pCandidates, int* pBucketItems);
+// Helper function: Fills pCandidates->pListStarts (nBuckets * AFFIXCANDIDATES_LISTS + 1 entries), and pCandidates->pAffixes unless it is nullptr. Returns the number of affixes.
+int32_t __fastcall DATATBLS_BuildAffixCandidateLists(D2AffixCandidatesStrc* pCandidates, const int* pBucketItems);
+// Helper function: Builds the affix candidates of every item, must be called once items.txt and the affix tables are loaded
+void __fastcall DATATBLS_LoadAffixCandidates();
+// Helper function
+void __fastcall DATATBLS_UnloadAffixCandidates();
+// Helper function: Returns the magic affixes of nList (AFFIXCANDIDATES_MAGICSUFFIX, MAGICPREFIX or AUTOMAGIC) whose type, frequency and levels allow them on nItemId at nLevel.
+// The level range of each affix still has to be checked, as well as everything that depends on the item itself.
+D2COMMON_DLL_DECL const uint16_t* __fastcall DATATBLS_GetMagicAffixCandidates(int nItemId, int nList, int nLevel, int* pCount);
+// Helper function: Returns the rare affixes whose type allow them on nItemId
+D2COMMON_DLL_DECL const uint16_t* __fastcall DATATBLS_GetRareAffixCandidates(int nItemId, BOOL bPrefix, int* pCount);
 //D2Common.0x6FD584E0
 void __fastcall DATATBLS_LoadUniqueItemsTxt(HD2ARCHIVE hArchive);
 //D2Common.0x6FD59110
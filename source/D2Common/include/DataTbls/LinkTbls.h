@@ -0,0 +1,68 @@
+#pragma once
+
+#include <D2BasicTypes.h>
+#include <Fog.h>
+
+// D2Moo only: hash indices of the linkers, used instead of FOG_GetLinkIndex and FOG_GetRowFromTxt which walk the linker.
+// An index is built from the codes and strings of a linker the first time it is used while the tables are loaded,
+// then the indices of the linkers used at runtime are built once at the end of DATATBLS_LoadAllTxts and never change.
+// Lookups that are not found in the index (or that match several records) are forwarded to Fog, so that the results and errors are unchanged.
+
+#pragma pack(1)
+
+enum D2C_TxtLinkIndexConstants
+{
+	LINKINDEX_NOT_FOUND = -1,
+	LINKINDEX_AMBIGUOUS = -2,
+	LINKINDEX_MAX_LINKERS = 128,
+};
+
+struct D2TxtLinkIndexCodeStrc
+{
+	uint32_t dwCode;						//0x00
+	int32_t nLinkIndex;						//0x04 LINKINDEX_NOT_FOUND for empty slots
+};
+
+struct D2TxtLinkIndexStringStrc
+{
+	uint32_t dwHash;						//0x00 Case insensitive
+	int32_t nLinkIndex;						//0x04 LINKINDEX_NOT_FOUND for empty slots
+	D2TxtLinkNodeStrc* pNode;				//0x08
+};
+
+struct D2TxtLinkIndexStrc
+{
+	D2TxtLinkStrc* pLinker;					//0x00
+	int32_t nRecords;						//0x04 State of the linker when the index was built
+	D2TxtLinkNodeStrc* pFirstNode;			//0x08
+	uint32_t nCodeMask;						//0x0C
+	uint32_t nStringMask;					//0x10
+	D2TxtLinkIndexCodeStrc* pCodes;			//0x14
+	D2TxtLinkIndexStringStrc* pStrings;		//0x18
+};
+
+#pragma pack()
+
+// Helper function: Returns the size of the buffer needed by DATATBLS_BuildLinkIndex
+size_t __fastcall DATATBLS_GetLinkIndexSize(D2TxtLinkStrc* pLinker);
+// Helper function: Builds the index of pLinker in pBuffer, which must be DATATBLS_GetLinkIndexSize bytes
+D2TxtLinkIndexStrc* __fastcall DATATBLS_BuildLinkIndex(D2TxtLinkStrc* pLinker, void* pBuffer);
+// Helper function: Returns LINKINDEX_NOT_FOUND if the code is not indexed
+int __fastcall DATATBLS_FindCodeInLinkIndex(const D2TxtLinkIndexStrc* pIndex, uint32_t dwCode);
+// Helper function: Returns LINKINDEX_NOT_FOUND if the string is not indexed
+int __fastcall DATATBLS_FindStringInLinkIndex(const D2TxtLinkIndexStrc* pIndex, const char* szText);
+
+// Helper function: Frees the indices of all linkers, and allows building them until DATATBLS_FinalizeLinkIndices
+void __fastcall DATATBLS_InitLinkIndices();
+// Helper function
+void __fastcall DATATBLS_FreeLinkIndices();
+// Helper function: Builds the indices of the linkers used at runtime
+void __fastcall DATATBLS_FinalizeLinkIndices();
+// Helper function: Same as FOG_GetLinkIndex
+int __fastcall DATATBLS_GetLinkIndex(D2TxtLinkStrc* pLinker, uint32_t dwCode, BOOL bLogError);
+// Helper function: Same as FOG_GetRowFromTxt
+int __fastcall DATATBLS_GetRowFromTxt(D2TxtLinkStrc* pLinker, char* szText, int nColumn);
+// Helper function: Resolves nCount codes read every nStride bytes from pCodes, same as FOG_GetLinkIndex
+void __fastcall DATATBLS_ResolveLinkCodes(D2TxtLinkStrc* pLinker, const uint32_t* pCodes, size_t nStride, int nCount, int* pLinkIndices, BOOL bLogError);
+// Helper function: Resolves nCount strings, same as FOG_GetRowFromTxt
+void __fastcall DATATBLS_ResolveLinkStrings(D2TxtLinkStrc* pLinker, char* const* pStrings, int nCount, int* pRows, int nColumn);
@@ -33,6 +33,11 @@ struct D2TCExInfoStrc
 	int16_t unk0x1A;						//0x1A
 };
 
+enum D2C_TreasureClassConstants
+{
+	TREASURECLASS_NODROP_MAX_PLAYERS = 8,	// D2Moo only, size of D2TCExShortStrc::nNoDropByPlayers
+};
+
 struct D2TCExShortStrc
 {
 	int16_t nGroup;							//0x00
@@ -51,6 +56,7 @@ struct D2TCExShortStrc
 	int16_t nNormal;						//0x24
 	int16_t unk0x26;						//0x26
 	D2TCExInfoStrc* pInfo;					//0x28
+	int32_t nNoDropByPlayers[2][TREASURECLASS_NODROP_MAX_PLAYERS];	//0x2C D2Moo only, nNoDrop for 1 to 8 players, in classic then expansion (see DATATBLS_GetTreasureClassNoDrop)
 };
 
 struct D2MonEquipTxt
@@ -694,6 +700,14 @@ D2COMMON_DLL_DECL D2TCExShortStrc* __stdcall DATATBLS_GetTreasureClassExRecordFr
 D2COMMON_DLL_DECL D2TCExShortStrc* __stdcall DATATBLS_GetTreasureClassExRecordFromActAndDifficulty(int nDifficulty, int nAct, int nIndex);
 //D2Common.0x6FD68EC0
 void __fastcall DATATBLS_LoadTreasureClassExTxt(HD2ARCHIVE hArchive);
+// Helper function: Returns the nodrop of a treasure class of nChance adjusted for nPlayerCount players, as done by D2GAME_DropTC_6FC51360
+int __fastcall DATATBLS_ComputeTreasureClassNoDrop(int nChance, int nNoDrop, uint32_t nPlayerCount);
+// Helper function: Fills nNoDropByPlayers once the probabilities of the treasure class are final
+void __fastcall DATATBLS_BuildTreasureClassNoDropTable(D2TCExShortStrc* pTCExRecord);
+// Helper function: Same as DATATBLS_ComputeTreasureClassNoDrop with the probabilities of the treasure class
+D2COMMON_DLL_DECL int __fastcall DATATBLS_GetTreasureClassNoDrop(D2TCExShortStrc* pTCExRecord, BOOL bExpansion, uint32_t nPlayerCount);
+// Helper function: Returns the index of the entry of pInfo picked by nRand, or nTypes if no entry can be picked
+D2COMMON_DLL_DECL int __fastcall DATATBLS_PickTreasureClassEntry(D2TCExShortStrc* pTCExRecord, BOOL bExpansion, int nRand);
 //D2Common.0x6FD69B70 (#10656)
 D2COMMON_DLL_DECL int __stdcall DATATBLS_ShouldNeverCallInExpansion();
 //D2Common.0x6FD69B90
@@ -30,6 +30,8 @@ struct D2RoomCollisionGridStrc;
 struct D2LvlWarpTxt;
 struct D2LvlMazeTxt;
 struct D2UnitStrc;
+struct D2UnitSpatialIndexStrc;
+struct D2DrlgRoomIndexStrc;
 
 enum D2DrlgFlags
 {
@@ -242,6 +244,7 @@ struct D2ActiveRoomStrc // Used to be called D2RoomStrc
 	D2UnitGUID nLastDeadGUIDs[4];			//0x68
 	D2DrlgActStrc* pAct;					//0x78
 	D2ActiveRoomStrc* pRoomNext;			//0x7C
+	int32_t nPlayerUnits;					//0x80 D2Moo only, number of players in pUnitFirst
 };
 
 struct D2RoomTileStrc
@@ -334,6 +337,7 @@ struct D2DrlgActStrc
 	BOOL bUpdate;							//0x28
 	D2DrlgTileDataStrc pTileData;			//0x2C
 	void* pMemPool;							//0x5C
+	D2UnitSpatialIndexStrc* pSpatialIndex;	//0x60 D2Moo only, see UNITSPATIAL_IsEnabled
 };
 
 struct D2DrlgAnimTileGridStrc
@@ -424,6 +428,7 @@ struct D2DrlgLevelStrc
 	uint32_t dwInactiveFrames;					//0x224
 	int32_t* pPresetMaps;						//0x228
 	D2DrlgLevelStrc* pNextLevel;				//0x22C
+	D2DrlgRoomIndexStrc* pRoomIndex;			//0x230 D2Moo only, see DRLGROOMINDEX_GetIndex
 };
 
 struct D2DrlgLinkStrc
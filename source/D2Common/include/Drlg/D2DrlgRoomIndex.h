@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CommonDefinitions.h"
+
+struct D2DrlgRoomStrc;
+struct D2DrlgLevelStrc;
+
+// D2Moo only: uniform grid of the rooms of a level, used by DRLG_GetRoomExFromLevelAndCoordinates instead of walking every room of the level.
+// The grid is built on the first lookup, and freed whenever rooms are added to the level, removed or moved (see DRLGROOMINDEX_Invalidate).
+// The rooms of each cell are kept in the order of the level, so that the first room containing a position is the same as with the linear search.
+
+#pragma pack(1)
+
+enum D2C_DrlgRoomIndexConstants
+{
+	DRLGROOMINDEX_CELL_SIZE_SHIFT = 3,		// Cells are 8x8 tiles, outdoor rooms are 8x8 tiles
+	DRLGROOMINDEX_MAX_CELLS = 0x4000,		// The cells get larger for levels that would need more
+};
+
+struct D2DrlgRoomIndexStrc
+{
+	int32_t nOriginX;						//0x00 In tiles
+	int32_t nOriginY;						//0x04
+	int32_t nCellSizeShift;					//0x08
+	int32_t nCellsX;						//0x0C
+	int32_t nCellsY;						//0x10
+	int32_t* pCellStarts;					//0x14 nCellsX * nCellsY + 1 offsets in ppRooms
+	D2DrlgRoomStrc** ppRooms;				//0x18
+};
+
+#pragma pack()
+
+// Helper function: Returns the size of the buffer needed by DRLGROOMINDEX_BuildIndex
+size_t __fastcall DRLGROOMINDEX_GetIndexSize(D2DrlgLevelStrc* pLevel);
+// Helper function: Builds the index of the rooms of pLevel in pBuffer, which must be DRLGROOMINDEX_GetIndexSize bytes
+D2DrlgRoomIndexStrc* __fastcall DRLGROOMINDEX_BuildIndex(D2DrlgLevelStrc* pLevel, void* pBuffer);
+// Helper function: Returns the first room of the level containing nX, nY
+D2DrlgRoomStrc* __fastcall DRLGROOMINDEX_FindRoom(const D2DrlgRoomIndexStrc* pIndex, int nX, int nY);
+// Helper function: Returns the index of the level, built if needed, or nullptr if the level has no rooms
+D2DrlgRoomIndexStrc* __fastcall DRLGROOMINDEX_GetIndex(D2DrlgLevelStrc* pLevel);
+// Helper function: Frees the index of the level, must be called when its rooms change
+void __fastcall DRLGROOMINDEX_Invalidate(D2DrlgLevelStrc* pLevel);
@@ -4,60 +4,79 @@
 #include "Path.h"
 #include "D2Seed.h"
 
+struct D2DrlgCoordsStrc;
+
 #pragma pack(1)
 
 enum PATH_IDASTAR_CONSTANTS
 {
 	IDASTAR_MAXPROOM = 50000, // Max size of a room for IDAStar (ptRoomCoords->nSizeGameX * ptRoomCoords->nSizeGameY <= MAXPROOM)
+	IDASTAR_MAXNODES = 900,
+	IDASTAR_INVALID_NODE = -1,
+};
+
+// D2Moo only: the original game used an array of D2PathIDAStarNodeStrc (sizeof 0x1C) linked by pointers,
+// in a D2PathIDAStarContextStrc of 0x36FD8 bytes built on the stack for each path, and cleared aCoordData with memset.
+// Nodes are now stored as a struct of arrays and linked by index, so that the hot fields of the search stay in a few cache lines,
+// and the context is kept per thread (see PATH_IDAStar_GetThreadContext).
+struct D2PathIDAStarNodesStrc
+{
+	uint16_t aFScore[IDASTAR_MAXNODES];
+	uint16_t aHeuristicDistanceToTarget[IDASTAR_MAXNODES];
+	uint16_t aBestDistanceFromStart[IDASTAR_MAXNODES];
+	int16_t aEvaluationsCount[IDASTAR_MAXNODES];
+	int16_t aParent[IDASTAR_MAXNODES];
+	int16_t aBestChild[IDASTAR_MAXNODES];
+	uint8_t aNeighborsSequence[IDASTAR_MAXNODES];		// Index in the flattened dword_6FDD1BE0 table, may overflow to the next row like the original pointer
+	uint8_t aNextNeighborIndex[IDASTAR_MAXNODES];
+	D2PathPointStrc aCoord[IDASTAR_MAXNODES];
 };
 
-struct D2PathIDAStarNodeStrc             // sizeof 0x1C
+struct D2PathIDAStarCoordDataStrc
 {
-	uint16_t nFScore;                    // 0x00
-	uint16_t nHeuristicDistanceToTarget; // 0x02
-	uint16_t nBestDistanceFromStart;     // 0x04
-	int16_t nEvaluationsCount;           // 0x06
-	D2PathPointStrc tCoord;              // 0x08
-	int* pNeighborsSequence;             // 0x0C
-	int nNextNeighborIndex;              // 0x10
-	D2PathIDAStarNodeStrc* pParent;		 // 0x14
-	D2PathIDAStarNodeStrc* pBestChild;   // 0x18
+	uint32_t nGeneration;								// nBestDistanceFromStart is considered to be 0 if this is not the current generation of the context
+	int32_t nBestDistanceFromStart;
 };
 
-struct D2PathIDAStarContextStrc                           // sizof 0x36FD8
+struct D2PathIDAStarContextStrc
 {
-	static const size_t STORAGE_SIZE = 900;
-
-	D2PathIDAStarNodeStrc* pCurrentNode;				  // 0x00000
-	D2PathIDAStarNodeStrc aNodesStorage[STORAGE_SIZE];	  // 0x00004
-	int32_t nNodesCount;								  // 0x06274
-	D2PathPointStrc nCoord[3];							  // 0x06278
-	int32_t nStride;									  // 0x06284
-	int32_t nXOffset;										  // 0x06288
-	int32_t nYOffset;										  // 0x0628C
-	int32_t aCoordData[IDASTAR_MAXPROOM];				  // 0x06290
-	BOOL bRandomDirection;								  // 0x36FD0
-	D2SeedStrc* pSeed;									  // 0x36FD4
+	D2PathIDAStarNodesStrc tNodes;
+	int32_t nNodesCount;
+	D2PathPointStrc nCoord[3];
+	int32_t nStride;
+	int32_t nXOffset;
+	int32_t nYOffset;
+	BOOL bRandomDirection;
+	D2SeedStrc* pSeed;
+	uint32_t nGeneration;								// Incremented for each path instead of clearing aCoordData
+	D2PathIDAStarCoordDataStrc aCoordData[IDASTAR_MAXPROOM];
 };
 
 #pragma pack()
 
+//1.10f: Inlined
+//1.13c: D2Common.0x6FDC0BB0
+int __fastcall PATH_IdaStar_ComputePathWithRooms(D2DrlgCoordsStrc* pRoomCoords, D2PathInfoStrc* pPathInfo);
+
 //1.10f: D2Common.0x6FDA7970
 //1.13c: D2Common.0x6FDC0E40
 int __fastcall PATH_IdaStar_6FDA7970(D2PathInfoStrc* pPathInfo);
 
+// Helper function: Returns the context of the calling thread, allocated on first use and reused by all the paths of this thread.
+D2PathIDAStarContextStrc* __fastcall PATH_IDAStar_GetThreadContext();
+
 //1.10f: D2Common.0x6FDA7D40
 //1.13c: D2Common.0x6FDC08F0
-D2PathIDAStarNodeStrc* __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextStrc* pContext, int nFScoreCutoff, D2PathInfoStrc* pPathInfo);
+int32_t __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextStrc* pContext, int nFScoreCutoff, D2PathInfoStrc* pPathInfo);
 
 //1.10c: D2Common.0x6FDA81C0
 //1.13f: D2Common.0x6FDC07E0
-void __fastcall PATH_IDAStar_GetNextNeighborIndex(D2PathIDAStarNodeStrc* pNode, D2PathIDAStarContextStrc* pContext);
+void __fastcall PATH_IDAStar_GetNextNeighborIndex(int32_t nNode, D2PathIDAStarContextStrc* pContext);
 
 //1.10f: Inlined
 //1.13c: D2Common.0x6FDC0840
-D2PathIDAStarNodeStrc* __fastcall sub_6FDC0840(D2PathIDAStarNodeStrc* pNode, D2PathIDAStarContextStrc* pContext);
+int32_t __fastcall sub_6FDC0840(int32_t nNode, D2PathIDAStarContextStrc* pContext);
 
 //1.10f: Inlined
 //1.13c: D2Common.0x6FDC0650
-signed int __fastcall PATH_IDAStar_FlushNodeToDynamicPath(D2PathIDAStarNodeStrc* pNode, D2PathInfoStrc* pPathInfo);
\ No newline at end of file
+signed int __fastcall PATH_IDAStar_FlushNodeToDynamicPath(D2PathIDAStarContextStrc* pContext, int32_t nNode, D2PathInfoStrc* pPathInfo);
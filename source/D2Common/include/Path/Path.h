@@ -216,6 +216,7 @@ enum D2PathConstants {
 // Helper functions
 inline uint8_t PATH_NormalizeDirection(uint8_t nDirection) { return nDirection % PATH_NB_DIRECTIONS; }
 void PATH_UpdateClientCoords(D2DynamicPathStrc* pDynamicPath);
+void PATH_UpdateSpatialIndex(D2DynamicPathStrc* pDynamicPath);
 
 //D2Common.0x6FDA8220
 void __fastcall sub_6FDA8220(D2DynamicPathStrc* pDynamicPath);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CommonDefinitions.h"
+
+struct D2ActiveRoomStrc;
+struct D2UnitStrc;
+
+// D2Moo only: uniform grid of the units of an act, used to find units around a position without walking every unit of the adjacent rooms.
+// Units are indexed while they are linked to a room (see UNITROOM_AddUnitToRoomEx and UNITROOM_RemoveUnitFromRoom),
+// and their cell is updated when their path moves them (see PATH_UpdateSpatialIndex).
+// Disabled by default since it changes which units are tested by UNITFINDS_FindAllMatchingUnitsInNeighboredRooms and UNITFINDS_GetNearestTestedUnit:
+// only the units inside the search box are tested instead of all the units of the adjacent rooms.
+// Enabled for server acts with the D2_UNIT_SPATIAL_INDEX environment variable.
+
+#pragma pack(1)
+
+enum D2C_UnitSpatialIndexConstants
+{
+	UNITSPATIAL_CELL_SIZE_SHIFT = 4,		// Cells are 16x16 subtiles
+	UNITSPATIAL_CELL_BUCKETS = 1024,
+	UNITSPATIAL_UNIT_BUCKETS = 1024,
+	UNITSPATIAL_MAX_QUERY_SIZE = 128,		// Larger queries are cheaper by walking the rooms
+	UNITSPATIAL_MAX_CANDIDATES = 256,		// Queries finding more units walk the rooms
+};
+
+struct D2UnitSpatialCellStrc;
+
+struct D2UnitSpatialEntryStrc
+{
+	D2UnitStrc* pUnit;						//0x00
+	int32_t nX;								//0x04
+	int32_t nY;								//0x08
+	D2UnitSpatialCellStrc* pCell;			//0x0C
+	D2UnitSpatialEntryStrc* pCellPrev;		//0x10
+	D2UnitSpatialEntryStrc* pCellNext;		//0x14
+	D2UnitSpatialEntryStrc* pUnitHashNext;	//0x18 Also used for the free list
+};
+
+struct D2UnitSpatialCellStrc
+{
+	int32_t nCellX;							//0x00
+	int32_t nCellY;							//0x04
+	D2UnitSpatialEntryStrc* pFirstEntry;	//0x08
+	D2UnitSpatialCellStrc* pHashNext;		//0x0C
+};
+
+struct D2UnitSpatialIndexStrc
+{
+	void* pMemPool;																//0x00
+	int32_t nUnits;																//0x04
+	D2UnitSpatialEntryStrc* pFreeEntries;										//0x08
+	D2UnitSpatialCellStrc* pCellBuckets[UNITSPATIAL_CELL_BUCKETS];				//0x0C
+	D2UnitSpatialEntryStrc* pUnitBuckets[UNITSPATIAL_UNIT_BUCKETS];
+};
+
+#pragma pack()
+
+// Helper function
+BOOL __fastcall UNITSPATIAL_IsEnabled();
+// Helper function
+D2UnitSpatialIndexStrc* __fastcall UNITSPATIAL_AllocIndex(void* pMemPool);
+// Helper function
+void __fastcall UNITSPATIAL_FreeIndex(D2UnitSpatialIndexStrc* pIndex);
+// Helper function: Returns the index of the act of the room, or nullptr if the act has none
+D2UnitSpatialIndexStrc* __fastcall UNITSPATIAL_GetIndexFromRoom(D2ActiveRoomStrc* pRoom);
+// Helper function: Adds the unit, or moves it if it is already indexed
+void __fastcall UNITSPATIAL_InsertUnit(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit, int32_t nX, int32_t nY);
+// Helper function: Does nothing if the unit is not indexed
+void __fastcall UNITSPATIAL_MoveUnit(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit, int32_t nX, int32_t nY);
+// Helper function
+void __fastcall UNITSPATIAL_RemoveUnit(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit);
+// Helper function: Links pCell to the index, for the cell nCellX, nCellY that must not exist yet. Cells are otherwise allocated when a unit enters them.
+void __fastcall UNITSPATIAL_AddCell(D2UnitSpatialIndexStrc* pIndex, D2UnitSpatialCellStrc* pCell, int32_t nCellX, int32_t nCellY);
+// Helper function: Fills ppUnits with the units within nSize subtiles (on both axis) of nX, nY, in no particular order.
+// Returns the number of units, or -1 if there are more than nMaxUnits.
+int32_t __fastcall UNITSPATIAL_FindUnitsInBox(D2UnitSpatialIndexStrc* pIndex, int32_t nX, int32_t nY, int32_t nSize, D2UnitStrc** ppUnits, int32_t nMaxUnits);
@@ -5,6 +5,16 @@
 #include <D2Lang.h>
 #include <D2CMP.h>
 
+#include <intrin.h>
+#include <immintrin.h>
+
+// MSVC allows AVX2 intrinsics in any function, clang and gcc need the target attribute
+#if defined(__clang__) || defined(__GNUC__)
+#define COLLISION_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define COLLISION_TARGET_AVX2
+#endif
+
 //D2Common.0x6FD41000
 void __fastcall D2Common_COLLISION_FirstFn_6FD41000(D2ActiveRoomStrc* pRoom, D2DrlgTileDataStrc* pTileData, D2TileLibraryEntryStrc* pTileLibraryEntry)
 {
@@ -346,6 +356,138 @@ uint16_t __stdcall COLLISION_CheckMaskWithSizeXY(D2ActiveRoomStrc* pRoom, int nX
 	return COLLISION_CheckCollisionMaskForBoundingBoxRecursively(pRoom, &pBoundingBox, nMask);
 }
 
+// Helper function
+static uint16_t __fastcall COLLISION_OrReduceMaskRow_Scalar(const uint16_t* pRow, int32_t nWidth, const uint16_t* pReadLimit)
+{
+	uint16_t nResult = 0;
+	for (int32_t x = 0; x < nWidth; x++)
+	{
+		nResult |= pRow[x];
+	}
+	return nResult;
+}
+
+// Lanes kept when loading 8 masks for a row of n < 8 cells
+alignas(16) static const uint16_t gaCollisionRowTailLanes[8][8] = {
+	{ 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },
+	{ 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },
+	{ 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },
+	{ 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },
+	{ 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000 },
+	{ 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000 },
+	{ 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000 },
+	{ 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000 },
+};
+
+// Helper function
+static inline __m128i COLLISION_OrReduceMaskRowTail_SSE2(__m128i vResult, const uint16_t* pRow, int32_t nWidth, const uint16_t* pReadLimit)
+{
+	if (nWidth <= 0)
+	{
+		return vResult;
+	}
+
+	if (pRow + 8 <= pReadLimit)
+	{
+		// Unit sized boxes are only a few cells wide, read a full vector and drop the cells after the row
+		const __m128i vTail = _mm_loadu_si128((const __m128i*)pRow);
+		return _mm_or_si128(vResult, _mm_and_si128(vTail, _mm_load_si128((const __m128i*)gaCollisionRowTailLanes[nWidth])));
+	}
+
+	return _mm_or_si128(vResult, _mm_cvtsi32_si128(COLLISION_OrReduceMaskRow_Scalar(pRow, nWidth, pReadLimit)));
+}
+
+// Helper function
+static inline uint16_t COLLISION_HorizontalOr_SSE2(__m128i vResult)
+{
+	vResult = _mm_or_si128(vResult, _mm_srli_si128(vResult, 8));
+	vResult = _mm_or_si128(vResult, _mm_srli_si128(vResult, 4));
+	vResult = _mm_or_si128(vResult, _mm_srli_si128(vResult, 2));
+	return (uint16_t)_mm_cvtsi128_si32(vResult);
+}
+
+// Helper function
+static uint16_t __fastcall COLLISION_OrReduceMaskRow_SSE2(const uint16_t* pRow, int32_t nWidth, const uint16_t* pReadLimit)
+{
+	__m128i vResult = _mm_setzero_si128();
+	for (; nWidth >= 8; nWidth -= 8, pRow += 8)
+	{
+		vResult = _mm_or_si128(vResult, _mm_loadu_si128((const __m128i*)pRow));
+	}
+	vResult = COLLISION_OrReduceMaskRowTail_SSE2(vResult, pRow, nWidth, pReadLimit);
+	return COLLISION_HorizontalOr_SSE2(vResult);
+}
+
+// Helper function
+COLLISION_TARGET_AVX2 static uint16_t __fastcall COLLISION_OrReduceMaskRow_AVX2(const uint16_t* pRow, int32_t nWidth, const uint16_t* pReadLimit)
+{
+	__m256i vResult256 = _mm256_setzero_si256();
+	for (; nWidth >= 16; nWidth -= 16, pRow += 16)
+	{
+		vResult256 = _mm256_or_si256(vResult256, _mm256_loadu_si256((const __m256i*)pRow));
+	}
+
+	__m128i vResult = _mm_or_si128(_mm256_castsi256_si128(vResult256), _mm256_extracti128_si256(vResult256, 1));
+	if (nWidth >= 8)
+	{
+		vResult = _mm_or_si128(vResult, _mm_loadu_si128((const __m128i*)pRow));
+		nWidth -= 8;
+		pRow += 8;
+	}
+	vResult = COLLISION_OrReduceMaskRowTail_SSE2(vResult, pRow, nWidth, pReadLimit);
+	return COLLISION_HorizontalOr_SSE2(vResult);
+}
+
+// Helper function
+int __fastcall COLLISION_GetSupportedSimdLevel()
+{
+	int aCpuInfo[4] = {};
+	__cpuid(aCpuInfo, 0);
+	const int nMaxLeaf = aCpuInfo[0];
+	if (nMaxLeaf < 1)
+	{
+		return COLLISION_SIMD_SCALAR;
+	}
+
+	__cpuid(aCpuInfo, 1);
+	const bool bSSE2 = (aCpuInfo[3] & (1 << 26)) != 0;
+	const bool bOSXSAVE = (aCpuInfo[2] & (1 << 27)) != 0;
+	const bool bAVX = (aCpuInfo[2] & (1 << 28)) != 0;
+	if (!bSSE2)
+	{
+		return COLLISION_SIMD_SCALAR;
+	}
+
+	// The OS must save the YMM registers on context switches
+	if (nMaxLeaf >= 7 && bOSXSAVE && bAVX && (_xgetbv(0) & 6) == 6)
+	{
+		__cpuidex(aCpuInfo, 7, 0);
+		if (aCpuInfo[1] & (1 << 5))
+		{
+			return COLLISION_SIMD_AVX2;
+		}
+	}
+
+	return COLLISION_SIMD_SSE2;
+}
+
+// Helper function
+CollisionMaskRowKernel __fastcall COLLISION_GetMaskRowKernel(int nSimdLevel)
+{
+	switch (nSimdLevel)
+	{
+	case COLLISION_SIMD_AVX2:
+		return COLLISION_OrReduceMaskRow_AVX2;
+	case COLLISION_SIMD_SSE2:
+		return COLLISION_OrReduceMaskRow_SSE2;
+	default:
+		return COLLISION_OrReduceMaskRow_Scalar;
+	}
+}
+
+// Selected once when the DLL is loaded
+static const CollisionMaskRowKernel gpfCollisionMaskRowKernel = COLLISION_GetMaskRowKernel(COLLISION_GetSupportedSimdLevel());
+
 //D2Common.0x6FD41B40
 uint16_t __fastcall COLLISION_CheckCollisionMaskForBoundingBox(D2RoomCollisionGridStrc* pCollisionGrid, D2BoundingBoxStrc* pBoundingBox, uint16_t nMask)
 {
@@ -353,17 +495,17 @@ uint16_t __fastcall COLLISION_CheckCollisionMaskForBoundingBox(D2RoomCollisionGr
 	const int32_t boxHeight = pBoundingBox->nTop - pBoundingBox->nBottom + 1;
 	const int32_t nCollisionMaskBeginX = pBoundingBox->nLeft - pCollisionGrid->pRoomCoords.nSubtileX;
 	const int32_t nCollisionMaskBeginY = pBoundingBox->nBottom - pCollisionGrid->pRoomCoords.nSubtileY;
+	const uint16_t* pCollisionMaskEnd = &pCollisionGrid->pCollisionMask[pCollisionGrid->pRoomCoords.nSubtileWidth * pCollisionGrid->pRoomCoords.nSubtileHeight];
 	
+	// (a & nMask) | (b & nMask) == (a | b) & nMask, so we can reduce the rows first and apply the mask once
 	uint16_t nResult = 0;
 	const uint16_t* pCollisionMaskLine = &pCollisionGrid->pCollisionMask[nCollisionMaskBeginX + nCollisionMaskBeginY * pCollisionGrid->pRoomCoords.nSubtileWidth];
 	for (int y = 0; y < boxHeight; y++)
 	{
-		for (int x = 0; x < boxWidth; x++) {
-			nResult |= pCollisionMaskLine[x] & nMask;
-		}
+		nResult |= gpfCollisionMaskRowKernel(pCollisionMaskLine, boxWidth, pCollisionMaskEnd);
 		pCollisionMaskLine += pCollisionGrid->pRoomCoords.nSubtileWidth;
 	}
-	return nResult;
+	return nResult & nMask;
 }
 
 //D2Common.0x6FD41BE0
@@ -13,6 +13,7 @@
 #include "D2Environment.h"
 #include "Units/UnitRoom.h"
 #include "Units/Units.h"
+#include "Units/UnitSpatialIndex.h"
 #include "D2Seed.h"
 
 
@@ -29,6 +30,12 @@ D2DrlgActStrc* __stdcall DUNGEON_AllocAct(uint8_t nAct, uint32_t nInitSeed, BOOL
 	if (!bClient)
 	{
 		pAct->nTownId = nTownLevelId;
+
+		// D2Moo only
+		if (UNITSPATIAL_IsEnabled())
+		{
+			pAct->pSpatialIndex = UNITSPATIAL_AllocIndex(pMemPool);
+		}
 	}
 
 	pAct->pDrlg = DRLG_AllocDrlg(pAct, nAct, 0, nInitSeed, (bClient ? LEVEL_NONE : nTownLevelId), (bClient ? DRLGFLAG_ONCLIENT : 0), pGame, nDifficulty, pfAutoMap, pfTownAutoMap);
@@ -67,6 +74,12 @@ void __stdcall DUNGEON_FreeAct(D2DrlgActStrc* pAct)
 		pAct->pEnvironment = NULL;
 	}
 
+	if (pAct->pSpatialIndex)
+	{
+		UNITSPATIAL_FreeIndex(pAct->pSpatialIndex);
+		pAct->pSpatialIndex = NULL;
+	}
+
 	D2_FREE_POOL(pAct->pMemPool, pAct);
 }
 
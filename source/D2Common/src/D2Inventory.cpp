@@ -377,7 +377,7 @@ BOOL __fastcall INVENTORY_RemoveItem(D2UnitStrc* pItem)
 
 				if (nNodePos < 1)
 				{
-					pInventoryGrid->ppItems[pCoords.nX + pCoords.nY * pInventoryGrid->nGridWidth] = nullptr;
+					INVENTORY_SetGridCells(pInventoryGrid, pCoords.nX, pCoords.nY, 1, 1, nullptr);
 				}
 				else
 				{
@@ -386,13 +386,7 @@ BOOL __fastcall INVENTORY_RemoveItem(D2UnitStrc* pItem)
 
 					ITEMS_GetDimensions(pItem, &nWidth, &nHeight, __FILE__, __LINE__);
 
-					for (int y = pCoords.nY; y < pCoords.nY + nHeight; ++y)
-					{
-						for (int x = pCoords.nX; x < pCoords.nX + nWidth; ++x)
-						{
-							pInventoryGrid->ppItems[y * pInventoryGrid->nGridWidth + x] = nullptr;
-						}
-					}
+					INVENTORY_SetGridCells(pInventoryGrid, pCoords.nX, pCoords.nY, nWidth, nHeight, nullptr);
 				}
 			}
 
@@ -730,8 +724,7 @@ D2InventoryGridStrc* __fastcall INVENTORY_GetGrid(D2InventoryStrc* pInventory, i
 		pInventoryGrid = &pInventory->pGrids[nInventoryGrid];
 		pInventoryGrid->nGridWidth = pInventoryGridInfo->nGridX;
 		pInventoryGrid->nGridHeight = pInventoryGridInfo->nGridY;
-		pInventoryGrid->ppItems = (D2UnitStrc**)D2_ALLOC_POOL(pInventory->pMemPool, sizeof(D2UnitStrc*) * pInventoryGrid->nGridHeight * pInventoryGrid->nGridWidth);
-		memset(pInventoryGrid->ppItems, 0x00, sizeof(D2UnitStrc*) * pInventoryGrid->nGridHeight * pInventoryGrid->nGridWidth);
+		INVENTORY_AllocGridCells(pInventory, pInventoryGrid);
 	}
 	else
 	{
@@ -742,8 +735,7 @@ D2InventoryGridStrc* __fastcall INVENTORY_GetGrid(D2InventoryStrc* pInventory, i
 			{
 				pInventoryGrid->nGridWidth = pInventoryGridInfo->nGridX;
 				pInventoryGrid->nGridHeight = pInventoryGridInfo->nGridY;
-				pInventoryGrid->ppItems = (D2UnitStrc**)D2_ALLOC_POOL(pInventory->pMemPool, sizeof(D2UnitStrc*) * pInventoryGrid->nGridHeight * pInventoryGrid->nGridWidth);
-				memset(pInventoryGrid->ppItems, 0x00, sizeof(D2UnitStrc*) * pInventoryGrid->nGridHeight * pInventoryGrid->nGridWidth);
+				INVENTORY_AllocGridCells(pInventory, pInventoryGrid);
 			}
 
 			if (pInventoryGrid->nGridWidth != pInventoryGridInfo->nGridX || pInventoryGrid->nGridHeight != pInventoryGridInfo->nGridY)
@@ -760,6 +752,111 @@ D2InventoryGridStrc* __fastcall INVENTORY_GetGrid(D2InventoryStrc* pInventory, i
 	return pInventoryGrid;
 }
 
+// Helper function
+void __fastcall INVENTORY_AllocGridCells(D2InventoryStrc* pInventory, D2InventoryGridStrc* pInventoryGrid)
+{
+	const int nCells = pInventoryGrid->nGridHeight * pInventoryGrid->nGridWidth;
+	const int nRowMasks = pInventoryGrid->nGridWidth <= INVENTORY_GRID_MAX_MASK_WIDTH ? pInventoryGrid->nGridHeight : 0;
+	const size_t nSize = sizeof(D2UnitStrc*) * nCells + sizeof(uint32_t) * nRowMasks;
+	pInventoryGrid->ppItems = (D2UnitStrc**)D2_ALLOC_POOL(pInventory->pMemPool, nSize);
+	memset(pInventoryGrid->ppItems, 0x00, nSize);
+	pInventoryGrid->pRowMasks = nRowMasks ? (uint32_t*)&pInventoryGrid->ppItems[nCells] : nullptr;
+}
+
+// Helper function: Returns the mask of the columns nX to nX + nWidth - 1
+static uint32_t INVENTORY_GetColumnsMask(int nX, int nWidth)
+{
+	if (nWidth <= 0)
+	{
+		return 0;
+	}
+
+	return (0xFFFFFFFF >> (INVENTORY_GRID_MAX_MASK_WIDTH - nWidth)) << nX;
+}
+
+// Helper function
+static int INVENTORY_CountBits(uint32_t nMask)
+{
+	nMask = nMask - ((nMask >> 1) & 0x55555555);
+	nMask = (nMask & 0x33333333) + ((nMask >> 2) & 0x33333333);
+	return (((nMask + (nMask >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+// Helper function
+void __fastcall INVENTORY_SetGridCells(D2InventoryGridStrc* pInventoryGrid, int nX, int nY, int nWidth, int nHeight, D2UnitStrc* pItem)
+{
+	const int nCells = pInventoryGrid->nGridWidth * pInventoryGrid->nGridHeight;
+	for (int y = nY; y < nY + nHeight; ++y)
+	{
+		for (int x = nX; x < nX + nWidth; ++x)
+		{
+			const int nCell = x + y * pInventoryGrid->nGridWidth;
+			pInventoryGrid->ppItems[nCell] = pItem;
+
+			// D2Moo only: the masks follow the cells, even for rectangles that do not fit in the grid
+			if (pInventoryGrid->pRowMasks && nCell >= 0 && nCell < nCells)
+			{
+				const uint32_t nMask = 1u << (nCell % pInventoryGrid->nGridWidth);
+				if (pItem)
+				{
+					pInventoryGrid->pRowMasks[nCell / pInventoryGrid->nGridWidth] |= nMask;
+				}
+				else
+				{
+					pInventoryGrid->pRowMasks[nCell / pInventoryGrid->nGridWidth] &= ~nMask;
+				}
+			}
+		}
+	}
+}
+
+// Helper function
+void __fastcall INVENTORY_CopyGridCells(D2InventoryGridStrc* pDestination, const D2InventoryGridStrc* pSource)
+{
+	memcpy(pDestination->ppItems, pSource->ppItems, sizeof(D2UnitStrc*) * pSource->nGridWidth * pSource->nGridHeight);
+
+	// D2Moo only: grids of the same size both have row masks, or neither has
+	if (pDestination->pRowMasks && pSource->pRowMasks)
+	{
+		memcpy(pDestination->pRowMasks, pSource->pRowMasks, sizeof(uint32_t) * pSource->nGridHeight);
+	}
+}
+
+// Helper function: Sets bit x of pFreeMasks[y] when the item can be placed at x, y. Returns FALSE if the grid has no row masks
+static BOOL INVENTORY_GetFreePositionMasks(D2InventoryGridStrc* pInventoryGrid, uint8_t nItemWidth, uint8_t nItemHeight, uint32_t* pFreeMasks)
+{
+	if (!pInventoryGrid->pRowMasks || !nItemWidth || !nItemHeight)
+	{
+		return FALSE;
+	}
+
+	for (int nY = 0; nY < pInventoryGrid->nGridHeight; ++nY)
+	{
+		pFreeMasks[nY] = 0;
+		if (nItemWidth > pInventoryGrid->nGridWidth || nY + nItemHeight > pInventoryGrid->nGridHeight)
+		{
+			continue;
+		}
+
+		uint32_t nOccupied = 0;
+		for (int nTestY = nY; nTestY < nY + nItemHeight; ++nTestY)
+		{
+			nOccupied |= pInventoryGrid->pRowMasks[nTestY];
+		}
+
+		// The item can't start at a column if any of the nItemWidth columns from there is occupied
+		uint32_t nBlocked = nOccupied;
+		for (int i = 1; i < nItemWidth; ++i)
+		{
+			nBlocked |= nOccupied >> i;
+		}
+
+		pFreeMasks[nY] = ~nBlocked & INVENTORY_GetColumnsMask(0, pInventoryGrid->nGridWidth - nItemWidth + 1);
+	}
+
+	return TRUE;
+}
+
 //D2Common.0x6FD8EC70
 BOOL __fastcall INVENTORY_CanItemBePlacedAtPos(D2InventoryGridStrc* pInventoryGrid, int nX, int nY, uint8_t nItemWidth, uint8_t nItemHeight)
 {
@@ -768,6 +865,21 @@ BOOL __fastcall INVENTORY_CanItemBePlacedAtPos(D2InventoryGridStrc* pInventoryGr
 		return FALSE;
 	}
 
+	// D2Moo only: test the rows of the item at once
+	if (pInventoryGrid->pRowMasks && nX >= 0 && nY >= 0)
+	{
+		const uint32_t nItemMask = INVENTORY_GetColumnsMask(nX, nItemWidth);
+		for (int nTestY = nY; nTestY < nY + nItemHeight; ++nTestY)
+		{
+			if (pInventoryGrid->pRowMasks[nTestY] & nItemMask)
+			{
+				return FALSE;
+			}
+		}
+
+		return TRUE;
+	}
+
 	for (int nTestY = 0; nTestY < nItemHeight; ++nTestY)
 	{
 		for (int nTestX = 0; nTestX < nItemWidth; ++nTestX)
@@ -790,12 +902,16 @@ BOOL __fastcall INVENTORY_FindFreePositionBottomRightToTopLeftWithWeight(D2Inven
 		return FALSE;
 	}
 
+	// D2Moo only: the free positions of each row are computed at once
+	uint32_t aFreeMasks[UINT8_MAX + 1];
+	const BOOL bUseMasks = INVENTORY_GetFreePositionMasks(pInventoryGrid, nItemWidth, nItemHeight, aFreeMasks);
+
 	uint8_t nMax = 0;
 	for (int nX = pInventoryGrid->nGridWidth - 1; nX >= 0; --nX)
 	{
 		for (int nY = pInventoryGrid->nGridHeight - 1; nY >= 0; --nY)
 		{
-			if (INVENTORY_CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
+			if (bUseMasks ? (aFreeMasks[nY] >> nX) & 1 : INVENTORY_CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
 			{
 				const uint8_t nWeight = INVENTORY_GetPlacementWeight(pInventoryGrid, nX, nY, nItemWidth, nItemHeight);
 				if (nWeight > nMax)
@@ -822,6 +938,33 @@ uint8_t __fastcall INVENTORY_GetPlacementWeight(D2InventoryGridStrc* pInventoryG
 {
 	uint8_t nResult = 0;
 
+	// D2Moo only: count the occupied neighbours of each side with the row masks
+	if (pInventoryGrid->pRowMasks && nXPos >= 0 && nYPos >= 0 && nXPos + nItemWidth <= pInventoryGrid->nGridWidth && nYPos + nItemHeight <= pInventoryGrid->nGridHeight)
+	{
+		const uint32_t* pRowMasks = pInventoryGrid->pRowMasks;
+		const uint32_t nItemMask = INVENTORY_GetColumnsMask(nXPos, nItemWidth);
+		const bool bRightInGrid = nXPos + nItemWidth < pInventoryGrid->nGridWidth;
+		const uint32_t nLeftMask = nXPos > 0 ? 1u << (nXPos - 1) : 0;
+		const uint32_t nRightMask = bRightInGrid ? 1u << (nXPos + nItemWidth) : 0;
+
+		nResult = (nXPos > 0 ? 0 : nItemHeight) + (bRightInGrid ? 0 : nItemHeight);
+		for (int nY = nYPos; nY < nYPos + nItemHeight; ++nY)
+		{
+			nResult += (pRowMasks[nY] & nLeftMask) != 0;
+			nResult += (pRowMasks[nY] & nRightMask) != 0;
+		}
+
+		nResult += nYPos > 0 ? INVENTORY_CountBits(pRowMasks[nYPos - 1] & nItemMask) : nItemWidth;
+		nResult += nYPos + nItemHeight < pInventoryGrid->nGridHeight ? INVENTORY_CountBits(pRowMasks[nYPos + nItemHeight] & nItemMask) : nItemWidth;
+
+		if (nResult >= 2 * (nItemHeight + nItemWidth))
+		{
+			nResult = 255;
+		}
+
+		return nResult;
+	}
+
 	if (nXPos > 0)
 	{
 		for (int i = 0; i < nItemHeight; ++i)
@@ -898,12 +1041,16 @@ BOOL __fastcall INVENTORY_FindFreePositionTopLeftToBottomRightWithWeight(D2Inven
 		return FALSE;
 	}
 
+	// D2Moo only: the free positions of each row are computed at once
+	uint32_t aFreeMasks[UINT8_MAX + 1];
+	const BOOL bUseMasks = INVENTORY_GetFreePositionMasks(pInventoryGrid, nItemWidth, nItemHeight, aFreeMasks);
+
 	uint8_t nMax = 0;
 	for (int nY = 0; nY < pInventoryGrid->nGridHeight; ++nY)
 	{
 		for (int nX = 0; nX < pInventoryGrid->nGridWidth; ++nX)
 		{
-			if (INVENTORY_CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
+			if (bUseMasks ? (aFreeMasks[nY] >> nX) & 1 : INVENTORY_CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
 			{
 				const uint8_t nWeight = INVENTORY_GetPlacementWeight(pInventoryGrid, nX, nY, nItemWidth, nItemHeight);
 				if (nWeight > nMax)
@@ -928,11 +1075,15 @@ BOOL __fastcall INVENTORY_FindFreePositionTopLeftToBottomRightWithWeight(D2Inven
 //D2Common.0x6FD8F0E0
 BOOL __fastcall INVENTORY_FindFreePositionTopLeftToBottomRight(D2InventoryGridStrc* pInventoryGrid, int* pFreeX, int* pFreeY, uint8_t nItemWidth, uint8_t nItemHeight)
 {
+	// D2Moo only: the free positions of each row are computed at once
+	uint32_t aFreeMasks[UINT8_MAX + 1];
+	const BOOL bUseMasks = INVENTORY_GetFreePositionMasks(pInventoryGrid, nItemWidth, nItemHeight, aFreeMasks);
+
 	for (int nX = 0; nX < pInventoryGrid->nGridWidth; ++nX)
 	{
 		for (int nY = 0; nY < pInventoryGrid->nGridHeight; ++nY)
 		{
-			if (INVENTORY_CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
+			if (bUseMasks ? (aFreeMasks[nY] >> nX) & 1 : INVENTORY_CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
 			{
 				*pFreeX = nX;
 				*pFreeY = nY;
@@ -1062,13 +1213,7 @@ BOOL __fastcall INVENTORY_PlaceItemInGrid(D2InventoryStrc* pInventory, D2UnitStr
 	pItemExtraData->unk0x10 = pInventoryGrid->pLastItem;
 	pInventoryGrid->pLastItem = pItem;
 
-	for (int y = 0; y < nHeight; ++y)
-	{
-		for (int x = 0; x < nWidth; ++x)
-		{
-			pInventoryGrid->ppItems[nXPos + x + (nYPos + y) * pInventoryGrid->nGridWidth] = pItem;
-		}
-	}
+	INVENTORY_SetGridCells(pInventoryGrid, nXPos, nYPos, nWidth, nHeight, pItem);
 
 	pItemExtraData->nNodePos = nInventoryGrid + 1;
 	++pInventory->dwItemCount;
@@ -2760,88 +2905,94 @@ void __stdcall INVENTORY_GetItemSaveGfxInfo(D2UnitStrc* pPlayer, uint8_t* a2, ui
 	}
 }
 
-//D2Common.0x6FD915C0
-void __fastcall INVENTORY_InitializeComponentArray()
+// Helper function: Body of INVENTORY_InitializeComponentArray
+static BOOL INVENTORY_FillComponentArray()
 {
-	if (!gbComponentArrayInitialized)
-	{
-		gbComponentArrayInitialized = TRUE;
+	memset(gTxtComponentItemTypeMap, 0x00, sizeof(gTxtComponentItemTypeMap));
 
-		memset(gTxtComponentItemTypeMap, 0x00, sizeof(gTxtComponentItemTypeMap));
+	gTxtComponentItemTypeMap[1].dwCode = ' til';
+	gTxtComponentItemTypeMap[1].nItemType = ITEMTYPE_ARMOR;
+	gTxtComponentItemTypeMap[2].dwCode = ' dem';
+	gTxtComponentItemTypeMap[2].nItemType = ITEMTYPE_ARMOR;
+	gTxtComponentItemTypeMap[3].dwCode = ' yvh';
+	gTxtComponentItemTypeMap[3].nItemType = ITEMTYPE_ARMOR;
 
-		gTxtComponentItemTypeMap[1].dwCode = ' til';
-		gTxtComponentItemTypeMap[1].nItemType = ITEMTYPE_ARMOR;
-		gTxtComponentItemTypeMap[2].dwCode = ' dem';
-		gTxtComponentItemTypeMap[2].nItemType = ITEMTYPE_ARMOR;
-		gTxtComponentItemTypeMap[3].dwCode = ' yvh';
-		gTxtComponentItemTypeMap[3].nItemType = ITEMTYPE_ARMOR;
+	D2ItemDataTbl* pItemDataTbl = DATATBLS_GetItemDataTables();
 
-		D2ItemDataTbl* pItemDataTbl = DATATBLS_GetItemDataTables();
+	int nCurrentTableEntries = 4;
 
-		int nCurrentTableEntries = 4;
+	for (int i = 0; i < pItemDataTbl->nItemsTxtRecordCount; ++i)
+	{
+		D2ItemsTxt* pItemsTxtRecord = &pItemDataTbl->pItemsTxt[i];
 
-		for (int i = 0; i < pItemDataTbl->nItemsTxtRecordCount; ++i)
+		int dwCode = 0;
+		if (pItemsTxtRecord->dwAlternateGfx)
 		{
-			D2ItemsTxt* pItemsTxtRecord = &pItemDataTbl->pItemsTxt[i];
+			dwCode = pItemsTxtRecord->dwAlternateGfx;
+		}
+		else
+		{
+			dwCode = pItemsTxtRecord->dwCode;
+		}
 
-			int dwCode = 0;
-			if (pItemsTxtRecord->dwAlternateGfx)
-			{
-				dwCode = pItemsTxtRecord->dwAlternateGfx;
-			}
-			else
-			{
-				dwCode = pItemsTxtRecord->dwCode;
-			}
+		BOOL bNeedsToBeAdded = FALSE;
+		if (ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_WEAPON)
+			|| ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_ARMOR)
+			|| ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_ANY_SHIELD)
+			|| ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_HELM) && !ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_CIRCLET))
+		{
+			bNeedsToBeAdded = TRUE;
+		}
 
-			BOOL bNeedsToBeAdded = FALSE;
-			if (ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_WEAPON)
-				|| ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_ARMOR)
-				|| ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_ANY_SHIELD)
-				|| ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_HELM) && !ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_CIRCLET))
+		int nCounter = 0;
+		while (nCounter < nCurrentTableEntries)
+		{
+			if (gTxtComponentItemTypeMap[nCounter].dwCode == dwCode)
 			{
-				bNeedsToBeAdded = TRUE;
+				break;
 			}
 
-			int nCounter = 0;
-			while (nCounter < nCurrentTableEntries)
-			{
-				if (gTxtComponentItemTypeMap[nCounter].dwCode == dwCode)
-				{
-					break;
-				}
+			++nCounter;
+		}
 
-				++nCounter;
-			}
+		if (nCounter >= nCurrentTableEntries && bNeedsToBeAdded == 1)
+		{
+			int nIndex = nCurrentTableEntries;
 
-			if (nCounter >= nCurrentTableEntries && bNeedsToBeAdded == 1)
+			while (ITEMS_CheckType(gComponentItemTypeMap[nIndex].nItemType, ITEMTYPE_WEAPON) && ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_WEAPON)
+				   || ITEMS_CheckType(gComponentItemTypeMap[nIndex].nItemType, ITEMTYPE_ANY_ARMOR) && ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_ANY_ARMOR)
+				   || gTxtComponentItemTypeMap[nIndex].dwCode)
 			{
-				int nIndex = nCurrentTableEntries;
-
-				while (ITEMS_CheckType(gComponentItemTypeMap[nIndex].nItemType, ITEMTYPE_WEAPON) && ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_WEAPON)
-					   || ITEMS_CheckType(gComponentItemTypeMap[nIndex].nItemType, ITEMTYPE_ANY_ARMOR) && ITEMS_CheckType(pItemsTxtRecord->wType[0], ITEMTYPE_ANY_ARMOR)
-					   || gTxtComponentItemTypeMap[nIndex].dwCode)
-				{
-					++nIndex;
-				}
+				++nIndex;
+			}
 
-				if (nIndex >= ARRAY_SIZE(gTxtComponentItemTypeMap))
-				{
-					nIndex = nCurrentTableEntries;
-				}
+			if (nIndex >= ARRAY_SIZE(gTxtComponentItemTypeMap))
+			{
+				nIndex = nCurrentTableEntries;
+			}
 
-				gTxtComponentItemTypeMap[nIndex].dwCode = dwCode;
-				gTxtComponentItemTypeMap[nIndex].nItemType = pItemsTxtRecord->wType[0];
+			gTxtComponentItemTypeMap[nIndex].dwCode = dwCode;
+			gTxtComponentItemTypeMap[nIndex].nItemType = pItemsTxtRecord->wType[0];
 
-				if (nCurrentTableEntries == nIndex)
-				{
-					++nCurrentTableEntries;
-				}
+			if (nCurrentTableEntries == nIndex)
+			{
+				++nCurrentTableEntries;
 			}
 		}
-
-		gnComponentArrayRecordCount = ARRAY_SIZE(gTxtComponentItemTypeMap);
 	}
+
+	gnComponentArrayRecordCount = ARRAY_SIZE(gTxtComponentItemTypeMap);
+	gbComponentArrayInitialized = TRUE;
+	return TRUE;
+}
+
+//D2Common.0x6FD915C0
+void __fastcall INVENTORY_InitializeComponentArray()
+{
+	// D2Moo: the flag was set before filling the table, another thread could read it partially filled.
+	// A local static is initialized by the first caller while the others wait for it.
+	static const BOOL bComponentArrayFilled = INVENTORY_FillComponentArray();
+	D2_ASSERT(bComponentArrayFilled);
 }
 
 //D2Common.0x6FD917B0
@@ -3331,7 +3482,7 @@ BOOL __fastcall INVENTORY_CopyUnitItemsToTradeInventory(D2InventoryStrc* pTradeI
 				&& pUnitInventoryGrid->nGridWidth == pTradeInventoryGrid->nGridWidth && pUnitInventoryGrid->nGridHeight == pTradeInventoryGrid->nGridHeight
 				&& pUnitInventoryGrid->ppItems && pTradeInventoryGrid->ppItems)
 			{
-				memcpy(pTradeInventoryGrid->ppItems, pUnitInventoryGrid->ppItems, sizeof(D2UnitStrc*) * pUnitInventoryGrid->nGridWidth * pUnitInventoryGrid->nGridHeight);
+				INVENTORY_CopyGridCells(pTradeInventoryGrid, pUnitInventoryGrid);
 
 				return TRUE;
 			}
@@ -3363,13 +3514,8 @@ BOOL __fastcall INVENTORY_CanItemBePlacedInInventory(D2UnitStrc* pPlayer, D2Unit
 
 			if (nWidth && nHeight && nX >= 0 && nX + nWidth <= pInventoryGrid->nGridWidth && nY >= 0 && nY + nHeight <= pInventoryGrid->nGridHeight)
 			{
-				for (int y = nY; y < nY + nHeight; ++y)
-				{
-					for (int x = nX; x < nX + nWidth; ++x)
-					{
-						pInventoryGrid->ppItems[x + y * pInventoryGrid->nGridWidth] = (D2UnitStrc*)0xFFFFFFFF;
-					}
-				}
+				// Reserves the cells, through INVENTORY_SetGridCells so that the free position searches see them too
+				INVENTORY_SetGridCells(pInventoryGrid, nX, nY, nWidth, nHeight, (D2UnitStrc*)0xFFFFFFFF);
 
 				return TRUE;
 			}
@@ -485,7 +485,7 @@ int __stdcall SKILLS_EvaluateSkillFormula(D2UnitStrc* pUnit, unsigned int nCalc,
 		pSkillCalc.nSkillId = nSkillId;
 		pSkillCalc.nSkillLevel = nSkillLevel;
 
-		return DATATBLS_CalcEvaluateExpression(&sgptDataTables->pSkillsCode[nCalc], sgptDataTables->nSkillsCodeSize - nCalc, sub_6FDAF6A0, off_6FDE5804, dword_6FDE583C, &pSkillCalc);
+		return DATATBLS_EvaluateCalcProgram(&sgptDataTables->pSkillsCodePrograms, sgptDataTables->pSkillsCode, sgptDataTables->nSkillsCodeSize, nCalc, sub_6FDAF6A0, off_6FDE5804, dword_6FDE583C, &pSkillCalc);
 	}
 
 	return 0;
@@ -502,7 +502,7 @@ int __stdcall SKILLS_EvaluateSkillDescFormula(D2UnitStrc* pUnit, unsigned int nC
 		pSkillCalc.nSkillId = nSkillId;
 		pSkillCalc.nSkillLevel = nSkillLevel;
 
-		return DATATBLS_CalcEvaluateExpression(&sgptDataTables->pSkillDescCode[nCalc], sgptDataTables->nSkillDescCodeSize - nCalc, sub_6FDAF6A0, off_6FDE5804, dword_6FDE583C, &pSkillCalc);
+		return DATATBLS_EvaluateCalcProgram(&sgptDataTables->pSkillDescCodePrograms, sgptDataTables->pSkillDescCode, sgptDataTables->nSkillDescCodeSize, nCalc, sub_6FDAF6A0, off_6FDE5804, dword_6FDE583C, &pSkillCalc);
 	}
 
 	return 0;
@@ -635,6 +635,12 @@ D2SkillStrc* __fastcall SKILLS_GetHighestLevelSkillFromSkillId(D2UnitStrc* pUnit
 
 	if (pUnit->pSkills)
 	{
+		// Native skills are unique and always preferred
+		if (D2SkillStrc* pNativeSkill = SKILLS_FindSkillInIndex(&pUnit->pSkills->tSkillIndex, nSkillId, D2UnitInvalidGUID))
+		{
+			return pNativeSkill;
+		}
+
 		for (D2SkillStrc* pSkill = pUnit->pSkills->pFirstSkill; pSkill; pSkill = pSkill->pNextSkill)
 		{
 			if (pSkill->pSkillsTxt->nSkillId == nSkillId && (!pHighestLevelSkill || pSkill->nOwnerGUID == D2UnitInvalidGUID || pHighestLevelSkill->nOwnerGUID != D2UnitInvalidGUID && pSkill->nSkillLevel > pHighestLevelSkill->nSkillLevel))
@@ -676,12 +682,206 @@ int __stdcall SKILLS_GetRange(D2SkillStrc* pSkill)
 	return 0;
 }
 
+// Helper function: Owners are mostly D2UnitInvalidGUID, Fibonacci hashing spreads the consecutive skill ids over the whole table
+static inline uint32_t SKILLS_GetSkillIndexHomeSlot(const D2SkillIndexStrc* pIndex, int nSkillId, D2UnitGUID nOwnerGUID)
+{
+	return (((uint32_t)nSkillId ^ ((uint32_t)nOwnerGUID * 0x85EBCA6Bu)) * 0x9E3779B1u) >> pIndex->nHashShift;
+}
+
+// Helper function
+static inline uint32_t SKILLS_GetSkillIndexProbeDistance(const D2SkillIndexStrc* pIndex, uint32_t nSlot)
+{
+	const D2SkillIndexSlotStrc* pSlot = &pIndex->pSlots[nSlot];
+	return (nSlot - SKILLS_GetSkillIndexHomeSlot(pIndex, pSlot->nSkillId, pSlot->nOwnerGUID)) & (pIndex->nCapacity - 1);
+}
+
+// Helper function
+static void SKILLS_InsertSkillIndexSlot(D2SkillIndexStrc* pIndex, D2SkillIndexSlotStrc tSlot)
+{
+	const uint32_t nMask = pIndex->nCapacity - 1;
+	uint32_t nSlot = SKILLS_GetSkillIndexHomeSlot(pIndex, tSlot.nSkillId, tSlot.nOwnerGUID);
+	uint32_t nDistance = 0;
+	while (pIndex->pSlots[nSlot].pSkill)
+	{
+		// Take the place of entries closer to their home slot, this keeps the probe sequences short
+		const uint32_t nExistingDistance = SKILLS_GetSkillIndexProbeDistance(pIndex, nSlot);
+		if (nExistingDistance < nDistance)
+		{
+			const D2SkillIndexSlotStrc tDisplaced = pIndex->pSlots[nSlot];
+			pIndex->pSlots[nSlot] = tSlot;
+			tSlot = tDisplaced;
+			nDistance = nExistingDistance;
+		}
+
+		nSlot = (nSlot + 1) & nMask;
+		++nDistance;
+	}
+
+	pIndex->pSlots[nSlot] = tSlot;
+}
+
+// Helper function: Returns the slot of the key, or -1
+static int SKILLS_FindSkillIndexSlot(const D2SkillIndexStrc* pIndex, int nSkillId, D2UnitGUID nOwnerGUID)
+{
+	if (!pIndex->nCount)
+	{
+		return -1;
+	}
+
+	const uint32_t nMask = pIndex->nCapacity - 1;
+	uint32_t nSlot = SKILLS_GetSkillIndexHomeSlot(pIndex, nSkillId, nOwnerGUID);
+	for (uint32_t nDistance = 0; pIndex->pSlots[nSlot].pSkill; ++nDistance)
+	{
+		if (pIndex->pSlots[nSlot].nSkillId == nSkillId && pIndex->pSlots[nSlot].nOwnerGUID == nOwnerGUID)
+		{
+			return nSlot;
+		}
+
+		// The key would have been stored before any entry closer to its home slot
+		if (SKILLS_GetSkillIndexProbeDistance(pIndex, nSlot) < nDistance)
+		{
+			return -1;
+		}
+
+		nSlot = (nSlot + 1) & nMask;
+	}
+
+	return -1;
+}
+
+// Helper function
+D2SkillStrc* __fastcall SKILLS_FindSkillInIndex(const D2SkillIndexStrc* pIndex, int nSkillId, D2UnitGUID nOwnerGUID)
+{
+	const int nSlot = SKILLS_FindSkillIndexSlot(pIndex, nSkillId, nOwnerGUID);
+	return nSlot >= 0 ? pIndex->pSlots[nSlot].pSkill : nullptr;
+}
+
+// Helper function
+D2SkillIndexSlotStrc* __fastcall SKILLS_ResizeSkillIndex(D2SkillIndexStrc* pIndex, D2SkillIndexSlotStrc* pSlots, uint32_t nCapacity)
+{
+	D2_ASSERT(nCapacity > pIndex->nCount && !(nCapacity & (nCapacity - 1)));
+
+	D2SkillIndexSlotStrc* pOldSlots = pIndex->pSlots;
+	const uint32_t nOldCapacity = pIndex->nCapacity;
+
+	uint32_t nHashShift = 32;
+	for (uint32_t nSize = nCapacity; nSize > 1; nSize >>= 1)
+	{
+		--nHashShift;
+	}
+
+	memset(pSlots, 0x00, sizeof(D2SkillIndexSlotStrc) * nCapacity);
+	pIndex->pSlots = pSlots;
+	pIndex->nCapacity = nCapacity;
+	pIndex->nHashShift = nHashShift;
+
+	for (uint32_t i = 0; i < nOldCapacity; ++i)
+	{
+		if (pOldSlots[i].pSkill)
+		{
+			SKILLS_InsertSkillIndexSlot(pIndex, pOldSlots[i]);
+		}
+	}
+
+	return pOldSlots;
+}
+
+// Helper function
+void __fastcall SKILLS_InsertSkillInIndex(D2SkillIndexStrc* pIndex, D2SkillStrc* pSkill)
+{
+	D2_ASSERT(pSkill && pIndex->nCount < pIndex->nCapacity);
+
+	// Lookups return the first skill of the list, skills are always appended
+	if (SKILLS_FindSkillIndexSlot(pIndex, pSkill->pSkillsTxt->nSkillId, pSkill->nOwnerGUID) >= 0)
+	{
+		return;
+	}
+
+	D2SkillIndexSlotStrc tSlot = {};
+	tSlot.pSkill = pSkill;
+	tSlot.nSkillId = pSkill->pSkillsTxt->nSkillId;
+	tSlot.nOwnerGUID = pSkill->nOwnerGUID;
+	SKILLS_InsertSkillIndexSlot(pIndex, tSlot);
+	++pIndex->nCount;
+}
+
+// Helper function
+void __fastcall SKILLS_RemoveSkillFromIndex(D2SkillIndexStrc* pIndex, D2SkillStrc* pFirstSkill, D2SkillStrc* pSkill)
+{
+	const int nSkillId = pSkill->pSkillsTxt->nSkillId;
+	const D2UnitGUID nOwnerGUID = pSkill->nOwnerGUID;
+	const int nFoundSlot = SKILLS_FindSkillIndexSlot(pIndex, nSkillId, nOwnerGUID);
+	if (nFoundSlot < 0 || pIndex->pSlots[nFoundSlot].pSkill != pSkill)
+	{
+		return;
+	}
+
+	// Duplicates are not created by the game, but keep the same result as the linear search if there are any
+	for (D2SkillStrc* pNextSkill = pFirstSkill; pNextSkill; pNextSkill = pNextSkill->pNextSkill)
+	{
+		if (pNextSkill->pSkillsTxt->nSkillId == nSkillId && pNextSkill->nOwnerGUID == nOwnerGUID)
+		{
+			pIndex->pSlots[nFoundSlot].pSkill = pNextSkill;
+			return;
+		}
+	}
+
+	// Shift the following entries back instead of leaving a tombstone
+	const uint32_t nMask = pIndex->nCapacity - 1;
+	uint32_t nSlot = nFoundSlot;
+	uint32_t nNextSlot = (nSlot + 1) & nMask;
+	while (pIndex->pSlots[nNextSlot].pSkill && SKILLS_GetSkillIndexProbeDistance(pIndex, nNextSlot) > 0)
+	{
+		pIndex->pSlots[nSlot] = pIndex->pSlots[nNextSlot];
+		nSlot = nNextSlot;
+		nNextSlot = (nNextSlot + 1) & nMask;
+	}
+
+	pIndex->pSlots[nSlot] = {};
+	--pIndex->nCount;
+}
+
+// Helper function: Indexes a skill appended to the list
+static void SKILLS_AddSkillToIndex(D2SkillListStrc* pSkillList, D2SkillStrc* pSkill)
+{
+	D2SkillIndexStrc* pIndex = &pSkillList->tSkillIndex;
+
+	// Keep the load factor under 3/4
+	if ((pIndex->nCount + 1) * 4 > pIndex->nCapacity * 3)
+	{
+		const uint32_t nCapacity = pIndex->nCapacity ? 2 * pIndex->nCapacity : SKILLINDEX_MIN_CAPACITY;
+		D2SkillIndexSlotStrc* pOldSlots = SKILLS_ResizeSkillIndex(pIndex, (D2SkillIndexSlotStrc*)D2_ALLOC_POOL(pSkillList->pMemPool, sizeof(D2SkillIndexSlotStrc) * nCapacity), nCapacity);
+		if (pOldSlots)
+		{
+			D2_FREE_POOL(pSkillList->pMemPool, pOldSlots);
+		}
+	}
+
+	SKILLS_InsertSkillInIndex(pIndex, pSkill);
+}
+
+volatile LONG gnBonusLevelsStamp;
+
+// Helper function: Stamps are unique across units, so that a skill read with another unit than its owner is not mistaken for cached
+static uint32_t SKILLS_GetNewBonusLevelsStamp()
+{
+	uint32_t dwStamp = 0;
+	do
+	{
+		dwStamp = (uint32_t)InterlockedIncrement(&gnBonusLevelsStamp);
+	}
+	while (!dwStamp);
+
+	return dwStamp;
+}
+
 //D2Common.0x6FDAFCD0 (#10945)
 D2SkillListStrc* __stdcall SKILLS_AllocSkillList(void* pMemPool)
 {
 	D2SkillListStrc* pSkillList = D2_CALLOC_STRC_POOL(pMemPool, D2SkillListStrc);
 
 	pSkillList->pMemPool = pMemPool;
+	pSkillList->dwBonusLevelsStamp = SKILLS_GetNewBonusLevelsStamp();
 
 	return pSkillList;
 }
@@ -878,6 +1078,7 @@ void __fastcall D2COMMON_SKILLS_RemoveSkill_6FDAFFF0(D2UnitStrc* pUnit, int nSki
 				pUnit->pSkills->pFirstSkill = pSkill->pNextSkill;
 			}
 
+			SKILLS_RemoveSkillFromIndex(&pUnit->pSkills->tSkillIndex, pUnit->pSkills->pFirstSkill, pSkill);
 			D2_FREE_POOL(pUnit->pMemoryPool, pSkill);
 		}
 	}
@@ -930,6 +1131,11 @@ void __stdcall SKILLS_FreeSkillList(D2UnitStrc* pUnit)
 				pSkill = pNextSkill;
 			}
 
+			if (pSkillList->tSkillIndex.pSlots)
+			{
+				D2_FREE_POOL(pSkillList->pMemPool, pSkillList->tSkillIndex.pSlots);
+			}
+
 			D2_FREE_POOL(pUnit->pMemoryPool, pSkillList);
 			pUnit->pSkills = NULL;
 		}
@@ -957,15 +1163,7 @@ D2SkillStrc* __stdcall SKILLS_AddSkill(D2UnitStrc* pUnit, int nSkillId)
 			pSkill = UNITS_GetStartSkill(pUnit);
 			if (pSkill)
 			{
-				while (pSkill->pSkillsTxt != pSkillsTxtRecord || pSkill->nOwnerGUID != D2UnitInvalidGUID)
-				{
-					pSkill = pSkill->pNextSkill;
-					if (!pSkill)
-					{
-						break;
-					}
-				}
-
+				pSkill = SKILLS_FindSkillInIndex(&pUnit->pSkills->tSkillIndex, pSkillsTxtRecord->nSkillId, D2UnitInvalidGUID);
 				if (pSkill)
 				{
 					nMaxSkillLevel = pSkillsTxtRecord->wMaxLvl;
@@ -1023,6 +1221,7 @@ D2SkillStrc* __stdcall SKILLS_AddSkill(D2UnitStrc* pUnit, int nSkillId)
 					pUnit->pSkills->pFirstSkill = pSkill;
 				}
 
+				SKILLS_AddSkillToIndex(pUnit->pSkills, pSkill);
 				SKILLS_RefreshSkill(pUnit, nSkillId);
 
 				return pSkill;
@@ -1137,6 +1336,7 @@ void __stdcall D2Common_10954(D2UnitStrc* pUnit, D2UnitGUID nOwnerGUID, int nSki
 							pSkillList->pFirstSkill = pSkill->pNextSkill;
 						}
 
+						SKILLS_RemoveSkillFromIndex(&pSkillList->tSkillIndex, pSkillList->pFirstSkill, pSkill);
 						D2_FREE_POOL(pUnit->pMemoryPool, pSkill);
 					}
 				}
@@ -1191,6 +1391,8 @@ void __stdcall D2Common_10954(D2UnitStrc* pUnit, D2UnitGUID nOwnerGUID, int nSki
 						{
 							pSkillList->pFirstSkill = pSkill;
 						}
+
+						SKILLS_AddSkillToIndex(pSkillList, pSkill);
 					}
 				}
 			}
@@ -1905,13 +2107,46 @@ int __stdcall SKILLS_GetShrineSkillLevelBonus(D2UnitStrc* pUnit)
 	return 0;
 }
 
-//D2Common.0x6FDB1580
-int __fastcall SKILLS_GetBonusSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill)
+// Helper function: Reads the skill levels given by the stats of the unit, STAT_ITEM_NONCLASSSKILL is returned separately since it is capped depending on the skill level
+static int SKILLS_ReadStatBonusSkillLevels(D2UnitStrc* pUnit, D2SkillStrc* pSkill, int* pNonClassBonus)
 {
 	D2SkillDescTxt* pSkillDescTxtRecord = NULL;
 	D2SkillsTxt* pSkillsTxtRecord = NULL;
+	int nSkillLevel = STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ALLSKILLS, 0);
+
+	if (pUnit && pUnit->dwUnitType == UNIT_PLAYER && pSkill->pSkillsTxt->nCharClass == pUnit->dwClassId)
+	{
+		nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ADDCLASSSKILLS, pUnit->dwClassId);
+
+		pSkillsTxtRecord = &sgptDataTables->pSkillsTxt[pSkill->pSkillsTxt->nSkillId];
+		if (pSkillsTxtRecord)
+		{
+			pSkillDescTxtRecord = DATATBLS_GetSkillDescTxtRecord(pSkillsTxtRecord->wSkillDesc);
+
+			if (pSkillDescTxtRecord->nSkillPage)
+			{
+				nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ADDSKILL_TAB, (char)pSkillDescTxtRecord->nSkillPage + 8 * pUnit->dwClassId - 1);
+			}
+		}
+	}
+
+	*pNonClassBonus = STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
+
+	if (pSkill->pSkillsTxt->nEType)
+	{
+		nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ELEMSKILL, pSkill->pSkillsTxt->nEType);
+	}
+
+	return nSkillLevel + STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_SINGLESKILL, pSkill->pSkillsTxt->nSkillId);
+}
+
+//D2Common.0x6FDB1580
+int __fastcall SKILLS_GetBonusSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill)
+{
 	int nSkillLevel = 0;
-	int nBonus = 0;
+	int nStatBonus = 0;
+	int nNonClassBonus = 0;
+	BOOL bCapNonClassBonus = FALSE;
 
 	if (!pSkill || !pSkill->pSkillsTxt || !DATATBLS_GetSkillsTxtRecord(pSkill->pSkillsTxt->nSkillId))
 	{
@@ -1920,68 +2155,70 @@ int __fastcall SKILLS_GetBonusSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill)
 
 	nSkillLevel = pSkill->nLevelBonus;
 
+	// The state is a single bit, and is cleared along with others in several places, so it is not cached
 	if (STATES_CheckState(pUnit, STATE_SHRINE_SKILL))
 	{
 		nSkillLevel += 2;
 	}
 
-	nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ALLSKILLS, 0);
-
-	if (pUnit && pUnit->dwUnitType == UNIT_PLAYER)
+	// D2Moo only: the stats are only read again after one of them changed, see SKILLS_InvalidateBonusSkillLevels
+	if (pUnit && pUnit->pSkills)
 	{
-		if (pSkill->pSkillsTxt->nCharClass == pUnit->dwClassId)
+		if (pSkill->dwBonusLevelsStamp != pUnit->pSkills->dwBonusLevelsStamp)
 		{
-			nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ADDCLASSSKILLS, pUnit->dwClassId);
-
-			pSkillsTxtRecord = &sgptDataTables->pSkillsTxt[pSkill->pSkillsTxt->nSkillId];
-			if (pSkillsTxtRecord)
-			{
-				pSkillDescTxtRecord = DATATBLS_GetSkillDescTxtRecord(pSkillsTxtRecord->wSkillDesc);
+			pSkill->nStatBonusLevels = SKILLS_ReadStatBonusSkillLevels(pUnit, pSkill, &pSkill->nNonClassBonusLevels);
+			pSkill->dwBonusLevelsStamp = pUnit->pSkills->dwBonusLevelsStamp;
+		}
 
-				if (pSkillDescTxtRecord->nSkillPage)
-				{
-					nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ADDSKILL_TAB, (char)pSkillDescTxtRecord->nSkillPage + 8 * pUnit->dwClassId - 1);
-				}
-			}
+		nStatBonus = pSkill->nStatBonusLevels;
+		nNonClassBonus = pSkill->nNonClassBonusLevels;
+	}
+	else
+	{
+		nStatBonus = SKILLS_ReadStatBonusSkillLevels(pUnit, pSkill, &nNonClassBonus);
+	}
 
-			nBonus = STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
-			if (nBonus > 3)
-			{
-				nBonus = 3;
-			}
-			nSkillLevel += nBonus;
-		}
-		else
-		{
-			nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
-		}
+	if (pUnit && pUnit->dwUnitType == UNIT_PLAYER)
+	{
+		bCapNonClassBonus = pSkill->pSkillsTxt->nCharClass == pUnit->dwClassId;
 	}
 	else
 	{
-		if (pSkill->nSkillLevel <= 0)
-		{
-			nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
-		}
-		else
-		{
-			nBonus = STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
-			if (nBonus)
-			{
-				if (nBonus > 3)
-				{
-					nBonus = 3;
-				}
-				nSkillLevel += nBonus;
-			}
-		}
+		bCapNonClassBonus = pSkill->nSkillLevel > 0;
 	}
 
-	if (pSkill->pSkillsTxt->nEType)
+	if (bCapNonClassBonus && nNonClassBonus > 3)
 	{
-		nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ELEMSKILL, pSkill->pSkillsTxt->nEType);
+		nNonClassBonus = 3;
 	}
 
-	return nSkillLevel + STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_SINGLESKILL, pSkill->pSkillsTxt->nSkillId);
+	return nSkillLevel + nStatBonus + nNonClassBonus;
+}
+
+// Helper function
+BOOL __fastcall SKILLS_IsBonusSkillLevelStat(int nStatId)
+{
+	switch (nStatId)
+	{
+	case STAT_ITEM_ALLSKILLS:
+	case STAT_ITEM_ADDCLASSSKILLS:
+	case STAT_ITEM_ADDSKILL_TAB:
+	case STAT_ITEM_NONCLASSSKILL:
+	case STAT_ITEM_ELEMSKILL:
+	case STAT_ITEM_SINGLESKILL:
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
+
+// Helper function
+void __fastcall SKILLS_InvalidateBonusSkillLevels(D2UnitStrc* pUnit)
+{
+	if (pUnit && pUnit->pSkills)
+	{
+		pUnit->pSkills->dwBonusLevelsStamp = SKILLS_GetNewBonusLevelsStamp();
+	}
 }
 
 //D2Common.0x6FDB1700 (#10968)
@@ -2023,12 +2260,7 @@ int __stdcall SKILLS_GetBonusSkillLevelFromSkillId(D2UnitStrc* pUnit, int nSkill
 	
 	if (pUnit && pUnit->pSkills)
 	{
-		pSkill = pUnit->pSkills->pFirstSkill;
-
-		while (pSkill && (pSkill->pSkillsTxt->nSkillId != nSkillId || pSkill->nOwnerGUID != D2UnitInvalidGUID))
-		{
-			pSkill = pSkill->pNextSkill;
-		}
+		pSkill = SKILLS_FindSkillInIndex(&pUnit->pSkills->tSkillIndex, nSkillId, D2UnitInvalidGUID);
 
 		if (pSkill && pSkill->nOwnerGUID == D2UnitInvalidGUID)
 		{
@@ -2274,11 +2506,7 @@ int __stdcall SKILLS_GetRequiredLevelBasedOnCurrent(D2UnitStrc* pUnit, int nSkil
 		nRequiredLevel = pSkillsTxtRecord->wReqLevel;
 		if (pUnit->pSkills)
 		{
-			pSkill = pUnit->pSkills->pFirstSkill;
-			while (pSkill && (pSkill->pSkillsTxt->nSkillId != nSkillId || pSkill->nOwnerGUID != D2UnitInvalidGUID))
-			{
-				pSkill = pSkill->pNextSkill;
-			}
+			pSkill = SKILLS_FindSkillInIndex(&pUnit->pSkills->tSkillIndex, nSkillId, D2UnitInvalidGUID);
 
 			if (pSkill)
 			{
@@ -2367,12 +2595,7 @@ D2SkillStrc* __fastcall SKILLS_GetSkill(D2UnitStrc* pUnit, int nSkillId, D2UnitG
 
 	if (pUnit->pSkills)
 	{
-		pSkill = pUnit->pSkills->pFirstSkill;
-
-		while (pSkill && (pSkill->pSkillsTxt->nSkillId != nSkillId || pSkill->nOwnerGUID != nOwnerGUID))
-		{
-			pSkill = pSkill->pNextSkill;
-		}
+		pSkill = SKILLS_FindSkillInIndex(&pUnit->pSkills->tSkillIndex, nSkillId, nOwnerGUID);
 
 		return pSkill;
 	}
@@ -5,6 +5,7 @@
 #include "D2Environment.h"
 #include "D2ItemMods.h"
 #include "D2Items.h"
+#include "D2Skills.h"
 #include "D2States.h"
 #include "Units/Units.h"
 //TODO: Find names
@@ -125,6 +126,13 @@ static D2StatStrc* __fastcall STATLIST_GetOrInsertStat(void* pMemPool, D2StatsAr
 // Helper function
 static void STATLIST_NotifyUnitOfStatValueChange(D2ItemStatCostTxt* pItemStatCostTxtRecord, D2StatListExStrc* pStatListEx, D2UnitStrc* pUnit, D2SLayerStatIdStrc::PackedType nLayer_StatId, int nPreviousValue, int nNewValue)
 {
+	// D2Moo only: not done through pfOnValueChanged, which is set by D2Game and only called for the stats with fCallback
+	D2UnitStrc* pOwner = pStatListEx->pOwner;
+	if (pOwner && pOwner->pStatListEx == pStatListEx && SKILLS_IsBonusSkillLevelStat(D2SLayerStatIdStrc::FromPackedType(nLayer_StatId).nStat))
+	{
+		SKILLS_InvalidateBonusSkillLevels(pOwner);
+	}
+
 	if (pStatListEx->pfOnValueChanged && (pItemStatCostTxtRecord->dwItemStatFlags & gdwBitMasks[ITEMSTATCOSTFLAGINDEX_FCALLBACK]))
 	{
 		pStatListEx->pfOnValueChanged(pStatListEx->pGame, pStatListEx->pOwner, pUnit, nLayer_StatId, nPreviousValue, nNewValue);
@@ -459,10 +467,108 @@ static int STATLIST_ApplyMinValue(int nValue, D2ItemStatCostTxt* pItemStatCostTx
 	return nValue;
 }
 
+// Helper function
+void __fastcall STATLIST_BuildStatsArrayIndex(const D2StatsArrayStrc* pStatArray, uint16_t* pFirstIndex, int32_t nStatIds)
+{
+	int32_t nIndex = 0;
+	for (int32_t nStatId = 0; nStatId <= nStatIds; ++nStatId)
+	{
+		while (nIndex < pStatArray->nStatCount && pStatArray->pStat[nIndex].nStat < nStatId)
+		{
+			++nIndex;
+		}
+		pFirstIndex[nStatId] = nIndex;
+	}
+}
+
+// Helper function
+D2StatStrc* __fastcall STATLIST_FindStatInIndexedArray(D2StatsArrayStrc* pStatArray, const uint16_t* pFirstIndex, int32_t nStatIds, D2SLayerStatIdStrc::PackedType nLayer_StatId, BOOL* pIndexValid)
+{
+	*pIndexValid = TRUE;
+
+	const uint16_t nStatId = D2SLayerStatIdStrc::FromPackedType(nLayer_StatId).nStat;
+	if (nStatId >= nStatIds)
+	{
+		return STATLIST_FindStat_6FDB6920(pStatArray, nLayer_StatId);
+	}
+
+	const int32_t nBegin = pFirstIndex[nStatId];
+	const int32_t nEnd = pFirstIndex[nStatId + 1];
+	const D2StatStrc* pStats = pStatArray->pStat;
+	if (nBegin > nEnd || nEnd > pStatArray->nStatCount
+		|| (nBegin > 0 && pStats[nBegin - 1].nStat >= nStatId)
+		|| (nEnd < pStatArray->nStatCount && pStats[nEnd].nStat <= nStatId)
+		|| (nBegin < nEnd && (pStats[nBegin].nStat != nStatId || pStats[nEnd - 1].nStat != nStatId)))
+	{
+		*pIndexValid = FALSE;
+		return nullptr;
+	}
+
+	// Usually one entry (layer 0), more for stats using layers such as item_singleskill
+	int32_t nMin = nBegin;
+	int32_t nMax = nEnd;
+	while (nMin < nMax)
+	{
+		const int32_t nMidPoint = nMin + (nMax - nMin) / 2;
+		if (nLayer_StatId < pStats[nMidPoint].nPackedValue)
+		{
+			nMax = nMidPoint;
+		}
+		else if (nLayer_StatId > pStats[nMidPoint].nPackedValue)
+		{
+			nMin = nMidPoint + 1;
+		}
+		else
+		{
+			return &pStatArray->pStat[nMidPoint];
+		}
+	}
+
+	return nullptr;
+}
+
+// Helper function: Same as STATLIST_FindStat_6FDB6920 for the FullStats or Stats arrays of pStatList, using the stat index of extended lists
+static D2StatStrc* STATLIST_FindStatIndexed(D2StatListStrc* pStatList, D2StatsArrayStrc* pStatArray, D2SLayerStatIdStrc::PackedType nLayer_StatId)
+{
+	D2StatListExStrc* pStatListEx = STATLIST_StatListExCast(pStatList);
+	if (!pStatListEx || pStatArray->nStatCount < STATLIST_INDEX_MIN_STATS)
+	{
+		return STATLIST_FindStat_6FDB6920(pStatArray, nLayer_StatId);
+	}
+
+	D2_ASSERT(pStatArray == &pStatListEx->FullStats || pStatArray == &pStatListEx->Stats);
+
+	D2StatListIndexStrc* pStatIndex = pStatListEx->pStatIndex;
+	if (!pStatIndex)
+	{
+		pStatIndex = D2_CALLOC_STRC_POOL(pStatListEx->pMemPool, D2StatListIndexStrc);
+		pStatIndex->nStatIds = sgptDataTables->nItemStatCostTxtRecordCount;
+		pStatListEx->pStatIndex = pStatIndex;
+	}
+
+	uint16_t** ppFirstIndex = (pStatArray == &pStatListEx->FullStats) ? &pStatIndex->pFullStatsFirstIndex : &pStatIndex->pStatsFirstIndex;
+	if (!*ppFirstIndex)
+	{
+		*ppFirstIndex = (uint16_t*)D2_ALLOC_POOL(pStatListEx->pMemPool, sizeof(uint16_t) * (pStatIndex->nStatIds + 1));
+		STATLIST_BuildStatsArrayIndex(pStatArray, *ppFirstIndex, pStatIndex->nStatIds);
+	}
+
+	BOOL bIndexValid = FALSE;
+	D2StatStrc* pStat = STATLIST_FindStatInIndexedArray(pStatArray, *ppFirstIndex, pStatIndex->nStatIds, nLayer_StatId, &bIndexValid);
+	if (!bIndexValid)
+	{
+		STATLIST_BuildStatsArrayIndex(pStatArray, *ppFirstIndex, pStatIndex->nStatIds);
+		pStat = STATLIST_FindStatInIndexedArray(pStatArray, *ppFirstIndex, pStatIndex->nStatIds, nLayer_StatId, &bIndexValid);
+		D2_ASSERT(bIndexValid);
+	}
+
+	return pStat;
+}
+
 //D2Common.0x6FDB6340
 int __fastcall STATLIST_GetBaseStat_6FDB6340(D2StatListStrc* pStatList, D2SLayerStatIdStrc::PackedType nLayer_StatId, D2ItemStatCostTxt* pItemStatCostTxtRecord)
 {
-	if (D2StatStrc* pStat = STATLIST_FindStat_6FDB6920(&pStatList->Stats, nLayer_StatId))
+	if (D2StatStrc* pStat = STATLIST_FindStatIndexed(pStatList, &pStatList->Stats, nLayer_StatId))
 	{
 		return STATLIST_ApplyMinValue(pStat->nValue, pItemStatCostTxtRecord, STATLIST_StatListExCast(pStatList));
 	}
@@ -476,7 +582,7 @@ int __fastcall STATLIST_GetTotalStat_6FDB63E0(D2StatListStrc* pStatList, D2SLaye
 	D2StatListExStrc* pStatListEx = STATLIST_StatListExCast(pStatList);
 	D2StatsArrayStrc* pStatArray = pStatListEx ? &pStatListEx->FullStats : &pStatList->Stats;
 
-	if (D2StatStrc* pStat = STATLIST_FindStat_6FDB6920(pStatArray, nLayer_StatId))
+	if (D2StatStrc* pStat = STATLIST_FindStatIndexed(pStatList, pStatArray, nLayer_StatId))
 	{
 		return STATLIST_ApplyMinValue(pStat->nValue, pItemStatCostTxtRecord, pStatListEx);
 	}
@@ -919,6 +1025,21 @@ void __fastcall D2Common_STATLIST_FreeStatListImpl_6FDB7050(D2StatListStrc* pSta
 			D2_FREE_POOL(pStatListEx->pMemPool, pStatListEx->ModStats.pStat);
 		}
 
+		if (D2StatListIndexStrc* pStatIndex = pStatListEx->pStatIndex)
+		{
+			if (pStatIndex->pFullStatsFirstIndex)
+			{
+				D2_FREE_POOL(pStatListEx->pMemPool, pStatIndex->pFullStatsFirstIndex);
+			}
+
+			if (pStatIndex->pStatsFirstIndex)
+			{
+				D2_FREE_POOL(pStatListEx->pMemPool, pStatIndex->pStatsFirstIndex);
+			}
+
+			D2_FREE_POOL(pStatListEx->pMemPool, pStatIndex);
+		}
+
 		D2_FREE_POOL(pStatListEx->pMemPool, pStatListEx->StatFlags);
 	}
 
@@ -936,6 +1057,7 @@ void __stdcall STATLIST_FreeStatListEx(D2UnitStrc* pUnit)
 		}
 
 		pUnit->pStatListEx = NULL;
+		SKILLS_InvalidateBonusSkillLevels(pUnit);
 	}
 }
 
@@ -970,6 +1092,7 @@ void __stdcall STATLIST_AllocStatListEx(D2UnitStrc* pUnit, char nFlags, StatList
 	pStatListEx->StatFlags = (uint32_t*)D2_CALLOC_POOL(pUnit->pMemoryPool, 2 * sizeof(uint32_t) * (sgptDataTables->nStatesTxtRecordCount + 31) / 32);
 
 	pUnit->pStatListEx = pStatListEx;
+	SKILLS_InvalidateBonusSkillLevels(pUnit);
 }
 
 //D2Common.0x6FDB7260 (#10471)
@@ -1397,7 +1520,7 @@ int __stdcall STATLIST_GetStatValue(D2StatListStrc* pStatList, int nStatId, uint
 		return 0;
 	}
 
-	if (D2StatStrc* pStat = STATLIST_FindStat_6FDB6920(&pStatList->Stats, D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue))
+	if (D2StatStrc* pStat = STATLIST_FindStatIndexed(pStatList, &pStatList->Stats, D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue))
 	{
 		return STATLIST_ApplyMinValue(pStat->nValue, pItemStatCostTxtRecord, STATLIST_StatListExCast(pStatList));
 	}
@@ -1427,13 +1550,13 @@ int __stdcall STATLIST_GetUnitStatBonus(D2UnitStrc* pUnit, int nStatId, uint16_t
 
 	int nValue = 0;
 	D2StatsArrayStrc* pStatsArray = pStatListEx ? &pStatListEx->FullStats : &pStatList->Stats;
-	if (const D2StatStrc* pStat = STATLIST_FindStat_6FDB6920(pStatsArray, D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue))
+	if (const D2StatStrc* pStat = STATLIST_FindStatIndexed(pStatList, pStatsArray, D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue))
 	{
 		nValue = STATLIST_ApplyMinValue(pStat->nValue, pItemStatCostTxtRecord, pStatListEx);
 	}
 
 	D2StatsArrayStrc* pBaseStatsArray = &pStatList->Stats;
-	if (const D2StatStrc* pStat = STATLIST_FindStat_6FDB6920(pBaseStatsArray, D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue))
+	if (const D2StatStrc* pStat = STATLIST_FindStatIndexed(pStatList, pBaseStatsArray, D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue))
 	{
 		int nBaseValue = STATLIST_ApplyMinValue(pStat->nValue, pItemStatCostTxtRecord, pStatListEx);
 		return nValue - nBaseValue;
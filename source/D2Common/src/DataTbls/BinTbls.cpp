@@ -0,0 +1,486 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include <File.h>
+#include <Storm.h>
+
+#include "D2DataTbls.h"
+
+
+struct D2MappedBinStrc
+{
+	char szName[64];
+	const char* szError;				// Set when the file can not be used
+	BOOL bOutdated;						// Written by another version, rebuilt by DATATBLS_WriteMappedBin
+	void* pView;
+	BOOL bUsed;							// The records are used by a table, and unmapped by DATATBLS_UnloadBin
+};
+
+BOOL gbMappedBinsInitialized;
+BOOL gbMappedBinsEnabled;
+D2MappedBinStrc gaMappedBins[MAPPEDBIN_MAX_FILES];
+int gnMappedBins;
+volatile LONG gnNextMappedBinToPrefetch;
+
+
+// Helper function
+static BOOL DATATBLS_AreMappedBinsEnabled()
+{
+	if (!gbMappedBinsInitialized)
+	{
+		gbMappedBinsInitialized = TRUE;
+
+		char* szValue = nullptr;
+		size_t nBufferSize = 0;
+		if (0 == _dupenv_s(&szValue, &nBufferSize, "D2_MAPPED_BIN_TABLES") && szValue)
+		{
+			gbMappedBinsEnabled = atoi(szValue) != 0;
+			free(szValue);
+		}
+	}
+
+	return gbMappedBinsEnabled;
+}
+
+// Helper function
+uint32_t __fastcall DATATBLS_GetBinLayoutHash(D2BinFieldStrc* pTbl, size_t dwSize)
+{
+	// FNV-1a of the record size and of the name, type, length and offset of each field
+	uint32_t dwHash = 0x811C9DC5;
+	auto HashBytes = [&dwHash](const void* pData, size_t nSize)
+	{
+		for (size_t i = 0; i < nSize; ++i)
+		{
+			dwHash = (dwHash ^ ((const uint8_t*)pData)[i]) * 0x01000193;
+		}
+	};
+
+	const uint32_t nRecordSize = (uint32_t)dwSize;
+	HashBytes(&nRecordSize, sizeof(nRecordSize));
+	for (D2BinFieldStrc* pField = pTbl; pField->nFieldType != TXTFIELD_NONE; ++pField)
+	{
+		HashBytes(pField->szFieldName, strlen(pField->szFieldName) + 1);
+		HashBytes(&pField->nFieldType, sizeof(pField->nFieldType));
+		HashBytes(&pField->nFieldLength, sizeof(pField->nFieldLength));
+		HashBytes(&pField->nFieldOffset, sizeof(pField->nFieldOffset));
+	}
+
+	return dwHash;
+}
+
+// Helper function
+uint32_t __fastcall DATATBLS_GetMappedBinChecksum(const void* pRecords, size_t nSize)
+{
+	// FNV-1a on 32 bits words, the tables are too large for a byte per step
+	const uint8_t* pBytes = (const uint8_t*)pRecords;
+	uint32_t dwChecksum = 0x811C9DC5;
+	size_t i = 0;
+	for (; i + sizeof(uint32_t) <= nSize; i += sizeof(uint32_t))
+	{
+		uint32_t dwWord;
+		memcpy(&dwWord, &pBytes[i], sizeof(dwWord));
+		dwChecksum = (dwChecksum ^ dwWord) * 0x01000193;
+	}
+	for (; i < nSize; ++i)
+	{
+		dwChecksum = (dwChecksum ^ pBytes[i]) * 0x01000193;
+	}
+
+	return dwChecksum;
+}
+
+// Helper function
+static void DATATBLS_GetMappedBinPath(const char* szName, char* szFilePath, size_t nFilePathSize)
+{
+	sprintf_s(szFilePath, nFilePathSize, "%s\\%s%s", "DATA\\GLOBAL\\EXCEL", szName, ".mbin");
+}
+
+// Helper function: Maps the file and checks it against its own header, the table layout is checked by DATATBLS_GetMappedBin
+static void DATATBLS_MapBinFile(D2MappedBinStrc* pMappedBin)
+{
+	char szFilePath[MAX_PATH] = {};
+	DATATBLS_GetMappedBinPath(pMappedBin->szName, szFilePath, sizeof(szFilePath));
+
+	HANDLE hFile = CreateFileA(szFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		pMappedBin->szError = "unable to open the file";
+		return;
+	}
+
+	LARGE_INTEGER tFileSize = {};
+	if (!GetFileSizeEx(hFile, &tFileSize) || tFileSize.QuadPart < (LONGLONG)sizeof(D2MappedBinHeaderStrc) || tFileSize.QuadPart > INT32_MAX)
+	{
+		CloseHandle(hFile);
+		pMappedBin->szError = "truncated header";
+		return;
+	}
+
+	// Copy-on-write: the loaders may patch the records, the changes must not reach the file
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	void* pView = hMapping ? MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+	if (hMapping)
+	{
+		CloseHandle(hMapping);
+	}
+	CloseHandle(hFile);
+	if (!pView)
+	{
+		pMappedBin->szError = "unable to map the file";
+		return;
+	}
+
+	pMappedBin->pView = pView;
+
+	const D2MappedBinHeaderStrc* pHeader = (const D2MappedBinHeaderStrc*)pView;
+	if (pHeader->dwMagic == MAPPEDBIN_MAGIC && pHeader->nVersion != MAPPEDBIN_VERSION)
+	{
+		pMappedBin->bOutdated = TRUE;
+		return;
+	}
+
+	if (pHeader->dwMagic != MAPPEDBIN_MAGIC || pHeader->nHeaderSize != sizeof(D2MappedBinHeaderStrc) || pHeader->nRecordCount < 0)
+	{
+		pMappedBin->szError = "header mismatch";
+		return;
+	}
+
+	const uint64_t nRecordsSize = (uint64_t)pHeader->nRecordSize * (uint64_t)pHeader->nRecordCount;
+	if (sizeof(D2MappedBinHeaderStrc) + nRecordsSize != (uint64_t)tFileSize.QuadPart)
+	{
+		pMappedBin->szError = "size mismatch";
+		return;
+	}
+
+	// Also brings the whole file in memory, which is the point of doing it on the pool of threads
+	if (DATATBLS_GetMappedBinChecksum(pHeader + 1, (size_t)nRecordsSize) != pHeader->dwChecksum)
+	{
+		pMappedBin->szError = "checksum mismatch";
+		return;
+	}
+}
+
+static DWORD WINAPI DATATBLS_PrefetchMappedBinsThreadProc(LPVOID lpParameter)
+{
+	while (true)
+	{
+		const LONG nIndex = InterlockedIncrement(&gnNextMappedBinToPrefetch) - 1;
+		if (nIndex >= gnMappedBins)
+		{
+			return 0;
+		}
+
+		DATATBLS_MapBinFile(&gaMappedBins[nIndex]);
+	}
+}
+
+// Helper function
+static D2MappedBinStrc* DATATBLS_FindMappedBin(const char* szName)
+{
+	for (int i = 0; i < gnMappedBins; ++i)
+	{
+		if (!_stricmp(gaMappedBins[i].szName, szName))
+		{
+			return &gaMappedBins[i];
+		}
+	}
+
+	return nullptr;
+}
+
+// Helper function
+static D2MappedBinStrc* DATATBLS_AddMappedBin(const char* szName)
+{
+	if (gnMappedBins >= MAPPEDBIN_MAX_FILES || strlen(szName) >= sizeof(D2MappedBinStrc::szName))
+	{
+		return nullptr;
+	}
+
+	D2MappedBinStrc* pMappedBin = &gaMappedBins[gnMappedBins++];
+	memset(pMappedBin, 0x00, sizeof(D2MappedBinStrc));
+	strcpy_s(pMappedBin->szName, szName);
+	return pMappedBin;
+}
+
+// Helper function
+static void DATATBLS_RemoveMappedBin(D2MappedBinStrc* pMappedBin)
+{
+	if (pMappedBin->pView)
+	{
+		UnmapViewOfFile(pMappedBin->pView);
+	}
+
+	*pMappedBin = gaMappedBins[--gnMappedBins];
+}
+
+// Helper function
+void __fastcall DATATBLS_PrefetchMappedBins()
+{
+	if (!DATATBLS_AreMappedBinsEnabled() || sgptDataTables->bCompileTxt || !DATATBLS_LoadFromBin)
+	{
+		return;
+	}
+
+	LARGE_INTEGER tStartTime = {};
+	QueryPerformanceCounter(&tStartTime);
+
+	const int nFirstNewMappedBin = gnMappedBins;
+	WIN32_FIND_DATAA tFindData = {};
+	HANDLE hFind = FindFirstFileA("DATA\\GLOBAL\\EXCEL\\*.mbin", &tFindData);
+	if (hFind != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			char szName[MAX_PATH] = {};
+			strcpy_s(szName, tFindData.cFileName);
+			if (char* pExtension = strrchr(szName, '.'))
+			{
+				*pExtension = '\0';
+			}
+
+			if (!DATATBLS_FindMappedBin(szName))
+			{
+				DATATBLS_AddMappedBin(szName);
+			}
+		}
+		while (FindNextFileA(hFind, &tFindData));
+		FindClose(hFind);
+	}
+
+	// Only the files found above are processed by the threads, the ones of the previous loads are already mapped
+	gnNextMappedBinToPrefetch = nFirstNewMappedBin;
+	SYSTEM_INFO tSystemInfo = {};
+	GetSystemInfo(&tSystemInfo);
+	const int nThreads = std::min<int>({ MAPPEDBIN_MAX_THREADS, (int)tSystemInfo.dwNumberOfProcessors, gnMappedBins - nFirstNewMappedBin }) - 1;
+
+	HANDLE hThreads[MAPPEDBIN_MAX_THREADS] = {};
+	int nStartedThreads = 0;
+	for (int i = 0; i < nThreads; ++i)
+	{
+		hThreads[nStartedThreads] = CreateThread(nullptr, 0, DATATBLS_PrefetchMappedBinsThreadProc, nullptr, 0, nullptr);
+		if (hThreads[nStartedThreads])
+		{
+			SetThreadDescription(hThreads[nStartedThreads], L"D2CommonMappedBinThread");
+			++nStartedThreads;
+		}
+	}
+
+	// The loading thread works too
+	DATATBLS_PrefetchMappedBinsThreadProc(nullptr);
+
+	if (nStartedThreads)
+	{
+		WaitForMultipleObjects(nStartedThreads, hThreads, TRUE, INFINITE);
+		for (int i = 0; i < nStartedThreads; ++i)
+		{
+			CloseHandle(hThreads[i]);
+		}
+	}
+
+	LARGE_INTEGER tEndTime = {};
+	LARGE_INTEGER tFrequency = {};
+	QueryPerformanceCounter(&tEndTime);
+	QueryPerformanceFrequency(&tFrequency);
+	FOG_Trace("Mapped %d .mbin tables with %d threads in %u us", gnMappedBins - nFirstNewMappedBin, nStartedThreads + 1, (uint32_t)((tEndTime.QuadPart - tStartTime.QuadPart) * 1000000 / tFrequency.QuadPart));
+}
+
+// Helper function
+void __fastcall DATATBLS_ReleaseUnusedMappedBins()
+{
+	for (int i = gnMappedBins - 1; i >= 0; --i)
+	{
+		if (!gaMappedBins[i].bUsed)
+		{
+			DATATBLS_RemoveMappedBin(&gaMappedBins[i]);
+		}
+	}
+}
+
+// Helper function: Gets the size of the .bin file of a table and the last write time of the file holding it, without reading it.
+// The size comes from the block table of the archive, and a file of an archive is dated by the .mpq itself, a loose file by its own time.
+static BOOL DATATBLS_GetMappedBinSourceKey(HD2ARCHIVE hArchive, const char* szName, uint32_t* pSourceSize, uint32_t* pSourceWriteTime)
+{
+	char szFilePath[MAX_PATH] = {};
+	sprintf_s(szFilePath, "%s\\%s%s", "DATA\\GLOBAL\\EXCEL", szName, ".bin");
+
+	HSFILE hFile = nullptr;
+	if (!ARCHIVE_OpenFile(hArchive, szFilePath, &hFile, TRUE))
+	{
+		return FALSE;
+	}
+
+	size_t dwFileSizeHigh = 0;
+	*pSourceSize = (uint32_t)ARCHIVE_GetFileSize(hArchive, hFile, &dwFileSizeHigh);
+
+	char szSourcePath[MAX_PATH] = {};
+	HSARCHIVE hSourceArchive = nullptr;
+	if (!SFileGetFileArchive(hFile, &hSourceArchive) || !hSourceArchive || !SFileGetArchiveName(hSourceArchive, szSourcePath, sizeof(szSourcePath)))
+	{
+		strcpy_s(szSourcePath, szFilePath);
+	}
+	ARCHIVE_CloseFile(hArchive, hFile);
+
+	WIN32_FILE_ATTRIBUTE_DATA tAttributes = {};
+	if (!GetFileAttributesExA(szSourcePath, GetFileExInfoStandard, &tAttributes))
+	{
+		return FALSE;
+	}
+
+	// FILETIME counts 100ns intervals since 1601
+	ULARGE_INTEGER tWriteTime = {};
+	tWriteTime.LowPart = tAttributes.ftLastWriteTime.dwLowDateTime;
+	tWriteTime.HighPart = tAttributes.ftLastWriteTime.dwHighDateTime;
+	*pSourceWriteTime = (uint32_t)((tWriteTime.QuadPart - 116444736000000000ULL) / 10000000);
+	return TRUE;
+}
+
+// Helper function
+void* __fastcall DATATBLS_GetMappedBin(HD2ARCHIVE hArchive, const char* szName, D2BinFieldStrc* pTbl, size_t dwSize, int* pRecordCount)
+{
+	if (!DATATBLS_AreMappedBinsEnabled())
+	{
+		return nullptr;
+	}
+
+	D2MappedBinStrc* pMappedBin = DATATBLS_FindMappedBin(szName);
+	if (!pMappedBin)
+	{
+		// Not prefetched, only map it if it exists so that it gets written by DATATBLS_WriteMappedBin otherwise
+		char szFilePath[MAX_PATH] = {};
+		DATATBLS_GetMappedBinPath(szName, szFilePath, sizeof(szFilePath));
+		if (GetFileAttributesA(szFilePath) == INVALID_FILE_ATTRIBUTES)
+		{
+			return nullptr;
+		}
+
+		pMappedBin = DATATBLS_AddMappedBin(szName);
+		if (!pMappedBin)
+		{
+			return nullptr;
+		}
+		DATATBLS_MapBinFile(pMappedBin);
+	}
+
+	if (pMappedBin->bUsed)
+	{
+		// Loaded twice, the records of the first load are still in use
+		return nullptr;
+	}
+
+	if (pMappedBin->bOutdated)
+	{
+		// Unmapped so that DATATBLS_WriteMappedBin can replace the file
+		FOG_Trace("%s.mbin: written by another version, rebuilding it", szName);
+		DATATBLS_RemoveMappedBin(pMappedBin);
+		return nullptr;
+	}
+
+	char szMessage[256] = {};
+	if (pMappedBin->szError)
+	{
+		sprintf_s(szMessage, "%s.mbin: %s, delete the file to rebuild it", szName, pMappedBin->szError);
+		FOG_DisplayHalt(szMessage, __FILE__, __LINE__);
+		exit(-1);
+	}
+
+	const D2MappedBinHeaderStrc* pHeader = (const D2MappedBinHeaderStrc*)pMappedBin->pView;
+	if (pHeader->nRecordSize != dwSize || pHeader->dwLayoutHash != DATATBLS_GetBinLayoutHash(pTbl, dwSize))
+	{
+		sprintf_s(szMessage, "%s.mbin: layout mismatch with the table, delete the file to rebuild it", szName);
+		FOG_DisplayHalt(szMessage, __FILE__, __LINE__);
+		exit(-1);
+	}
+
+	uint32_t nSourceSize = 0;
+	uint32_t dwSourceWriteTime = 0;
+	if (!DATATBLS_GetMappedBinSourceKey(hArchive, szName, &nSourceSize, &dwSourceWriteTime) || nSourceSize != pHeader->nSourceSize || dwSourceWriteTime != pHeader->dwSourceWriteTime)
+	{
+		FOG_Trace("%s.mbin: %s.bin changed, rebuilding it", szName, szName);
+		DATATBLS_RemoveMappedBin(pMappedBin);
+		return nullptr;
+	}
+
+	pMappedBin->bUsed = TRUE;
+	if (pRecordCount)
+	{
+		*pRecordCount = pHeader->nRecordCount;
+	}
+
+	return (void*)(pHeader + 1);
+}
+
+// Helper function
+void __fastcall DATATBLS_WriteMappedBin(HD2ARCHIVE hArchive, const char* szName, D2BinFieldStrc* pTbl, const void* pRecords, int nRecordCount, size_t dwSize)
+{
+	if (!DATATBLS_AreMappedBinsEnabled())
+	{
+		return;
+	}
+
+	D2MappedBinHeaderStrc tHeader = {};
+	if (!DATATBLS_GetMappedBinSourceKey(hArchive, szName, &tHeader.nSourceSize, &tHeader.dwSourceWriteTime))
+	{
+		return;
+	}
+
+	tHeader.dwMagic = MAPPEDBIN_MAGIC;
+	tHeader.nVersion = MAPPEDBIN_VERSION;
+	tHeader.nHeaderSize = (uint16_t)sizeof(D2MappedBinHeaderStrc);
+	tHeader.nRecordSize = (uint32_t)dwSize;
+	tHeader.nRecordCount = nRecordCount;
+	tHeader.dwLayoutHash = DATATBLS_GetBinLayoutHash(pTbl, dwSize);
+	tHeader.dwChecksum = DATATBLS_GetMappedBinChecksum(pRecords, dwSize * nRecordCount);
+
+	char szFilePath[MAX_PATH] = {};
+	char szTempFilePath[MAX_PATH] = {};
+	DATATBLS_GetMappedBinPath(szName, szFilePath, sizeof(szFilePath));
+	sprintf_s(szTempFilePath, "%s.tmp", szFilePath);
+
+	// Written then renamed, so that a crash never leaves a partial file to be mapped
+	FILE* pFile = NULL;
+	fopen_s(&pFile, szTempFilePath, "wb");
+	if (!pFile)
+	{
+		return;
+	}
+
+	const BOOL bWritten = FileLockAndWrite(&tHeader, sizeof(tHeader), 1, pFile) == 1 && (nRecordCount == 0 || FileLockAndWrite((void*)pRecords, dwSize * nRecordCount, 1, pFile) == 1);
+	fclose(pFile);
+
+	if (!bWritten || !MoveFileExA(szTempFilePath, szFilePath, MOVEFILE_REPLACE_EXISTING))
+	{
+		FOG_Trace("Unable to write %s", szFilePath);
+		DeleteFileA(szTempFilePath);
+	}
+}
+
+// Helper function
+BOOL __fastcall DATATBLS_UnloadMappedBin(void* pRecords)
+{
+	for (int i = 0; i < gnMappedBins; ++i)
+	{
+		if (gaMappedBins[i].pView && (D2MappedBinHeaderStrc*)gaMappedBins[i].pView + 1 == pRecords)
+		{
+			DATATBLS_RemoveMappedBin(&gaMappedBins[i]);
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+// Helper function
+void __fastcall DATATBLS_TraceTableLoadTime(const char* szName, int nRecordCount, const LARGE_INTEGER* pStartTime, const char* szSource)
+{
+	if (!DATATBLS_AreMappedBinsEnabled())
+	{
+		return;
+	}
+
+	LARGE_INTEGER tEndTime = {};
+	LARGE_INTEGER tFrequency = {};
+	QueryPerformanceCounter(&tEndTime);
+	QueryPerformanceFrequency(&tFrequency);
+	FOG_Trace("Loaded %s (%s): %d records in %u us", szName, szSource, nRecordCount, (uint32_t)((tEndTime.QuadPart - pStartTime->QuadPart) * 1000000 / tFrequency.QuadPart));
+}
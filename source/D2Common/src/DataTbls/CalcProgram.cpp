@@ -0,0 +1,539 @@
+#include "D2DataTbls.h"
+
+#include <cstring>
+#include <limits>
+
+
+// Helper function: Same as the ReadFromBuffer of Fog's evaluator
+template<class T>
+static T DATATBLS_CalcReadFromBuffer(const FOGASTNodeStrc*& pBuffer)
+{
+	T val = *(T*)pBuffer;
+	pBuffer += sizeof(T);
+	return val;
+}
+
+struct D2CalcRunContextStrc
+{
+	int32_t nRegisters[CALC_REGISTERS_COUNT];
+	const D2CalcProgramStrc* pProgram;
+	void* pUserData;
+	int32_t nResult;
+};
+
+// Helper function: Same results as DATATBLS_EvaluateBinaryOperator, with the wrap around of the game made explicit
+static int32_t DATATBLS_CalcApplyBinaryOperator(FOGASTType nAST, int32_t nLeftHandSide, int32_t nRightHandSide)
+{
+	switch (nAST)
+	{
+	case AST_LessThan:
+		return nLeftHandSide < nRightHandSide;
+	case AST_GreaterThan:
+		return nLeftHandSide > nRightHandSide;
+	case AST_LessOrEqualThan:
+		return nLeftHandSide <= nRightHandSide;
+	case AST_GreaterOrEqualThan:
+		return nLeftHandSide >= nRightHandSide;
+	case AST_Equal:
+		return nLeftHandSide == nRightHandSide;
+	case AST_NotEqual:
+		return nLeftHandSide != nRightHandSide;
+	case AST_Addition:
+		return (int32_t)((uint32_t)nLeftHandSide + (uint32_t)nRightHandSide);
+	case AST_Substraction:
+		return (int32_t)((uint32_t)nLeftHandSide - (uint32_t)nRightHandSide);
+	case AST_Multipliction:
+		return (int32_t)((uint32_t)nLeftHandSide * (uint32_t)nRightHandSide);
+	case AST_Division:
+		return nRightHandSide == 0 ? 0 : nLeftHandSide / nRightHandSide;
+	case AST_Power:
+	{
+		if (nRightHandSide <= 0)
+		{
+			return 1;
+		}
+
+		// Squaring gives the same result modulo 2^32 as the repeated multiplications, without looping up to 2^31 times
+		uint32_t nPower = 1;
+		uint32_t nSquare = (uint32_t)nLeftHandSide;
+		for (uint32_t nExponent = (uint32_t)nRightHandSide; nExponent != 0; nExponent >>= 1)
+		{
+			if (nExponent & 1)
+			{
+				nPower *= nSquare;
+			}
+			nSquare *= nSquare;
+		}
+		return (int32_t)nPower;
+	}
+	default:
+		D2_UNREACHABLE;
+	}
+}
+
+// Helper function
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_LoadConstant(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	pContext->nRegisters[pInstruction->nDestination] = pInstruction->nValue;
+	return pInstruction + 1;
+}
+
+// Helper function
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_ParamCallBack(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	pContext->nRegisters[pInstruction->nDestination] = pContext->pProgram->fpParamCallBack(pInstruction->nValue, pContext->pUserData);
+	return pInstruction + 1;
+}
+
+// Helper function: Unused parameters are read from CALC_ZERO_REGISTER
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_TableCallBack(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	const int32_t* pRegisters = pContext->nRegisters;
+	pContext->nRegisters[pInstruction->nDestination] = pInstruction->fpCallBack(pRegisters[pInstruction->nOperands[0]], pRegisters[pInstruction->nOperands[1]], pRegisters[pInstruction->nOperands[2]], pContext->pUserData);
+	return pInstruction + 1;
+}
+
+// Helper function
+template<FOGASTType nAST>
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_BinaryOperator(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	int32_t* pRegisters = pContext->nRegisters;
+	pRegisters[pInstruction->nDestination] = DATATBLS_CalcApplyBinaryOperator(nAST, pRegisters[pInstruction->nOperands[0]], pRegisters[pInstruction->nOperands[1]]);
+	return pInstruction + 1;
+}
+
+// Helper function
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_Negate(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	pContext->nRegisters[pInstruction->nDestination] = (int32_t)(0u - (uint32_t)pContext->nRegisters[pInstruction->nOperands[0]]);
+	return pInstruction + 1;
+}
+
+// Helper function
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_ReturnConstant(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	pContext->nResult = pInstruction->nValue;
+	return nullptr;
+}
+
+// Helper function
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_ReturnRegister(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	pContext->nResult = pContext->nRegisters[pInstruction->nOperands[0]];
+	return nullptr;
+}
+
+// Helper function: AST_Ternary always ends the evaluation
+static const D2CalcInstructionStrc* __fastcall DATATBLS_CalcOp_ReturnTernary(const D2CalcInstructionStrc* pInstruction, D2CalcRunContextStrc* pContext)
+{
+	const int32_t* pRegisters = pContext->nRegisters;
+	pContext->nResult = pRegisters[pInstruction->nOperands[0]] ? pRegisters[pInstruction->nOperands[1]] : pRegisters[pInstruction->nOperands[2]];
+	return nullptr;
+}
+
+// Helper function
+static CalcInstructionHandler_t DATATBLS_CalcGetBinaryOperatorHandler(FOGASTType nAST)
+{
+	switch (nAST)
+	{
+	case AST_LessThan: return DATATBLS_CalcOp_BinaryOperator<AST_LessThan>;
+	case AST_GreaterThan: return DATATBLS_CalcOp_BinaryOperator<AST_GreaterThan>;
+	case AST_LessOrEqualThan: return DATATBLS_CalcOp_BinaryOperator<AST_LessOrEqualThan>;
+	case AST_GreaterOrEqualThan: return DATATBLS_CalcOp_BinaryOperator<AST_GreaterOrEqualThan>;
+	case AST_Equal: return DATATBLS_CalcOp_BinaryOperator<AST_Equal>;
+	case AST_NotEqual: return DATATBLS_CalcOp_BinaryOperator<AST_NotEqual>;
+	case AST_Addition: return DATATBLS_CalcOp_BinaryOperator<AST_Addition>;
+	case AST_Substraction: return DATATBLS_CalcOp_BinaryOperator<AST_Substraction>;
+	case AST_Multipliction: return DATATBLS_CalcOp_BinaryOperator<AST_Multipliction>;
+	case AST_Division: return DATATBLS_CalcOp_BinaryOperator<AST_Division>;
+	case AST_Power: return DATATBLS_CalcOp_BinaryOperator<AST_Power>;
+	default:
+		D2_UNREACHABLE;
+	}
+}
+
+// Stack slot as seen by the compiler: either a known constant, or the register of the slot holding a value computed at runtime
+struct D2CalcCompilerOperandStrc
+{
+	int32_t nValue;
+	int32_t nRegister;
+	BOOL bConstant;
+};
+
+struct D2CalcCompilerStrc
+{
+	D2CalcProgramStrc* pProgram;
+	D2CalcCompilerOperandStrc tStack[Fog64IntStack::nCapacity];
+	int32_t nStackSize;
+	BOOL bProgramFull;
+};
+
+// Helper function
+static void DATATBLS_CalcCompiler_Emit(D2CalcCompilerStrc* pCompiler, CalcInstructionHandler_t pfHandler, int32_t nDestination, int32_t nOperand0, int32_t nOperand1, int32_t nOperand2, int32_t nValue)
+{
+	D2CalcProgramStrc* pProgram = pCompiler->pProgram;
+	if (pProgram->nInstructions >= CALC_PROGRAM_MAX_INSTRUCTIONS)
+	{
+		pCompiler->bProgramFull = TRUE;
+		return;
+	}
+
+	D2CalcInstructionStrc* pInstruction = &pProgram->tInstructions[pProgram->nInstructions++];
+	pInstruction->pfHandler = pfHandler;
+	pInstruction->nDestination = (uint8_t)nDestination;
+	pInstruction->nOperands[0] = (uint8_t)nOperand0;
+	pInstruction->nOperands[1] = (uint8_t)nOperand1;
+	pInstruction->nOperands[2] = (uint8_t)nOperand2;
+	pInstruction->nValue = nValue;
+}
+
+// Helper function: Same as DATATBLS_IntStackPop
+static D2CalcCompilerOperandStrc DATATBLS_CalcCompiler_Pop(D2CalcCompilerStrc* pCompiler)
+{
+	if (pCompiler->nStackSize <= 0)
+	{
+		return { 0, CALC_ZERO_REGISTER, TRUE };
+	}
+
+	return pCompiler->tStack[--pCompiler->nStackSize];
+}
+
+// Helper function: Same as DATATBLS_IntStackPush
+static void DATATBLS_CalcCompiler_PushConstant(D2CalcCompilerStrc* pCompiler, int32_t nValue)
+{
+	if (pCompiler->nStackSize < Fog64IntStack::nCapacity)
+	{
+		pCompiler->tStack[pCompiler->nStackSize] = { nValue, pCompiler->nStackSize, TRUE };
+		++pCompiler->nStackSize;
+	}
+}
+
+// Helper function: Pushes a value computed at runtime, and returns the register where the instruction must write it
+static int32_t DATATBLS_CalcCompiler_PushRegister(D2CalcCompilerStrc* pCompiler)
+{
+	if (pCompiler->nStackSize >= Fog64IntStack::nCapacity)
+	{
+		return CALC_DISCARD_REGISTER;
+	}
+
+	pCompiler->tStack[pCompiler->nStackSize] = { 0, pCompiler->nStackSize, FALSE };
+	return pCompiler->nStackSize++;
+}
+
+// Helper function: Returns a register holding the value of the operand, loading the constants into the register of their (popped) slot
+static int32_t DATATBLS_CalcCompiler_GetRegister(D2CalcCompilerStrc* pCompiler, const D2CalcCompilerOperandStrc& tOperand)
+{
+	if (!tOperand.bConstant)
+	{
+		return tOperand.nRegister;
+	}
+
+	if (tOperand.nValue == 0)
+	{
+		return CALC_ZERO_REGISTER;
+	}
+
+	DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_LoadConstant, tOperand.nRegister, 0, 0, 0, tOperand.nValue);
+	return tOperand.nRegister;
+}
+
+// Helper function
+static void DATATBLS_CalcCompiler_EmitReturn(D2CalcCompilerStrc* pCompiler, const D2CalcCompilerOperandStrc& tOperand)
+{
+	if (tOperand.bConstant)
+	{
+		DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnConstant, 0, 0, 0, 0, tOperand.nValue);
+	}
+	else
+	{
+		DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnRegister, 0, tOperand.nRegister, 0, 0, 0);
+	}
+}
+
+// Helper function: Mirrors DATATBLS_CalcEvaluateExpression, every path returning from it emits a return instruction
+static void DATATBLS_CalcCompiler_CompileExpression(D2CalcCompilerStrc* pCompiler, const FOGASTNodeStrc* pExpressionBuffer, int32_t nExpressionBufferSize, CalcFogCallBack2_t fpParamCallBack, D2CalcCallbackInfoStrc* pTableData, int nTableSize)
+{
+	if (nExpressionBufferSize <= 0)
+	{
+		DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnConstant, 0, 0, 0, 0, 0);
+		return;
+	}
+
+	const FOGASTNodeStrc* pBufferCurrentPos = pExpressionBuffer;
+	auto ReachedEndOfBuffer = [&]()
+	{
+		return pBufferCurrentPos - pExpressionBuffer >= nExpressionBufferSize;
+	};
+
+	while (!ReachedEndOfBuffer())
+	{
+		const uint8_t nAST = DATATBLS_CalcReadFromBuffer<uint8_t>(pBufferCurrentPos);
+		switch (nAST)
+		{
+		case AST_CallbackTable:
+		{
+			const int nTableIndex = DATATBLS_CalcReadFromBuffer<uint8_t>(pBufferCurrentPos);
+			const int nParameters = nTableIndex < nTableSize ? pTableData[nTableIndex].nParameters : -1;
+			if (nParameters < 0 || nParameters > 3)
+			{
+				DATATBLS_CalcCompiler_PushConstant(pCompiler, 0);
+				break;
+			}
+
+			D2CalcCompilerOperandStrc tParameters[3] = { { 0, CALC_ZERO_REGISTER, TRUE }, { 0, CALC_ZERO_REGISTER, TRUE }, { 0, CALC_ZERO_REGISTER, TRUE } };
+			for (int i = nParameters - 1; i >= 0; --i)
+			{
+				tParameters[i] = DATATBLS_CalcCompiler_Pop(pCompiler);
+			}
+
+			int32_t nRegisters[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				nRegisters[i] = DATATBLS_CalcCompiler_GetRegister(pCompiler, tParameters[i]);
+			}
+
+			const int32_t nDestination = DATATBLS_CalcCompiler_PushRegister(pCompiler);
+			DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_TableCallBack, nDestination, nRegisters[0], nRegisters[1], nRegisters[2], 0);
+			if (!pCompiler->bProgramFull)
+			{
+				pCompiler->pProgram->tInstructions[pCompiler->pProgram->nInstructions - 1].fpCallBack = pTableData[nTableIndex].fpCallBack;
+			}
+			break;
+		}
+		case AST_Callback_Param_UInt8:
+		case AST_Callback_Param_UInt16:
+		case AST_Callback_Param_UInt32:
+			if (!fpParamCallBack)
+			{
+				DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnConstant, 0, 0, 0, 0, 0);
+				return;
+			}
+			// FALLTHROUGH
+		case AST_Raw_Int8:
+		case AST_Raw_Int16:
+		case AST_Raw_Int32:
+		{
+			if (ReachedEndOfBuffer())
+			{
+				DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnConstant, 0, 0, 0, 0, 0);
+				return;
+			}
+
+			int32_t nParameter = 0;
+			switch (nAST)
+			{
+			case AST_Callback_Param_UInt8:
+				nParameter = DATATBLS_CalcReadFromBuffer<uint8_t>(pBufferCurrentPos);
+				break;
+			case AST_Callback_Param_UInt16:
+				nParameter = DATATBLS_CalcReadFromBuffer<uint16_t>(pBufferCurrentPos);
+				break;
+			case AST_Callback_Param_UInt32:
+				nParameter = DATATBLS_CalcReadFromBuffer<uint32_t>(pBufferCurrentPos);
+				break;
+			case AST_Raw_Int8:
+				DATATBLS_CalcCompiler_PushConstant(pCompiler, DATATBLS_CalcReadFromBuffer<int8_t>(pBufferCurrentPos)); // NOLINT
+				continue;
+			case AST_Raw_Int16:
+				DATATBLS_CalcCompiler_PushConstant(pCompiler, DATATBLS_CalcReadFromBuffer<int16_t>(pBufferCurrentPos));
+				continue;
+			default:
+				DATATBLS_CalcCompiler_PushConstant(pCompiler, DATATBLS_CalcReadFromBuffer<int32_t>(pBufferCurrentPos));
+				continue;
+			}
+
+			const int32_t nDestination = DATATBLS_CalcCompiler_PushRegister(pCompiler);
+			DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ParamCallBack, nDestination, 0, 0, 0, nParameter);
+			break;
+		}
+		case AST_LessThan:
+		case AST_GreaterThan:
+		case AST_LessOrEqualThan:
+		case AST_GreaterOrEqualThan:
+		case AST_Equal:
+		case AST_NotEqual:
+		case AST_Addition:
+		case AST_Substraction:
+		case AST_Multipliction:
+		case AST_Division:
+		case AST_Power:
+		{
+			const D2CalcCompilerOperandStrc tRightHandSide = DATATBLS_CalcCompiler_Pop(pCompiler);
+			const D2CalcCompilerOperandStrc tLeftHandSide = DATATBLS_CalcCompiler_Pop(pCompiler);
+			// INT_MIN / -1 faults at runtime, let it do so rather than folding it to some value
+			const bool bFaultingDivision = nAST == AST_Division && tLeftHandSide.nValue == std::numeric_limits<int32_t>::min() && tRightHandSide.nValue == -1;
+			if (tLeftHandSide.bConstant && tRightHandSide.bConstant && !bFaultingDivision)
+			{
+				DATATBLS_CalcCompiler_PushConstant(pCompiler, DATATBLS_CalcApplyBinaryOperator((FOGASTType)nAST, tLeftHandSide.nValue, tRightHandSide.nValue));
+				break;
+			}
+
+			const int32_t nLeftRegister = DATATBLS_CalcCompiler_GetRegister(pCompiler, tLeftHandSide);
+			const int32_t nRightRegister = DATATBLS_CalcCompiler_GetRegister(pCompiler, tRightHandSide);
+			const int32_t nDestination = DATATBLS_CalcCompiler_PushRegister(pCompiler);
+			DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcGetBinaryOperatorHandler((FOGASTType)nAST), nDestination, nLeftRegister, nRightRegister, 0, 0);
+			break;
+		}
+		case AST_Negate:
+		{
+			const D2CalcCompilerOperandStrc tOperand = DATATBLS_CalcCompiler_Pop(pCompiler);
+			if (tOperand.bConstant)
+			{
+				DATATBLS_CalcCompiler_PushConstant(pCompiler, (int32_t)(0u - (uint32_t)tOperand.nValue));
+				break;
+			}
+
+			const int32_t nDestination = DATATBLS_CalcCompiler_PushRegister(pCompiler);
+			DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_Negate, nDestination, tOperand.nRegister, 0, 0, 0);
+			break;
+		}
+		case AST_Ternary:
+		{
+			// The evaluator pushes the selected value then falls through to the default case, which pops it back
+			const D2CalcCompilerOperandStrc tIfFalse = DATATBLS_CalcCompiler_Pop(pCompiler);
+			const D2CalcCompilerOperandStrc tIfTrue = DATATBLS_CalcCompiler_Pop(pCompiler);
+			const D2CalcCompilerOperandStrc tCondition = DATATBLS_CalcCompiler_Pop(pCompiler);
+			if (tCondition.bConstant)
+			{
+				DATATBLS_CalcCompiler_EmitReturn(pCompiler, tCondition.nValue ? tIfTrue : tIfFalse);
+				return;
+			}
+
+			const int32_t nIfTrueRegister = DATATBLS_CalcCompiler_GetRegister(pCompiler, tIfTrue);
+			const int32_t nIfFalseRegister = DATATBLS_CalcCompiler_GetRegister(pCompiler, tIfFalse);
+			DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnTernary, 0, tCondition.nRegister, nIfTrueRegister, nIfFalseRegister, 0);
+			return;
+		}
+		default:
+			DATATBLS_CalcCompiler_EmitReturn(pCompiler, DATATBLS_CalcCompiler_Pop(pCompiler));
+			return;
+		}
+	}
+
+	DATATBLS_CalcCompiler_Emit(pCompiler, DATATBLS_CalcOp_ReturnConstant, 0, 0, 0, 0, 0);
+}
+
+// Helper function
+BOOL __fastcall DATATBLS_CalcCompileProgram(const FOGASTNodeStrc* pExpressionBuffer, int32_t nExpressionBufferSize, CalcFogCallBack2_t fpParamCallBack, D2CalcCallbackInfoStrc* pTableData, int nTableSize, D2CalcProgramStrc* pOutProgram)
+{
+	pOutProgram->fpParamCallBack = fpParamCallBack;
+	pOutProgram->nInstructions = 0;
+
+	D2CalcCompilerStrc tCompiler;
+	tCompiler.pProgram = pOutProgram;
+	tCompiler.nStackSize = 0;
+	tCompiler.bProgramFull = FALSE;
+	DATATBLS_CalcCompiler_CompileExpression(&tCompiler, pExpressionBuffer, nExpressionBufferSize, fpParamCallBack, pTableData, nTableSize);
+
+	return !tCompiler.bProgramFull;
+}
+
+// Helper function
+int __fastcall DATATBLS_CalcRunProgram(const D2CalcProgramStrc* pProgram, void* pUserData)
+{
+	D2CalcRunContextStrc tContext;
+	tContext.nRegisters[CALC_ZERO_REGISTER] = 0;
+	tContext.pProgram = pProgram;
+	tContext.pUserData = pUserData;
+	tContext.nResult = 0;
+
+	// Each handler returns the next instruction to run, the last one being a return
+	const D2CalcInstructionStrc* pInstruction = pProgram->tInstructions;
+	do
+	{
+		pInstruction = pInstruction->pfHandler(pInstruction, &tContext);
+	}
+	while (pInstruction);
+
+	return tContext.nResult;
+}
+
+// Helper function: Replaces pCurrentCache by a cache matching the code buffer, returns the cache to use
+static D2CalcProgramCacheStrc* DATATBLS_ReplaceCalcProgramCache(D2CalcProgramCacheStrc** ppCache, D2CalcProgramCacheStrc* pCurrentCache, const FOGASTNodeStrc* pCode, uint32_t nCodeSize)
+{
+	const size_t nCacheSize = offsetof(D2CalcProgramCacheStrc, pPrograms) + nCodeSize * sizeof(D2CalcProgramStrc*);
+	D2CalcProgramCacheStrc* pNewCache = (D2CalcProgramCacheStrc*)D2_CALLOC(nCacheSize);
+	pNewCache->pCode = pCode;
+	pNewCache->nCodeSize = nCodeSize;
+	// Other threads may still be reading the replaced cache, it is only freed with the new one
+	pNewCache->pPrevious = pCurrentCache;
+
+	D2CalcProgramCacheStrc* pCache = (D2CalcProgramCacheStrc*)InterlockedCompareExchangePointer((PVOID volatile*)ppCache, pNewCache, pCurrentCache);
+	if (pCache != pCurrentCache)
+	{
+		// Another thread replaced it first
+		D2_FREE(pNewCache);
+		return pCache;
+	}
+
+	return pNewCache;
+}
+
+// Helper function
+int __fastcall DATATBLS_EvaluateCalcProgram(D2CalcProgramCacheStrc** ppCache, const FOGASTNodeStrc* pCode, uint32_t nCodeSize, uint32_t nCalc, CalcFogCallBack2_t fpParamCallBack, D2CalcCallbackInfoStrc* pTableData, int nTableSize, void* pUserData)
+{
+	// The code buffers grow while the .txt files are being compiled, a cache created before they were complete is rebuilt
+	D2CalcProgramCacheStrc* pCache = *ppCache;
+	if (!pCache || pCache->pCode != pCode || pCache->nCodeSize != nCodeSize)
+	{
+		pCache = DATATBLS_ReplaceCalcProgramCache(ppCache, pCache, pCode, nCodeSize);
+	}
+
+	if (pCache->pCode != pCode || pCache->nCodeSize != nCodeSize)
+	{
+		return DATATBLS_CalcEvaluateExpression(&pCode[nCalc], nCodeSize - nCalc, fpParamCallBack, pTableData, nTableSize, pUserData);
+	}
+
+	D2CalcProgramStrc* pProgram = pCache->pPrograms[nCalc];
+	if (!pProgram)
+	{
+		D2CalcProgramStrc tProgram;
+		if (!DATATBLS_CalcCompileProgram(&pCode[nCalc], nCodeSize - nCalc, fpParamCallBack, pTableData, nTableSize, &tProgram))
+		{
+			// Too long to be compiled, the empty program makes it use the evaluator
+			tProgram.nInstructions = 0;
+		}
+
+		const size_t nProgramSize = DATATBLS_CalcGetProgramSize(&tProgram);
+		D2CalcProgramStrc* pNewProgram = (D2CalcProgramStrc*)D2_ALLOC(nProgramSize);
+		memcpy(pNewProgram, &tProgram, nProgramSize);
+		pProgram = (D2CalcProgramStrc*)InterlockedCompareExchangePointer((PVOID volatile*)&pCache->pPrograms[nCalc], pNewProgram, nullptr);
+		if (pProgram)
+		{
+			D2_FREE(pNewProgram);
+		}
+		else
+		{
+			pProgram = pNewProgram;
+		}
+	}
+
+	if (!pProgram->nInstructions)
+	{
+		return DATATBLS_CalcEvaluateExpression(&pCode[nCalc], nCodeSize - nCalc, fpParamCallBack, pTableData, nTableSize, pUserData);
+	}
+
+	return DATATBLS_CalcRunProgram(pProgram, pUserData);
+}
+
+// Helper function
+void __fastcall DATATBLS_FreeCalcProgramCache(D2CalcProgramCacheStrc** ppCache)
+{
+	D2CalcProgramCacheStrc* pCache = *ppCache;
+	while (pCache)
+	{
+		for (uint32_t i = 0; i < pCache->nCodeSize; ++i)
+		{
+			if (pCache->pPrograms[i])
+			{
+				D2_FREE(pCache->pPrograms[i]);
+			}
+		}
+
+		D2CalcProgramCacheStrc* pPrevious = pCache->pPrevious;
+		D2_FREE(pCache);
+		pCache = pPrevious;
+	}
+
+	*ppCache = nullptr;
+}
@@ -614,6 +614,23 @@ void* __stdcall DATATBLS_CompileTxt(HD2ARCHIVE hArchive, const char* szName, D2B
 	size_t dwDataSize = 0;
 	char szFilePath[MAX_PATH] = {};
 
+	LARGE_INTEGER tStartTime = {};
+	QueryPerformanceCounter(&tStartTime);
+
+	if (!sgptDataTables->bCompileTxt && DATATBLS_LoadFromBin)
+	{
+		// D2Moo only
+		if (void* pMappedTxt = DATATBLS_GetMappedBin(hArchive, szName, pTbl, dwSize, &nRecordCount))
+		{
+			DATATBLS_TraceTableLoadTime(szName, nRecordCount, &tStartTime, "mapped");
+			if (pRecordCount)
+			{
+				*pRecordCount = nRecordCount;
+			}
+			return pMappedTxt;
+		}
+	}
+
 	dwDataSize = 0;
 	if (sgptDataTables->bCompileTxt)
 	{
@@ -681,6 +698,13 @@ void* __stdcall DATATBLS_CompileTxt(HD2ARCHIVE hArchive, const char* szName, D2B
 		FOG_FreeBinFile(pBinFile);
 	}
 
+	if (DATATBLS_LoadFromBin)
+	{
+		// D2Moo only: mapped on the next loads
+		DATATBLS_WriteMappedBin(hArchive, szName, pTbl, pTxt, nRecordCount, dwSize);
+	}
+	DATATBLS_TraceTableLoadTime(szName, nRecordCount, &tStartTime, sgptDataTables->bCompileTxt ? "compiled" : "read");
+
 	if (pRecordCount)
 	{
 		*pRecordCount = nRecordCount;
@@ -700,6 +724,11 @@ void __stdcall DATATBLS_UnloadBin(void* pBinFile)
 {
 	if (pBinFile)
 	{
+		if (DATATBLS_UnloadMappedBin(pBinFile))
+		{
+			return;
+		}
+
 		if (DATATBLS_LoadFromBin)
 		{
 			D2_FREE_POOL(nullptr, (char*)pBinFile - 4);
@@ -714,6 +743,8 @@ void __stdcall DATATBLS_UnloadBin(void* pBinFile)
 //D2Common.0x6FD50150 (#10575)
 void __stdcall DATATBLS_UnloadAllBins()
 {
+	DATATBLS_FreeLinkIndices();
+
 	DATATBLS_UnloadBin(sgptDataTables->pCompCodeTxt);
 	FOG_FreeLinker(sgptDataTables->pCompCodeLinker);
 
@@ -765,6 +796,7 @@ void __stdcall DATATBLS_UnloadAllBins()
 	DATATBLS_UnloadPropertiesTxt();
 	DATATBLS_UnloadMagicSuffix_Prefix_AutomagicTxt();
 	DATATBLS_UnloadRareSuffix_PrefixTxt();
+	DATATBLS_UnloadAffixCandidates();
 	DATATBLS_UnloadUniqueItemsTxt();
 	DATATBLS_UnloadSets_SetItemsTxt();
 	DATATBLS_UnloadQualityItemsTxt();
@@ -819,6 +851,11 @@ void __stdcall DATATBLS_LoadAllTxts(HD2ARCHIVE hArchive, int a2, int a3)
 		{ "end", TXTFIELD_NONE, 0, 0, NULL },
 	};
 
+	LARGE_INTEGER tStartTime = {};
+	QueryPerformanceCounter(&tStartTime);
+	DATATBLS_PrefetchMappedBins();
+	DATATBLS_InitLinkIndices();
+
 	DATATBLS_LoadSomeTxts(hArchive);
 	DATATBLS_LoadItemTypesTxt(hArchive);
 	DATATBLS_LoadMonTypeTxt(hArchive);
@@ -836,6 +873,7 @@ void __stdcall DATATBLS_LoadAllTxts(HD2ARCHIVE hArchive, int a2, int a3)
 	DATATBLS_LoadItemsTxt(hArchive);
 	DATATBLS_LoadMagicSuffix_Prefix_AutomagicTxt(hArchive);
 	DATATBLS_LoadRareSuffix_PrefixTxt(hArchive);
+	DATATBLS_LoadAffixCandidates();
 	DATATBLS_LoadUniqueItemsTxt(hArchive);
 	DATATBLS_LoadSets_SetItemsTxt(hArchive);
 	DATATBLS_LoadGemsTxt(hArchive);
@@ -878,6 +916,10 @@ void __stdcall DATATBLS_LoadAllTxts(HD2ARCHIVE hArchive, int a2, int a3)
 	DATATBLS_LoadCubeMainTxt(hArchive);
 	DATATBLS_LoadDifficultyLevelsTxt(hArchive);
 	DATATBLS_UnloadSoundsTxt();
+
+	DATATBLS_FinalizeLinkIndices();
+	DATATBLS_ReleaseUnusedMappedBins();
+	DATATBLS_TraceTableLoadTime("all tables", 0, &tStartTime, "total");
 }
 
 //D2Common.0x6FD507B0
@@ -78,7 +78,7 @@ BOOL __fastcall DATATBLS_CubeMainInputParser(D2CubeInputItem* pCubeInput, char*
 
 			if (strlen(szInput) <= 4)
 			{
-				nLinkId = FOG_GetLinkIndex(sgptDataTables->pItemTypesLinker, DATATBLS_StringToCode(szInput), 0);
+				nLinkId = DATATBLS_GetLinkIndex(sgptDataTables->pItemTypesLinker, DATATBLS_StringToCode(szInput), 0);
 			}
 
 			if (nLinkId >= 0)
@@ -97,7 +97,7 @@ BOOL __fastcall DATATBLS_CubeMainInputParser(D2CubeInputItem* pCubeInput, char*
 
 				if (sgptDataTables->pUniqueItemsLinker)
 				{
-					nLinkId = FOG_GetRowFromTxt(sgptDataTables->pUniqueItemsLinker, szInput, 0);
+					nLinkId = DATATBLS_GetRowFromTxt(sgptDataTables->pUniqueItemsLinker, szInput, 0);
 				}
 
 				if (nLinkId >= 0)
@@ -114,7 +114,7 @@ BOOL __fastcall DATATBLS_CubeMainInputParser(D2CubeInputItem* pCubeInput, char*
 
 					if (sgptDataTables->pSetItemsLinker)
 					{
-						nLinkId = FOG_GetRowFromTxt(sgptDataTables->pSetItemsLinker, szInput, 0);
+						nLinkId = DATATBLS_GetRowFromTxt(sgptDataTables->pSetItemsLinker, szInput, 0);
 					}
 
 					if (nLinkId >= 0)
@@ -327,7 +327,7 @@ BOOL __fastcall DATATBLS_CubeMainOutputParser(D2CubeOutputItem* pCubeOutputParam
 
 		if (strlen(szOutput) <= 4)
 		{
-			nLinkId = FOG_GetLinkIndex(sgptDataTables->pItemTypesLinker, DATATBLS_StringToCode(szOutput), 0);
+			nLinkId = DATATBLS_GetLinkIndex(sgptDataTables->pItemTypesLinker, DATATBLS_StringToCode(szOutput), 0);
 		}
 
 		if (nLinkId >= 0)
@@ -341,7 +341,7 @@ BOOL __fastcall DATATBLS_CubeMainOutputParser(D2CubeOutputItem* pCubeOutputParam
 
 			if (sgptDataTables->pUniqueItemsLinker)
 			{
-				nLinkId = FOG_GetRowFromTxt(sgptDataTables->pUniqueItemsLinker, szOutput, 0);
+				nLinkId = DATATBLS_GetRowFromTxt(sgptDataTables->pUniqueItemsLinker, szOutput, 0);
 			}
 
 			if (nLinkId >= 0)
@@ -360,7 +360,7 @@ BOOL __fastcall DATATBLS_CubeMainOutputParser(D2CubeOutputItem* pCubeOutputParam
 
 				if (sgptDataTables->pSetItemsLinker)
 				{
-					nLinkId = FOG_GetRowFromTxt(sgptDataTables->pSetItemsLinker, szOutput, 0);
+					nLinkId = DATATBLS_GetRowFromTxt(sgptDataTables->pSetItemsLinker, szOutput, 0);
 				}
 
 				if (nLinkId >= 0)
@@ -572,7 +572,7 @@ void __fastcall DATATBLS_CubeMainParamLinker(char* pSrc, void* pRecord, int nOff
 		{
 			if (sgptDataTables->pItemStatCostLinker)
 			{
-				nValue = FOG_GetRowFromTxt(sgptDataTables->pItemStatCostLinker, pSrc, 0);
+				nValue = DATATBLS_GetRowFromTxt(sgptDataTables->pItemStatCostLinker, pSrc, 0);
 				if (nValue >= 0)
 				{
 					*(int*)pRecord = nValue;
@@ -1,9 +1,12 @@
 #include "D2DataTbls.h"
 
+#include <algorithm>
+
 #include "D2Items.h"
 #include <Archive.h>
 #include <D2Lang.h>
 #include <D2BitManip.h>
+#include <D2Math.h>
 #include <D2StatList.h>
 #include <Calc.h>
 #include <Storm.h>
@@ -373,6 +376,8 @@ void __fastcall DATATBLS_UnloadItemsTxt()
 	}
 
 	sgptDataTables->pItemDataTables.pItemsTxt = NULL;
+
+	DATATBLS_FreeCalcProgramCache(&sgptDataTables->pItemsCodePrograms);
 }
 
 //D2Common.0x6FD57620 (#10599)
@@ -411,7 +416,7 @@ D2ItemsTxt* __stdcall DATATBLS_GetItemsTxtRecord(int nItemId)
 //D2Common.0x6FD576D0 (#10601)
 D2ItemsTxt* __stdcall DATATBLS_GetItemRecordFromItemCode(uint32_t dwCode, int* pItemId)
 {
-	*pItemId = FOG_GetLinkIndex(sgptDataTables->pItemsLinker, dwCode, 0);
+	*pItemId = DATATBLS_GetLinkIndex(sgptDataTables->pItemsLinker, dwCode, 0);
 	if (*pItemId >= 0)
 	{
 		return &sgptDataTables->pItemDataTables.pItemsTxt[*pItemId];
@@ -424,7 +429,7 @@ D2ItemsTxt* __stdcall DATATBLS_GetItemRecordFromItemCode(uint32_t dwCode, int* p
 //D2Common.0x6FD57720 (#10602)
 int __stdcall DATATBLS_GetItemIdFromItemCode(uint32_t dwCode)
 {
-	return FOG_GetLinkIndex(sgptDataTables->pItemsLinker, dwCode, 0);
+	return DATATBLS_GetLinkIndex(sgptDataTables->pItemsLinker, dwCode, 0);
 }
 
 //D2Common.0x6FD57740
@@ -444,7 +449,7 @@ void __fastcall DATATBLS_ItemParamLinker(char* pSrc, void* pRecord, int nOffset,
 			{
 				if (sgptDataTables->pSkillsLinker)
 				{
-					nRow = FOG_GetRowFromTxt(sgptDataTables->pSkillsLinker, pSrc, 0);
+					nRow = DATATBLS_GetRowFromTxt(sgptDataTables->pSkillsLinker, pSrc, 0);
 					if (nRow >= 0)
 					{
 						*(uint32_t*)((char*)pRecord + nOffset) = nRow;
@@ -454,7 +459,7 @@ void __fastcall DATATBLS_ItemParamLinker(char* pSrc, void* pRecord, int nOffset,
 
 				if (sgptDataTables->pMonTypeLinker)
 				{
-					nRow = FOG_GetRowFromTxt(sgptDataTables->pMonTypeLinker, pSrc, 0);
+					nRow = DATATBLS_GetRowFromTxt(sgptDataTables->pMonTypeLinker, pSrc, 0);
 					if (nRow >= 0)
 					{
 						*(uint32_t*)((char*)pRecord + nOffset) = nRow;
@@ -464,7 +469,7 @@ void __fastcall DATATBLS_ItemParamLinker(char* pSrc, void* pRecord, int nOffset,
 
 				if (sgptDataTables->pStatesLinker)
 				{
-					nRow = FOG_GetRowFromTxt(sgptDataTables->pStatesLinker, pSrc, 0);
+					nRow = DATATBLS_GetRowFromTxt(sgptDataTables->pStatesLinker, pSrc, 0);
 					if (nRow >= 0)
 					{
 						*(uint32_t*)((char*)pRecord + nOffset) = nRow;
@@ -677,6 +682,227 @@ D2RareAffixTxt* __stdcall DATATBLS_GetRareAffixTxtRecord(int nId)
 	}
 }
 
+// Helper function: Same item type checks as ITEMMODS_CanItemHaveMagicAffix and ITEMMODS_CanItemHaveRareAffix
+static BOOL DATATBLS_CanItemTypeHaveAffix(int nItemId, const uint16_t* pITypes, int nITypes, const uint16_t* pETypes, int nETypes)
+{
+	for (int i = 0; i < nETypes; ++i)
+	{
+		if (pETypes[i] <= 0)
+		{
+			break;
+		}
+
+		if (ITEMS_CheckItemTypeIdByItemId(nItemId, pETypes[i]))
+		{
+			return FALSE;
+		}
+	}
+
+	for (int i = 0; i < nITypes; ++i)
+	{
+		if (pITypes[i] <= 0)
+		{
+			break;
+		}
+
+		if (ITEMS_CheckItemTypeIdByItemId(nItemId, pITypes[i]))
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+// Helper function: Adds the affixes of a list of nItemId to the candidates, or only counts them when pAffixes is nullptr
+static void DATATBLS_AddAffixCandidates(D2AffixCandidatesStrc* pCandidates, int nItemId, int nList, int32_t* pListOffset)
+{
+	const D2MagicAffixDataTbl* pMagicAffixDataTbl = &sgptDataTables->pMagicAffixDataTables;
+	const D2RareAffixDataTbl* pRareAffixDataTbl = &sgptDataTables->pRareAffixDataTables;
+
+	if (nList >= AFFIXCANDIDATES_RARESUFFIX)
+	{
+		const D2RareAffixTxt* pBegin = pRareAffixDataTbl->pRareSuffix;
+		const D2RareAffixTxt* pEnd = pRareAffixDataTbl->pRarePrefix;
+		if (nList == AFFIXCANDIDATES_RAREPREFIX)
+		{
+			pBegin = pRareAffixDataTbl->pRarePrefix;
+			pEnd = &pRareAffixDataTbl->pRareAffixTxt[pRareAffixDataTbl->nRareAffixTxtRecordCount];
+		}
+
+		for (int i = 0; pBegin && i < pEnd - pBegin; ++i)
+		{
+			if (DATATBLS_CanItemTypeHaveAffix(nItemId, pBegin[i].wIType, ARRAY_SIZE(pBegin[i].wIType), pBegin[i].wEType, ARRAY_SIZE(pBegin[i].wEType)))
+			{
+				if (pCandidates->pAffixes)
+				{
+					pCandidates->pAffixes[*pListOffset] = i;
+				}
+				++*pListOffset;
+			}
+		}
+		return;
+	}
+
+	const int nBand = (nList - AFFIXCANDIDATES_MAGICSUFFIX) % AFFIXCANDIDATES_LEVEL_BANDS;
+	const uint32_t nBandMinLevel = nBand << AFFIXCANDIDATES_LEVEL_BAND_SHIFT;
+	// The last band also holds every higher level, see DATATBLS_GetMagicAffixCandidates
+	const uint32_t nBandMaxLevel = nBand == AFFIXCANDIDATES_LEVEL_BANDS - 1 ? UINT32_MAX : ((nBand + 1) << AFFIXCANDIDATES_LEVEL_BAND_SHIFT) - 1;
+
+	const D2MagicAffixTxt* pBegin = pMagicAffixDataTbl->pMagicSuffix;
+	const D2MagicAffixTxt* pEnd = pMagicAffixDataTbl->pMagicPrefix;
+	if (nList >= AFFIXCANDIDATES_AUTOMAGIC)
+	{
+		pBegin = pMagicAffixDataTbl->pAutoMagic;
+		pEnd = &pMagicAffixDataTbl->pMagicAffixTxt[pMagicAffixDataTbl->nMagicAffixTxtRecordCount];
+	}
+	else if (nList >= AFFIXCANDIDATES_MAGICPREFIX)
+	{
+		pBegin = pMagicAffixDataTbl->pMagicPrefix;
+		pEnd = pMagicAffixDataTbl->pAutoMagic;
+	}
+
+	for (int i = 0; pBegin && i < pEnd - pBegin; ++i)
+	{
+		const D2MagicAffixTxt* pAffix = &pBegin[i];
+		// Affixes that can not spawn at any level of the band, or never spawn (see ITEMS_RollMagicAffixesNew)
+		if (pAffix->wFrequency == 0 || pAffix->dwLevel > nBandMaxLevel || (pAffix->dwMaxLevel != 0 && pAffix->dwMaxLevel < nBandMinLevel))
+		{
+			continue;
+		}
+
+		if (DATATBLS_CanItemTypeHaveAffix(nItemId, pAffix->wIType, ARRAY_SIZE(pAffix->wIType), pAffix->wEType, ARRAY_SIZE(pAffix->wEType)))
+		{
+			if (pCandidates->pAffixes)
+			{
+				pCandidates->pAffixes[*pListOffset] = i;
+			}
+			++*pListOffset;
+		}
+	}
+}
+
+// Helper function
+int __fastcall DATATBLS_BuildAffixCandidateBuckets(D2AffixCandidatesStrc* pCandidates, int* pBucketItems)
+{
+	const D2ItemDataTbl* pItemDataTbl = &sgptDataTables->pItemDataTables;
+
+	// The item type checks only depend on the two types of the item, the first item of each bucket is used to build its lists
+	pCandidates->nBuckets = 0;
+	for (int nItemId = 0; nItemId < pItemDataTbl->nItemsTxtRecordCount; ++nItemId)
+	{
+		const D2ItemsTxt* pItemsTxtRecord = &pItemDataTbl->pItemsTxt[nItemId];
+
+		int nBucket = 0;
+		while (nBucket < pCandidates->nBuckets)
+		{
+			const D2ItemsTxt* pBucketItemsTxtRecord = &pItemDataTbl->pItemsTxt[pBucketItems[nBucket]];
+			if (pBucketItemsTxtRecord->wType[0] == pItemsTxtRecord->wType[0] && pBucketItemsTxtRecord->wType[1] == pItemsTxtRecord->wType[1])
+			{
+				break;
+			}
+			++nBucket;
+		}
+
+		if (nBucket == pCandidates->nBuckets)
+		{
+			pBucketItems[pCandidates->nBuckets] = nItemId;
+			++pCandidates->nBuckets;
+		}
+		pCandidates->pItemBuckets[nItemId] = nBucket;
+	}
+
+	return pCandidates->nBuckets;
+}
+
+// Helper function
+int32_t __fastcall DATATBLS_BuildAffixCandidateLists(D2AffixCandidatesStrc* pCandidates, const int* pBucketItems)
+{
+	int32_t nOffset = 0;
+	for (int nBucket = 0; nBucket < pCandidates->nBuckets; ++nBucket)
+	{
+		for (int nList = 0; nList < AFFIXCANDIDATES_LISTS; ++nList)
+		{
+			pCandidates->pListStarts[nBucket * AFFIXCANDIDATES_LISTS + nList] = nOffset;
+			DATATBLS_AddAffixCandidates(pCandidates, pBucketItems[nBucket], nList, &nOffset);
+		}
+	}
+	pCandidates->pListStarts[pCandidates->nBuckets * AFFIXCANDIDATES_LISTS] = nOffset;
+
+	return nOffset;
+}
+
+// Helper function
+void __fastcall DATATBLS_LoadAffixCandidates()
+{
+	DATATBLS_UnloadAffixCandidates();
+
+	const D2ItemDataTbl* pItemDataTbl = &sgptDataTables->pItemDataTables;
+	if (!pItemDataTbl->pItemsTxt || !sgptDataTables->pMagicAffixDataTables.pMagicAffixTxt || !sgptDataTables->pRareAffixDataTables.pRareAffixTxt)
+	{
+		return;
+	}
+
+	D2AffixCandidatesStrc tCandidates = {};
+	tCandidates.pItemBuckets = (int16_t*)D2_ALLOC_POOL(nullptr, sizeof(int16_t) * pItemDataTbl->nItemsTxtRecordCount);
+	int* pBucketItems = (int*)D2_ALLOC_POOL(nullptr, sizeof(int) * pItemDataTbl->nItemsTxtRecordCount);
+	DATATBLS_BuildAffixCandidateBuckets(&tCandidates, pBucketItems);
+
+	// Counts the affixes of each list, then fills them
+	tCandidates.pListStarts = (int32_t*)D2_ALLOC_POOL(nullptr, sizeof(int32_t) * (tCandidates.nBuckets * AFFIXCANDIDATES_LISTS + 1));
+	const int32_t nAffixes = DATATBLS_BuildAffixCandidateLists(&tCandidates, pBucketItems);
+	tCandidates.pAffixes = (uint16_t*)D2_ALLOC_POOL(nullptr, sizeof(uint16_t) * std::max(nAffixes, 1));
+	DATATBLS_BuildAffixCandidateLists(&tCandidates, pBucketItems);
+
+	D2_FREE_POOL(nullptr, pBucketItems);
+
+	sgptDataTables->pAffixCandidates = D2_ALLOC_STRC_POOL(nullptr, D2AffixCandidatesStrc);
+	*sgptDataTables->pAffixCandidates = tCandidates;
+}
+
+// Helper function
+void __fastcall DATATBLS_UnloadAffixCandidates()
+{
+	if (D2AffixCandidatesStrc* pCandidates = sgptDataTables->pAffixCandidates)
+	{
+		D2_FREE_POOL(nullptr, pCandidates->pItemBuckets);
+		D2_FREE_POOL(nullptr, pCandidates->pListStarts);
+		D2_FREE_POOL(nullptr, pCandidates->pAffixes);
+		D2_FREE_POOL(nullptr, pCandidates);
+		sgptDataTables->pAffixCandidates = nullptr;
+	}
+}
+
+// Helper function
+static const uint16_t* DATATBLS_GetAffixCandidates(int nItemId, int nList, int* pCount)
+{
+	const D2AffixCandidatesStrc* pCandidates = sgptDataTables->pAffixCandidates;
+	if (!pCandidates || nItemId < 0 || nItemId >= sgptDataTables->pItemDataTables.nItemsTxtRecordCount)
+	{
+		*pCount = 0;
+		return nullptr;
+	}
+
+	const int nListIndex = pCandidates->pItemBuckets[nItemId] * AFFIXCANDIDATES_LISTS + nList;
+	*pCount = pCandidates->pListStarts[nListIndex + 1] - pCandidates->pListStarts[nListIndex];
+	return &pCandidates->pAffixes[pCandidates->pListStarts[nListIndex]];
+}
+
+// Helper function
+const uint16_t* __fastcall DATATBLS_GetMagicAffixCandidates(int nItemId, int nList, int nLevel, int* pCount)
+{
+	D2_ASSERT(nList == AFFIXCANDIDATES_MAGICSUFFIX || nList == AFFIXCANDIDATES_MAGICPREFIX || nList == AFFIXCANDIDATES_AUTOMAGIC);
+
+	const int nBand = D2Clamp<int>(nLevel >> AFFIXCANDIDATES_LEVEL_BAND_SHIFT, 0, AFFIXCANDIDATES_LEVEL_BANDS - 1);
+	return DATATBLS_GetAffixCandidates(nItemId, nList + nBand, pCount);
+}
+
+// Helper function
+const uint16_t* __fastcall DATATBLS_GetRareAffixCandidates(int nItemId, BOOL bPrefix, int* pCount)
+{
+	return DATATBLS_GetAffixCandidates(nItemId, bPrefix ? AFFIXCANDIDATES_RAREPREFIX : AFFIXCANDIDATES_RARESUFFIX, pCount);
+}
+
 //D2Common.0x6FD584E0
 void __fastcall DATATBLS_LoadUniqueItemsTxt(HD2ARCHIVE hArchive)
 {
@@ -1689,9 +1915,11 @@ void __fastcall DATATBLS_LoadGambleTxt(HD2ARCHIVE hArchive)
 	if (sgptDataTables->pGambleDataTables.nGambleTxtRecordCount)
 	{
 		sgptDataTables->pGambleDataTables.pGambleSelection = (uint32_t*)D2_ALLOC_POOL(nullptr, sizeof(uint32_t) * sgptDataTables->pGambleDataTables.nGambleTxtRecordCount);
+		// D2Moo only: the item ids are resolved in the selection, which is filled with the sorted ids below
+		DATATBLS_ResolveLinkCodes(sgptDataTables->pItemsLinker, &pGambleTxt[0].dwItemCode, sizeof(D2GambleTxt), sgptDataTables->pGambleDataTables.nGambleTxtRecordCount, (int*)sgptDataTables->pGambleDataTables.pGambleSelection, 0);
 		for (int i = 0; i < sgptDataTables->pGambleDataTables.nGambleTxtRecordCount; ++i)
 		{
-			nItemId = FOG_GetLinkIndex(sgptDataTables->pItemsLinker, pGambleTxt[i].dwItemCode, 0);
+			nItemId = (int)sgptDataTables->pGambleDataTables.pGambleSelection[i];
 			D2_ASSERT(nItemId >= 0 && &sgptDataTables->pItemDataTables.pItemsTxt[nItemId]);
 			pGambleTxt[i].nItemId = nItemId;
 			pGambleTxt[i].nLevel = sgptDataTables->pItemDataTables.pItemsTxt[nItemId].nLevel;
@@ -0,0 +1,352 @@
+#include "D2DataTbls.h"
+
+#include <cctype>
+#include <cstring>
+
+
+struct D2TxtLinkIndexSlotStrc
+{
+	D2TxtLinkStrc* pLinker;
+	D2TxtLinkIndexStrc* pIndex;
+};
+
+D2TxtLinkIndexSlotStrc gaLinkIndices[LINKINDEX_MAX_LINKERS];
+int gnLinkIndices;
+BOOL gbLinkIndicesBuildable;
+
+
+// Helper function
+static uint32_t DATATBLS_GetLinkIndexCapacity(int nEntries)
+{
+	// At most half full, so that the probes always end on an empty slot
+	uint32_t nCapacity = 2;
+	while (nCapacity < 2 * (uint32_t)nEntries)
+	{
+		nCapacity *= 2;
+	}
+	return nCapacity;
+}
+
+// Helper function
+static uint32_t DATATBLS_HashLinkCode(uint32_t dwCode)
+{
+	uint32_t dwHash = dwCode * 0x9E3779B1;
+	return dwHash ^ (dwHash >> 16);
+}
+
+// Helper function
+static uint32_t DATATBLS_HashLinkString(const char* szText)
+{
+	uint32_t dwHash = 0x811C9DC5;
+	for (; *szText; ++szText)
+	{
+		dwHash = (dwHash ^ (uint8_t)tolower((uint8_t)*szText)) * 0x01000193;
+	}
+	return dwHash;
+}
+
+// Helper function
+static int DATATBLS_GetLinkNodesCount(D2TxtLinkStrc* pLinker)
+{
+	int nNodes = 0;
+	for (D2TxtLinkNodeStrc* pNode = pLinker->pFirstNode; pNode; pNode = pNode->pNext)
+	{
+		++nNodes;
+	}
+	return nNodes;
+}
+
+// Helper function
+static size_t DATATBLS_GetLinkIndexHeaderSize()
+{
+	return (sizeof(D2TxtLinkIndexStrc) + 7) & ~7;
+}
+
+// Helper function
+size_t __fastcall DATATBLS_GetLinkIndexSize(D2TxtLinkStrc* pLinker)
+{
+	const int nCodes = pLinker->pTbl ? pLinker->nRecords : 0;
+	return DATATBLS_GetLinkIndexHeaderSize()
+		+ DATATBLS_GetLinkIndexCapacity(nCodes) * sizeof(D2TxtLinkIndexCodeStrc)
+		+ DATATBLS_GetLinkIndexCapacity(DATATBLS_GetLinkNodesCount(pLinker)) * sizeof(D2TxtLinkIndexStringStrc);
+}
+
+// Helper function
+D2TxtLinkIndexStrc* __fastcall DATATBLS_BuildLinkIndex(D2TxtLinkStrc* pLinker, void* pBuffer)
+{
+	const int nCodes = pLinker->pTbl ? pLinker->nRecords : 0;
+	const uint32_t nCodeCapacity = DATATBLS_GetLinkIndexCapacity(nCodes);
+	const uint32_t nStringCapacity = DATATBLS_GetLinkIndexCapacity(DATATBLS_GetLinkNodesCount(pLinker));
+
+	D2TxtLinkIndexStrc* pIndex = (D2TxtLinkIndexStrc*)pBuffer;
+	pIndex->pLinker = pLinker;
+	pIndex->nRecords = pLinker->nRecords;
+	pIndex->pFirstNode = pLinker->pFirstNode;
+	pIndex->nCodeMask = nCodeCapacity - 1;
+	pIndex->nStringMask = nStringCapacity - 1;
+	pIndex->pCodes = (D2TxtLinkIndexCodeStrc*)((uint8_t*)pBuffer + DATATBLS_GetLinkIndexHeaderSize());
+	pIndex->pStrings = (D2TxtLinkIndexStringStrc*)&pIndex->pCodes[nCodeCapacity];
+
+	for (uint32_t i = 0; i < nCodeCapacity; ++i)
+	{
+		pIndex->pCodes[i].dwCode = 0;
+		pIndex->pCodes[i].nLinkIndex = LINKINDEX_NOT_FOUND;
+	}
+
+	for (uint32_t i = 0; i < nStringCapacity; ++i)
+	{
+		pIndex->pStrings[i].dwHash = 0;
+		pIndex->pStrings[i].nLinkIndex = LINKINDEX_NOT_FOUND;
+		pIndex->pStrings[i].pNode = nullptr;
+	}
+
+	for (int i = 0; i < nCodes; ++i)
+	{
+		const D2TxtLinkTblStrc* pLink = &pLinker->pTbl[i];
+		if (pLink->nLinkIndex < 0)
+		{
+			continue;
+		}
+
+		uint32_t nSlot = DATATBLS_HashLinkCode(pLink->dwCode) & pIndex->nCodeMask;
+		while (pIndex->pCodes[nSlot].nLinkIndex != LINKINDEX_NOT_FOUND && pIndex->pCodes[nSlot].dwCode != pLink->dwCode)
+		{
+			nSlot = (nSlot + 1) & pIndex->nCodeMask;
+		}
+
+		if (pIndex->pCodes[nSlot].nLinkIndex == LINKINDEX_NOT_FOUND)
+		{
+			pIndex->pCodes[nSlot].dwCode = pLink->dwCode;
+			pIndex->pCodes[nSlot].nLinkIndex = pLink->nLinkIndex;
+		}
+		else
+		{
+			// Which of the duplicates Fog returns is its own business
+			pIndex->pCodes[nSlot].nLinkIndex = LINKINDEX_AMBIGUOUS;
+		}
+	}
+
+	for (D2TxtLinkNodeStrc* pNode = pLinker->pFirstNode; pNode; pNode = pNode->pNext)
+	{
+		if (pNode->nLinkIndex < 0 || !memchr(pNode->szText, '\0', sizeof(pNode->szText)))
+		{
+			continue;
+		}
+
+		// Strings that only differ by their case share an entry, so that they are left to Fog whatever the comparison it does
+		const uint32_t dwHash = DATATBLS_HashLinkString(pNode->szText);
+		uint32_t nSlot = dwHash & pIndex->nStringMask;
+		while (pIndex->pStrings[nSlot].nLinkIndex != LINKINDEX_NOT_FOUND
+			&& (pIndex->pStrings[nSlot].dwHash != dwHash || _stricmp(pIndex->pStrings[nSlot].pNode->szText, pNode->szText)))
+		{
+			nSlot = (nSlot + 1) & pIndex->nStringMask;
+		}
+
+		if (pIndex->pStrings[nSlot].nLinkIndex == LINKINDEX_NOT_FOUND)
+		{
+			pIndex->pStrings[nSlot].dwHash = dwHash;
+			pIndex->pStrings[nSlot].nLinkIndex = pNode->nLinkIndex;
+			pIndex->pStrings[nSlot].pNode = pNode;
+		}
+		else
+		{
+			pIndex->pStrings[nSlot].nLinkIndex = LINKINDEX_AMBIGUOUS;
+		}
+	}
+
+	return pIndex;
+}
+
+// Helper function
+int __fastcall DATATBLS_FindCodeInLinkIndex(const D2TxtLinkIndexStrc* pIndex, uint32_t dwCode)
+{
+	uint32_t nSlot = DATATBLS_HashLinkCode(dwCode) & pIndex->nCodeMask;
+	while (pIndex->pCodes[nSlot].nLinkIndex != LINKINDEX_NOT_FOUND)
+	{
+		if (pIndex->pCodes[nSlot].dwCode == dwCode)
+		{
+			return pIndex->pCodes[nSlot].nLinkIndex >= 0 ? pIndex->pCodes[nSlot].nLinkIndex : LINKINDEX_NOT_FOUND;
+		}
+		nSlot = (nSlot + 1) & pIndex->nCodeMask;
+	}
+
+	return LINKINDEX_NOT_FOUND;
+}
+
+// Helper function
+int __fastcall DATATBLS_FindStringInLinkIndex(const D2TxtLinkIndexStrc* pIndex, const char* szText)
+{
+	if (!szText || strnlen(szText, sizeof(D2TxtLinkNodeStrc::szText)) >= sizeof(D2TxtLinkNodeStrc::szText))
+	{
+		return LINKINDEX_NOT_FOUND;
+	}
+
+	const uint32_t dwHash = DATATBLS_HashLinkString(szText);
+	uint32_t nSlot = dwHash & pIndex->nStringMask;
+	while (pIndex->pStrings[nSlot].nLinkIndex != LINKINDEX_NOT_FOUND)
+	{
+		const D2TxtLinkIndexStringStrc* pEntry = &pIndex->pStrings[nSlot];
+		if (pEntry->dwHash == dwHash && !_stricmp(pEntry->pNode->szText, szText))
+		{
+			// Only an exact match is known to be the answer of Fog
+			return (pEntry->nLinkIndex >= 0 && !strcmp(pEntry->pNode->szText, szText)) ? pEntry->nLinkIndex : LINKINDEX_NOT_FOUND;
+		}
+		nSlot = (nSlot + 1) & pIndex->nStringMask;
+	}
+
+	return LINKINDEX_NOT_FOUND;
+}
+
+// Helper function
+static D2TxtLinkIndexSlotStrc* DATATBLS_GetLinkIndexSlot(D2TxtLinkStrc* pLinker)
+{
+	uint32_t nSlot = DATATBLS_HashLinkCode((uint32_t)(uintptr_t)pLinker) & (LINKINDEX_MAX_LINKERS - 1);
+	while (gaLinkIndices[nSlot].pLinker && gaLinkIndices[nSlot].pLinker != pLinker)
+	{
+		nSlot = (nSlot + 1) & (LINKINDEX_MAX_LINKERS - 1);
+	}
+	return &gaLinkIndices[nSlot];
+}
+
+// Helper function
+static D2TxtLinkIndexStrc* DATATBLS_GetLinkerIndex(D2TxtLinkStrc* pLinker)
+{
+	if (!pLinker)
+	{
+		return nullptr;
+	}
+
+	D2TxtLinkIndexSlotStrc* pSlot = DATATBLS_GetLinkIndexSlot(pLinker);
+	if (pSlot->pIndex && pSlot->pIndex->nRecords == pLinker->nRecords && pSlot->pIndex->pFirstNode == pLinker->pFirstNode)
+	{
+		return pSlot->pIndex;
+	}
+
+	// Records were added to the linker since the index was built. Once the tables are loaded, the lookups run on several threads and the
+	// indices must not change anymore, so they only rely on Fog.
+	if (!gbLinkIndicesBuildable)
+	{
+		return nullptr;
+	}
+
+	if (pSlot->pIndex)
+	{
+		D2_FREE(pSlot->pIndex);
+		pSlot->pIndex = nullptr;
+	}
+	else
+	{
+		if (gnLinkIndices >= LINKINDEX_MAX_LINKERS / 2)
+		{
+			return nullptr;
+		}
+		pSlot->pLinker = pLinker;
+		++gnLinkIndices;
+	}
+
+	pSlot->pIndex = DATATBLS_BuildLinkIndex(pLinker, D2_ALLOC(DATATBLS_GetLinkIndexSize(pLinker)));
+	return pSlot->pIndex;
+}
+
+// Helper function
+void __fastcall DATATBLS_FreeLinkIndices()
+{
+	for (int i = 0; i < LINKINDEX_MAX_LINKERS; ++i)
+	{
+		if (gaLinkIndices[i].pIndex)
+		{
+			D2_FREE(gaLinkIndices[i].pIndex);
+		}
+		gaLinkIndices[i].pLinker = nullptr;
+		gaLinkIndices[i].pIndex = nullptr;
+	}
+
+	gnLinkIndices = 0;
+	gbLinkIndicesBuildable = FALSE;
+}
+
+// Helper function
+void __fastcall DATATBLS_InitLinkIndices()
+{
+	DATATBLS_FreeLinkIndices();
+	gbLinkIndicesBuildable = TRUE;
+}
+
+// Helper function
+void __fastcall DATATBLS_FinalizeLinkIndices()
+{
+	// Some linkers are freed during the loading (sounds, ranges...), their memory may be reused by new linkers
+	DATATBLS_InitLinkIndices();
+
+	D2TxtLinkStrc* pRuntimeLinkers[] =
+	{
+		sgptDataTables->pItemsLinker,
+		sgptDataTables->pItemTypesLinker,
+		sgptDataTables->pUniqueItemsLinker,
+		sgptDataTables->pSetItemsLinker,
+		sgptDataTables->pItemStatCostLinker,
+		sgptDataTables->pStatesLinker,
+		sgptDataTables->pSkillsLinker,
+		sgptDataTables->pMonStatsLinker,
+	};
+
+	for (D2TxtLinkStrc* pLinker : pRuntimeLinkers)
+	{
+		DATATBLS_GetLinkerIndex(pLinker);
+	}
+
+	gbLinkIndicesBuildable = FALSE;
+}
+
+// Helper function
+int __fastcall DATATBLS_GetLinkIndex(D2TxtLinkStrc* pLinker, uint32_t dwCode, BOOL bLogError)
+{
+	if (const D2TxtLinkIndexStrc* pIndex = DATATBLS_GetLinkerIndex(pLinker))
+	{
+		const int nLinkIndex = DATATBLS_FindCodeInLinkIndex(pIndex, dwCode);
+		if (nLinkIndex >= 0)
+		{
+			return nLinkIndex;
+		}
+	}
+
+	return FOG_GetLinkIndex(pLinker, dwCode, bLogError);
+}
+
+// Helper function
+int __fastcall DATATBLS_GetRowFromTxt(D2TxtLinkStrc* pLinker, char* szText, int nColumn)
+{
+	if (const D2TxtLinkIndexStrc* pIndex = DATATBLS_GetLinkerIndex(pLinker))
+	{
+		const int nRow = DATATBLS_FindStringInLinkIndex(pIndex, szText);
+		if (nRow >= 0)
+		{
+			return nRow;
+		}
+	}
+
+	return FOG_GetRowFromTxt(pLinker, szText, nColumn);
+}
+
+// Helper function
+void __fastcall DATATBLS_ResolveLinkCodes(D2TxtLinkStrc* pLinker, const uint32_t* pCodes, size_t nStride, int nCount, int* pLinkIndices, BOOL bLogError)
+{
+	const D2TxtLinkIndexStrc* pIndex = DATATBLS_GetLinkerIndex(pLinker);
+	for (int i = 0; i < nCount; ++i)
+	{
+		const uint32_t dwCode = *(const uint32_t*)((const uint8_t*)pCodes + i * nStride);
+		const int nLinkIndex = pIndex ? DATATBLS_FindCodeInLinkIndex(pIndex, dwCode) : LINKINDEX_NOT_FOUND;
+		pLinkIndices[i] = nLinkIndex >= 0 ? nLinkIndex : FOG_GetLinkIndex(pLinker, dwCode, bLogError);
+	}
+}
+
+// Helper function
+void __fastcall DATATBLS_ResolveLinkStrings(D2TxtLinkStrc* pLinker, char* const* pStrings, int nCount, int* pRows, int nColumn)
+{
+	const D2TxtLinkIndexStrc* pIndex = DATATBLS_GetLinkerIndex(pLinker);
+	for (int i = 0; i < nCount; ++i)
+	{
+		const int nRow = pIndex ? DATATBLS_FindStringInLinkIndex(pIndex, pStrings[i]) : LINKINDEX_NOT_FOUND;
+		pRows[i] = nRow >= 0 ? nRow : FOG_GetRowFromTxt(pLinker, pStrings[i], nColumn);
+	}
+}
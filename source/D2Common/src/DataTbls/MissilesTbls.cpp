@@ -323,6 +323,8 @@ void __fastcall DATATBLS_LoadMissilesTxt(HD2ARCHIVE hArchive)
 //D2Common.0x6FD64B80
 void __fastcall DATATBLS_UnloadMissilesTxt()
 {
+	DATATBLS_FreeCalcProgramCache(&sgptDataTables->pMissCodePrograms);
+
 	if (sgptDataTables->pMissCode)
 	{
 		D2_FREE_POOL(nullptr, sgptDataTables->pMissCode);
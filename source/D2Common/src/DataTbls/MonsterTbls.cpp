@@ -7,6 +7,8 @@
 #include <Units/Units.h>
 #include <D2Monsters.h>
 
+#include <algorithm>
+
 //Inlined in some functions
 uint32_t __fastcall DATATBLS_StringToCode(char* szText)
 {
@@ -1408,6 +1410,112 @@ void __fastcall DATATBLS_LoadTreasureClassExTxt(HD2ARCHIVE hArchive)
 	}
 
 	DATATBLS_UnloadBin(pTreasureClassExTxt);
+
+	// D2Moo only: the item type treasure classes are created before, their probabilities are final now too
+	for (int i = 0; i < sgptDataTables->nTreasureClassEx; ++i)
+	{
+		DATATBLS_BuildTreasureClassNoDropTable(&sgptDataTables->pTreasureClassEx[i]);
+	}
+}
+
+// Helper function
+int __fastcall DATATBLS_ComputeTreasureClassNoDrop(int nChance, int nNoDrop, uint32_t nPlayerCount)
+{
+	if (nPlayerCount <= 1)
+	{
+		return nNoDrop;
+	}
+
+	double noDropRatio = (double)nNoDrop / (double)(nChance + nNoDrop);
+	const double baseRatio = noDropRatio;
+
+	for (int32_t i = nPlayerCount - 1; i > 0; --i)
+	{
+		noDropRatio *= baseRatio;
+	}
+
+	const double inverseRatio = 1.0 - noDropRatio;
+	if (inverseRatio == 0.0)
+	{
+		return 0;
+	}
+
+	return (int32_t)((double)nChance / inverseRatio * (1.0 - inverseRatio));
+}
+
+// Helper function
+void __fastcall DATATBLS_BuildTreasureClassNoDropTable(D2TCExShortStrc* pTCExRecord)
+{
+	for (uint32_t nPlayerCount = 1; nPlayerCount <= TREASURECLASS_NODROP_MAX_PLAYERS; ++nPlayerCount)
+	{
+		pTCExRecord->nNoDropByPlayers[0][nPlayerCount - 1] = DATATBLS_ComputeTreasureClassNoDrop(pTCExRecord->nClassic, pTCExRecord->nNoDrop, nPlayerCount);
+		pTCExRecord->nNoDropByPlayers[1][nPlayerCount - 1] = DATATBLS_ComputeTreasureClassNoDrop(pTCExRecord->nProb, pTCExRecord->nNoDrop, nPlayerCount);
+	}
+}
+
+// Helper function
+int __fastcall DATATBLS_GetTreasureClassNoDrop(D2TCExShortStrc* pTCExRecord, BOOL bExpansion, uint32_t nPlayerCount)
+{
+	if (nPlayerCount >= 1 && nPlayerCount <= TREASURECLASS_NODROP_MAX_PLAYERS)
+	{
+		return pTCExRecord->nNoDropByPlayers[bExpansion ? 1 : 0][nPlayerCount - 1];
+	}
+
+	return DATATBLS_ComputeTreasureClassNoDrop(bExpansion ? pTCExRecord->nProb : pTCExRecord->nClassic, pTCExRecord->nNoDrop, nPlayerCount);
+}
+
+// Helper function
+int __fastcall DATATBLS_PickTreasureClassEntry(D2TCExShortStrc* pTCExRecord, BOOL bExpansion, int nRand)
+{
+	if (bExpansion)
+	{
+		int32_t nIndex = 0;
+		int32_t nLowerBound = 0;
+		int32_t nUpperBound = pTCExRecord->nTypes;
+		while (nLowerBound < nUpperBound)
+		{
+			nIndex = nLowerBound + (nUpperBound - nLowerBound) / 2;
+			if (nRand > pTCExRecord->pInfo[nIndex].nProb)
+			{
+				nLowerBound = nIndex + 1;
+			}
+			else if (nRand < pTCExRecord->pInfo[nIndex].nProb)
+			{
+				nUpperBound = nIndex;
+			}
+			else // nRand == pTCExRecord->pInfo[nIndex].nProb
+			{
+				break;
+			}
+		}
+
+		return std::max(nLowerBound - 1, 0);
+	}
+
+	// The original walks the entries until one that is not expansion only (0x10) and whose next cumulative probability is above nRand.
+	// The cumulative probabilities are sorted, so the first entry passing the second test is found by binary search instead.
+	int32_t nLowerBound = 0;
+	int32_t nUpperBound = pTCExRecord->nTypes - 1; // The last entry always passes
+	while (nLowerBound < nUpperBound)
+	{
+		const int32_t nMiddle = nLowerBound + (nUpperBound - nLowerBound) / 2;
+		if (pTCExRecord->pInfo[nMiddle + 1].nClassic > nRand)
+		{
+			nUpperBound = nMiddle;
+		}
+		else
+		{
+			nLowerBound = nMiddle + 1;
+		}
+	}
+
+	int32_t nIndex = nLowerBound;
+	while (nIndex < pTCExRecord->nTypes && (pTCExRecord->pInfo[nIndex].nFlags & 0x10))
+	{
+		++nIndex;
+	}
+
+	return nIndex;
 }
 
 //D2Common.0x6FD69B70 (#10656)
@@ -2669,7 +2777,7 @@ void __fastcall DATATBLS_LoadMonEquipTxt(HD2ARCHIVE hArchive)
 			for (int j = 0; j < 3; ++j)
 			{
 				if (pMonEquipTxtRecord->nLoc[j] <= BODYLOC_NONE || pMonEquipTxtRecord->nLoc[j] >= BODYLOC_SWRARM
-					|| pMonEquipTxtRecord->dwItem[j] != '    ' && FOG_GetLinkIndex(sgptDataTables->pItemsLinker, pMonEquipTxtRecord->dwItem[j], 1) < 0)
+					|| pMonEquipTxtRecord->dwItem[j] != '    ' && DATATBLS_GetLinkIndex(sgptDataTables->pItemsLinker, pMonEquipTxtRecord->dwItem[j], 1) < 0)
 				{
 					pMonEquipTxtRecord->nLoc[j] = BODYLOC_NONE;
 				}
@@ -899,6 +899,9 @@ void __fastcall DATATBLS_UnloadSkills_SkillDescTxt()
 	}
 	sgptDataTables->nPassiveSkills = 0;
 
+	DATATBLS_FreeCalcProgramCache(&sgptDataTables->pSkillsCodePrograms);
+	DATATBLS_FreeCalcProgramCache(&sgptDataTables->pSkillDescCodePrograms);
+
 	if (sgptDataTables->pSkillsCode)
 	{
 		D2_FREE_POOL(nullptr, sgptDataTables->pSkillsCode);
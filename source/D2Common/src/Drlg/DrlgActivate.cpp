@@ -6,10 +6,11 @@
 #include "Drlg/D2DrlgRoomTile.h"
 #include <DataTbls/LevelsIds.h>
 
-static int gStatsClientFreedRooms;
-static int gStatsClientAllocatedRooms;
-static int gStatsFreedRooms;
-static int gStatsAllocatedRooms;
+// D2Moo: written with InterlockedExchange, the drlgs of different games may be updated in parallel
+static volatile LONG gStatsClientFreedRooms;
+static volatile LONG gStatsClientAllocatedRooms;
+static volatile LONG gStatsFreedRooms;
+static volatile LONG gStatsAllocatedRooms;
 
 // D2Common.0x6FDE07B0
 static void (__fastcall* gRoomExSetStatus[ROOMSTATUS_COUNT])(D2DrlgRoomStrc*) =
@@ -407,13 +408,13 @@ void __stdcall DRLGACTIVATE_Update(D2DrlgStrc* pDrlg)
 {
 	if (DRLG_IsOnClient(pDrlg))
 	{
-		gStatsClientAllocatedRooms = pDrlg->nAllocatedRooms;
-		gStatsClientFreedRooms = pDrlg->nFreedRooms;
+		InterlockedExchange(&gStatsClientAllocatedRooms, pDrlg->nAllocatedRooms);
+		InterlockedExchange(&gStatsClientFreedRooms, pDrlg->nFreedRooms);
 	}
 	else
 	{
-		gStatsAllocatedRooms = pDrlg->nAllocatedRooms;
-		gStatsFreedRooms = pDrlg->nFreedRooms;
+		InterlockedExchange(&gStatsAllocatedRooms, pDrlg->nAllocatedRooms);
+		InterlockedExchange(&gStatsFreedRooms, pDrlg->nFreedRooms);
 	}
 
 	if (pDrlg->nRoomsInitSinceLastUpdate > 1)
@@ -9,6 +9,7 @@
 #include "Drlg/D2DrlgOutdoors.h"
 #include "Drlg/D2DrlgOutPlace.h"
 #include "Drlg/D2DrlgPreset.h"
+#include "Drlg/D2DrlgRoomIndex.h"
 #include "Drlg/D2DrlgRoomTile.h"
 #include "D2Dungeon.h"
 #include "D2Seed.h"
@@ -155,6 +156,8 @@ void __fastcall DRLG_FreeLevel(void* pMemPool, D2DrlgLevelStrc* pLevel, BOOL bAl
 		}
 	}
 
+	DRLGROOMINDEX_Invalidate(pLevel);
+
 	pNextRoomEx = pLevel->pFirstRoomEx;
 	if (pNextRoomEx)
 	{
@@ -605,6 +608,9 @@ void __stdcall DRLG_InitLevel(D2DrlgLevelStrc* pLevel)
 		return;
 	}
 
+	// D2Moo only: the index may have been built while the rooms were generated
+	DRLGROOMINDEX_Invalidate(pLevel);
+
 	if (pLevel->nRooms && pLevel->pPresetMaps)
 	{
 		int nCounter = 0;
@@ -706,6 +712,8 @@ void __fastcall DRLG_UpdateRoomExCoordinates(D2DrlgLevelStrc* pLevel)
 		FOG_DisplayWarning("ptCoordsLevel->nSizeTileY >= nTileMaxY - nTileMinY", __FILE__, __LINE__);
 	}
 
+	DRLGROOMINDEX_Invalidate(pLevel);
+
 	pDrlgRoom = pLevel->pFirstRoomEx;
 	while (pDrlgRoom)
 	{
@@ -731,6 +739,12 @@ D2DrlgRoomStrc* __fastcall DRLG_GetRoomExFromLevelAndCoordinates(D2DrlgLevelStrc
 		FOG_DisplayWarning("ptDrlgLevel->ptRoomFirst", __FILE__, __LINE__);
 	}
 
+	// D2Moo only: look in the cell of the position instead of every room of the level
+	if (D2DrlgRoomIndexStrc* pIndex = DRLGROOMINDEX_GetIndex(pLevel))
+	{
+		return DRLGROOMINDEX_FindRoom(pIndex, nX, nY);
+	}
+
 	pDrlgRoom = pLevel->pFirstRoomEx;
 	while (pDrlgRoom)
 	{
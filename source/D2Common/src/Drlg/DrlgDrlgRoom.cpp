@@ -6,6 +6,7 @@
 #include "Drlg/D2DrlgDrlgWarp.h"
 #include "Drlg/D2DrlgOutRoom.h"
 #include "Drlg/D2DrlgPreset.h"
+#include "Drlg/D2DrlgRoomIndex.h"
 #include "Drlg/D2DrlgRoomTile.h"
 #include "D2Dungeon.h"
 #include "D2Seed.h"
@@ -170,6 +171,8 @@ void __fastcall DRLGROOM_FreeRoomEx(D2DrlgRoomStrc* pDrlgRoom)
 		D2_FREE_POOL(pMemPool, pDrlgOrth);
 	}
 
+	DRLGROOMINDEX_Invalidate(pDrlgRoom->pLevel);
+
 	pCurrentRoomEx = pDrlgRoom->pLevel->pFirstRoomEx;
 	if (pCurrentRoomEx == pDrlgRoom)
 	{
@@ -502,6 +505,8 @@ BOOL __fastcall DRLGMAZE_CheckRoomNotOverlaping(D2DrlgLevelStrc* pLevel, D2DrlgR
 //D2Common.0x6FD77910
 void __fastcall DRLGROOM_AddRoomExToLevel(D2DrlgLevelStrc* pLevel, D2DrlgRoomStrc* pDrlgRoom)
 {
+	DRLGROOMINDEX_Invalidate(pLevel);
+
 	pDrlgRoom->pDrlgRoomNext = pLevel->pFirstRoomEx;
 	pLevel->pFirstRoomEx = pDrlgRoom;
 	++pLevel->nRooms;
@@ -4,6 +4,7 @@
 #include "Drlg/D2DrlgDrlg.h"
 #include "Drlg/D2DrlgDrlgRoom.h"
 #include "Drlg/D2DrlgPreset.h"
+#include "Drlg/D2DrlgRoomIndex.h"
 #include "D2Seed.h"
 #include <DataTbls/LevelsIds.h>
 
@@ -1169,6 +1170,9 @@ BOOL __fastcall DRLGMAZE_LinkMazeRooms(D2DrlgRoomStrc* pDrlgRoom1, D2DrlgRoomStr
 		break;
 	}
 	
+	// D2Moo only: pDrlgRoom1 moved
+	DRLGROOMINDEX_Invalidate(pDrlgRoom1->pLevel);
+
 	for (D2DrlgOrthStrc* pDrlgOrth = pDrlgRoom2->pDrlgOrth; pDrlgOrth; pDrlgOrth = pDrlgOrth->pNext)
 	{
 		if (!DRLG_ComputeRectanglesManhattanDistance(&pDrlgRoom1->pDrlgCoord, pDrlgOrth->pBox, 0))
@@ -2861,6 +2865,9 @@ void __fastcall DRLGMAZE_PlaceAct1Barracks(D2DrlgLevelStrc* pLevel)
 		i->nTileYPos += nY;
 	}
 
+	// D2Moo only: every room of the level moved
+	DRLGROOMINDEX_Invalidate(pLevel);
+
 	DRLG_GetMinAndMaxCoordinatesFromLevel(pLevel, &nTileMinX, &nTileMinY, &nTileMaxX, &nTileMaxY);
 	pLevel->nPosX = nTileMinX;
 	pLevel->nPosY = nTileMinY;
@@ -2945,6 +2952,9 @@ void __fastcall DRLGMAZE_PlaceAct4Lava(D2DrlgLevelStrc* pLevel)
 			i->nTileYPos += nY;
 		}
 
+		// D2Moo only: every room of the level moved
+		DRLGROOMINDEX_Invalidate(pLevel);
+
 		int nMinX, nMinY, nMaxX, nMaxY;
 		DRLG_GetMinAndMaxCoordinatesFromLevel(pLevel, &nMinX, &nMinY, &nMaxX, &nMaxY);
 
@@ -23,7 +23,8 @@
 #include <cmath>
 #include <algorithm>
 
-int dword_6FDEA6FC;
+// D2Moo: per thread, it is set and read while linking the act IV levels, and games may create their acts in parallel
+thread_local int dword_6FDEA6FC;
 
 //D2Common.0x6FDCFE40
 static D2DrlgLinkStrc gAct1WildernessDrlgLink[15] =
@@ -0,0 +1,164 @@
+#include "Drlg/D2DrlgRoomIndex.h"
+
+#include "Drlg/D2DrlgDrlg.h"
+#include "Drlg/D2DrlgDrlgRoom.h"
+
+
+// Helper function: Computes the grid of the level without building it, returns the number of room entries
+static int DRLGROOMINDEX_ComputeGrid(D2DrlgLevelStrc* pLevel, D2DrlgRoomIndexStrc* pIndex)
+{
+	int nTileMinX = 0;
+	int nTileMinY = 0;
+	int nTileMaxX = 0;
+	int nTileMaxY = 0;
+	if (pLevel->pFirstRoomEx)
+	{
+		DRLG_GetMinAndMaxCoordinatesFromLevel(pLevel, &nTileMinX, &nTileMinY, &nTileMaxX, &nTileMaxY);
+	}
+
+	pIndex->nOriginX = nTileMinX;
+	pIndex->nOriginY = nTileMinY;
+	pIndex->nCellSizeShift = DRLGROOMINDEX_CELL_SIZE_SHIFT;
+	while (true)
+	{
+		pIndex->nCellsX = ((nTileMaxX - nTileMinX) >> pIndex->nCellSizeShift) + 1;
+		pIndex->nCellsY = ((nTileMaxY - nTileMinY) >> pIndex->nCellSizeShift) + 1;
+		if ((int64_t)pIndex->nCellsX * pIndex->nCellsY <= DRLGROOMINDEX_MAX_CELLS)
+		{
+			break;
+		}
+		++pIndex->nCellSizeShift;
+	}
+
+	int nEntries = 0;
+	for (D2DrlgRoomStrc* pDrlgRoom = pLevel->pFirstRoomEx; pDrlgRoom; pDrlgRoom = pDrlgRoom->pDrlgRoomNext)
+	{
+		if (pDrlgRoom->nTileWidth > 0 && pDrlgRoom->nTileHeight > 0)
+		{
+			const int nCellMinX = (pDrlgRoom->nTileXPos - pIndex->nOriginX) >> pIndex->nCellSizeShift;
+			const int nCellMinY = (pDrlgRoom->nTileYPos - pIndex->nOriginY) >> pIndex->nCellSizeShift;
+			const int nCellMaxX = (pDrlgRoom->nTileXPos + pDrlgRoom->nTileWidth - 1 - pIndex->nOriginX) >> pIndex->nCellSizeShift;
+			const int nCellMaxY = (pDrlgRoom->nTileYPos + pDrlgRoom->nTileHeight - 1 - pIndex->nOriginY) >> pIndex->nCellSizeShift;
+			nEntries += (nCellMaxX - nCellMinX + 1) * (nCellMaxY - nCellMinY + 1);
+		}
+	}
+
+	return nEntries;
+}
+
+// Helper function
+size_t __fastcall DRLGROOMINDEX_GetIndexSize(D2DrlgLevelStrc* pLevel)
+{
+	D2DrlgRoomIndexStrc tIndex = {};
+	const int nEntries = DRLGROOMINDEX_ComputeGrid(pLevel, &tIndex);
+	return sizeof(D2DrlgRoomIndexStrc) + sizeof(int32_t) * (tIndex.nCellsX * tIndex.nCellsY + 1) + sizeof(D2DrlgRoomStrc*) * nEntries;
+}
+
+// Helper function
+D2DrlgRoomIndexStrc* __fastcall DRLGROOMINDEX_BuildIndex(D2DrlgLevelStrc* pLevel, void* pBuffer)
+{
+	D2DrlgRoomIndexStrc* pIndex = (D2DrlgRoomIndexStrc*)pBuffer;
+	DRLGROOMINDEX_ComputeGrid(pLevel, pIndex);
+
+	const int nCells = pIndex->nCellsX * pIndex->nCellsY;
+	pIndex->pCellStarts = (int32_t*)&pIndex[1];
+	pIndex->ppRooms = (D2DrlgRoomStrc**)&pIndex->pCellStarts[nCells + 1];
+	memset(pIndex->pCellStarts, 0x00, sizeof(int32_t) * (nCells + 1));
+
+	// Counts the rooms of each cell, then fills the cells in the order of the level
+	for (int nPass = 0; nPass < 2; ++nPass)
+	{
+		for (D2DrlgRoomStrc* pDrlgRoom = pLevel->pFirstRoomEx; pDrlgRoom; pDrlgRoom = pDrlgRoom->pDrlgRoomNext)
+		{
+			if (pDrlgRoom->nTileWidth <= 0 || pDrlgRoom->nTileHeight <= 0)
+			{
+				continue;
+			}
+
+			const int nCellMinX = (pDrlgRoom->nTileXPos - pIndex->nOriginX) >> pIndex->nCellSizeShift;
+			const int nCellMinY = (pDrlgRoom->nTileYPos - pIndex->nOriginY) >> pIndex->nCellSizeShift;
+			const int nCellMaxX = (pDrlgRoom->nTileXPos + pDrlgRoom->nTileWidth - 1 - pIndex->nOriginX) >> pIndex->nCellSizeShift;
+			const int nCellMaxY = (pDrlgRoom->nTileYPos + pDrlgRoom->nTileHeight - 1 - pIndex->nOriginY) >> pIndex->nCellSizeShift;
+			for (int nCellY = nCellMinY; nCellY <= nCellMaxY; ++nCellY)
+			{
+				for (int nCellX = nCellMinX; nCellX <= nCellMaxX; ++nCellX)
+				{
+					const int nCell = nCellX + nCellY * pIndex->nCellsX;
+					if (nPass == 0)
+					{
+						++pIndex->pCellStarts[nCell + 1];
+					}
+					else
+					{
+						pIndex->ppRooms[pIndex->pCellStarts[nCell]++] = pDrlgRoom;
+					}
+				}
+			}
+		}
+
+		if (nPass == 0)
+		{
+			for (int i = 0; i < nCells; ++i)
+			{
+				pIndex->pCellStarts[i + 1] += pIndex->pCellStarts[i];
+			}
+		}
+	}
+
+	// The second pass moved each start to the end of its cell, which is the start of the next one
+	for (int i = nCells; i > 0; --i)
+	{
+		pIndex->pCellStarts[i] = pIndex->pCellStarts[i - 1];
+	}
+	pIndex->pCellStarts[0] = 0;
+
+	return pIndex;
+}
+
+// Helper function
+D2DrlgRoomStrc* __fastcall DRLGROOMINDEX_FindRoom(const D2DrlgRoomIndexStrc* pIndex, int nX, int nY)
+{
+	if (nX < pIndex->nOriginX || nY < pIndex->nOriginY)
+	{
+		return nullptr;
+	}
+
+	const int nCellX = (nX - pIndex->nOriginX) >> pIndex->nCellSizeShift;
+	const int nCellY = (nY - pIndex->nOriginY) >> pIndex->nCellSizeShift;
+	if (nCellX >= pIndex->nCellsX || nCellY >= pIndex->nCellsY)
+	{
+		return nullptr;
+	}
+
+	const int nCell = nCellX + nCellY * pIndex->nCellsX;
+	for (int i = pIndex->pCellStarts[nCell]; i < pIndex->pCellStarts[nCell + 1]; ++i)
+	{
+		if (DRLGROOM_AreXYInsideCoordinates(&pIndex->ppRooms[i]->pDrlgCoord, nX, nY))
+		{
+			return pIndex->ppRooms[i];
+		}
+	}
+
+	return nullptr;
+}
+
+// Helper function
+D2DrlgRoomIndexStrc* __fastcall DRLGROOMINDEX_GetIndex(D2DrlgLevelStrc* pLevel)
+{
+	if (!pLevel->pRoomIndex && pLevel->pFirstRoomEx)
+	{
+		pLevel->pRoomIndex = DRLGROOMINDEX_BuildIndex(pLevel, D2_ALLOC_POOL(pLevel->pDrlg->pMempool, DRLGROOMINDEX_GetIndexSize(pLevel)));
+	}
+
+	return pLevel->pRoomIndex;
+}
+
+// Helper function
+void __fastcall DRLGROOMINDEX_Invalidate(D2DrlgLevelStrc* pLevel)
+{
+	if (pLevel->pRoomIndex)
+	{
+		D2_FREE_POOL(pLevel->pDrlg->pMempool, pLevel->pRoomIndex);
+		pLevel->pRoomIndex = nullptr;
+	}
+}
@@ -4347,7 +4347,7 @@ int __stdcall ITEMMODS_EvaluateItemFormula(D2UnitStrc* pUnit, D2UnitStrc* pItem,
 		pItemCalc.pUnit = pUnit;
 		pItemCalc.pItem = pItem;
 
-		return DATATBLS_CalcEvaluateExpression(&sgptDataTables->pItemsCode[nCalc], sgptDataTables->nItemsCodeSize - nCalc, ITEMMODS_GetCalcParamValue_Return0, off_6FDE3BA0, dword_6FDE3BC0, &pItemCalc);
+		return DATATBLS_EvaluateCalcProgram(&sgptDataTables->pItemsCodePrograms, sgptDataTables->pItemsCode, sgptDataTables->nItemsCodeSize, nCalc, ITEMMODS_GetCalcParamValue_Return0, off_6FDE3BA0, dword_6FDE3BC0, &pItemCalc);
 	}
 
 	return 0;
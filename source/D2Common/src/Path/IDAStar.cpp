@@ -7,6 +7,7 @@
 #include "D2Collision.h"
 #include "D2Dungeon.h"
 #include <cmath>
+#include <memory>
 
 //1.10f: D2Common.0x6FDD1D60
 //1.13c: D2Common.0x6FDDF508
@@ -35,55 +36,72 @@ int32_t dword_6FDD1BE0[8][8] = {
     { 0, 7, 2, 5, 7, 5, 2, 7},
 };
 
+// Helper function
+D2PathIDAStarContextStrc* __fastcall PATH_IDAStar_GetThreadContext()
+{
+    // Allocated outside of the memory pools since it is shared by all the games handled by this thread
+    static thread_local std::unique_ptr<D2PathIDAStarContextStrc> pThreadContext;
+    if (!pThreadContext)
+    {
+        pThreadContext = std::make_unique<D2PathIDAStarContextStrc>();
+    }
+    return pThreadContext.get();
+}
+
+// Helper function
+static int32_t* PATH_IDAStar_GetBestDistanceFromStart(D2PathIDAStarContextStrc* pContext, int nDataIndex)
+{
+    D2PathIDAStarCoordDataStrc* pCoordData = &pContext->aCoordData[nDataIndex];
+    if (pCoordData->nGeneration != pContext->nGeneration)
+    {
+        pCoordData->nGeneration = pContext->nGeneration;
+        pCoordData->nBestDistanceFromStart = 0;
+    }
+    return &pCoordData->nBestDistanceFromStart;
+}
+
 //1.10f: Inlined
 //1.13c: D2Common.0x6FDC0BB0
 int __fastcall PATH_IdaStar_ComputePathWithRooms(D2DrlgCoordsStrc* pRoomCoords, D2PathInfoStrc* pPathInfo)
 {
     D2_ASSERT(pRoomCoords->nSubtileHeight * pRoomCoords->nSubtileWidth <= IDASTAR_MAXPROOM);
-    D2PathIDAStarContextStrc tContext;
-    const int nAreaMargin = 6;
-    const int nMaxNodes = (pRoomCoords->nSubtileHeight + nAreaMargin) * (pRoomCoords->nSubtileWidth + nAreaMargin);
-    memset(tContext.aCoordData, 0, sizeof(int32_t) * nMaxNodes); // Note, may overflow since assert does not take margin into account.
-    tContext.nCoord[0].Y = pRoomCoords->nSubtileY;
-    tContext.nCoord[0].X = pRoomCoords->nSubtileX;
-    tContext.nCoord[1].X = pRoomCoords->nSubtileX + pRoomCoords->nSubtileWidth;
-    tContext.nCoord[1].Y = pRoomCoords->nSubtileY + tContext.nCoord[2].Y;
-    tContext.nCoord[2].X = pRoomCoords->nSubtileWidth;
-    tContext.nCoord[2].Y = pRoomCoords->nSubtileHeight;
-    tContext.nStride = pRoomCoords->nSubtileWidth + 6;
-    tContext.nYOffset = -(pRoomCoords->nSubtileY - 3);
-    tContext.nXOffset = -(pRoomCoords->nSubtileX - 3);
-    tContext.bRandomDirection = FALSE;
+    D2PathIDAStarContextStrc* pContext = PATH_IDAStar_GetThreadContext();
+    // Invalidates the distances of the previous path. Note that the original game only cleared (nSubtileHeight + 6) * (nSubtileWidth + 6) entries.
+    if (++pContext->nGeneration == 0)
+    {
+        memset(pContext->aCoordData, 0, sizeof(pContext->aCoordData));
+        pContext->nGeneration = 1;
+    }
+    pContext->nCoord[0].Y = pRoomCoords->nSubtileY;
+    pContext->nCoord[0].X = pRoomCoords->nSubtileX;
+    pContext->nCoord[1].X = pRoomCoords->nSubtileX + pRoomCoords->nSubtileWidth;
+    pContext->nCoord[1].Y = pRoomCoords->nSubtileY + pContext->nCoord[2].Y;
+    pContext->nCoord[2].X = pRoomCoords->nSubtileWidth;
+    pContext->nCoord[2].Y = pRoomCoords->nSubtileHeight;
+    pContext->nStride = pRoomCoords->nSubtileWidth + 6;
+    pContext->nYOffset = -(pRoomCoords->nSubtileY - 3);
+    pContext->nXOffset = -(pRoomCoords->nSubtileX - 3);
+    pContext->bRandomDirection = FALSE;
 
     if (pPathInfo->nPathType == PATHTYPE_MISSILE_STREAM)
     {
-        tContext.bRandomDirection = 1;
-        tContext.pSeed = &pPathInfo->pDynamicPath->pUnit->pSeed;
+        pContext->bRandomDirection = 1;
+        pContext->pSeed = &pPathInfo->pDynamicPath->pUnit->pSeed;
     }
     D2PathPointStrc tStartCoord = pPathInfo->tStartCoord;
     D2PathPointStrc tTargetCoord = pPathInfo->tTargetCoord;
 
-    D2PathIDAStarNodeStrc tStartNode;
-    tStartNode.nBestDistanceFromStart = 0;
-    tStartNode.nHeuristicDistanceToTarget = PATH_FoWall_Heuristic(tStartCoord, tTargetCoord);
-    tStartNode.nFScore = tStartNode.nHeuristicDistanceToTarget;
-    tStartNode.tCoord = tStartCoord;
-    tStartNode.nEvaluationsCount = -3;
-    tStartNode.pNeighborsSequence = dword_6FDD1BE0[0];
-    tStartNode.pBestChild = 0;
-    tStartNode.pParent = 0;
-    tStartNode.nNextNeighborIndex = sub_6FDAB770(tStartCoord, tTargetCoord) & 7;
-
-    memset(&tContext.aNodesStorage[0], 0, sizeof(tContext.aNodesStorage[0]));
-    tContext.nNodesCount = 1;
-    tContext.pCurrentNode = &tContext.aNodesStorage[0];
+    const uint16_t nStartHeuristicDistanceToTarget = PATH_FoWall_Heuristic(tStartCoord, tTargetCoord);
+    const uint8_t nStartNextNeighborIndex = sub_6FDAB770(tStartCoord, tTargetCoord) & 7;
+
+    pContext->nNodesCount = 1;
     
     int16_t nMaxFScore;
     int16_t nFScoreCutoff;
     switch (pPathInfo->nPathType)
     {
     case PATHTYPE_MISSILE_STREAM:
-        nFScoreCutoff = tStartNode.nHeuristicDistanceToTarget + tStartNode.nHeuristicDistanceToTarget / 2;
+        nFScoreCutoff = nStartHeuristicDistanceToTarget + nStartHeuristicDistanceToTarget / 2;
         nMaxFScore = pPathInfo->nMinimumFScoreToEvaluate;
         if (nFScoreCutoff > nMaxFScore)
         {
@@ -91,36 +109,47 @@ int __fastcall PATH_IdaStar_ComputePathWithRooms(D2DrlgCoordsStrc* pRoomCoords,
         }
         break;
     case PATHTYPE_IDASTAR:
-        nFScoreCutoff = tStartNode.nHeuristicDistanceToTarget;
+        nFScoreCutoff = nStartHeuristicDistanceToTarget;
         nMaxFScore = pPathInfo->nMinimumFScoreToEvaluate;
         if (nMaxFScore > pPathInfo->nMinimumFScoreToEvaluate)
         {
-            nMaxFScore = tStartNode.nHeuristicDistanceToTarget;
+            nMaxFScore = nStartHeuristicDistanceToTarget;
         }
         break;
     default:
-        nFScoreCutoff = tStartNode.nHeuristicDistanceToTarget;
-        nMaxFScore = tStartNode.nHeuristicDistanceToTarget;
+        nFScoreCutoff = nStartHeuristicDistanceToTarget;
+        nMaxFScore = nStartHeuristicDistanceToTarget;
         break;
     }
-    D2PathIDAStarNodeStrc* pValidPathNode = nullptr;
+
+    D2PathIDAStarNodesStrc* pNodes = &pContext->tNodes;
+    int32_t nValidPathNode = IDASTAR_INVALID_NODE;
     do
     {
-        *tContext.pCurrentNode = tStartNode;
-
-        pValidPathNode = PATH_IDAStar_VisitNodes(&tContext, nFScoreCutoff, pPathInfo);
+        // Root node is always the first one
+        pNodes->aBestDistanceFromStart[0] = 0;
+        pNodes->aHeuristicDistanceToTarget[0] = nStartHeuristicDistanceToTarget;
+        pNodes->aFScore[0] = nStartHeuristicDistanceToTarget;
+        pNodes->aCoord[0] = tStartCoord;
+        pNodes->aEvaluationsCount[0] = -3;
+        pNodes->aNeighborsSequence[0] = 0;
+        pNodes->aBestChild[0] = IDASTAR_INVALID_NODE;
+        pNodes->aParent[0] = IDASTAR_INVALID_NODE;
+        pNodes->aNextNeighborIndex[0] = nStartNextNeighborIndex;
+
+        nValidPathNode = PATH_IDAStar_VisitNodes(pContext, nFScoreCutoff, pPathInfo);
         nFScoreCutoff += 5;
-        if (!pValidPathNode && tContext.nNodesCount == ARRAY_SIZE(tContext.aNodesStorage))
+        if (nValidPathNode == IDASTAR_INVALID_NODE && pContext->nNodesCount == IDASTAR_MAXNODES)
             break;
-        tContext.nNodesCount = 1;
-        if (pValidPathNode)
+        pContext->nNodesCount = 1;
+        if (nValidPathNode != IDASTAR_INVALID_NODE)
             break;
     } while (nFScoreCutoff < nMaxFScore);
 
     int nPathPoints = 0;
-    if (pValidPathNode)
+    if (nValidPathNode != IDASTAR_INVALID_NODE)
     {
-        nPathPoints = PATH_IDAStar_FlushNodeToDynamicPath(pValidPathNode, pPathInfo);
+        nPathPoints = PATH_IDAStar_FlushNodeToDynamicPath(pContext, nValidPathNode, pPathInfo);
         if (nPathPoints >= D2DynamicPathStrc::MAXPATHLEN)
             nPathPoints = 0;
     }
@@ -189,42 +218,53 @@ int __fastcall PATH_IdaStar_6FDA7970(D2PathInfoStrc* pPathInfo)
 
 //1.10f: Inlined
 //1.13c: Inlined
-D2PathIDAStarNodeStrc* __fastcall PATH_IDAStar_GetNewNode(D2PathIDAStarContextStrc* pContext)
+static int32_t __fastcall PATH_IDAStar_GetNewNode(D2PathIDAStarContextStrc* pContext)
 {
-    if (pContext->nNodesCount == ARRAY_SIZE(pContext->aNodesStorage))
+    if (pContext->nNodesCount == IDASTAR_MAXNODES)
     {
-        return nullptr;
+        return IDASTAR_INVALID_NODE;
     }
-    D2PathIDAStarNodeStrc* pNewNode = &pContext->aNodesStorage[pContext->nNodesCount++];
-    memset(pNewNode, 0, sizeof(*pNewNode));
-    return pNewNode;
+    const int32_t nNewNode = pContext->nNodesCount++;
+    D2PathIDAStarNodesStrc* pNodes = &pContext->tNodes;
+    pNodes->aFScore[nNewNode] = 0;
+    pNodes->aHeuristicDistanceToTarget[nNewNode] = 0;
+    pNodes->aBestDistanceFromStart[nNewNode] = 0;
+    pNodes->aEvaluationsCount[nNewNode] = 0;
+    pNodes->aParent[nNewNode] = IDASTAR_INVALID_NODE;
+    pNodes->aBestChild[nNewNode] = IDASTAR_INVALID_NODE;
+    pNodes->aNeighborsSequence[nNewNode] = 0;
+    pNodes->aNextNeighborIndex[nNewNode] = 0;
+    pNodes->aCoord[nNewNode] = {};
+    return nNewNode;
 }
 
 //1.10f: D2Common.0x6FDA7D40
 //1.13c: D2Common.0x6FDC08F0
-D2PathIDAStarNodeStrc* __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextStrc* pContext, int nFScoreCutoff, D2PathInfoStrc* pPathInfo)
+int32_t __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextStrc* pContext, int nFScoreCutoff, D2PathInfoStrc* pPathInfo)
 {
-    D2PathIDAStarNodeStrc* pCurrentNode = pContext->pCurrentNode;
+    D2PathIDAStarNodesStrc* pNodes = &pContext->tNodes;
+    int32_t nCurrentNode = 0;
     int nIterations = 0;
-    while (pCurrentNode->tCoord != pPathInfo->tTargetCoord)
+    while (pNodes->aCoord[nCurrentNode] != pPathInfo->tTargetCoord)
     {
         if (++nIterations > 10000)
         {
-            return nullptr;
+            return IDASTAR_INVALID_NODE;
         }
 
-        if (pCurrentNode->tCoord.X < pContext->nCoord[0].X || pCurrentNode->tCoord.X > pContext->nCoord[1].X
-         || pCurrentNode->tCoord.Y < pContext->nCoord[0].Y || pCurrentNode->tCoord.Y > pContext->nCoord[1].Y)
+        const D2PathPointStrc tCurrentCoord = pNodes->aCoord[nCurrentNode];
+        if (tCurrentCoord.X < pContext->nCoord[0].X || tCurrentCoord.X > pContext->nCoord[1].X
+         || tCurrentCoord.Y < pContext->nCoord[0].Y || tCurrentCoord.Y > pContext->nCoord[1].Y)
         {
             break;
         }
 
         D2PathPointStrc tNeighborCoords;
-        tNeighborCoords.X = pCurrentNode->tCoord.X + aCoordOffsets[pCurrentNode->nNextNeighborIndex].nX;
-        tNeighborCoords.Y = pCurrentNode->tCoord.Y + aCoordOffsets[pCurrentNode->nNextNeighborIndex].nY;
+        tNeighborCoords.X = tCurrentCoord.X + aCoordOffsets[pNodes->aNextNeighborIndex[nCurrentNode]].nX;
+        tNeighborCoords.Y = tCurrentCoord.Y + aCoordOffsets[pNodes->aNextNeighborIndex[nCurrentNode]].nY;
 
         const int nDataIndex = tNeighborCoords.X + pContext->nXOffset + pContext->nStride * (tNeighborCoords.Y + pContext->nYOffset);
-        int* pNeighborBestDistanceToStart = &pContext->aCoordData[nDataIndex];
+        int* pNeighborBestDistanceToStart = PATH_IDAStar_GetBestDistanceFromStart(pContext, nDataIndex);
         
         bool bShouldEvaluateNextNeighbor = true;
         bool bMayEvaluateNode = true;
@@ -244,8 +284,8 @@ D2PathIDAStarNodeStrc* __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextSt
 
         if(bMayEvaluateNode)
         {
-            const int16_t nDistanceBetweenPoints = PATH_FoWall_HeuristicForNeighbor(pCurrentNode->tCoord, tNeighborCoords);
-            const int16_t nNewDistanceFromStart = nDistanceBetweenPoints + pCurrentNode->nBestDistanceFromStart;
+            const int16_t nDistanceBetweenPoints = PATH_FoWall_HeuristicForNeighbor(tCurrentCoord, tNeighborCoords);
+            const int16_t nNewDistanceFromStart = nDistanceBetweenPoints + pNodes->aBestDistanceFromStart[nCurrentNode];
             if (*pNeighborBestDistanceToStart == 0 || (unsigned int)nNewDistanceFromStart >= *pNeighborBestDistanceToStart )
             {
                 *pNeighborBestDistanceToStart = nNewDistanceFromStart;
@@ -254,28 +294,29 @@ D2PathIDAStarNodeStrc* __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextSt
                 const int16_t nNewNodeFSCore = nHeuristicDistanceToTarget + nNewDistanceFromStart;
                 if (nNewNodeFSCore <= nFScoreCutoff)
                 {
-                    if (!pCurrentNode->pBestChild)
+                    if (pNodes->aBestChild[nCurrentNode] == IDASTAR_INVALID_NODE)
                     {
-                        D2PathIDAStarNodeStrc* pNewSubposition = PATH_IDAStar_GetNewNode(pContext);
-                        pCurrentNode->pBestChild = pNewSubposition;
-                        if (!pNewSubposition)
+                        const int32_t nNewSubposition = PATH_IDAStar_GetNewNode(pContext);
+                        pNodes->aBestChild[nCurrentNode] = nNewSubposition;
+                        if (nNewSubposition == IDASTAR_INVALID_NODE)
                         {
-                            return nullptr;
+                            return IDASTAR_INVALID_NODE;
                         }
-                        pNewSubposition->pParent = pCurrentNode;
+                        pNodes->aParent[nNewSubposition] = nCurrentNode;
                     }
-                    pCurrentNode = pCurrentNode->pBestChild;
-                    pCurrentNode->tCoord = tNeighborCoords;
-                    pCurrentNode->nBestDistanceFromStart = nNewDistanceFromStart;
-                    pCurrentNode->nFScore = nNewNodeFSCore;
-                    pCurrentNode->nHeuristicDistanceToTarget = nHeuristicDistanceToTarget;
-                    pCurrentNode->nEvaluationsCount = 0;
-                    pCurrentNode->pNeighborsSequence = dword_6FDD1BE0[(sub_6FDAB770(tNeighborCoords, pPathInfo->tTargetCoord) - pCurrentNode->pParent->nNextNeighborIndex) & 7];
-                    PATH_IDAStar_GetNextNeighborIndex(pCurrentNode, pContext);
-
-                    if ((__int16)pCurrentNode->nHeuristicDistanceToTarget < pPathInfo->field_14)
+                    nCurrentNode = pNodes->aBestChild[nCurrentNode];
+                    pNodes->aCoord[nCurrentNode] = tNeighborCoords;
+                    pNodes->aBestDistanceFromStart[nCurrentNode] = nNewDistanceFromStart;
+                    pNodes->aFScore[nCurrentNode] = nNewNodeFSCore;
+                    pNodes->aHeuristicDistanceToTarget[nCurrentNode] = nHeuristicDistanceToTarget;
+                    pNodes->aEvaluationsCount[nCurrentNode] = 0;
+                    const int32_t nParentNextNeighborIndex = pNodes->aNextNeighborIndex[pNodes->aParent[nCurrentNode]];
+                    pNodes->aNeighborsSequence[nCurrentNode] = (uint8_t)(((sub_6FDAB770(tNeighborCoords, pPathInfo->tTargetCoord) - nParentNextNeighborIndex) & 7) * ARRAY_SIZE(dword_6FDD1BE0[0]));
+                    PATH_IDAStar_GetNextNeighborIndex(nCurrentNode, pContext);
+
+                    if ((__int16)pNodes->aHeuristicDistanceToTarget[nCurrentNode] < pPathInfo->field_14)
                     {
-                        return pCurrentNode;
+                        return nCurrentNode;
                     }
                     bShouldEvaluateNextNeighbor = false;
                 }
@@ -284,14 +325,14 @@ D2PathIDAStarNodeStrc* __fastcall PATH_IDAStar_VisitNodes(D2PathIDAStarContextSt
 
         if (bShouldEvaluateNextNeighbor)
         {
-            pCurrentNode = sub_6FDC0840(pCurrentNode, pContext);
-            if (!pCurrentNode)
+            nCurrentNode = sub_6FDC0840(nCurrentNode, pContext);
+            if (nCurrentNode == IDASTAR_INVALID_NODE)
             {
-                return nullptr;
+                return IDASTAR_INVALID_NODE;
             }
         }
     }
-    return pCurrentNode;
+    return nCurrentNode;
 }
 
 // 1.10f: 0x6FDD1CE0
@@ -309,82 +350,87 @@ int dword_6FDD1CE0[32] = {
 
 //1.10c: D2Common.0x6FDA81C0
 //1.13f: D2Common.0x6FDC07E0
-void __fastcall PATH_IDAStar_GetNextNeighborIndex(D2PathIDAStarNodeStrc* pNode, D2PathIDAStarContextStrc* pContext)
+void __fastcall PATH_IDAStar_GetNextNeighborIndex(int32_t nNode, D2PathIDAStarContextStrc* pContext)
 {
+	D2PathIDAStarNodesStrc* pNodes = &pContext->tNodes;
+	const int32_t nNeighborsSequence = (&dword_6FDD1BE0[0][0])[pNodes->aNeighborsSequence[nNode]];
 	if (pContext->bRandomDirection)
 	{
 		const uint64_t nRand = SEED_RollRandomNumber(pContext->pSeed);
-		pNode->nNextNeighborIndex = ((unsigned __int8)pNode->nNextNeighborIndex
-			+ (unsigned __int8)*pNode->pNeighborsSequence
+		pNodes->aNextNeighborIndex[nNode] = ((unsigned __int8)pNodes->aNextNeighborIndex[nNode]
+			+ (unsigned __int8)nNeighborsSequence
 			+ (unsigned __int8)dword_6FDD1CE0[nRand & 0x1F]) & 7;
 	}
 	else
 	{
-		pNode->nNextNeighborIndex = (pNode->nNextNeighborIndex + *pNode->pNeighborsSequence) & 7;
+		pNodes->aNextNeighborIndex[nNode] = (pNodes->aNextNeighborIndex[nNode] + nNeighborsSequence) & 7;
 	}
 }
 
 //1.10f: Inlined
 //1.13c: D2Common.0x6FDC0840
-D2PathIDAStarNodeStrc* __fastcall sub_6FDC0840(D2PathIDAStarNodeStrc* pNode, D2PathIDAStarContextStrc* pContext)
+int32_t __fastcall sub_6FDC0840(int32_t nNode, D2PathIDAStarContextStrc* pContext)
 {
-    if (pNode->nEvaluationsCount < 4)
+    D2PathIDAStarNodesStrc* pNodes = &pContext->tNodes;
+    if (pNodes->aEvaluationsCount[nNode] < 4)
     {
-        pNode->pNeighborsSequence++;
-        PATH_IDAStar_GetNextNeighborIndex(pNode, pContext);
+        pNodes->aNeighborsSequence[nNode]++;
+        PATH_IDAStar_GetNextNeighborIndex(nNode, pContext);
     }
 
-    pNode->nEvaluationsCount++;
-    if (pNode->nEvaluationsCount == 5)
+    pNodes->aEvaluationsCount[nNode]++;
+    if (pNodes->aEvaluationsCount[nNode] == 5)
     {
-        while (pNode != pContext->pCurrentNode)
+        // Node 0 is the root
+        while (nNode != 0)
         {
-            pNode = pNode->pParent;
-            pNode->pNeighborsSequence++;
+            nNode = pNodes->aParent[nNode];
+            pNodes->aNeighborsSequence[nNode]++;
 
-            PATH_IDAStar_GetNextNeighborIndex(pNode, pContext);
+            PATH_IDAStar_GetNextNeighborIndex(nNode, pContext);
 
-            if ((++pNode->nEvaluationsCount) != 5)
+            if ((++pNodes->aEvaluationsCount[nNode]) != 5)
             {
-                return pNode;
+                return nNode;
             }
         }
-        return 0;
+        return IDASTAR_INVALID_NODE;
     }
 
-    return pNode;
+    return nNode;
 }
 
 
 //1.10f: Inlined
 //1.13c: D2Common.0x6FDC0650
-signed int __fastcall PATH_IDAStar_FlushNodeToDynamicPath(D2PathIDAStarNodeStrc* pNode, D2PathInfoStrc* pPathInfo)
+signed int __fastcall PATH_IDAStar_FlushNodeToDynamicPath(D2PathIDAStarContextStrc* pContext, int32_t nNode, D2PathInfoStrc* pPathInfo)
 {
-    if (!pNode)
+    if (nNode == IDASTAR_INVALID_NODE)
     {
         return 0;
     }
 
+    const D2PathIDAStarNodesStrc* pNodes = &pContext->tNodes;
     int nbPoints = 0;
     D2PathPointStrc aTempPathPoints[78];
     // Assumes all points are conex, so we can't have a delta of -2, hence used for init
     int prevDeltaX = -2;
     int prevDeltaY = -2;
-    while (pNode && pNode->pParent && nbPoints < D2DynamicPathStrc::MAXPATHLEN)
+    while (nNode != IDASTAR_INVALID_NODE && pNodes->aParent[nNode] != IDASTAR_INVALID_NODE && nbPoints < D2DynamicPathStrc::MAXPATHLEN)
     {
-        D2PathIDAStarNodeStrc* pNextPoint = pNode->pParent;
-        const int deltaX = pNode->tCoord.X - pNextPoint->tCoord.X;
-        const int deltaY = pNode->tCoord.Y - pNextPoint->tCoord.Y;
+        const int32_t nNextPoint = pNodes->aParent[nNode];
+        const int deltaX = pNodes->aCoord[nNode].X - pNodes->aCoord[nNextPoint].X;
+        const int deltaY = pNodes->aCoord[nNode].Y - pNodes->aCoord[nNextPoint].Y;
         // If the direction doesn't change, then ignore the point
         if (deltaX != prevDeltaX || deltaY != prevDeltaY)
         {
             ++nbPoints;
             // Store path in reverse order
-            aTempPathPoints[D2DynamicPathStrc::MAXPATHLEN - nbPoints] = pNode->tCoord;
+            aTempPathPoints[D2DynamicPathStrc::MAXPATHLEN - nbPoints] = pNodes->aCoord[nNode];
             prevDeltaX = deltaX;
             prevDeltaY = deltaY;
         }
-        pNode = pNextPoint;
+        nNode = nNextPoint;
     }
 
     if (nbPoints <= 1 || nbPoints >= D2DynamicPathStrc::MAXPATHLEN)
@@ -394,4 +440,4 @@ signed int __fastcall PATH_IDAStar_FlushNodeToDynamicPath(D2PathIDAStarNodeStrc*
 
     memcpy(pPathInfo->pDynamicPath->PathPoints, &aTempPathPoints[D2DynamicPathStrc::MAXPATHLEN - nbPoints], sizeof(D2PathPointStrc) * nbPoints);
     return nbPoints;
-}
\ No newline at end of file
+}
@@ -9,6 +9,7 @@
 #include "Path/IDAStar.h"
 #include "Units/UnitRoom.h"
 #include "Units/Units.h"
+#include "Units/UnitSpatialIndex.h"
 #include <DataTbls/MonsterIds.h>
 #include <D2Math.h>
 #include "Path/IDAStar.h"
@@ -133,6 +134,21 @@ void PATH_UpdateClientCoords(D2DynamicPathStrc* pDynamicPath)
 
 	pDynamicPath->dwClientCoordX = nX;
 	pDynamicPath->dwClientCoordY = nY;
+
+	PATH_UpdateSpatialIndex(pDynamicPath);
+}
+
+// Helper function: Every write of tGameCoords must be followed by a call to this function, either directly or through PATH_UpdateClientCoords
+void PATH_UpdateSpatialIndex(D2DynamicPathStrc* pDynamicPath)
+{
+	// D2Moo only
+	if (pDynamicPath->pUnit)
+	{
+		if (D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pDynamicPath->pRoom))
+		{
+			UNITSPATIAL_MoveUnit(pSpatialIndex, pDynamicPath->pUnit, pDynamicPath->tGameCoords.wPosX, pDynamicPath->tGameCoords.wPosY);
+		}
+	}
 }
 
 //D2Common.0x6FDA8220
@@ -1116,12 +1132,14 @@ int __stdcall PATH_GetPrecisionY(D2DynamicPathStrc* pDynamicPath)
 void __stdcall PATH_SetPrecisionX(D2DynamicPathStrc* pDynamicPath, int nPrecisionX)
 {
 	pDynamicPath->tGameCoords.dwPrecisionX = nPrecisionX;
+	PATH_UpdateSpatialIndex(pDynamicPath);
 }
 
 //D2Common.0x6FDA9DA0 (#10197)
 void __stdcall PATH_SetPrecisionY(D2DynamicPathStrc* pDynamicPath, int nPrecisionY)
 {
 	pDynamicPath->tGameCoords.dwPrecisionY = nPrecisionY;
+	PATH_UpdateSpatialIndex(pDynamicPath);
 }
 
 //D2Common.0x6FDA9DB0 (#10164)
@@ -1540,7 +1540,7 @@ int __stdcall MISSILE_EvaluateMissileFormula(D2UnitStrc* pMissile, D2UnitStrc* p
 		pMissileCalc.nMissileId = nMissile;
 		pMissileCalc.nMissileLevel = nMissileLevel;
 
-		return DATATBLS_CalcEvaluateExpression(&sgptDataTables->pMissCode[nCalc], sgptDataTables->nMissCodeSize - nCalc, MISSILE_GetCalcParamValue, off_6FDE5A50, dword_6FDE5A70, &pMissileCalc);
+		return DATATBLS_EvaluateCalcProgram(&sgptDataTables->pMissCodePrograms, sgptDataTables->pMissCode, sgptDataTables->nMissCodeSize, nCalc, MISSILE_GetCalcParamValue, off_6FDE5A50, dword_6FDE5A70, &pMissileCalc);
 	}
 
 	return 0;
@@ -5,8 +5,49 @@
 #include "D2Dungeon.h"
 #include "D2Monsters.h"
 #include "Units/Units.h"
+#include "Units/UnitSpatialIndex.h"
 #include <D2BitManip.h>
 
+#include <algorithm>
+#include <functional>
+
+
+// Helper function: Reorders the candidates as the original code visits them: rooms in the order of ppRoomList, then units in the order of the units list of the room.
+// Candidates outside of these rooms are dropped. The units list of a room is only walked until its last candidate, and not at all if it has none.
+static int UNITFINDS_SortCandidatesInRoomsOrder(D2UnitStrc** ppCandidates, int nCandidates, D2ActiveRoomStrc** ppRoomList, int nNumRooms)
+{
+	D2UnitStrc* pSortedCandidates[UNITSPATIAL_MAX_CANDIDATES];
+	D2_ASSERT(nCandidates <= UNITSPATIAL_MAX_CANDIDATES);
+
+	std::sort(ppCandidates, ppCandidates + nCandidates, std::less<D2UnitStrc*>());
+
+	int nSortedCandidates = 0;
+	for (int i = 0; i < nNumRooms; ++i)
+	{
+		int nRoomCandidates = 0;
+		for (int j = 0; j < nCandidates; ++j)
+		{
+			if (UNITS_GetRoom(ppCandidates[j]) == ppRoomList[i])
+			{
+				++nRoomCandidates;
+			}
+		}
+
+		for (D2UnitStrc* pUnit = ppRoomList[i]->pUnitFirst; pUnit && nRoomCandidates > 0; pUnit = pUnit->pRoomNext)
+		{
+			if (std::binary_search(ppCandidates, ppCandidates + nCandidates, pUnit, std::less<D2UnitStrc*>()) && nSortedCandidates < UNITSPATIAL_MAX_CANDIDATES)
+			{
+				pSortedCandidates[nSortedCandidates] = pUnit;
+				++nSortedCandidates;
+				--nRoomCandidates;
+			}
+		}
+	}
+
+	memcpy(ppCandidates, pSortedCandidates, sizeof(D2UnitStrc*) * nSortedCandidates);
+	return nSortedCandidates;
+}
+
 
 //D2Common.0x6FDBC680 (#10408)
 BOOL __stdcall UNITFINDS_AreUnitsInNeighboredRooms(D2UnitStrc* pDestUnit, D2UnitStrc* pSrcUnit)
@@ -113,6 +154,28 @@ D2UnitStrc* __stdcall UNITFINDS_GetNearestTestedUnit(D2UnitStrc* pUnit, int nX,
 
 	nSmallestDistance = 65535;
 
+	// D2Moo only: only test the units inside the search box, in the order of the original code so that ties are resolved the same way
+	D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pRoom);
+	if (pSpatialIndex && nSize <= UNITSPATIAL_MAX_QUERY_SIZE)
+	{
+		D2UnitStrc* pCandidates[UNITSPATIAL_MAX_CANDIDATES];
+		int nCandidates = UNITSPATIAL_FindUnitsInBox(pSpatialIndex, nX, nY, nSize, pCandidates, ARRAY_SIZE(pCandidates));
+		if (nCandidates >= 0)
+		{
+			nCandidates = UNITFINDS_SortCandidatesInRoomsOrder(pCandidates, nCandidates, ppRoomList, nNumRooms);
+			for (int i = 0; i < nCandidates; ++i)
+			{
+				nDistance = UNITS_GetDistanceToCoordinates(pCandidates[i], nX, nY);
+				if (nDistance < nSize && nDistance < nSmallestDistance && pfnUnitTest(pCandidates[i], pUnit))
+				{
+					pResult = pCandidates[i];
+					nSmallestDistance = nDistance;
+				}
+			}
+			return pResult;
+		}
+	}
+
 	for (int i = 0; i < nNumRooms; ++i)
 	{
 		DUNGEON_GetRoomCoordinates(ppRoomList[i], &pRoomCoord);
@@ -204,6 +267,52 @@ void __stdcall UNITFINDS_FindAllMatchingUnitsInNeighboredRooms(D2UnitFindDataStr
 		nNumRooms = 1;
 	}
 
+	// D2Moo only: only test the units inside the search box, in the order of the original code
+	D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pRoom);
+	if (pSpatialIndex && nSize <= UNITSPATIAL_MAX_QUERY_SIZE)
+	{
+		D2UnitStrc* pCandidates[UNITSPATIAL_MAX_CANDIDATES];
+		int nCandidates = UNITSPATIAL_FindUnitsInBox(pSpatialIndex, nX, nY, nSize, pCandidates, ARRAY_SIZE(pCandidates));
+		if (nCandidates >= 0)
+		{
+			nCandidates = UNITFINDS_SortCandidatesInRoomsOrder(pCandidates, nCandidates, ppRoomList, nNumRooms);
+			for (int i = 0; i < nCandidates; ++i)
+			{
+				D2UnitStrc* pUnit = pCandidates[i];
+				if ((pUnitFindData->nFlags & 0x2000) && DUNGEON_IsRoomInTown(UNITS_GetRoom(pUnit)))
+				{
+					continue;
+				}
+
+				if (pUnitFindData->pfnUnitTest)
+				{
+					D2_ASSERT(!IsBadCodePtr((FARPROC)pUnitFindData->pfnUnitTest));
+
+					nUnitTest = pUnitFindData->pfnUnitTest(pUnit, pUnitFindData->pUnitFindArg);
+				}
+				else
+				{
+					nUnitTest = UNITFINDS_TestUnit(pUnit, pUnitFindData->pUnitFindArg);
+				}
+
+				if (nUnitTest)
+				{
+					pUnitFindData->pUnitsArray[nIndex] = pUnit;
+					++nIndex;
+
+					if (nIndex == pUnitFindData->nMaxArrayEntries)
+					{
+						pUnitFindData->nMaxArrayEntries += UNIT_FIND_ARRAY_SIZE;
+						pUnitFindData->pUnitsArray = (D2UnitStrc**)D2_REALLOC_POOL(pUnitFindData->pMemPool, pUnitFindData->pUnitsArray, sizeof(D2UnitStrc*) * pUnitFindData->nMaxArrayEntries);
+					}
+				}
+			}
+
+			pUnitFindData->nIndex = nIndex;
+			return;
+		}
+	}
+
 	for (int i = 0; i < nNumRooms; ++i)
 	{
 		if (!(pUnitFindData->nFlags & 0x2000) || !DUNGEON_IsRoomInTown(ppRoomList[i]))
@@ -3,6 +3,7 @@
 #include "D2Dungeon.h"
 #include "D2StatList.h"
 #include "Units/Units.h"
+#include "Units/UnitSpatialIndex.h"
 #include "Path/Path.h"
 
 
@@ -36,6 +37,18 @@ int __stdcall UNITROOM_AddUnitToRoomEx(D2UnitStrc* pUnit, D2ActiveRoomStrc* pRoo
 	pUnit->pRoomNext = *ppUnitFirst;
 	*ppUnitFirst = pUnit;
 
+	// D2Moo only
+	if (D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pRoom))
+	{
+		UNITSPATIAL_InsertUnit(pSpatialIndex, pUnit, tCoord.nX, tCoord.nY);
+	}
+
+	// D2Moo only
+	if (pUnit->dwUnitType == UNIT_PLAYER)
+	{
+		++pRoom->nPlayerUnits;
+	}
+
 	UNITROOM_RefreshUnit(pUnit);
 
 	if (pUnit->dwUnitType == UNIT_PLAYER || (pUnit->dwUnitType == UNIT_MONSTER && STATLIST_GetUnitAlignment(pUnit) == UNIT_ALIGNMENT_GOOD))
@@ -74,52 +87,32 @@ void __stdcall UNITROOM_RefreshUnit(D2UnitStrc* pUnit)
 //D2Common.0x6FDBD1B0 (#10388)
 void __stdcall UNITROOM_SortUnitListByTargetY(D2ActiveRoomStrc* pRoom)
 {
-	D2UnitStrc** ppUnitFirst = NULL;
-	D2UnitStrc** ppUnit = NULL;
-	D2UnitStrc* pPreviousUnit = NULL;
-	D2UnitStrc* pNextUnit = NULL;
-	D2UnitStrc* pUnit = NULL;
-	bool bContinue = false;
-
-	ppUnit = DUNGEON_GetUnitListFromRoom(pRoom);
-	pUnit = *ppUnit;
-	ppUnitFirst = ppUnit;
+	D2UnitStrc** ppUnit = DUNGEON_GetUnitListFromRoom(pRoom);
+	D2UnitStrc* pUnit = *ppUnit;
+	if (!pUnit)
+	{
+		return;
+	}
 
-	if (pUnit)
+	// A single bubble pass: the list gets sorted over the successive calls instead of at once.
+	// D2Moo only: the coordinate of each unit is read once instead of once per comparison.
+	int nUnitY = UNITS_GetClientCoordY(pUnit);
+	while (D2UnitStrc* pNextUnit = pUnit->pRoomNext)
 	{
-		pNextUnit = pUnit->pRoomNext;
-		do
+		const int nNextUnitY = UNITS_GetClientCoordY(pNextUnit);
+		if (nUnitY <= nNextUnitY)
 		{
-			bContinue = false;
-
-			while (pNextUnit)
-			{
-				if (UNITS_GetClientCoordY(pUnit) <= UNITS_GetClientCoordY(pNextUnit))
-				{
-					pPreviousUnit = pUnit;
-					pUnit = pNextUnit;
-					pNextUnit = pNextUnit->pRoomNext;
-				}
-				else
-				{
-					if (pPreviousUnit)
-					{
-						pPreviousUnit->pRoomNext = pNextUnit;
-					}
-					else
-					{
-						*ppUnitFirst = pNextUnit;
-					}
-
-					pPreviousUnit = pNextUnit;
-					pUnit->pRoomNext = pNextUnit->pRoomNext;
-					pNextUnit->pRoomNext = pUnit;
-					pNextUnit = pUnit->pRoomNext;
-					bContinue = true;
-				}
-			}
+			ppUnit = &pUnit->pRoomNext;
+			pUnit = pNextUnit;
+			nUnitY = nNextUnitY;
+		}
+		else
+		{
+			*ppUnit = pNextUnit;
+			pUnit->pRoomNext = pNextUnit->pRoomNext;
+			pNextUnit->pRoomNext = pUnit;
+			ppUnit = &pNextUnit->pRoomNext;
 		}
-		while (bContinue);
 	}
 }
 
@@ -139,6 +132,7 @@ void __stdcall UNITROOM_UpdatePath(D2UnitStrc* pUnit)
 
 		pUnit->pDynamicPath->dwClientCoordX = dword_6FDD2580;
 		pUnit->pDynamicPath->dwClientCoordY = dword_6FDD2584;
+		PATH_UpdateSpatialIndex(pUnit->pDynamicPath);
 
 		pUnit->pDynamicPath->dwPathPoints = 0;
 		
@@ -225,6 +219,19 @@ void __stdcall UNITROOM_RemoveUnitFromRoom(D2UnitStrc* pUnit)
 
 				pRoomUnit->pRoomNext = NULL;
 
+				// D2Moo only
+				if (D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pRoom))
+				{
+					UNITSPATIAL_RemoveUnit(pSpatialIndex, pUnit);
+				}
+
+				// D2Moo only
+				if (pUnit->dwUnitType == UNIT_PLAYER)
+				{
+					D2_ASSERT(pRoom->nPlayerUnits > 0);
+					--pRoom->nPlayerUnits;
+				}
+
 				if (pUnit->dwUnitType == UNIT_PLAYER || pUnit->dwUnitType == UNIT_MONSTER && STATLIST_GetUnitAlignment(pUnit) == UNIT_ALIGNMENT_GOOD)
 				{
 					DUNGEON_DecreaseAlliedCountOfRoom(pRoom);
@@ -0,0 +1,295 @@
+#include "Units/UnitSpatialIndex.h"
+
+#include "Drlg/D2DrlgDrlg.h"
+#include "Units/Units.h"
+
+#include <cstdlib>
+
+
+// Helper function
+static uint32_t UNITSPATIAL_GetCellBucket(int32_t nCellX, int32_t nCellY)
+{
+	return ((uint32_t)nCellX * 73856093u ^ (uint32_t)nCellY * 19349663u) & (UNITSPATIAL_CELL_BUCKETS - 1);
+}
+
+// Helper function
+static uint32_t UNITSPATIAL_GetUnitBucket(D2UnitStrc* pUnit)
+{
+	return ((uintptr_t)pUnit >> 4) & (UNITSPATIAL_UNIT_BUCKETS - 1);
+}
+
+// Helper function
+static D2UnitSpatialCellStrc* UNITSPATIAL_FindCell(D2UnitSpatialIndexStrc* pIndex, int32_t nCellX, int32_t nCellY)
+{
+	for (D2UnitSpatialCellStrc* pCell = pIndex->pCellBuckets[UNITSPATIAL_GetCellBucket(nCellX, nCellY)]; pCell; pCell = pCell->pHashNext)
+	{
+		if (pCell->nCellX == nCellX && pCell->nCellY == nCellY)
+		{
+			return pCell;
+		}
+	}
+	return nullptr;
+}
+
+// Helper function: Cells are never freed before the index, the explored area of an act is bounded
+static D2UnitSpatialCellStrc* UNITSPATIAL_GetOrCreateCell(D2UnitSpatialIndexStrc* pIndex, int32_t nX, int32_t nY)
+{
+	const int32_t nCellX = nX >> UNITSPATIAL_CELL_SIZE_SHIFT;
+	const int32_t nCellY = nY >> UNITSPATIAL_CELL_SIZE_SHIFT;
+	if (D2UnitSpatialCellStrc* pCell = UNITSPATIAL_FindCell(pIndex, nCellX, nCellY))
+	{
+		return pCell;
+	}
+
+	D2UnitSpatialCellStrc* pCell = D2_CALLOC_STRC_POOL(pIndex->pMemPool, D2UnitSpatialCellStrc);
+	UNITSPATIAL_AddCell(pIndex, pCell, nCellX, nCellY);
+	return pCell;
+}
+
+// Helper function
+static D2UnitSpatialEntryStrc* UNITSPATIAL_FindEntry(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit)
+{
+	for (D2UnitSpatialEntryStrc* pEntry = pIndex->pUnitBuckets[UNITSPATIAL_GetUnitBucket(pUnit)]; pEntry; pEntry = pEntry->pUnitHashNext)
+	{
+		if (pEntry->pUnit == pUnit)
+		{
+			return pEntry;
+		}
+	}
+	return nullptr;
+}
+
+// Helper function
+static void UNITSPATIAL_UnlinkFromCell(D2UnitSpatialEntryStrc* pEntry)
+{
+	if (pEntry->pCellPrev)
+	{
+		pEntry->pCellPrev->pCellNext = pEntry->pCellNext;
+	}
+	else
+	{
+		pEntry->pCell->pFirstEntry = pEntry->pCellNext;
+	}
+
+	if (pEntry->pCellNext)
+	{
+		pEntry->pCellNext->pCellPrev = pEntry->pCellPrev;
+	}
+
+	pEntry->pCell = nullptr;
+	pEntry->pCellPrev = nullptr;
+	pEntry->pCellNext = nullptr;
+}
+
+// Helper function
+static void UNITSPATIAL_LinkToCell(D2UnitSpatialEntryStrc* pEntry, D2UnitSpatialCellStrc* pCell)
+{
+	pEntry->pCell = pCell;
+	pEntry->pCellPrev = nullptr;
+	pEntry->pCellNext = pCell->pFirstEntry;
+	if (pCell->pFirstEntry)
+	{
+		pCell->pFirstEntry->pCellPrev = pEntry;
+	}
+	pCell->pFirstEntry = pEntry;
+}
+
+// Helper function
+void __fastcall UNITSPATIAL_AddCell(D2UnitSpatialIndexStrc* pIndex, D2UnitSpatialCellStrc* pCell, int32_t nCellX, int32_t nCellY)
+{
+	D2_ASSERT(!UNITSPATIAL_FindCell(pIndex, nCellX, nCellY));
+
+	pCell->nCellX = nCellX;
+	pCell->nCellY = nCellY;
+	pCell->pFirstEntry = nullptr;
+	D2UnitSpatialCellStrc** ppBucket = &pIndex->pCellBuckets[UNITSPATIAL_GetCellBucket(nCellX, nCellY)];
+	pCell->pHashNext = *ppBucket;
+	*ppBucket = pCell;
+}
+
+// Helper function
+BOOL __fastcall UNITSPATIAL_IsEnabled()
+{
+	static const BOOL bEnabled = []()
+	{
+		char* szValue = nullptr;
+		size_t nBufferSize = 0;
+		BOOL bResult = FALSE;
+		if (0 == _dupenv_s(&szValue, &nBufferSize, "D2_UNIT_SPATIAL_INDEX") && szValue)
+		{
+			bResult = atoi(szValue) != 0;
+			free(szValue);
+		}
+		return bResult;
+	}();
+	return bEnabled;
+}
+
+// Helper function
+D2UnitSpatialIndexStrc* __fastcall UNITSPATIAL_AllocIndex(void* pMemPool)
+{
+	D2UnitSpatialIndexStrc* pIndex = D2_CALLOC_STRC_POOL(pMemPool, D2UnitSpatialIndexStrc);
+	pIndex->pMemPool = pMemPool;
+	return pIndex;
+}
+
+// Helper function
+void __fastcall UNITSPATIAL_FreeIndex(D2UnitSpatialIndexStrc* pIndex)
+{
+	if (!pIndex)
+	{
+		return;
+	}
+
+	for (int32_t i = 0; i < UNITSPATIAL_UNIT_BUCKETS; ++i)
+	{
+		D2UnitSpatialEntryStrc* pEntry = pIndex->pUnitBuckets[i];
+		while (pEntry)
+		{
+			D2UnitSpatialEntryStrc* pNext = pEntry->pUnitHashNext;
+			D2_FREE_POOL(pIndex->pMemPool, pEntry);
+			pEntry = pNext;
+		}
+	}
+
+	D2UnitSpatialEntryStrc* pFreeEntry = pIndex->pFreeEntries;
+	while (pFreeEntry)
+	{
+		D2UnitSpatialEntryStrc* pNext = pFreeEntry->pUnitHashNext;
+		D2_FREE_POOL(pIndex->pMemPool, pFreeEntry);
+		pFreeEntry = pNext;
+	}
+
+	for (int32_t i = 0; i < UNITSPATIAL_CELL_BUCKETS; ++i)
+	{
+		D2UnitSpatialCellStrc* pCell = pIndex->pCellBuckets[i];
+		while (pCell)
+		{
+			D2UnitSpatialCellStrc* pNext = pCell->pHashNext;
+			D2_FREE_POOL(pIndex->pMemPool, pCell);
+			pCell = pNext;
+		}
+	}
+
+	D2_FREE_POOL(pIndex->pMemPool, pIndex);
+}
+
+// Helper function
+D2UnitSpatialIndexStrc* __fastcall UNITSPATIAL_GetIndexFromRoom(D2ActiveRoomStrc* pRoom)
+{
+	return (pRoom && pRoom->pAct) ? pRoom->pAct->pSpatialIndex : nullptr;
+}
+
+// Helper function
+void __fastcall UNITSPATIAL_InsertUnit(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit, int32_t nX, int32_t nY)
+{
+	D2_ASSERT(pIndex);
+	D2_ASSERT(pUnit);
+
+	if (UNITSPATIAL_FindEntry(pIndex, pUnit))
+	{
+		UNITSPATIAL_MoveUnit(pIndex, pUnit, nX, nY);
+		return;
+	}
+
+	D2UnitSpatialEntryStrc* pEntry = pIndex->pFreeEntries;
+	if (pEntry)
+	{
+		pIndex->pFreeEntries = pEntry->pUnitHashNext;
+	}
+	else
+	{
+		pEntry = D2_ALLOC_STRC_POOL(pIndex->pMemPool, D2UnitSpatialEntryStrc);
+	}
+
+	pEntry->pUnit = pUnit;
+	pEntry->nX = nX;
+	pEntry->nY = nY;
+
+	D2UnitSpatialEntryStrc** ppBucket = &pIndex->pUnitBuckets[UNITSPATIAL_GetUnitBucket(pUnit)];
+	pEntry->pUnitHashNext = *ppBucket;
+	*ppBucket = pEntry;
+
+	UNITSPATIAL_LinkToCell(pEntry, UNITSPATIAL_GetOrCreateCell(pIndex, nX, nY));
+	++pIndex->nUnits;
+}
+
+// Helper function
+void __fastcall UNITSPATIAL_MoveUnit(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit, int32_t nX, int32_t nY)
+{
+	D2UnitSpatialEntryStrc* pEntry = UNITSPATIAL_FindEntry(pIndex, pUnit);
+	if (!pEntry)
+	{
+		return;
+	}
+
+	pEntry->nX = nX;
+	pEntry->nY = nY;
+
+	D2UnitSpatialCellStrc* pCell = pEntry->pCell;
+	if (pCell->nCellX != (nX >> UNITSPATIAL_CELL_SIZE_SHIFT) || pCell->nCellY != (nY >> UNITSPATIAL_CELL_SIZE_SHIFT))
+	{
+		UNITSPATIAL_UnlinkFromCell(pEntry);
+		UNITSPATIAL_LinkToCell(pEntry, UNITSPATIAL_GetOrCreateCell(pIndex, nX, nY));
+	}
+}
+
+// Helper function
+void __fastcall UNITSPATIAL_RemoveUnit(D2UnitSpatialIndexStrc* pIndex, D2UnitStrc* pUnit)
+{
+	D2UnitSpatialEntryStrc** ppEntry = &pIndex->pUnitBuckets[UNITSPATIAL_GetUnitBucket(pUnit)];
+	while (*ppEntry && (*ppEntry)->pUnit != pUnit)
+	{
+		ppEntry = &(*ppEntry)->pUnitHashNext;
+	}
+
+	D2UnitSpatialEntryStrc* pEntry = *ppEntry;
+	if (!pEntry)
+	{
+		return;
+	}
+
+	*ppEntry = pEntry->pUnitHashNext;
+	UNITSPATIAL_UnlinkFromCell(pEntry);
+	pEntry->pUnit = nullptr;
+	pEntry->pUnitHashNext = pIndex->pFreeEntries;
+	pIndex->pFreeEntries = pEntry;
+	--pIndex->nUnits;
+}
+
+// Helper function
+int32_t __fastcall UNITSPATIAL_FindUnitsInBox(D2UnitSpatialIndexStrc* pIndex, int32_t nX, int32_t nY, int32_t nSize, D2UnitStrc** ppUnits, int32_t nMaxUnits)
+{
+	D2_ASSERT(pIndex);
+
+	const int32_t nFirstCellX = (nX - nSize) >> UNITSPATIAL_CELL_SIZE_SHIFT;
+	const int32_t nLastCellX = (nX + nSize) >> UNITSPATIAL_CELL_SIZE_SHIFT;
+	const int32_t nFirstCellY = (nY - nSize) >> UNITSPATIAL_CELL_SIZE_SHIFT;
+	const int32_t nLastCellY = (nY + nSize) >> UNITSPATIAL_CELL_SIZE_SHIFT;
+
+	int32_t nUnits = 0;
+	for (int32_t nCellY = nFirstCellY; nCellY <= nLastCellY; ++nCellY)
+	{
+		for (int32_t nCellX = nFirstCellX; nCellX <= nLastCellX; ++nCellX)
+		{
+			D2UnitSpatialCellStrc* pCell = UNITSPATIAL_FindCell(pIndex, nCellX, nCellY);
+			if (!pCell)
+			{
+				continue;
+			}
+
+			for (D2UnitSpatialEntryStrc* pEntry = pCell->pFirstEntry; pEntry; pEntry = pEntry->pCellNext)
+			{
+				if (std::abs(pEntry->nX - nX) <= nSize && std::abs(pEntry->nY - nY) <= nSize)
+				{
+					if (nUnits == nMaxUnits)
+					{
+						return -1;
+					}
+					ppUnits[nUnits++] = pEntry->pUnit;
+				}
+			}
+		}
+	}
+	return nUnits;
+}
@@ -17,6 +17,7 @@
 #include "D2States.h"
 #include "D2StatList.h"
 #include "Units/UnitRoom.h"
+#include "Units/UnitSpatialIndex.h"
 #include "D2Waypoints.h"
 #include <D2BitManip.h>
 #include <DataTbls/LevelsIds.h>
@@ -168,6 +169,11 @@ void __stdcall UNITS_SetXForStaticUnit(D2UnitStrc* pUnit, int nX)
 	case UNIT_ITEM:
 	case UNIT_TILE:
 		pUnit->pStaticPath->tGameCoords.nX = nX;
+		// D2Moo only
+		if (D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pUnit->pStaticPath->pRoom))
+		{
+			UNITSPATIAL_MoveUnit(pSpatialIndex, pUnit, pUnit->pStaticPath->tGameCoords.nX, pUnit->pStaticPath->tGameCoords.nY);
+		}
 		break;
 
 	default:
@@ -186,6 +192,11 @@ void __stdcall UNITS_SetYForStaticUnit(D2UnitStrc* pUnit, int nY)
 	case UNIT_ITEM:
 	case UNIT_TILE:
 		pUnit->pStaticPath->tGameCoords.nY = nY;
+		// D2Moo only
+		if (D2UnitSpatialIndexStrc* pSpatialIndex = UNITSPATIAL_GetIndexFromRoom(pUnit->pStaticPath->pRoom))
+		{
+			UNITSPATIAL_MoveUnit(pSpatialIndex, pUnit, pUnit->pStaticPath->tGameCoords.nX, pUnit->pStaticPath->tGameCoords.nY);
+		}
 		break;
 
 	default:
@@ -0,0 +1,231 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <D2BitManip.h>
+#include <D2DataTbls.h>
+#include <D2Items.h>
+#include <DataTbls/ItemsTbls.h>
+
+namespace
+{
+    // Original affix scans of ITEMS_RollMagicAffixesNew and ITEMS_RollRareAffixes, used as a reference.
+    namespace Reference
+    {
+        template<typename AffixTxt>
+        bool CanItemTypeHaveAffix(int nItemId, const AffixTxt& rAffix)
+        {
+            for (uint16_t wEType : rAffix.wEType)
+            {
+                if (wEType <= 0)
+                {
+                    break;
+                }
+
+                if (ITEMS_CheckItemTypeIdByItemId(nItemId, wEType))
+                {
+                    return false;
+                }
+            }
+
+            for (uint16_t wIType : rAffix.wIType)
+            {
+                if (wIType <= 0)
+                {
+                    break;
+                }
+
+                if (ITEMS_CheckItemTypeIdByItemId(nItemId, wIType))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool CanAffixSpawnAtLevel(const D2MagicAffixTxt& rAffix, uint32_t nLevel)
+        {
+            return rAffix.dwLevel <= nLevel && (rAffix.dwMaxLevel == 0 || nLevel <= rAffix.dwMaxLevel);
+        }
+
+        std::vector<uint16_t> GetMagicAffixes(int nItemId, const D2MagicAffixTxt* pBegin, const D2MagicAffixTxt* pEnd, uint32_t nLevel)
+        {
+            std::vector<uint16_t> aAffixes;
+            for (int i = 0; i < pEnd - pBegin; ++i)
+            {
+                if (pBegin[i].wFrequency != 0 && CanAffixSpawnAtLevel(pBegin[i], nLevel) && CanItemTypeHaveAffix(nItemId, pBegin[i]))
+                {
+                    aAffixes.push_back((uint16_t)i);
+                }
+            }
+            return aAffixes;
+        }
+
+        std::vector<uint16_t> GetRareAffixes(int nItemId, const D2RareAffixTxt* pBegin, const D2RareAffixTxt* pEnd)
+        {
+            std::vector<uint16_t> aAffixes;
+            for (int i = 0; i < pEnd - pBegin; ++i)
+            {
+                if (CanItemTypeHaveAffix(nItemId, pBegin[i]))
+                {
+                    aAffixes.push_back((uint16_t)i);
+                }
+            }
+            return aAffixes;
+        }
+    }
+
+    // Candidates still have to be checked against the exact level by the callers, as in ITEMS_RollMagicAffixesNew
+    std::vector<uint16_t> GetMagicAffixCandidates(int nItemId, int nList, const D2MagicAffixTxt* pBegin, uint32_t nLevel)
+    {
+        int nCount = 0;
+        const uint16_t* pCandidates = DATATBLS_GetMagicAffixCandidates(nItemId, nList, nLevel, &nCount);
+        std::vector<uint16_t> aAffixes;
+        for (int i = 0; i < nCount; ++i)
+        {
+            if (Reference::CanAffixSpawnAtLevel(pBegin[pCandidates[i]], nLevel))
+            {
+                aAffixes.push_back(pCandidates[i]);
+            }
+        }
+        return aAffixes;
+    }
+
+    std::vector<uint16_t> GetRareAffixCandidates(int nItemId, BOOL bPrefix)
+    {
+        int nCount = 0;
+        const uint16_t* pCandidates = DATATBLS_GetRareAffixCandidates(nItemId, bPrefix, &nCount);
+        return std::vector<uint16_t>(pCandidates, pCandidates + nCount);
+    }
+
+    template<typename AffixTxt>
+    void SetRandomTypes(AffixTxt& rAffix, std::mt19937& tRand, int nItemTypes)
+    {
+        // Types are 0 terminated, and 0 is never a valid type
+        const int nITypes = std::uniform_int_distribution<int>(0, 3)(tRand);
+        for (int i = 0; i < nITypes; ++i)
+        {
+            rAffix.wIType[i] = (uint16_t)std::uniform_int_distribution<int>(1, nItemTypes - 1)(tRand);
+        }
+        const int nETypes = std::uniform_int_distribution<int>(0, 2)(tRand);
+        for (int i = 0; i < nETypes; ++i)
+        {
+            rAffix.wEType[i] = (uint16_t)std::uniform_int_distribution<int>(1, nItemTypes - 1)(tRand);
+        }
+    }
+}
+
+TEST_CASE("DATATBLS affix candidates match the scan of the affix tables")
+{
+    std::mt19937 tRand(0x6FD58110);
+
+    // Minimal tables, no txt files are shipped with the repository
+    constexpr int nItemTypes = 12;
+    constexpr int nItems = 40;
+    constexpr int nMagicAffixes = 300;
+    constexpr int nRareAffixes = 60;
+    constexpr uint32_t nMaxLevel = 300;
+
+    // Each type is equivalent to itself and to a random parent
+    std::vector<uint32_t> aItemTypesEquivalenceLUTs(nItemTypes);
+    for (int nItemType = 0; nItemType < nItemTypes; ++nItemType)
+    {
+        aItemTypesEquivalenceLUTs[nItemType] = gdwBitMasks[nItemType] | gdwBitMasks[std::uniform_int_distribution<int>(1, nItemTypes - 1)(tRand)];
+    }
+
+    std::vector<D2ItemsTxt> aItemsTxt(nItems);
+    for (D2ItemsTxt& rItemsTxt : aItemsTxt)
+    {
+        rItemsTxt = {};
+        rItemsTxt.wType[0] = (int16_t)std::uniform_int_distribution<int>(1, nItemTypes - 1)(tRand);
+        rItemsTxt.wType[1] = (int16_t)std::uniform_int_distribution<int>(-1, nItemTypes - 1)(tRand);
+    }
+
+    // Suffixes, prefixes then automagic, with levels and max levels above 99
+    std::vector<D2MagicAffixTxt> aMagicAffixTxt(nMagicAffixes);
+    for (D2MagicAffixTxt& rAffix : aMagicAffixTxt)
+    {
+        rAffix = {};
+        rAffix.dwLevel = std::uniform_int_distribution<uint32_t>(0, 130)(tRand);
+        if (std::uniform_int_distribution<int>(0, 2)(tRand) == 0)
+        {
+            rAffix.dwMaxLevel = std::uniform_int_distribution<uint32_t>(1, 140)(tRand);
+        }
+        rAffix.wFrequency = (uint8_t)std::uniform_int_distribution<int>(0, 3)(tRand);
+        SetRandomTypes(rAffix, tRand, nItemTypes);
+    }
+
+    std::vector<D2RareAffixTxt> aRareAffixTxt(nRareAffixes);
+    for (D2RareAffixTxt& rAffix : aRareAffixTxt)
+    {
+        rAffix = {};
+        SetRandomTypes(rAffix, tRand, nItemTypes);
+    }
+
+    std::unique_ptr<D2DataTablesStrc> pDataTables(new D2DataTablesStrc{});
+    pDataTables->nItemTypesTxtRecordCount = nItemTypes;
+    pDataTables->nItemTypesIndex = 1;
+    pDataTables->pItemTypesEquivalenceLUTs = aItemTypesEquivalenceLUTs.data();
+    pDataTables->pItemDataTables.pItemsTxt = aItemsTxt.data();
+    pDataTables->pItemDataTables.nItemsTxtRecordCount = nItems;
+    D2MagicAffixDataTbl* pMagicAffixDataTbl = &pDataTables->pMagicAffixDataTables;
+    pMagicAffixDataTbl->pMagicAffixTxt = aMagicAffixTxt.data();
+    pMagicAffixDataTbl->nMagicAffixTxtRecordCount = nMagicAffixes;
+    pMagicAffixDataTbl->pMagicSuffix = &aMagicAffixTxt[0];
+    pMagicAffixDataTbl->pMagicPrefix = &aMagicAffixTxt[nMagicAffixes / 3];
+    pMagicAffixDataTbl->pAutoMagic = &aMagicAffixTxt[2 * nMagicAffixes / 3];
+    D2RareAffixDataTbl* pRareAffixDataTbl = &pDataTables->pRareAffixDataTables;
+    pRareAffixDataTbl->pRareAffixTxt = aRareAffixTxt.data();
+    pRareAffixDataTbl->nRareAffixTxtRecordCount = nRareAffixes;
+    pRareAffixDataTbl->pRareSuffix = &aRareAffixTxt[0];
+    pRareAffixDataTbl->pRarePrefix = &aRareAffixTxt[nRareAffixes / 2];
+    D2DataTablesStrc* pPreviousDataTables = sgptDataTables;
+    sgptDataTables = pDataTables.get();
+
+    // Same steps as DATATBLS_LoadAffixCandidates, using the memory of the test instead of Fog
+    D2AffixCandidatesStrc tCandidates = {};
+    std::vector<int16_t> aItemBuckets(nItems);
+    std::vector<int> aBucketItems(nItems);
+    tCandidates.pItemBuckets = aItemBuckets.data();
+    DATATBLS_BuildAffixCandidateBuckets(&tCandidates, aBucketItems.data());
+    std::vector<int32_t> aListStarts(tCandidates.nBuckets * AFFIXCANDIDATES_LISTS + 1);
+    tCandidates.pListStarts = aListStarts.data();
+    std::vector<uint16_t> aAffixes(std::max(DATATBLS_BuildAffixCandidateLists(&tCandidates, aBucketItems.data()), 1));
+    tCandidates.pAffixes = aAffixes.data();
+    DATATBLS_BuildAffixCandidateLists(&tCandidates, aBucketItems.data());
+    pDataTables->pAffixCandidates = &tCandidates;
+    MESSAGE(tCandidates.nBuckets, " buckets, ", aAffixes.size(), " candidates");
+
+    const struct
+    {
+        int nList;
+        const D2MagicAffixTxt* pBegin;
+        const D2MagicAffixTxt* pEnd;
+    } aMagicLists[] = {
+        { AFFIXCANDIDATES_MAGICSUFFIX, pMagicAffixDataTbl->pMagicSuffix, pMagicAffixDataTbl->pMagicPrefix },
+        { AFFIXCANDIDATES_MAGICPREFIX, pMagicAffixDataTbl->pMagicPrefix, pMagicAffixDataTbl->pAutoMagic },
+        { AFFIXCANDIDATES_AUTOMAGIC, pMagicAffixDataTbl->pAutoMagic, &aMagicAffixTxt[nMagicAffixes] },
+    };
+
+    for (int nItemId = 0; nItemId < nItems; ++nItemId)
+    {
+        CAPTURE(nItemId);
+        for (const auto& tMagicList : aMagicLists)
+        {
+            CAPTURE(tMagicList.nList);
+            for (uint32_t nLevel = 0; nLevel <= nMaxLevel; ++nLevel)
+            {
+                CAPTURE(nLevel);
+                REQUIRE(GetMagicAffixCandidates(nItemId, tMagicList.nList, tMagicList.pBegin, nLevel) == Reference::GetMagicAffixes(nItemId, tMagicList.pBegin, tMagicList.pEnd, nLevel));
+            }
+        }
+
+        REQUIRE(GetRareAffixCandidates(nItemId, FALSE) == Reference::GetRareAffixes(nItemId, pRareAffixDataTbl->pRareSuffix, pRareAffixDataTbl->pRarePrefix));
+        REQUIRE(GetRareAffixCandidates(nItemId, TRUE) == Reference::GetRareAffixes(nItemId, pRareAffixDataTbl->pRarePrefix, &aRareAffixTxt[nRareAffixes]));
+    }
+
+    sgptDataTables = pPreviousDataTables;
+}
@@ -0,0 +1,279 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <D2DataTbls.h>
+
+namespace
+{
+    constexpr int nParamsCount = 8;
+
+    struct CalcTestUserData
+    {
+        int32_t nParams[nParamsCount];
+        std::vector<int32_t> aCallsLog;  // Callbacks and their parameters, in the order they were called
+    };
+
+    int __fastcall ParamCallBack(int nParam, void* pUserData)
+    {
+        CalcTestUserData* pData = (CalcTestUserData*)pUserData;
+        pData->aCallsLog.push_back(-1);
+        pData->aCallsLog.push_back(nParam);
+        return pData->nParams[(uint32_t)nParam % nParamsCount];
+    }
+
+    template<int nFunction>
+    int __fastcall TableCallBack(int nParam1, int nParam2, int nParam3, void* pUserData)
+    {
+        CalcTestUserData* pData = (CalcTestUserData*)pUserData;
+        pData->aCallsLog.insert(pData->aCallsLog.end(), { nFunction, nParam1, nParam2, nParam3 });
+        switch (nFunction)
+        {
+        case 1: return nParam1 < nParam2 ? nParam1 : nParam2;
+        case 2: return nParam1 > nParam2 ? nParam1 : nParam2;
+        case 3: return (int32_t)((uint32_t)nParam1 + (uint32_t)nParam2 * 3u + (uint32_t)nParam3 * 7u);
+        case 4: return (int32_t)(0u - (uint32_t)nParam1);
+        default: return pData->nParams[0] ^ nParam1;
+        }
+    }
+
+    // Index 0 can not be referenced by the formulas (0 means "not a function" for the parser), the last entries are only used by the random buffers
+    D2CalcCallbackInfoStrc gtCallbacks[] =
+    {
+        { TableCallBack<0>, 0 },
+        { TableCallBack<1>, 2 },    // min
+        { TableCallBack<2>, 2 },    // max
+        { TableCallBack<3>, 3 },    // sum3
+        { TableCallBack<4>, 1 },    // neg
+        { TableCallBack<5>, 0 },    // rnd
+        { TableCallBack<6>, 4 },    // Unsupported parameter counts push 0
+        { TableCallBack<7>, -1 },
+    };
+    const char* gszFunctions[] = { "", "min", "max", "sum3", "neg", "rnd" };
+
+    int __fastcall FunctionNameToId(char* szKey)
+    {
+        for (int i = 1; i < (int)std::size(gszFunctions); ++i)
+        {
+            if (!strcmp(szKey, gszFunctions[i]))
+            {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    int __fastcall GetFunctionParameterCount(int nFunctionIndex)
+    {
+        return gtCallbacks[nFunctionIndex].nParameters;
+    }
+
+    // "pN" are parameters read with ParamCallBack, "kN" constants resolved at compile time
+    int __fastcall LinkParse(char* szText, BOOL* pOutHasResolvedToConstant, int nAST, int nKeywordNumber)
+    {
+        if ((szText[0] == 'p' || szText[0] == 'k') && szText[1] >= '0' && szText[1] <= '9' && szText[2] == 0)
+        {
+            *pOutHasResolvedToConstant = szText[0] == 'k';
+            return (szText[1] - '0') * (szText[0] == 'k' ? 1000 : 1);
+        }
+        return -1;
+    }
+
+    std::string RandomFormula(std::mt19937& tRand, int nDepth)
+    {
+        static const char* szOperators[] = { "+", "-", "*", "/", "<", "<=", ">", ">=", "==", "!=" };
+
+        if (nDepth <= 0 || tRand() % 4 == 0)
+        {
+            switch (tRand() % 4)
+            {
+            case 0: return std::to_string(tRand() % 20);
+            case 1: return std::to_string(tRand() % 100000);
+            case 2: return "k" + std::to_string(tRand() % 10);
+            default: return "p" + std::to_string(tRand() % 10);
+            }
+        }
+
+        switch (tRand() % 9)
+        {
+        case 0:
+            return "(" + RandomFormula(tRand, nDepth - 1) + "?" + RandomFormula(tRand, nDepth - 1) + ":" + RandomFormula(tRand, nDepth - 1) + ")";
+        case 1:
+            return "-" + RandomFormula(tRand, nDepth - 1);
+        case 2:
+        {
+            const int nFunction = 1 + tRand() % (std::size(gszFunctions) - 1);
+            std::string szFormula = std::string(gszFunctions[nFunction]) + "(";
+            for (int i = 0; i < gtCallbacks[nFunction].nParameters; ++i)
+            {
+                szFormula += (i ? "," : "") + RandomFormula(tRand, nDepth - 1);
+            }
+            return szFormula + ")";
+        }
+        case 3:
+            // The evaluator multiplies as many times as the exponent, keep it small
+            return "(" + RandomFormula(tRand, nDepth - 1) + "^" + (tRand() % 2 ? std::to_string(tRand() % 12) : "p" + std::to_string(tRand() % 10)) + ")";
+        case 4:
+            // No parenthesis, to use the precedence of the operators
+            return RandomFormula(tRand, nDepth - 1) + szOperators[tRand() % std::size(szOperators)] + RandomFormula(tRand, nDepth - 1);
+        default:
+            return "(" + RandomFormula(tRand, nDepth - 1) + szOperators[tRand() % std::size(szOperators)] + RandomFormula(tRand, nDepth - 1) + ")";
+        }
+    }
+
+    // Formulas appended to a single buffer as done for skillscode.bin, missing formulas are compiled to 0
+    std::vector<FOGASTNodeStrc> CompileFormulas(std::mt19937& tRand, int nFormulas, std::vector<int32_t>& aOffsets)
+    {
+        std::vector<FOGASTNodeStrc> aCode;
+        for (int i = 0; i < nFormulas; ++i)
+        {
+            // Enclosed in parenthesis, DATATBLS_ResolveConstantLink reads the previous pending operation of the parser
+            const std::string szFormula = "(" + RandomFormula(tRand, 1 + tRand() % 6) + ")";
+            FOGASTNodeStrc tBuffer[1024];
+            const int nSize = DATATBLS_CompileExpression(szFormula.c_str(), tBuffer, (int)std::size(tBuffer), FunctionNameToId, GetFunctionParameterCount, LinkParse);
+            if (nSize > 0)
+            {
+                aOffsets.push_back((int32_t)aCode.size());
+                aCode.insert(aCode.end(), tBuffer, tBuffer + nSize);
+            }
+        }
+        return aCode;
+    }
+
+    void RandomizeParams(std::mt19937& tRand, CalcTestUserData& tUserData)
+    {
+        static const int32_t nSpecialValues[] = { 0, 1, -1, 2, 31, 32, 65536, -65536, INT32_MIN + 1 };
+        for (int32_t& nParam : tUserData.nParams)
+        {
+            nParam = tRand() % 3 == 0 ? nSpecialValues[tRand() % std::size(nSpecialValues)] : (int32_t)(tRand() % 2001) - 1000;
+        }
+    }
+
+    void CheckSameResult(const FOGASTNodeStrc* pCode, int32_t nSize, CalcFogCallBack2_t fpParamCallBack, std::mt19937& tRand)
+    {
+        D2CalcProgramStrc tProgram;
+        if (!DATATBLS_CalcCompileProgram(pCode, nSize, fpParamCallBack, gtCallbacks, (int)std::size(gtCallbacks), &tProgram))
+        {
+            // Only the random buffers can be too long for a program
+            return;
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            CalcTestUserData tExpected = {};
+            RandomizeParams(tRand, tExpected);
+            CalcTestUserData tCompiled = tExpected;
+
+            const int nExpectedResult = DATATBLS_CalcEvaluateExpression(pCode, nSize, fpParamCallBack, gtCallbacks, (int)std::size(gtCallbacks), &tExpected);
+            const int nResult = DATATBLS_CalcRunProgram(&tProgram, &tCompiled);
+            REQUIRE(nResult == nExpectedResult);
+            REQUIRE(tCompiled.aCallsLog == tExpected.aCallsLog);
+        }
+    }
+}
+
+TEST_CASE("CALC compiled formulas match the evaluator")
+{
+    std::mt19937 tRand(0x6FF51E30);
+    std::vector<int32_t> aOffsets;
+    const std::vector<FOGASTNodeStrc> aCode = CompileFormulas(tRand, 5000, aOffsets);
+    REQUIRE(aOffsets.size() > 1000);
+
+    for (const int32_t nOffset : aOffsets)
+    {
+        CAPTURE(nOffset);
+        // The game passes the size remaining in the whole code buffer
+        CheckSameResult(&aCode[nOffset], (int32_t)aCode.size() - nOffset, ParamCallBack, tRand);
+        CheckSameResult(&aCode[nOffset], (int32_t)aCode.size() - nOffset, nullptr, tRand);
+    }
+}
+
+TEST_CASE("CALC compiled random buffers match the evaluator")
+{
+    // Stack overflows and underflows, unknown functions, truncated constants, ...
+    std::mt19937 tRand(0x6FF524F0);
+    for (int nIteration = 0; nIteration < 20000; ++nIteration)
+    {
+        // Padding at the end, since the evaluator may read constants past the size it was given
+        std::vector<FOGASTNodeStrc> aCode(1 + tRand() % 100 + sizeof(int32_t) + 1);
+        const int32_t nSize = (int32_t)aCode.size() - sizeof(int32_t) - 1;
+        for (FOGASTNodeStrc& tNode : aCode)
+        {
+            // Mostly constants and operators, which do not end the evaluation. No AST_Power, the exponents would be too large.
+            tNode.nRawValue = tRand() % 8 ? (uint8_t)(AST_CallbackTable + tRand() % (AST_Division - AST_CallbackTable + 1)) : (uint8_t)tRand();
+            if (tNode.nType == AST_Power)
+            {
+                tNode.nType = AST_Negate;
+            }
+        }
+        CAPTURE(nIteration);
+        CheckSameResult(aCode.data(), nSize, ParamCallBack, tRand);
+    }
+
+    // More pushes than the stack can hold, then operators on what was kept
+    std::vector<FOGASTNodeStrc> aCode;
+    for (int i = 0; i < 70; ++i)
+    {
+        aCode.push_back({ AST_Callback_Param_UInt8 });
+        aCode.push_back({ (FOGASTType)(i % nParamsCount) });
+        aCode.push_back({ AST_Raw_Int8 });
+        aCode.push_back({ (FOGASTType)i });
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        aCode.push_back({ (FOGASTType)(AST_LessThan + i % (AST_Division - AST_LessThan + 1)) });
+    }
+    aCode.push_back({ AST_None });
+    CheckSameResult(aCode.data(), (int32_t)aCode.size(), ParamCallBack, tRand);
+}
+
+TEST_CASE("CALC compiled formulas benchmark")
+{
+    std::mt19937 tRand(0x6FF53280);
+    std::vector<int32_t> aOffsets;
+    const std::vector<FOGASTNodeStrc> aCode = CompileFormulas(tRand, 2000, aOffsets);
+
+    std::vector<D2CalcProgramStrc> aPrograms(aOffsets.size());
+    for (size_t i = 0; i < aOffsets.size(); ++i)
+    {
+        REQUIRE(DATATBLS_CalcCompileProgram(&aCode[aOffsets[i]], (int32_t)aCode.size() - aOffsets[i], ParamCallBack, gtCallbacks, (int)std::size(gtCallbacks), &aPrograms[i]));
+    }
+
+    CalcTestUserData tUserData = {};
+    RandomizeParams(tRand, tUserData);
+    tUserData.aCallsLog.reserve(1 << 16);
+    constexpr int nRuns = 50;
+
+    int64_t nExpectedSum = 0;
+    const auto tEvaluateStart = std::chrono::steady_clock::now();
+    for (int nRun = 0; nRun < nRuns; ++nRun)
+    {
+        for (const int32_t nOffset : aOffsets)
+        {
+            tUserData.aCallsLog.clear();
+            nExpectedSum += DATATBLS_CalcEvaluateExpression(&aCode[nOffset], (int32_t)aCode.size() - nOffset, ParamCallBack, gtCallbacks, (int)std::size(gtCallbacks), &tUserData);
+        }
+    }
+    const auto tEvaluateElapsed = std::chrono::steady_clock::now() - tEvaluateStart;
+
+    int64_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int nRun = 0; nRun < nRuns; ++nRun)
+    {
+        for (const D2CalcProgramStrc& tProgram : aPrograms)
+        {
+            tUserData.aCallsLog.clear();
+            nSum += DATATBLS_CalcRunProgram(&tProgram, &tUserData);
+        }
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Evaluator: ", std::chrono::duration_cast<std::chrono::microseconds>(tEvaluateElapsed).count(), "us");
+    MESSAGE("Compiled programs: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
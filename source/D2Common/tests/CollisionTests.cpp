@@ -0,0 +1,97 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <D2Collision.h>
+
+TEST_CASE("COLLISION mask row kernels match the scalar version")
+{
+    const int nSupportedSimdLevel = COLLISION_GetSupportedSimdLevel();
+    const CollisionMaskRowKernel pfScalarKernel = COLLISION_GetMaskRowKernel(COLLISION_SIMD_SCALAR);
+
+    std::mt19937 tRand(0x6FD41B40);
+    for (int nSimdLevel = COLLISION_SIMD_SSE2; nSimdLevel <= nSupportedSimdLevel; ++nSimdLevel)
+    {
+        CAPTURE(nSimdLevel);
+        const CollisionMaskRowKernel pfKernel = COLLISION_GetMaskRowKernel(nSimdLevel);
+
+        for (int nIteration = 0; nIteration < 20000; ++nIteration)
+        {
+            // Sparse masks so that a missed cell is likely to change the result
+            const int nGridSize = 1 + tRand() % 200;
+            std::vector<uint16_t> aGrid(nGridSize);
+            for (uint16_t& nCell : aGrid)
+            {
+                nCell = (tRand() % 8 == 0) ? uint16_t(1 << (tRand() % 16)) : 0;
+            }
+
+            const int nStart = tRand() % nGridSize;
+            const int nWidth = tRand() % (nGridSize - nStart + 1);
+            // Cells after the row must be ignored, even when the kernel reads them
+            const uint16_t* pReadLimit = aGrid.data() + nStart + nWidth + tRand() % (nGridSize - nStart - nWidth + 1);
+            CAPTURE(nGridSize);
+            CAPTURE(nStart);
+            CAPTURE(nWidth);
+            REQUIRE(pfKernel(aGrid.data() + nStart, nWidth, pReadLimit) == pfScalarKernel(aGrid.data() + nStart, nWidth, pReadLimit));
+        }
+    }
+}
+
+TEST_CASE("COLLISION bounding box benchmark")
+{
+    constexpr int nGridSize = 128;
+    std::mt19937 tRand(0x6FD418C0);
+    std::vector<uint16_t> aCollisionMask(nGridSize * nGridSize);
+    for (uint16_t& nCell : aCollisionMask)
+    {
+        nCell = (tRand() % 16 == 0) ? COLLIDE_BLOCK_PLAYER : COLLIDE_NONE;
+    }
+
+    D2RoomCollisionGridStrc tCollisionGrid = {};
+    tCollisionGrid.pRoomCoords.nSubtileX = 5000;
+    tCollisionGrid.pRoomCoords.nSubtileY = 3000;
+    tCollisionGrid.pRoomCoords.nSubtileWidth = nGridSize;
+    tCollisionGrid.pRoomCoords.nSubtileHeight = nGridSize;
+    tCollisionGrid.pCollisionMask = aCollisionMask.data();
+
+    // Mostly unit sized boxes, and a few large ones as used when looking for free coordinates
+    std::vector<D2BoundingBoxStrc> aBoundingBoxes(100000);
+    for (D2BoundingBoxStrc& tBoundingBox : aBoundingBoxes)
+    {
+        const int nSize = (tRand() % 10 == 0) ? 8 + tRand() % 32 : 1 + tRand() % 5;
+        tBoundingBox.nLeft = tCollisionGrid.pRoomCoords.nSubtileX + tRand() % (nGridSize - nSize);
+        tBoundingBox.nBottom = tCollisionGrid.pRoomCoords.nSubtileY + tRand() % (nGridSize - nSize);
+        tBoundingBox.nRight = tBoundingBox.nLeft + nSize - 1;
+        tBoundingBox.nTop = tBoundingBox.nBottom + nSize - 1;
+    }
+
+    uint64_t nExpectedCollisions = 0;
+    const CollisionMaskRowKernel pfScalarKernel = COLLISION_GetMaskRowKernel(COLLISION_SIMD_SCALAR);
+    const auto tScalarStart = std::chrono::steady_clock::now();
+    for (const D2BoundingBoxStrc& tBoundingBox : aBoundingBoxes)
+    {
+        uint16_t nResult = 0;
+        for (int nY = tBoundingBox.nBottom; nY <= tBoundingBox.nTop; ++nY)
+        {
+            const uint16_t* pRow = &aCollisionMask[(nY - tCollisionGrid.pRoomCoords.nSubtileY) * nGridSize + tBoundingBox.nLeft - tCollisionGrid.pRoomCoords.nSubtileX];
+            nResult |= pfScalarKernel(pRow, tBoundingBox.nRight - tBoundingBox.nLeft + 1, nullptr);
+        }
+        nExpectedCollisions += (nResult & COLLIDE_MASK_WALKING_UNIT) != 0;
+    }
+    const auto tScalarElapsed = std::chrono::steady_clock::now() - tScalarStart;
+
+    uint64_t nCollisions = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (D2BoundingBoxStrc& tBoundingBox : aBoundingBoxes)
+    {
+        nCollisions += COLLISION_CheckCollisionMaskForBoundingBox(&tCollisionGrid, &tBoundingBox, COLLIDE_MASK_WALKING_UNIT) != 0;
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nCollisions == nExpectedCollisions);
+    MESSAGE("SIMD level: ", COLLISION_GetSupportedSimdLevel());
+    MESSAGE("Scalar: ", std::chrono::duration_cast<std::chrono::microseconds>(tScalarElapsed).count(), "us");
+    MESSAGE("Dispatched: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
@@ -0,0 +1,190 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <Drlg/D2DrlgDrlg.h>
+#include <Drlg/D2DrlgDrlgRoom.h>
+#include <Drlg/D2DrlgRoomIndex.h>
+
+namespace
+{
+    // Linear search in the rooms of the level, as done by DRLG_GetRoomExFromLevelAndCoordinates, used as a reference.
+    namespace Reference
+    {
+        D2DrlgRoomStrc* FindRoom(D2DrlgLevelStrc* pLevel, int nX, int nY)
+        {
+            for (D2DrlgRoomStrc* pDrlgRoom = pLevel->pFirstRoomEx; pDrlgRoom; pDrlgRoom = pDrlgRoom->pDrlgRoomNext)
+            {
+                if (DRLGROOM_AreXYInsideCoordinates(&pDrlgRoom->pDrlgCoord, nX, nY))
+                {
+                    return pDrlgRoom;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    struct TestLevel
+    {
+        D2DrlgLevelStrc tLevel = {};
+        std::vector<D2DrlgRoomStrc> aRooms;
+
+        void AddRoom(int nX, int nY, int nWidth, int nHeight)
+        {
+            D2DrlgRoomStrc tDrlgRoom = {};
+            tDrlgRoom.nTileXPos = nX;
+            tDrlgRoom.nTileYPos = nY;
+            tDrlgRoom.nTileWidth = nWidth;
+            tDrlgRoom.nTileHeight = nHeight;
+            aRooms.push_back(tDrlgRoom);
+        }
+
+        void Finalize()
+        {
+            // Rooms are added at the head of the level, the last room created is the first one searched
+            tLevel.pFirstRoomEx = nullptr;
+            for (D2DrlgRoomStrc& tDrlgRoom : aRooms)
+            {
+                tDrlgRoom.pLevel = &tLevel;
+                tDrlgRoom.pDrlgRoomNext = tLevel.pFirstRoomEx;
+                tLevel.pFirstRoomEx = &tDrlgRoom;
+            }
+            tLevel.nRooms = (int32_t)aRooms.size();
+        }
+    };
+
+    // Outdoor levels are grids of 8x8 tiles rooms
+    TestLevel CreateOutdoorLevel(std::mt19937& tRand, int nRoomsX, int nRoomsY)
+    {
+        TestLevel tLevel;
+        const int nOriginX = tRand() % 2000;
+        const int nOriginY = tRand() % 2000;
+        for (int nY = 0; nY < nRoomsY; ++nY)
+        {
+            for (int nX = 0; nX < nRoomsX; ++nX)
+            {
+                tLevel.AddRoom(nOriginX + nX * 8, nOriginY + nY * 8, 8, 8);
+            }
+        }
+        tLevel.Finalize();
+        return tLevel;
+    }
+
+    // Maze levels have rooms of various sizes with gaps between them, some rooms overlap or are empty
+    TestLevel CreateMazeLevel(std::mt19937& tRand, int nRooms)
+    {
+        TestLevel tLevel;
+        const int nOriginX = (int)(tRand() % 4000) - 1000;
+        const int nOriginY = (int)(tRand() % 4000) - 1000;
+        for (int i = 0; i < nRooms; ++i)
+        {
+            tLevel.AddRoom(nOriginX + tRand() % 300, nOriginY + tRand() % 300, tRand() % 50, tRand() % 50);
+        }
+        tLevel.Finalize();
+        return tLevel;
+    }
+
+    void CheckLevel(std::mt19937& tRand, TestLevel& tLevel)
+    {
+        std::vector<uint8_t> aBuffer(DRLGROOMINDEX_GetIndexSize(&tLevel.tLevel));
+        const D2DrlgRoomIndexStrc* pIndex = DRLGROOMINDEX_BuildIndex(&tLevel.tLevel, aBuffer.data());
+
+        int nMinX = 0;
+        int nMinY = 0;
+        int nMaxX = 0;
+        int nMaxY = 0;
+        if (tLevel.tLevel.pFirstRoomEx)
+        {
+            DRLG_GetMinAndMaxCoordinatesFromLevel(&tLevel.tLevel, &nMinX, &nMinY, &nMaxX, &nMaxY);
+        }
+
+        // Every position of the level, and a margin around it
+        for (int nY = nMinY - 20; nY < nMaxY + 20; ++nY)
+        {
+            for (int nX = nMinX - 20; nX < nMaxX + 20; ++nX)
+            {
+                CAPTURE(nX);
+                CAPTURE(nY);
+                REQUIRE(DRLGROOMINDEX_FindRoom(pIndex, nX, nY) == Reference::FindRoom(&tLevel.tLevel, nX, nY));
+            }
+        }
+
+        // Far away positions
+        for (int i = 0; i < 100; ++i)
+        {
+            const int nX = (int)(tRand() % 100000) - 50000;
+            const int nY = (int)(tRand() % 100000) - 50000;
+            CAPTURE(nX);
+            CAPTURE(nY);
+            REQUIRE(DRLGROOMINDEX_FindRoom(pIndex, nX, nY) == Reference::FindRoom(&tLevel.tLevel, nX, nY));
+        }
+    }
+}
+
+TEST_CASE("DRLGROOMINDEX lookups match the linear search")
+{
+    std::mt19937 tRand(0x6FD74F20);
+
+    TestLevel tEmptyLevel;
+    CheckLevel(tRand, tEmptyLevel);
+
+    for (int nIteration = 0; nIteration < 50; ++nIteration)
+    {
+        CAPTURE(nIteration);
+        TestLevel tOutdoorLevel = CreateOutdoorLevel(tRand, 1 + tRand() % 20, 1 + tRand() % 20);
+        CheckLevel(tRand, tOutdoorLevel);
+
+        TestLevel tMazeLevel = CreateMazeLevel(tRand, 1 + tRand() % 60);
+        CheckLevel(tRand, tMazeLevel);
+    }
+
+    // Levels larger than DRLGROOMINDEX_MAX_CELLS cells of the default size use larger cells
+    TestLevel tLargeLevel = CreateOutdoorLevel(tRand, 200, 150);
+    std::vector<uint8_t> aBuffer(DRLGROOMINDEX_GetIndexSize(&tLargeLevel.tLevel));
+    const D2DrlgRoomIndexStrc* pIndex = DRLGROOMINDEX_BuildIndex(&tLargeLevel.tLevel, aBuffer.data());
+    CHECK(pIndex->nCellSizeShift > DRLGROOMINDEX_CELL_SIZE_SHIFT);
+    CHECK(pIndex->nCellsX * pIndex->nCellsY <= DRLGROOMINDEX_MAX_CELLS);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int nX = tLargeLevel.aRooms[0].nTileXPos + (int)(tRand() % (200 * 8 + 10)) - 5;
+        const int nY = tLargeLevel.aRooms[0].nTileYPos + (int)(tRand() % (150 * 8 + 10)) - 5;
+        REQUIRE(DRLGROOMINDEX_FindRoom(pIndex, nX, nY) == Reference::FindRoom(&tLargeLevel.tLevel, nX, nY));
+    }
+}
+
+TEST_CASE("DRLGROOMINDEX benchmark")
+{
+    // Outdoor level the size of the Blood Moor, with lookups spread over the level
+    std::mt19937 tRand(0x6FD74F70);
+    TestLevel tLevel = CreateOutdoorLevel(tRand, 28, 50);
+    std::vector<uint8_t> aBuffer(DRLGROOMINDEX_GetIndexSize(&tLevel.tLevel));
+    const D2DrlgRoomIndexStrc* pIndex = DRLGROOMINDEX_BuildIndex(&tLevel.tLevel, aBuffer.data());
+
+    std::vector<std::pair<int, int>> aPositions;
+    for (int i = 0; i < 100000; ++i)
+    {
+        aPositions.emplace_back(tLevel.aRooms[0].nTileXPos + tRand() % (28 * 8), tLevel.aRooms[0].nTileYPos + tRand() % (50 * 8));
+    }
+
+    size_t nExpectedSum = 0;
+    const auto tLinearStart = std::chrono::steady_clock::now();
+    for (const auto& tPosition : aPositions)
+    {
+        nExpectedSum += Reference::FindRoom(&tLevel.tLevel, tPosition.first, tPosition.second) - tLevel.aRooms.data();
+    }
+    const auto tLinearElapsed = std::chrono::steady_clock::now() - tLinearStart;
+
+    size_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (const auto& tPosition : aPositions)
+    {
+        nSum += DRLGROOMINDEX_FindRoom(pIndex, tPosition.first, tPosition.second) - tLevel.aRooms.data();
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Linear search: ", std::chrono::duration_cast<std::chrono::microseconds>(tLinearElapsed).count(), "us");
+    MESSAGE("Indexed search: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
@@ -0,0 +1,388 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <D2Inventory.h>
+
+namespace
+{
+    // Original versions of the grid searches, testing the cells one by one, used as a reference.
+    namespace Legacy
+    {
+        BOOL CanItemBePlacedAtPos(D2InventoryGridStrc* pInventoryGrid, int nX, int nY, uint8_t nItemWidth, uint8_t nItemHeight)
+        {
+            if (nItemWidth + nX > pInventoryGrid->nGridWidth || nItemHeight + nY > pInventoryGrid->nGridHeight)
+            {
+                return FALSE;
+            }
+
+            for (int nTestY = 0; nTestY < nItemHeight; ++nTestY)
+            {
+                for (int nTestX = 0; nTestX < nItemWidth; ++nTestX)
+                {
+                    if (pInventoryGrid->ppItems[(nX + nTestX) + (nY + nTestY) * pInventoryGrid->nGridWidth])
+                    {
+                        return FALSE;
+                    }
+                }
+            }
+
+            return TRUE;
+        }
+
+        uint8_t GetPlacementWeight(D2InventoryGridStrc* pInventoryGrid, int nXPos, int nYPos, uint8_t nItemWidth, uint8_t nItemHeight)
+        {
+            uint8_t nResult = 0;
+
+            if (nXPos > 0)
+            {
+                for (int i = 0; i < nItemHeight; ++i)
+                {
+                    if (pInventoryGrid->ppItems[nXPos - 1 + (nYPos + i) * pInventoryGrid->nGridWidth])
+                    {
+                        ++nResult;
+                    }
+                }
+            }
+            else
+            {
+                nResult = nItemHeight;
+            }
+
+            if (nXPos + nItemWidth < pInventoryGrid->nGridWidth)
+            {
+                for (int i = 0; i < nItemHeight; ++i)
+                {
+                    if (pInventoryGrid->ppItems[nXPos + nItemWidth + (nYPos + i) * pInventoryGrid->nGridWidth])
+                    {
+                        ++nResult;
+                    }
+                }
+            }
+            else
+            {
+                nResult += nItemHeight;
+            }
+
+            if (nYPos > 0)
+            {
+                for (int i = 0; i < nItemWidth; ++i)
+                {
+                    if (pInventoryGrid->ppItems[(nXPos + i) + (nYPos - 1) * pInventoryGrid->nGridWidth])
+                    {
+                        ++nResult;
+                    }
+                }
+            }
+            else
+            {
+                nResult += nItemWidth;
+            }
+
+            if (nYPos + nItemHeight < pInventoryGrid->nGridHeight)
+            {
+                for (int i = 0; i < nItemWidth; ++i)
+                {
+                    if (pInventoryGrid->ppItems[(nXPos + i) + (nYPos + nItemHeight) * pInventoryGrid->nGridWidth])
+                    {
+                        ++nResult;
+                    }
+                }
+            }
+            else
+            {
+                nResult += nItemWidth;
+            }
+
+            if (nResult >= 2 * (nItemHeight + nItemWidth))
+            {
+                nResult = 255;
+            }
+
+            return nResult;
+        }
+
+        BOOL FindFreePositionBottomRightToTopLeftWithWeight(D2InventoryGridStrc* pInventoryGrid, int* pFreeX, int* pFreeY, uint8_t nItemWidth, uint8_t nItemHeight)
+        {
+            if (pInventoryGrid->nGridWidth < 1 || pInventoryGrid->nGridHeight < 1)
+            {
+                return FALSE;
+            }
+
+            uint8_t nMax = 0;
+            for (int nX = pInventoryGrid->nGridWidth - 1; nX >= 0; --nX)
+            {
+                for (int nY = pInventoryGrid->nGridHeight - 1; nY >= 0; --nY)
+                {
+                    if (CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
+                    {
+                        const uint8_t nWeight = GetPlacementWeight(pInventoryGrid, nX, nY, nItemWidth, nItemHeight);
+                        if (nWeight > nMax)
+                        {
+                            nMax = nWeight;
+                            *pFreeX = nX;
+                            *pFreeY = nY;
+                            if (nWeight == 255)
+                            {
+                                return TRUE;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return nMax > 0;
+        }
+
+        BOOL FindFreePositionTopLeftToBottomRightWithWeight(D2InventoryGridStrc* pInventoryGrid, int* pFreeX, int* pFreeY, uint8_t nItemWidth, uint8_t nItemHeight)
+        {
+            if (pInventoryGrid->nGridWidth <= 0 || pInventoryGrid->nGridHeight <= 0)
+            {
+                return FALSE;
+            }
+
+            uint8_t nMax = 0;
+            for (int nY = 0; nY < pInventoryGrid->nGridHeight; ++nY)
+            {
+                for (int nX = 0; nX < pInventoryGrid->nGridWidth; ++nX)
+                {
+                    if (CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
+                    {
+                        const uint8_t nWeight = GetPlacementWeight(pInventoryGrid, nX, nY, nItemWidth, nItemHeight);
+                        if (nWeight > nMax)
+                        {
+                            nMax = nWeight;
+                            *pFreeX = nX;
+                            *pFreeY = nY;
+                            if (nWeight == 255)
+                            {
+                                return TRUE;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return nMax > 0;
+        }
+
+        BOOL FindFreePositionTopLeftToBottomRight(D2InventoryGridStrc* pInventoryGrid, int* pFreeX, int* pFreeY, uint8_t nItemWidth, uint8_t nItemHeight)
+        {
+            for (int nX = 0; nX < pInventoryGrid->nGridWidth; ++nX)
+            {
+                for (int nY = 0; nY < pInventoryGrid->nGridHeight; ++nY)
+                {
+                    if (CanItemBePlacedAtPos(pInventoryGrid, nX, nY, nItemWidth, nItemHeight))
+                    {
+                        *pFreeX = nX;
+                        *pFreeY = nY;
+                        return TRUE;
+                    }
+                }
+            }
+
+            return FALSE;
+        }
+    }
+
+    // Grid allocated the same way as INVENTORY_AllocGridCells, filled with fake item pointers
+    struct TestGrid
+    {
+        D2InventoryGridStrc tGrid = {};
+        std::vector<D2UnitStrc*> aCells;
+        std::vector<uint32_t> aRowMasks;
+        std::vector<uint8_t> aItems;
+
+        TestGrid(int nWidth, int nHeight)
+            : aCells(nWidth * nHeight), aRowMasks(nHeight), aItems(256)
+        {
+            tGrid.nGridWidth = (uint8_t)nWidth;
+            tGrid.nGridHeight = (uint8_t)nHeight;
+            tGrid.ppItems = aCells.data();
+            tGrid.pRowMasks = nWidth <= INVENTORY_GRID_MAX_MASK_WIDTH ? aRowMasks.data() : nullptr;
+        }
+
+        void Fill(std::mt19937& tRand, int nFillPercent)
+        {
+            // Items are placed where they fit, then some are removed, like an inventory after some trading
+            for (int nItem = 0; nItem < (int)aItems.size(); ++nItem)
+            {
+                const uint8_t nWidth = 1 + tRand() % 3;
+                const uint8_t nHeight = 1 + tRand() % 4;
+                const int nX = tRand() % tGrid.nGridWidth;
+                const int nY = tRand() % tGrid.nGridHeight;
+                if ((int)(tRand() % 100) < nFillPercent && Legacy::CanItemBePlacedAtPos(&tGrid, nX, nY, nWidth, nHeight))
+                {
+                    INVENTORY_SetGridCells(&tGrid, nX, nY, nWidth, nHeight, (D2UnitStrc*)&aItems[nItem]);
+                }
+                else if (tRand() % 4 == 0)
+                {
+                    const int nRemovedWidth = std::min<int>(nWidth, tGrid.nGridWidth - nX);
+                    const int nRemovedHeight = std::min<int>(nHeight, tGrid.nGridHeight - nY);
+                    INVENTORY_SetGridCells(&tGrid, nX, nY, nRemovedWidth, nRemovedHeight, nullptr);
+                }
+            }
+        }
+    };
+}
+
+TEST_CASE("INVENTORY row masks match the cells")
+{
+    std::mt19937 tRand(0x6FD8EC70);
+
+    // Belt, cube, inventory, stash, and a wide grid that has no row masks
+    const int aSizes[][2] = { { 4, 4 }, { 3, 4 }, { 10, 4 }, { 6, 8 }, { 10, 10 }, { 16, 13 }, { 32, 3 }, { 40, 5 } };
+    for (int nIteration = 0; nIteration < 200; ++nIteration)
+    {
+        for (const auto& aSize : aSizes)
+        {
+            TestGrid tGrid(aSize[0], aSize[1]);
+            tGrid.Fill(tRand, tRand() % 100);
+
+            for (int nY = 0; nY < tGrid.tGrid.nGridHeight && tGrid.tGrid.pRowMasks; ++nY)
+            {
+                for (int nX = 0; nX < tGrid.tGrid.nGridWidth; ++nX)
+                {
+                    REQUIRE(((tGrid.tGrid.pRowMasks[nY] >> nX) & 1) == (tGrid.tGrid.ppItems[nX + nY * tGrid.tGrid.nGridWidth] != nullptr));
+                }
+            }
+
+            for (uint8_t nItemWidth = 1; nItemWidth <= 4; ++nItemWidth)
+            {
+                for (uint8_t nItemHeight = 1; nItemHeight <= 4; ++nItemHeight)
+                {
+                    CAPTURE(aSize[0]);
+                    CAPTURE(aSize[1]);
+                    CAPTURE(nItemWidth);
+                    CAPTURE(nItemHeight);
+
+                    for (int nY = 0; nY < tGrid.tGrid.nGridHeight; ++nY)
+                    {
+                        for (int nX = 0; nX < tGrid.tGrid.nGridWidth; ++nX)
+                        {
+                            const BOOL bCanBePlaced = INVENTORY_CanItemBePlacedAtPos(&tGrid.tGrid, nX, nY, nItemWidth, nItemHeight);
+                            REQUIRE(bCanBePlaced == Legacy::CanItemBePlacedAtPos(&tGrid.tGrid, nX, nY, nItemWidth, nItemHeight));
+                            if (bCanBePlaced)
+                            {
+                                REQUIRE(INVENTORY_GetPlacementWeight(&tGrid.tGrid, nX, nY, nItemWidth, nItemHeight) == Legacy::GetPlacementWeight(&tGrid.tGrid, nX, nY, nItemWidth, nItemHeight));
+                            }
+                        }
+                    }
+
+                    int nFreeX = -1, nFreeY = -1, nExpectedFreeX = -1, nExpectedFreeY = -1;
+                    REQUIRE(INVENTORY_FindFreePositionBottomRightToTopLeftWithWeight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) == Legacy::FindFreePositionBottomRightToTopLeftWithWeight(&tGrid.tGrid, &nExpectedFreeX, &nExpectedFreeY, nItemWidth, nItemHeight));
+                    REQUIRE(nFreeX == nExpectedFreeX);
+                    REQUIRE(nFreeY == nExpectedFreeY);
+
+                    REQUIRE(INVENTORY_FindFreePositionTopLeftToBottomRightWithWeight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) == Legacy::FindFreePositionTopLeftToBottomRightWithWeight(&tGrid.tGrid, &nExpectedFreeX, &nExpectedFreeY, nItemWidth, nItemHeight));
+                    REQUIRE(nFreeX == nExpectedFreeX);
+                    REQUIRE(nFreeY == nExpectedFreeY);
+
+                    REQUIRE(INVENTORY_FindFreePositionTopLeftToBottomRight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) == Legacy::FindFreePositionTopLeftToBottomRight(&tGrid.tGrid, &nExpectedFreeX, &nExpectedFreeY, nItemWidth, nItemHeight));
+                    REQUIRE(nFreeX == nExpectedFreeX);
+                    REQUIRE(nFreeY == nExpectedFreeY);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("INVENTORY free position search benchmark")
+{
+    // Mostly full 10x10 stashes, searched for every item size, as when a vendor is restocked or the cube output is placed
+    std::mt19937 tRand(0x6FD8EFB0);
+    std::vector<TestGrid> aGrids;
+    for (int i = 0; i < 200; ++i)
+    {
+        aGrids.emplace_back(10, 10);
+        aGrids.back().Fill(tRand, 90);
+    }
+
+    constexpr int nPasses = 20;
+    int64_t nExpectedSum = 0;
+    const auto tLegacyStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        for (TestGrid& tGrid : aGrids)
+        {
+            for (uint8_t nItemWidth = 1; nItemWidth <= 2; ++nItemWidth)
+            {
+                for (uint8_t nItemHeight = 1; nItemHeight <= 4; ++nItemHeight)
+                {
+                    int nFreeX = 0, nFreeY = 0;
+                    nExpectedSum += Legacy::FindFreePositionTopLeftToBottomRightWithWeight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) + nFreeX + nFreeY;
+                    nExpectedSum += Legacy::FindFreePositionTopLeftToBottomRight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) + nFreeX + nFreeY;
+                }
+            }
+        }
+    }
+    const auto tLegacyElapsed = std::chrono::steady_clock::now() - tLegacyStart;
+
+    int64_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        for (TestGrid& tGrid : aGrids)
+        {
+            for (uint8_t nItemWidth = 1; nItemWidth <= 2; ++nItemWidth)
+            {
+                for (uint8_t nItemHeight = 1; nItemHeight <= 4; ++nItemHeight)
+                {
+                    int nFreeX = 0, nFreeY = 0;
+                    nSum += INVENTORY_FindFreePositionTopLeftToBottomRightWithWeight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) + nFreeX + nFreeY;
+                    nSum += INVENTORY_FindFreePositionTopLeftToBottomRight(&tGrid.tGrid, &nFreeX, &nFreeY, nItemWidth, nItemHeight) + nFreeX + nFreeY;
+                }
+            }
+        }
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Cell by cell search: ", std::chrono::duration_cast<std::chrono::microseconds>(tLegacyElapsed).count(), "us");
+    MESSAGE("Row mask search: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
+
+TEST_CASE("INVENTORY trade grids see the copied items and the reserved cells")
+{
+    // Same steps as INVENTORY_CanItemsBeTraded: the inventory of the player is copied to a trade grid,
+    // then the cells of each traded item are reserved where INVENTORY_GetFreePosition finds room for it
+    TestGrid tInventory(10, 4);
+    TestGrid tTradeGrid(10, 4);
+    D2UnitStrc* pReserved = (D2UnitStrc*)0xFFFFFFFF;
+    int nFreeX = -1, nFreeY = -1;
+
+    SUBCASE("Full inventory")
+    {
+        INVENTORY_SetGridCells(&tInventory.tGrid, 0, 0, 10, 4, (D2UnitStrc*)&tInventory.aItems[0]);
+        INVENTORY_CopyGridCells(&tTradeGrid.tGrid, &tInventory.tGrid);
+
+        CHECK_FALSE(Legacy::FindFreePositionTopLeftToBottomRight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 1));
+        CHECK_FALSE(INVENTORY_FindFreePositionTopLeftToBottomRight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 1));
+        CHECK_FALSE(INVENTORY_FindFreePositionTopLeftToBottomRightWithWeight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 2));
+        CHECK_FALSE(INVENTORY_FindFreePositionBottomRightToTopLeftWithWeight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 1));
+    }
+
+    SUBCASE("Inventory filled by the traded items")
+    {
+        // Room for a single 1x2 item
+        INVENTORY_SetGridCells(&tInventory.tGrid, 0, 0, 10, 4, (D2UnitStrc*)&tInventory.aItems[0]);
+        INVENTORY_SetGridCells(&tInventory.tGrid, 7, 1, 1, 2, nullptr);
+        INVENTORY_CopyGridCells(&tTradeGrid.tGrid, &tInventory.tGrid);
+
+        REQUIRE(INVENTORY_FindFreePositionTopLeftToBottomRight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 2));
+        CHECK(nFreeX == 7);
+        CHECK(nFreeY == 1);
+        INVENTORY_SetGridCells(&tTradeGrid.tGrid, nFreeX, nFreeY, 1, 2, pReserved);
+
+        // The second item does not fit anymore
+        CHECK_FALSE(Legacy::FindFreePositionTopLeftToBottomRight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 1));
+        CHECK_FALSE(INVENTORY_FindFreePositionTopLeftToBottomRight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 1));
+        CHECK_FALSE(INVENTORY_FindFreePositionBottomRightToTopLeftWithWeight(&tTradeGrid.tGrid, &nFreeX, &nFreeY, 1, 1));
+
+        // The inventory of the player is unchanged
+        CHECK(INVENTORY_FindFreePositionTopLeftToBottomRight(&tInventory.tGrid, &nFreeX, &nFreeY, 1, 2));
+    }
+}
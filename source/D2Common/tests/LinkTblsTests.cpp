@@ -0,0 +1,203 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <D2DataTbls.h>
+
+namespace
+{
+    // Linear lookups in the linker, as done by FOG_GetLinkIndex and FOG_GetRowFromTxt, used as a reference.
+    namespace Reference
+    {
+        int GetLinkIndex(const D2TxtLinkStrc* pLinker, uint32_t dwCode)
+        {
+            for (int i = 0; i < pLinker->nRecords; ++i)
+            {
+                if (pLinker->pTbl[i].dwCode == dwCode)
+                {
+                    return pLinker->pTbl[i].nLinkIndex;
+                }
+            }
+            return -1;
+        }
+
+        int GetRowFromTxt(const D2TxtLinkStrc* pLinker, const char* szText)
+        {
+            for (const D2TxtLinkNodeStrc* pNode = pLinker->pFirstNode; pNode; pNode = pNode->pNext)
+            {
+                if (!strcmp(pNode->szText, szText))
+                {
+                    return pNode->nLinkIndex;
+                }
+            }
+            return -1;
+        }
+    }
+
+    // Linker built the way Fog builds them, one code and one string per record
+    struct TestLinker
+    {
+        D2TxtLinkStrc tLinker = {};
+        std::vector<D2TxtLinkTblStrc> aCodes;
+        std::vector<D2TxtLinkNodeStrc> aNodes;
+
+        void Finalize()
+        {
+            for (size_t i = 0; i < aNodes.size(); ++i)
+            {
+                aNodes[i].pPrevious = i > 0 ? &aNodes[i - 1] : nullptr;
+                aNodes[i].pNext = i + 1 < aNodes.size() ? &aNodes[i + 1] : nullptr;
+            }
+            tLinker.nRecords = (int32_t)aCodes.size();
+            tLinker.nAllocatedCells = (int32_t)aCodes.size();
+            tLinker.pTbl = aCodes.data();
+            tLinker.pFirstNode = aNodes.empty() ? nullptr : aNodes.data();
+        }
+    };
+
+    uint32_t RandomCode(std::mt19937& tRand)
+    {
+        // Item codes such as "hax " or "7gw": lowercase letters and digits, padded with spaces
+        const char szChars[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+        char szCode[4] = { ' ', ' ', ' ', ' ' };
+        const int nLength = 3 + tRand() % 2;
+        for (int i = 0; i < nLength; ++i)
+        {
+            szCode[i] = szChars[tRand() % (sizeof(szChars) - 1)];
+        }
+        uint32_t dwCode = 0;
+        memcpy(&dwCode, szCode, sizeof(dwCode));
+        return dwCode;
+    }
+
+    std::string RandomName(std::mt19937& tRand)
+    {
+        // Unique and set item names, with some case only variations
+        std::string szName;
+        const int nLength = 1 + tRand() % 31;
+        for (int i = 0; i < nLength; ++i)
+        {
+            szName += (char)((tRand() % 4 ? 'a' : 'A') + tRand() % 3);
+        }
+        return szName;
+    }
+
+    TestLinker CreateLinker(std::mt19937& tRand, int nRecords)
+    {
+        TestLinker tLinker;
+        for (int i = 0; i < nRecords; ++i)
+        {
+            D2TxtLinkTblStrc tCode = {};
+            tCode.dwCode = RandomCode(tRand);
+            tCode.nLinkIndex = i;
+            tLinker.aCodes.push_back(tCode);
+
+            D2TxtLinkNodeStrc tNode = {};
+            const std::string szName = RandomName(tRand);
+            memcpy(tNode.szText, szName.c_str(), szName.size() + 1);
+            tNode.nLinkIndex = i;
+            tLinker.aNodes.push_back(tNode);
+        }
+        tLinker.Finalize();
+        return tLinker;
+    }
+}
+
+TEST_CASE("DATATBLS link indices match the linear lookups")
+{
+    std::mt19937 tRand(0x6FD576D0);
+
+    for (int nIteration = 0; nIteration < 200; ++nIteration)
+    {
+        // Few records with short names so that duplicates are frequent
+        const int nRecords = tRand() % (nIteration % 2 ? 20 : 1000);
+        TestLinker tLinker = CreateLinker(tRand, nRecords);
+
+        std::vector<uint8_t> aBuffer(DATATBLS_GetLinkIndexSize(&tLinker.tLinker));
+        const D2TxtLinkIndexStrc* pIndex = DATATBLS_BuildLinkIndex(&tLinker.tLinker, aBuffer.data());
+
+        for (int nLookup = 0; nLookup < 1000; ++nLookup)
+        {
+            const bool bExisting = nRecords && tRand() % 2;
+            const uint32_t dwCode = bExisting ? tLinker.aCodes[tRand() % nRecords].dwCode : RandomCode(tRand);
+            const std::string szName = bExisting ? tLinker.aNodes[tRand() % nRecords].szText : RandomName(tRand);
+            CAPTURE(dwCode);
+            CAPTURE(szName);
+
+            // Not found means that the lookup is forwarded to Fog, which happens for missing and duplicated keys
+            const int nLinkIndex = DATATBLS_FindCodeInLinkIndex(pIndex, dwCode);
+            const int nExpectedLinkIndex = Reference::GetLinkIndex(&tLinker.tLinker, dwCode);
+            REQUIRE((nLinkIndex == nExpectedLinkIndex || nLinkIndex == LINKINDEX_NOT_FOUND));
+
+            const int nRow = DATATBLS_FindStringInLinkIndex(pIndex, szName.c_str());
+            const int nExpectedRow = Reference::GetRowFromTxt(&tLinker.tLinker, szName.c_str());
+            REQUIRE((nRow == nExpectedRow || nRow == LINKINDEX_NOT_FOUND));
+
+            int nCodeCount = 0;
+            int nNameCount = 0;
+            for (int i = 0; i < nRecords; ++i)
+            {
+                nCodeCount += tLinker.aCodes[i].dwCode == dwCode;
+                nNameCount += !_stricmp(tLinker.aNodes[i].szText, szName.c_str());
+            }
+            if (nCodeCount == 1)
+            {
+                REQUIRE(nLinkIndex == nExpectedLinkIndex);
+            }
+            if (nNameCount == 1)
+            {
+                REQUIRE(nRow == nExpectedRow);
+            }
+        }
+    }
+
+    // Names that do not fit in the linker are never found
+    TestLinker tLinker = CreateLinker(tRand, 10);
+    std::vector<uint8_t> aBuffer(DATATBLS_GetLinkIndexSize(&tLinker.tLinker));
+    const D2TxtLinkIndexStrc* pIndex = DATATBLS_BuildLinkIndex(&tLinker.tLinker, aBuffer.data());
+    CHECK(DATATBLS_FindStringInLinkIndex(pIndex, std::string(40, 'a').c_str()) == LINKINDEX_NOT_FOUND);
+}
+
+TEST_CASE("DATATBLS link indices benchmark")
+{
+    // Synthetic linkers the size of items.txt (no tables are shipped with the repository), every code and name is resolved
+    std::mt19937 tRand(0x6FD57720);
+    TestLinker tLinker = CreateLinker(tRand, 650);
+    std::vector<uint8_t> aBuffer(DATATBLS_GetLinkIndexSize(&tLinker.tLinker));
+    const D2TxtLinkIndexStrc* pIndex = DATATBLS_BuildLinkIndex(&tLinker.tLinker, aBuffer.data());
+
+    constexpr int nPasses = 200;
+    int64_t nExpectedSum = 0;
+    const auto tLinearStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        for (int i = 0; i < tLinker.tLinker.nRecords; ++i)
+        {
+            nExpectedSum += Reference::GetLinkIndex(&tLinker.tLinker, tLinker.aCodes[i].dwCode);
+            nExpectedSum += Reference::GetRowFromTxt(&tLinker.tLinker, tLinker.aNodes[i].szText);
+        }
+    }
+    const auto tLinearElapsed = std::chrono::steady_clock::now() - tLinearStart;
+
+    int64_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        for (int i = 0; i < tLinker.tLinker.nRecords; ++i)
+        {
+            int nLinkIndex = DATATBLS_FindCodeInLinkIndex(pIndex, tLinker.aCodes[i].dwCode);
+            nSum += nLinkIndex != LINKINDEX_NOT_FOUND ? nLinkIndex : Reference::GetLinkIndex(&tLinker.tLinker, tLinker.aCodes[i].dwCode);
+            nLinkIndex = DATATBLS_FindStringInLinkIndex(pIndex, tLinker.aNodes[i].szText);
+            nSum += nLinkIndex != LINKINDEX_NOT_FOUND ? nLinkIndex : Reference::GetRowFromTxt(&tLinker.tLinker, tLinker.aNodes[i].szText);
+        }
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Linear lookups: ", std::chrono::duration_cast<std::chrono::microseconds>(tLinearElapsed).count(), "us");
+    MESSAGE("Indexed lookups: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
@@ -0,0 +1,391 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <D2Collision.h>
+#include <Drlg/D2DrlgDrlg.h>
+#include <Path/IDAStar.h>
+#include <Path/FollowWall.h>
+#include <Path/PathMisc.h>
+
+namespace
+{
+    // Implementation of IDA* as it was before the nodes were stored as a struct of arrays, used as a reference.
+    namespace Legacy
+    {
+        struct D2PathIDAStarNodeStrc
+        {
+            uint16_t nFScore;
+            uint16_t nHeuristicDistanceToTarget;
+            uint16_t nBestDistanceFromStart;
+            int16_t nEvaluationsCount;
+            D2PathPointStrc tCoord;
+            const int* pNeighborsSequence;
+            int nNextNeighborIndex;
+            D2PathIDAStarNodeStrc* pParent;
+            D2PathIDAStarNodeStrc* pBestChild;
+        };
+
+        struct D2PathIDAStarContextStrc
+        {
+            D2PathIDAStarNodeStrc* pCurrentNode;
+            D2PathIDAStarNodeStrc aNodesStorage[IDASTAR_MAXNODES];
+            int32_t nNodesCount;
+            D2PathPointStrc nCoord[3];
+            int32_t nStride;
+            int32_t nXOffset;
+            int32_t nYOffset;
+            int32_t aCoordData[IDASTAR_MAXPROOM];
+        };
+
+        const D2CoordStrc aCoordOffsets[8] = { {1,0}, {1,1}, {0,1}, {-1,1}, {-1,0}, {-1,-1}, {0,-1}, {1,-1} };
+        const int32_t aNeighborsSequences[8][8] = {
+            { 0, 1, 6, 3, 4, 5, 2, 7},
+            { 0, 1, 6, 3, 1, 3, 6, 1},
+            { 0, 1, 1, 1, 1, 1, 2, 7},
+            { 1, 1, 1, 1, 1, 3, 6, 1},
+            { 6, 4, 3, 6, 1, 3, 2, 7},
+            { 7, 7, 7, 7, 7, 5, 2, 7},
+            { 0, 7, 7, 7, 7, 5, 2, 7},
+            { 0, 7, 2, 5, 7, 5, 2, 7},
+        };
+
+        void GetNextNeighborIndex(D2PathIDAStarNodeStrc* pNode)
+        {
+            pNode->nNextNeighborIndex = (pNode->nNextNeighborIndex + *pNode->pNeighborsSequence) & 7;
+        }
+
+        D2PathIDAStarNodeStrc* GetNewNode(D2PathIDAStarContextStrc* pContext)
+        {
+            if (pContext->nNodesCount == IDASTAR_MAXNODES)
+            {
+                return nullptr;
+            }
+            D2PathIDAStarNodeStrc* pNewNode = &pContext->aNodesStorage[pContext->nNodesCount++];
+            memset(pNewNode, 0, sizeof(*pNewNode));
+            return pNewNode;
+        }
+
+        D2PathIDAStarNodeStrc* NextNode(D2PathIDAStarNodeStrc* pNode, D2PathIDAStarContextStrc* pContext)
+        {
+            if (pNode->nEvaluationsCount < 4)
+            {
+                pNode->pNeighborsSequence++;
+                GetNextNeighborIndex(pNode);
+            }
+
+            pNode->nEvaluationsCount++;
+            if (pNode->nEvaluationsCount == 5)
+            {
+                while (pNode != pContext->pCurrentNode)
+                {
+                    pNode = pNode->pParent;
+                    pNode->pNeighborsSequence++;
+                    GetNextNeighborIndex(pNode);
+                    if ((++pNode->nEvaluationsCount) != 5)
+                    {
+                        return pNode;
+                    }
+                }
+                return nullptr;
+            }
+            return pNode;
+        }
+
+        D2PathIDAStarNodeStrc* VisitNodes(D2PathIDAStarContextStrc* pContext, int nFScoreCutoff, D2PathInfoStrc* pPathInfo)
+        {
+            D2PathIDAStarNodeStrc* pCurrentNode = pContext->pCurrentNode;
+            int nIterations = 0;
+            while (pCurrentNode->tCoord != pPathInfo->tTargetCoord)
+            {
+                if (++nIterations > 10000)
+                {
+                    return nullptr;
+                }
+
+                if (pCurrentNode->tCoord.X < pContext->nCoord[0].X || pCurrentNode->tCoord.X > pContext->nCoord[1].X
+                    || pCurrentNode->tCoord.Y < pContext->nCoord[0].Y || pCurrentNode->tCoord.Y > pContext->nCoord[1].Y)
+                {
+                    break;
+                }
+
+                D2PathPointStrc tNeighborCoords;
+                tNeighborCoords.X = pCurrentNode->tCoord.X + aCoordOffsets[pCurrentNode->nNextNeighborIndex].nX;
+                tNeighborCoords.Y = pCurrentNode->tCoord.Y + aCoordOffsets[pCurrentNode->nNextNeighborIndex].nY;
+
+                const int nDataIndex = tNeighborCoords.X + pContext->nXOffset + pContext->nStride * (tNeighborCoords.Y + pContext->nYOffset);
+                int* pNeighborBestDistanceToStart = &pContext->aCoordData[nDataIndex];
+
+                bool bShouldEvaluateNextNeighbor = true;
+                bool bMayEvaluateNode = true;
+                if (*pNeighborBestDistanceToStart == 0)
+                {
+                    if (COLLISION_CheckAnyCollisionWithPattern(pPathInfo->pStartRoom, tNeighborCoords.X, tNeighborCoords.Y, pPathInfo->nCollisionPattern, pPathInfo->nCollisionMask))
+                    {
+                        *pNeighborBestDistanceToStart = 1;
+                        bMayEvaluateNode = false;
+                    }
+                }
+
+                if (bMayEvaluateNode)
+                {
+                    const int16_t nDistanceBetweenPoints = PATH_FoWall_HeuristicForNeighbor(pCurrentNode->tCoord, tNeighborCoords);
+                    const int16_t nNewDistanceFromStart = nDistanceBetweenPoints + pCurrentNode->nBestDistanceFromStart;
+                    if (*pNeighborBestDistanceToStart == 0 || (unsigned int)nNewDistanceFromStart >= *pNeighborBestDistanceToStart)
+                    {
+                        *pNeighborBestDistanceToStart = nNewDistanceFromStart;
+
+                        const int16_t nHeuristicDistanceToTarget = PATH_FoWall_Heuristic(pPathInfo->tTargetCoord, tNeighborCoords);
+                        const int16_t nNewNodeFSCore = nHeuristicDistanceToTarget + nNewDistanceFromStart;
+                        if (nNewNodeFSCore <= nFScoreCutoff)
+                        {
+                            if (!pCurrentNode->pBestChild)
+                            {
+                                D2PathIDAStarNodeStrc* pNewSubposition = GetNewNode(pContext);
+                                pCurrentNode->pBestChild = pNewSubposition;
+                                if (!pNewSubposition)
+                                {
+                                    return nullptr;
+                                }
+                                pNewSubposition->pParent = pCurrentNode;
+                            }
+                            pCurrentNode = pCurrentNode->pBestChild;
+                            pCurrentNode->tCoord = tNeighborCoords;
+                            pCurrentNode->nBestDistanceFromStart = nNewDistanceFromStart;
+                            pCurrentNode->nFScore = nNewNodeFSCore;
+                            pCurrentNode->nHeuristicDistanceToTarget = nHeuristicDistanceToTarget;
+                            pCurrentNode->nEvaluationsCount = 0;
+                            pCurrentNode->pNeighborsSequence = aNeighborsSequences[(sub_6FDAB770(tNeighborCoords, pPathInfo->tTargetCoord) - pCurrentNode->pParent->nNextNeighborIndex) & 7];
+                            GetNextNeighborIndex(pCurrentNode);
+
+                            if ((int16_t)pCurrentNode->nHeuristicDistanceToTarget < pPathInfo->field_14)
+                            {
+                                return pCurrentNode;
+                            }
+                            bShouldEvaluateNextNeighbor = false;
+                        }
+                    }
+                }
+
+                if (bShouldEvaluateNextNeighbor)
+                {
+                    pCurrentNode = NextNode(pCurrentNode, pContext);
+                    if (!pCurrentNode)
+                    {
+                        return nullptr;
+                    }
+                }
+            }
+            return pCurrentNode;
+        }
+
+        int FlushNodeToDynamicPath(D2PathIDAStarNodeStrc* pNode, D2PathInfoStrc* pPathInfo)
+        {
+            int nbPoints = 0;
+            D2PathPointStrc aTempPathPoints[D2DynamicPathStrc::MAXPATHLEN];
+            int prevDeltaX = -2;
+            int prevDeltaY = -2;
+            while (pNode && pNode->pParent && nbPoints < D2DynamicPathStrc::MAXPATHLEN)
+            {
+                D2PathIDAStarNodeStrc* pNextPoint = pNode->pParent;
+                const int deltaX = pNode->tCoord.X - pNextPoint->tCoord.X;
+                const int deltaY = pNode->tCoord.Y - pNextPoint->tCoord.Y;
+                if (deltaX != prevDeltaX || deltaY != prevDeltaY)
+                {
+                    ++nbPoints;
+                    aTempPathPoints[D2DynamicPathStrc::MAXPATHLEN - nbPoints] = pNode->tCoord;
+                    prevDeltaX = deltaX;
+                    prevDeltaY = deltaY;
+                }
+                pNode = pNextPoint;
+            }
+
+            if (nbPoints <= 1 || nbPoints >= D2DynamicPathStrc::MAXPATHLEN)
+            {
+                return 0;
+            }
+
+            memcpy(pPathInfo->pDynamicPath->PathPoints, &aTempPathPoints[D2DynamicPathStrc::MAXPATHLEN - nbPoints], sizeof(D2PathPointStrc) * nbPoints);
+            return nbPoints;
+        }
+
+        // Only supports PATHTYPE_IDASTAR. The context is kept between calls so that nCoord[2] has the same value as with the pooled context.
+        int ComputePathWithRooms(D2PathIDAStarContextStrc* pContext, D2DrlgCoordsStrc* pRoomCoords, D2PathInfoStrc* pPathInfo)
+        {
+            const int nMaxNodes = (pRoomCoords->nSubtileHeight + 6) * (pRoomCoords->nSubtileWidth + 6);
+            memset(pContext->aCoordData, 0, sizeof(int32_t) * nMaxNodes);
+            pContext->nCoord[0].Y = pRoomCoords->nSubtileY;
+            pContext->nCoord[0].X = pRoomCoords->nSubtileX;
+            pContext->nCoord[1].X = pRoomCoords->nSubtileX + pRoomCoords->nSubtileWidth;
+            pContext->nCoord[1].Y = pRoomCoords->nSubtileY + pContext->nCoord[2].Y;
+            pContext->nCoord[2].X = pRoomCoords->nSubtileWidth;
+            pContext->nCoord[2].Y = pRoomCoords->nSubtileHeight;
+            pContext->nStride = pRoomCoords->nSubtileWidth + 6;
+            pContext->nYOffset = -(pRoomCoords->nSubtileY - 3);
+            pContext->nXOffset = -(pRoomCoords->nSubtileX - 3);
+
+            D2PathIDAStarNodeStrc tStartNode = {};
+            tStartNode.nHeuristicDistanceToTarget = PATH_FoWall_Heuristic(pPathInfo->tStartCoord, pPathInfo->tTargetCoord);
+            tStartNode.nFScore = tStartNode.nHeuristicDistanceToTarget;
+            tStartNode.tCoord = pPathInfo->tStartCoord;
+            tStartNode.nEvaluationsCount = -3;
+            tStartNode.pNeighborsSequence = aNeighborsSequences[0];
+            tStartNode.nNextNeighborIndex = sub_6FDAB770(pPathInfo->tStartCoord, pPathInfo->tTargetCoord) & 7;
+
+            pContext->nNodesCount = 1;
+            pContext->pCurrentNode = &pContext->aNodesStorage[0];
+
+            int16_t nFScoreCutoff = tStartNode.nHeuristicDistanceToTarget;
+            const int16_t nMaxFScore = pPathInfo->nMinimumFScoreToEvaluate;
+            D2PathIDAStarNodeStrc* pValidPathNode = nullptr;
+            do
+            {
+                *pContext->pCurrentNode = tStartNode;
+                pValidPathNode = VisitNodes(pContext, nFScoreCutoff, pPathInfo);
+                nFScoreCutoff += 5;
+                if (!pValidPathNode && pContext->nNodesCount == IDASTAR_MAXNODES)
+                    break;
+                pContext->nNodesCount = 1;
+                if (pValidPathNode)
+                    break;
+            } while (nFScoreCutoff < nMaxFScore);
+
+            int nPathPoints = 0;
+            if (pValidPathNode)
+            {
+                nPathPoints = FlushNodeToDynamicPath(pValidPathNode, pPathInfo);
+            }
+            return nPathPoints;
+        }
+    }
+
+    struct RecordedPathStrc
+    {
+        D2PathPointStrc tStartCoord;
+        D2PathPointStrc tTargetCoord;
+        uint8_t nMinimumFScoreToEvaluate;
+    };
+
+    // Room with random obstacles, similar to a cave or a crowded area
+    struct IDAStarBenchmarkRoom
+    {
+        static const int ROOM_X = 5000;
+        static const int ROOM_Y = 3000;
+        static const int ROOM_SIZE = 120;
+
+        D2ActiveRoomStrc tRoom = {};
+        D2RoomCollisionGridStrc tCollisionGrid = {};
+        std::vector<uint16_t> aCollisionMask = std::vector<uint16_t>(ROOM_SIZE * ROOM_SIZE);
+
+        explicit IDAStarBenchmarkRoom(std::mt19937& tRand)
+        {
+            for (uint16_t& nMask : aCollisionMask)
+            {
+                nMask = (tRand() % 100 < 18) ? (COLLIDE_BLOCK_PLAYER | COLLIDE_BLOCK_MISSILE) : COLLIDE_NONE;
+            }
+            tRoom.tCoords.nSubtileX = ROOM_X;
+            tRoom.tCoords.nSubtileY = ROOM_Y;
+            tRoom.tCoords.nSubtileWidth = ROOM_SIZE;
+            tRoom.tCoords.nSubtileHeight = ROOM_SIZE;
+            tCollisionGrid.pRoomCoords = tRoom.tCoords;
+            tCollisionGrid.pCollisionMask = aCollisionMask.data();
+            tRoom.pCollisionGrid = &tCollisionGrid;
+        }
+
+        D2PathPointStrc GetRandomFreeCoord(std::mt19937& tRand) const
+        {
+            while (true)
+            {
+                const int nX = tRand() % ROOM_SIZE;
+                const int nY = tRand() % ROOM_SIZE;
+                if (aCollisionMask[nX + nY * ROOM_SIZE] == COLLIDE_NONE)
+                {
+                    return { uint16_t(ROOM_X + nX), uint16_t(ROOM_Y + nY) };
+                }
+            }
+        }
+    };
+
+    void InitBenchmarkPathInfo(D2PathInfoStrc* pPathInfo, D2ActiveRoomStrc* pRoom, D2DynamicPathStrc* pDynamicPath, const RecordedPathStrc& tRecordedPath)
+    {
+        *pPathInfo = {};
+        pPathInfo->tStartCoord = tRecordedPath.tStartCoord;
+        pPathInfo->tTargetCoord = tRecordedPath.tTargetCoord;
+        pPathInfo->pStartRoom = pRoom;
+        pPathInfo->pTargetRoom = pRoom;
+        pPathInfo->field_14 = 2;
+        pPathInfo->nMinimumFScoreToEvaluate = tRecordedPath.nMinimumFScoreToEvaluate;
+        pPathInfo->nPathType = PATHTYPE_IDASTAR;
+        pPathInfo->nCollisionPattern = COLLISION_PATTERN_NONE;
+        pPathInfo->nCollisionMask = COLLIDE_MASK_MONSTER_DEFAULT;
+        pPathInfo->pDynamicPath = pDynamicPath;
+    }
+}
+
+TEST_CASE("PATH IDAStar pooled context matches the original implementation")
+{
+    std::mt19937 tRand(0x6FDC0BB0);
+    IDAStarBenchmarkRoom tBenchmarkRoom(tRand);
+
+    // Monsters chasing a target a few subtiles away, as recorded when a pack re-paths around obstacles
+    std::vector<RecordedPathStrc> aRecordedPaths(4000);
+    for (RecordedPathStrc& tRecordedPath : aRecordedPaths)
+    {
+        tRecordedPath.tStartCoord = tBenchmarkRoom.GetRandomFreeCoord(tRand);
+        tRecordedPath.tTargetCoord = tRecordedPath.tStartCoord;
+        tRecordedPath.tTargetCoord.X += tRand() % 31 - 15;
+        tRecordedPath.tTargetCoord.Y += tRand() % 31 - 15;
+        tRecordedPath.nMinimumFScoreToEvaluate = uint8_t(40 + tRand() % 200);
+    }
+
+    // Same bounds as PATH_IdaStar_6FDA7970 when start and target are in the same room
+    D2DrlgCoordsStrc tPathRoomsAABB = tBenchmarkRoom.tRoom.tCoords;
+    tPathRoomsAABB.nSubtileX -= 10;
+    tPathRoomsAABB.nSubtileY -= 10;
+    tPathRoomsAABB.nSubtileWidth += 20;
+    tPathRoomsAABB.nSubtileHeight += 20;
+
+    std::unique_ptr<Legacy::D2PathIDAStarContextStrc> pLegacyContext = std::make_unique<Legacy::D2PathIDAStarContextStrc>();
+    std::unique_ptr<D2DynamicPathStrc> pLegacyDynamicPath = std::make_unique<D2DynamicPathStrc>();
+    std::unique_ptr<D2DynamicPathStrc> pDynamicPath = std::make_unique<D2DynamicPathStrc>();
+    // Make sure the pooled context has the same initial state as the legacy context
+    PATH_IDAStar_GetThreadContext()->nCoord[2] = {};
+
+    std::vector<int> aLegacyPathPointsCount;
+    std::vector<D2PathPointStrc> aLegacyPathPoints;
+    const auto tLegacyStart = std::chrono::steady_clock::now();
+    for (const RecordedPathStrc& tRecordedPath : aRecordedPaths)
+    {
+        D2PathInfoStrc tPathInfo;
+        InitBenchmarkPathInfo(&tPathInfo, &tBenchmarkRoom.tRoom, pLegacyDynamicPath.get(), tRecordedPath);
+        const int nPathPoints = Legacy::ComputePathWithRooms(pLegacyContext.get(), &tPathRoomsAABB, &tPathInfo);
+        aLegacyPathPointsCount.push_back(nPathPoints);
+        aLegacyPathPoints.insert(aLegacyPathPoints.end(), pLegacyDynamicPath->PathPoints, pLegacyDynamicPath->PathPoints + nPathPoints);
+    }
+    const auto tLegacyElapsed = std::chrono::steady_clock::now() - tLegacyStart;
+
+    std::vector<int> aPathPointsCount;
+    std::vector<D2PathPointStrc> aPathPoints;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (const RecordedPathStrc& tRecordedPath : aRecordedPaths)
+    {
+        D2PathInfoStrc tPathInfo;
+        InitBenchmarkPathInfo(&tPathInfo, &tBenchmarkRoom.tRoom, pDynamicPath.get(), tRecordedPath);
+        const int nPathPoints = PATH_IdaStar_ComputePathWithRooms(&tPathRoomsAABB, &tPathInfo);
+        aPathPointsCount.push_back(nPathPoints);
+        aPathPoints.insert(aPathPoints.end(), pDynamicPath->PathPoints, pDynamicPath->PathPoints + nPathPoints);
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    REQUIRE(aPathPointsCount == aLegacyPathPointsCount);
+    REQUIRE(aPathPoints.size() == aLegacyPathPoints.size());
+    CHECK(memcmp(aPathPoints.data(), aLegacyPathPoints.data(), aPathPoints.size() * sizeof(D2PathPointStrc)) == 0);
+
+    MESSAGE("Paths found: ", std::count_if(aPathPointsCount.begin(), aPathPointsCount.end(), [](int nCount) { return nCount > 0; }), "/", aRecordedPaths.size());
+    MESSAGE("Stack context: ", std::chrono::duration_cast<std::chrono::microseconds>(tLegacyElapsed).count(), "us");
+    MESSAGE("Pooled context: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
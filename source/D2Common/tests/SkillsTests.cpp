@@ -0,0 +1,420 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <D2DataTbls.h>
+#include <D2Skills.h>
+#include <D2StatList.h>
+#include <D2States.h>
+#include <DataTbls/SkillsTbls.h>
+#include <Units/Units.h>
+
+namespace
+{
+    // Original versions of SKILLS_GetSkill and SKILLS_GetBonusSkillLevel, used as a reference.
+    namespace Reference
+    {
+        D2SkillStrc* GetSkill(D2SkillStrc* pFirstSkill, int nSkillId, D2UnitGUID nOwnerGUID)
+        {
+            D2SkillStrc* pSkill = pFirstSkill;
+            while (pSkill && (pSkill->pSkillsTxt->nSkillId != nSkillId || pSkill->nOwnerGUID != nOwnerGUID))
+            {
+                pSkill = pSkill->pNextSkill;
+            }
+            return pSkill;
+        }
+
+        // Reads every stat on each call
+        int GetBonusSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill)
+        {
+            int nSkillLevel = pSkill->nLevelBonus;
+            if (STATES_CheckState(pUnit, STATE_SHRINE_SKILL))
+            {
+                nSkillLevel += 2;
+            }
+
+            nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ALLSKILLS, 0);
+
+            if (pUnit->dwUnitType == UNIT_PLAYER)
+            {
+                if (pSkill->pSkillsTxt->nCharClass == pUnit->dwClassId)
+                {
+                    nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ADDCLASSSKILLS, pUnit->dwClassId);
+
+                    const D2SkillDescTxt* pSkillDescTxtRecord = DATATBLS_GetSkillDescTxtRecord(pSkill->pSkillsTxt->wSkillDesc);
+                    if (pSkillDescTxtRecord->nSkillPage)
+                    {
+                        nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ADDSKILL_TAB, (char)pSkillDescTxtRecord->nSkillPage + 8 * pUnit->dwClassId - 1);
+                    }
+
+                    nSkillLevel += std::min(STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId), 3);
+                }
+                else
+                {
+                    nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
+                }
+            }
+            else
+            {
+                const int nBonus = STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_NONCLASSSKILL, pSkill->pSkillsTxt->nSkillId);
+                nSkillLevel += pSkill->nSkillLevel <= 0 ? nBonus : std::min(nBonus, 3);
+            }
+
+            if (pSkill->pSkillsTxt->nEType)
+            {
+                nSkillLevel += STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_ELEMSKILL, pSkill->pSkillsTxt->nEType);
+            }
+
+            return nSkillLevel + STATLIST_UnitGetStatValue(pUnit, STAT_ITEM_SINGLESKILL, pSkill->pSkillsTxt->nSkillId);
+        }
+
+        int GetSkillLevel(D2UnitStrc* pUnit, D2SkillStrc* pSkill)
+        {
+            int nSkillLevel = pSkill->nSkillLevel;
+            if (pSkill->nOwnerGUID == D2UnitInvalidGUID)
+            {
+                nSkillLevel += GetBonusSkillLevel(pUnit, pSkill);
+            }
+            return std::clamp(nSkillLevel, 0, DATATBLS_GetMaxLevel(0));
+        }
+    }
+
+    // Skill list with its index, the slots are owned by the test instead of a memory pool
+    struct TestSkillList
+    {
+        D2SkillStrc* pFirstSkill = nullptr;
+        D2SkillIndexStrc tIndex = {};
+        std::vector<D2SkillIndexSlotStrc> aSlots;
+
+        void Append(D2SkillStrc* pSkill)
+        {
+            pSkill->pNextSkill = nullptr;
+            D2SkillStrc** ppLink = &pFirstSkill;
+            while (*ppLink)
+            {
+                ppLink = &(*ppLink)->pNextSkill;
+            }
+            *ppLink = pSkill;
+
+            if ((tIndex.nCount + 1) * 4 > tIndex.nCapacity * 3)
+            {
+                std::vector<D2SkillIndexSlotStrc> aNewSlots(tIndex.nCapacity ? 2 * tIndex.nCapacity : SKILLINDEX_MIN_CAPACITY);
+                SKILLS_ResizeSkillIndex(&tIndex, aNewSlots.data(), (uint32_t)aNewSlots.size());
+                aSlots.swap(aNewSlots);
+            }
+            SKILLS_InsertSkillInIndex(&tIndex, pSkill);
+        }
+
+        void Remove(D2SkillStrc* pSkill)
+        {
+            D2SkillStrc** ppLink = &pFirstSkill;
+            while (*ppLink != pSkill)
+            {
+                ppLink = &(*ppLink)->pNextSkill;
+            }
+            *ppLink = pSkill->pNextSkill;
+
+            SKILLS_RemoveSkillFromIndex(&tIndex, pFirstSkill, pSkill);
+        }
+    };
+}
+
+TEST_CASE("SKILLS skill index matches the linear lookup")
+{
+    std::mt19937 tRand(0x6FDB1F80);
+
+    std::vector<D2SkillsTxt> aSkillsTxt(360);
+    for (size_t i = 0; i < aSkillsTxt.size(); ++i)
+    {
+        aSkillsTxt[i] = {};
+        aSkillsTxt[i].nSkillId = (int16_t)i;
+    }
+
+    for (int nIteration = 0; nIteration < 100; ++nIteration)
+    {
+        // Few skill ids and owners on odd iterations so that duplicates are frequent
+        const int nSkillIds = nIteration % 2 ? 4 : (int)aSkillsTxt.size();
+        const int nOwners = nIteration % 2 ? 3 : 20;
+        auto RandomKey = [&](int* pSkillId, D2UnitGUID* pOwnerGUID) {
+            *pSkillId = tRand() % nSkillIds;
+            *pOwnerGUID = tRand() % 2 ? D2UnitInvalidGUID : (D2UnitGUID)(tRand() % nOwners);
+        };
+
+        std::vector<D2SkillStrc> aSkills(200);
+        std::vector<D2SkillStrc*> aLinkedSkills;
+        std::vector<D2SkillStrc*> aFreeSkills;
+        for (D2SkillStrc& tSkill : aSkills)
+        {
+            aFreeSkills.push_back(&tSkill);
+        }
+
+        TestSkillList tSkillList;
+        for (int nOperation = 0; nOperation < 2000; ++nOperation)
+        {
+            // Lists grow up to the size of a character with many charged items, then shrink
+            const bool bGrowing = (nOperation / 500) % 2 == 0;
+            if (!aFreeSkills.empty() && (aLinkedSkills.empty() || tRand() % 4 < (bGrowing ? 3u : 1u)))
+            {
+                D2SkillStrc* pSkill = aFreeSkills.back();
+                aFreeSkills.pop_back();
+
+                int nSkillId = 0;
+                *pSkill = {};
+                RandomKey(&nSkillId, &pSkill->nOwnerGUID);
+                pSkill->pSkillsTxt = &aSkillsTxt[nSkillId];
+                tSkillList.Append(pSkill);
+                aLinkedSkills.push_back(pSkill);
+            }
+            else
+            {
+                const size_t nRemoved = tRand() % aLinkedSkills.size();
+                D2SkillStrc* pSkill = aLinkedSkills[nRemoved];
+                aLinkedSkills.erase(aLinkedSkills.begin() + nRemoved);
+                tSkillList.Remove(pSkill);
+                aFreeSkills.push_back(pSkill);
+            }
+
+            for (int nLookup = 0; nLookup < 20; ++nLookup)
+            {
+                int nSkillId = 0;
+                D2UnitGUID nOwnerGUID = D2UnitInvalidGUID;
+                RandomKey(&nSkillId, &nOwnerGUID);
+                if (!aLinkedSkills.empty() && tRand() % 2)
+                {
+                    const D2SkillStrc* pSkill = aLinkedSkills[tRand() % aLinkedSkills.size()];
+                    nSkillId = pSkill->pSkillsTxt->nSkillId;
+                    nOwnerGUID = pSkill->nOwnerGUID;
+                }
+                CAPTURE(nSkillId);
+                CAPTURE(nOwnerGUID);
+
+                REQUIRE(SKILLS_FindSkillInIndex(&tSkillList.tIndex, nSkillId, nOwnerGUID) == Reference::GetSkill(tSkillList.pFirstSkill, nSkillId, nOwnerGUID));
+            }
+        }
+    }
+}
+
+TEST_CASE("SKILLS skill index benchmark")
+{
+    // Skill list of a level 99 character: every class skill, some base skills and the charged skills of its items
+    std::mt19937 tRand(0x6FDB0320);
+
+    std::vector<D2SkillsTxt> aSkillsTxt(360);
+    for (size_t i = 0; i < aSkillsTxt.size(); ++i)
+    {
+        aSkillsTxt[i] = {};
+        aSkillsTxt[i].nSkillId = (int16_t)i;
+    }
+
+    std::vector<D2SkillStrc> aSkills(120);
+    std::vector<int> aSkillIds;
+    std::vector<D2UnitGUID> aOwnerGUIDs;
+    TestSkillList tSkillList;
+    for (size_t i = 0; i < aSkills.size(); ++i)
+    {
+        aSkills[i] = {};
+        aSkills[i].pSkillsTxt = &aSkillsTxt[i < 40 ? i : tRand() % aSkillsTxt.size()];
+        aSkills[i].nOwnerGUID = i < 40 ? D2UnitInvalidGUID : (D2UnitGUID)(1000 + i);
+        tSkillList.Append(&aSkills[i]);
+        aSkillIds.push_back(aSkills[i].pSkillsTxt->nSkillId);
+        aOwnerGUIDs.push_back(aSkills[i].nOwnerGUID);
+    }
+
+    constexpr int nPasses = 2000;
+    int64_t nExpectedSum = 0;
+    const auto tLinearStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        for (size_t i = 0; i < aSkillIds.size(); ++i)
+        {
+            nExpectedSum += (intptr_t)Reference::GetSkill(tSkillList.pFirstSkill, aSkillIds[i], aOwnerGUIDs[i]) & 0xFFFF;
+            nExpectedSum += (intptr_t)Reference::GetSkill(tSkillList.pFirstSkill, aSkillIds[i], D2UnitInvalidGUID) & 0xFFFF;
+        }
+    }
+    const auto tLinearElapsed = std::chrono::steady_clock::now() - tLinearStart;
+
+    int64_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        for (size_t i = 0; i < aSkillIds.size(); ++i)
+        {
+            nSum += (intptr_t)SKILLS_FindSkillInIndex(&tSkillList.tIndex, aSkillIds[i], aOwnerGUIDs[i]) & 0xFFFF;
+            nSum += (intptr_t)SKILLS_FindSkillInIndex(&tSkillList.tIndex, aSkillIds[i], D2UnitInvalidGUID) & 0xFFFF;
+        }
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Linear lookups: ", std::chrono::duration_cast<std::chrono::microseconds>(tLinearElapsed).count(), "us");
+    MESSAGE("Indexed lookups: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
+
+TEST_CASE("SKILLS cached skill levels match the uncached levels")
+{
+    std::mt19937 tRand(0x6FDB1580);
+
+    // Minimal tables, no txt files are shipped with the repository
+    constexpr int nSkills = 3;
+    std::vector<D2SkillsTxt> aSkillsTxt(nSkills);
+    std::vector<D2SkillDescTxt> aSkillDescTxt(nSkills);
+    for (int i = 0; i < nSkills; ++i)
+    {
+        aSkillsTxt[i] = {};
+        aSkillsTxt[i].nSkillId = (int16_t)i;
+        aSkillsTxt[i].nCharClass = (int8_t)(i - 1); // No class, amazon and sorceress
+        aSkillsTxt[i].nEType = (uint8_t)(i % 2);
+        aSkillsTxt[i].wSkillDesc = (uint16_t)i;
+        aSkillDescTxt[i] = {};
+        aSkillDescTxt[i].nSkillPage = (uint8_t)i;
+    }
+
+    // Items are random sets of the stats read for skill levels, plus one that is not
+    const D2SLayerStatIdStrc aItemStats[] = {
+        D2SLayerStatIdStrc::Make(0, STAT_ITEM_ALLSKILLS),
+        D2SLayerStatIdStrc::Make(0, STAT_ITEM_ADDCLASSSKILLS),
+        D2SLayerStatIdStrc::Make(1, STAT_ITEM_ADDCLASSSKILLS),
+        D2SLayerStatIdStrc::Make(0, STAT_ITEM_ADDSKILL_TAB),
+        D2SLayerStatIdStrc::Make(9, STAT_ITEM_ADDSKILL_TAB),
+        D2SLayerStatIdStrc::Make(0, STAT_ITEM_NONCLASSSKILL),
+        D2SLayerStatIdStrc::Make(1, STAT_ITEM_NONCLASSSKILL),
+        D2SLayerStatIdStrc::Make(2, STAT_ITEM_NONCLASSSKILL),
+        D2SLayerStatIdStrc::Make(1, STAT_ITEM_ELEMSKILL),
+        D2SLayerStatIdStrc::Make(0, STAT_ITEM_SINGLESKILL),
+        D2SLayerStatIdStrc::Make(1, STAT_ITEM_SINGLESKILL),
+        D2SLayerStatIdStrc::Make(2, STAT_ITEM_SINGLESKILL),
+        D2SLayerStatIdStrc::Make(0, STAT_STRENGTH),
+    };
+    static_assert(ARRAY_SIZE(aItemStats) < STATLIST_INDEX_MIN_STATS, "The stat index would be allocated from the memory pool");
+
+    uint16_t nMaxStatId = 0;
+    for (const D2SLayerStatIdStrc& tLayerStatId : aItemStats)
+    {
+        nMaxStatId = std::max(nMaxStatId, tLayerStatId.nStat);
+    }
+    std::vector<D2ItemStatCostTxt> aItemStatCostTxt(nMaxStatId + 1);
+    std::vector<D2ExperienceTxt> aExperienceTxt(1);
+    aExperienceTxt[0].dwClass[0] = 30;
+
+    std::unique_ptr<D2DataTablesStrc> pDataTables(new D2DataTablesStrc{});
+    pDataTables->pSkillsTxt = aSkillsTxt.data();
+    pDataTables->nSkillsTxtRecordCount = nSkills;
+    pDataTables->pSkillDescTxt = aSkillDescTxt.data();
+    pDataTables->nSkillDescTxtRecordCount = nSkills;
+    pDataTables->pItemStatCostTxt = aItemStatCostTxt.data();
+    pDataTables->nItemStatCostTxtRecordCount = (int)aItemStatCostTxt.size();
+    pDataTables->nStatesTxtRecordCount = STATE_SHRINE_SKILL + 1;
+    pDataTables->pExperienceTxt = (D2ExperienceDataTbl*)aExperienceTxt.data();
+    D2DataTablesStrc* pPreviousDataTables = sgptDataTables;
+    sgptDataTables = pDataTables.get();
+
+    for (int nIteration = 0; nIteration < 200; ++nIteration)
+    {
+        std::vector<D2StatStrc> aFullStats;
+        std::vector<uint32_t> aStatFlags(2 * ((STATE_SHRINE_SKILL + 32) / 32));
+        D2StatListExStrc tStatListEx = {};
+        tStatListEx.dwFlags = STATLIST_EXTENDED;
+        tStatListEx.StatFlags = aStatFlags.data();
+
+        D2SkillListStrc tSkillList = {};
+        tSkillList.dwBonusLevelsStamp = 1;
+
+        D2UnitStrc tUnit = {};
+        tUnit.dwUnitType = nIteration % 2 ? UNIT_PLAYER : UNIT_MONSTER;
+        tUnit.dwClassId = tRand() % 2;
+        tUnit.pStatListEx = &tStatListEx;
+        tUnit.pSkills = &tSkillList;
+        tStatListEx.pOwner = &tUnit;
+
+        std::vector<D2SkillStrc> aSkills(2 * nSkills);
+        for (size_t i = 0; i < aSkills.size(); ++i)
+        {
+            aSkills[i] = {};
+            aSkills[i].pSkillsTxt = &aSkillsTxt[i % nSkills];
+            aSkills[i].nOwnerGUID = i < nSkills ? D2UnitInvalidGUID : (D2UnitGUID)i;
+        }
+
+        // Adds the stat as done by the stat lists, including the notification of STATLIST_NotifyUnitOfStatValueChange
+        auto AddStat = [&](D2SLayerStatIdStrc tLayerStatId, int nValue) {
+            auto it = std::lower_bound(aFullStats.begin(), aFullStats.end(), tLayerStatId.nPackedValue, [](const D2StatStrc& tStat, D2SLayerStatIdStrc::PackedType nValue) { return tStat.nPackedValue < nValue; });
+            if (it == aFullStats.end() || it->nPackedValue != tLayerStatId.nPackedValue)
+            {
+                D2StatStrc tStat = {};
+                tStat.nPackedValue = tLayerStatId.nPackedValue;
+                it = aFullStats.insert(it, tStat);
+            }
+            it->nValue += nValue;
+            if (!it->nValue)
+            {
+                aFullStats.erase(it);
+            }
+            tStatListEx.FullStats.pStat = aFullStats.data();
+            tStatListEx.FullStats.nStatCount = (uint16_t)aFullStats.size();
+            tStatListEx.FullStats.nCapacity = (uint16_t)aFullStats.size();
+
+            if (nValue && SKILLS_IsBonusSkillLevelStat(tLayerStatId.nStat))
+            {
+                SKILLS_InvalidateBonusSkillLevels(&tUnit);
+            }
+        };
+
+        std::vector<std::vector<D2StatStrc>> aEquippedItems;
+        for (int nChange = 0; nChange < 100; ++nChange)
+        {
+            switch (tRand() % 4)
+            {
+            case 0:
+            {
+                std::vector<D2StatStrc> aItemStatList;
+                for (int nStat = tRand() % 4; nStat >= 0; --nStat)
+                {
+                    D2StatStrc tStat = {};
+                    tStat.nPackedValue = aItemStats[tRand() % ARRAY_SIZE(aItemStats)].nPackedValue;
+                    tStat.nValue = (int)(tRand() % 9) - 2;
+                    aItemStatList.push_back(tStat);
+                    AddStat(tStat, tStat.nValue);
+                }
+                aEquippedItems.push_back(aItemStatList);
+                break;
+            }
+            case 1:
+                if (!aEquippedItems.empty())
+                {
+                    const size_t nItem = tRand() % aEquippedItems.size();
+                    for (const D2StatStrc& tStat : aEquippedItems[nItem])
+                    {
+                        AddStat(tStat, -tStat.nValue);
+                    }
+                    aEquippedItems.erase(aEquippedItems.begin() + nItem);
+                }
+                break;
+            case 2:
+                // States are set and cleared without notifying the skills, such as the death states in STATES_UpdateStayDeathFlags
+                aStatFlags[STATE_SHRINE_SKILL / 32] ^= 1u << (STATE_SHRINE_SKILL % 32);
+                break;
+            default:
+            {
+                // Skill levels are changed directly by many callers
+                D2SkillStrc& tSkill = aSkills[tRand() % aSkills.size()];
+                tSkill.nSkillLevel = (int)(tRand() % 6) - 1;
+                tSkill.nLevelBonus = tRand() % 3;
+                break;
+            }
+            }
+
+            for (D2SkillStrc& tSkill : aSkills)
+            {
+                CAPTURE(tUnit.dwUnitType);
+                CAPTURE(tSkill.pSkillsTxt->nSkillId);
+                REQUIRE(SKILLS_GetBonusSkillLevel(&tUnit, &tSkill) == Reference::GetBonusSkillLevel(&tUnit, &tSkill));
+                REQUIRE(SKILLS_GetSkillLevel(&tUnit, &tSkill, TRUE) == Reference::GetSkillLevel(&tUnit, &tSkill));
+            }
+        }
+    }
+
+    sgptDataTables = pPreviousDataTables;
+}
@@ -0,0 +1,146 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <D2StatList.h>
+
+namespace
+{
+    constexpr int nStatIds = 360;
+
+    D2SLayerStatIdStrc::PackedType RandomStat(std::mt19937& tRand)
+    {
+        // Mostly layer 0, and a few stats with many layers such as item_singleskill
+        const uint16_t nStatId = tRand() % (nStatIds + 8); // Also test stat ids that are not indexed
+        const uint16_t nLayer = (nStatId % 16 == 0) ? tRand() % 64 : 0;
+        return D2SLayerStatIdStrc::Make(nLayer, nStatId).nPackedValue;
+    }
+
+    void InsertStat(std::vector<D2StatStrc>& aStats, D2SLayerStatIdStrc::PackedType nLayer_StatId, int32_t nValue)
+    {
+        auto it = std::lower_bound(aStats.begin(), aStats.end(), nLayer_StatId, [](const D2StatStrc& tStat, D2SLayerStatIdStrc::PackedType nValue) { return tStat.nPackedValue < nValue; });
+        if (it == aStats.end() || it->nPackedValue != nLayer_StatId)
+        {
+            D2StatStrc tStat = {};
+            tStat.nPackedValue = nLayer_StatId;
+            it = aStats.insert(it, tStat);
+        }
+        it->nValue = nValue;
+    }
+}
+
+TEST_CASE("STATLIST indexed stat lookups match the binary search")
+{
+    std::mt19937 tRand(0x6FDB7C30);
+    std::vector<uint16_t> aFirstIndex(nStatIds + 1);
+
+    for (int nIteration = 0; nIteration < 200; ++nIteration)
+    {
+        std::vector<D2StatStrc> aStats;
+        const int nInitialStats = tRand() % 100;
+        for (int i = 0; i < nInitialStats; ++i)
+        {
+            InsertStat(aStats, RandomStat(tRand), 1 + tRand() % 1000);
+        }
+
+        D2StatsArrayStrc tStatsArray = {};
+        tStatsArray.pStat = aStats.data();
+        tStatsArray.nStatCount = (uint16_t)aStats.size();
+        STATLIST_BuildStatsArrayIndex(&tStatsArray, aFirstIndex.data(), nStatIds);
+
+        // The index is only rebuilt when a lookup reports it as invalid, as done by the stat lists
+        for (int nChange = 0; nChange < 100; ++nChange)
+        {
+            switch (tRand() % 3)
+            {
+            case 0:
+                InsertStat(aStats, RandomStat(tRand), 1 + tRand() % 1000);
+                break;
+            case 1:
+                if (!aStats.empty())
+                {
+                    aStats.erase(aStats.begin() + tRand() % aStats.size());
+                }
+                break;
+            default:
+                if (!aStats.empty())
+                {
+                    aStats[tRand() % aStats.size()].nValue = 1 + tRand() % 1000;
+                }
+                break;
+            }
+            tStatsArray.pStat = aStats.data();
+            tStatsArray.nStatCount = (uint16_t)aStats.size();
+
+            for (int nLookup = 0; nLookup < 50; ++nLookup)
+            {
+                // Look for existing stats as often as for missing ones
+                const D2SLayerStatIdStrc::PackedType nLayer_StatId = (!aStats.empty() && tRand() % 2) ? aStats[tRand() % aStats.size()].nPackedValue : RandomStat(tRand);
+                CAPTURE(nLayer_StatId);
+
+                BOOL bIndexValid = FALSE;
+                D2StatStrc* pStat = STATLIST_FindStatInIndexedArray(&tStatsArray, aFirstIndex.data(), nStatIds, nLayer_StatId, &bIndexValid);
+                if (!bIndexValid)
+                {
+                    STATLIST_BuildStatsArrayIndex(&tStatsArray, aFirstIndex.data(), nStatIds);
+                    pStat = STATLIST_FindStatInIndexedArray(&tStatsArray, aFirstIndex.data(), nStatIds, nLayer_StatId, &bIndexValid);
+                    REQUIRE(bIndexValid);
+                }
+
+                REQUIRE(pStat == STATLIST_FindStat_6FDB6920(&tStatsArray, nLayer_StatId));
+            }
+        }
+    }
+}
+
+TEST_CASE("STATLIST indexed stat lookups benchmark")
+{
+    std::mt19937 tRand(0x6FDB7F40);
+    std::vector<D2StatStrc> aStats;
+    for (int i = 0; i < 150; ++i)
+    {
+        InsertStat(aStats, RandomStat(tRand), 1 + tRand() % 1000);
+    }
+
+    D2StatsArrayStrc tStatsArray = {};
+    tStatsArray.pStat = aStats.data();
+    tStatsArray.nStatCount = (uint16_t)aStats.size();
+    std::vector<uint16_t> aFirstIndex(nStatIds + 1);
+    STATLIST_BuildStatsArrayIndex(&tStatsArray, aFirstIndex.data(), nStatIds);
+
+    std::vector<D2SLayerStatIdStrc::PackedType> aLookups(1000000);
+    for (D2SLayerStatIdStrc::PackedType& nLayer_StatId : aLookups)
+    {
+        nLayer_StatId = D2SLayerStatIdStrc::MakeFromStatId(tRand() % nStatIds).nPackedValue;
+    }
+
+    int64_t nExpectedSum = 0;
+    const auto tSearchStart = std::chrono::steady_clock::now();
+    for (const D2SLayerStatIdStrc::PackedType nLayer_StatId : aLookups)
+    {
+        if (const D2StatStrc* pStat = STATLIST_FindStat_6FDB6920(&tStatsArray, nLayer_StatId))
+        {
+            nExpectedSum += pStat->nValue;
+        }
+    }
+    const auto tSearchElapsed = std::chrono::steady_clock::now() - tSearchStart;
+
+    int64_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (const D2SLayerStatIdStrc::PackedType nLayer_StatId : aLookups)
+    {
+        BOOL bIndexValid = FALSE;
+        if (const D2StatStrc* pStat = STATLIST_FindStatInIndexedArray(&tStatsArray, aFirstIndex.data(), nStatIds, nLayer_StatId, &bIndexValid))
+        {
+            nSum += pStat->nValue;
+        }
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Binary search: ", std::chrono::duration_cast<std::chrono::microseconds>(tSearchElapsed).count(), "us");
+    MESSAGE("Indexed: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
@@ -0,0 +1,263 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <D2DataTbls.h>
+#include <D2Seed.h>
+
+namespace
+{
+    // Original versions of the treasure class rolls of D2GAME_DropTC_6FC51360, used as a reference.
+    namespace Legacy
+    {
+        int ComputeNoDrop(int nChance, int nNoDrop, uint32_t nPlayerCount)
+        {
+            if (nPlayerCount > 1)
+            {
+                double noDropRatio = (double)nNoDrop / (double)(nChance + nNoDrop);
+                const double baseRatio = noDropRatio;
+
+                for (int32_t i = nPlayerCount - 1; i > 0; --i)
+                {
+                    noDropRatio *= baseRatio;
+                }
+
+                const double inverseRatio = 1.0 - noDropRatio;
+                if (inverseRatio == 0.0)
+                {
+                    nNoDrop = 0;
+                }
+                else
+                {
+                    nNoDrop = (int32_t)((double)nChance / inverseRatio * (1.0 - inverseRatio));
+                }
+            }
+            return nNoDrop;
+        }
+
+        int PickEntry(const D2TCExShortStrc* pTC, bool bExpansion, int nRand)
+        {
+            int32_t nIndex = 0;
+            if (!bExpansion)
+            {
+                while (nIndex < pTC->nTypes)
+                {
+                    if (!(pTC->pInfo[nIndex].nFlags & 0x10) && (nIndex >= pTC->nTypes - 1 || pTC->pInfo[nIndex + 1].nClassic > nRand))
+                    {
+                        break;
+                    }
+
+                    ++nIndex;
+                }
+            }
+            else
+            {
+                int32_t nLowerBound = 0;
+                int32_t nUpperBound = pTC->nTypes;
+                while (nLowerBound < nUpperBound)
+                {
+                    nIndex = nLowerBound + (nUpperBound - nLowerBound) / 2;
+                    if (nRand > pTC->pInfo[nIndex].nProb)
+                    {
+                        nLowerBound = nIndex + 1;
+                    }
+                    else if (nRand < pTC->pInfo[nIndex].nProb)
+                    {
+                        nUpperBound = nIndex;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+
+                nIndex = std::max(nLowerBound - 1, 0);
+            }
+            return nIndex;
+        }
+    }
+
+    // Treasure classes built like DATATBLS_ParseTreasureClassItem does: cumulative probabilities, expansion only entries (0x10) and nested classes (4)
+    struct TestTreasureClasses
+    {
+        std::vector<D2TCExShortStrc> aTCs;
+        std::vector<std::vector<D2TCExInfoStrc>> aInfos;
+
+        TestTreasureClasses(std::mt19937& tRand, int nCount)
+            : aTCs(nCount), aInfos(nCount)
+        {
+            for (int nTC = 0; nTC < nCount; ++nTC)
+            {
+                D2TCExShortStrc& tTC = aTCs[nTC];
+                tTC = {};
+                tTC.nPicks = (tRand() % 8 == 0) ? -(int)(1 + tRand() % 6) : (int)(1 + tRand() % 3);
+                tTC.nNoDrop = (tRand() % 3) ? tRand() % 200 : 0;
+
+                const int nTypes = tRand() % 11;
+                for (int i = 0; i < nTypes; ++i)
+                {
+                    D2TCExInfoStrc tInfo = {};
+                    tInfo.nClassic = tTC.nClassic;
+                    tInfo.nProb = tTC.nProb;
+                    tInfo.nItemId = (int16_t)(tRand() % 600);
+                    // Only lower classes are nested so that the recursion ends
+                    if (nTC > 0 && tRand() % 3 == 0)
+                    {
+                        tInfo.nFlags |= 4;
+                        tInfo.nItemId = (int16_t)(tRand() % nTC);
+                    }
+                    const bool bExpansionOnly = tRand() % 4 == 0;
+                    if (bExpansionOnly)
+                    {
+                        tInfo.nFlags |= 0x10;
+                    }
+
+                    const int nProbability = 1 + tRand() % (tRand() % 2 ? 10 : 1000);
+                    tTC.nProb += nProbability;
+                    if (!bExpansionOnly)
+                    {
+                        tTC.nClassic += nProbability;
+                    }
+                    aInfos[nTC].push_back(tInfo);
+                }
+                tTC.nTypes = nTypes;
+                tTC.pInfo = aInfos[nTC].data();
+                DATATBLS_BuildTreasureClassNoDropTable(&tTC);
+            }
+        }
+
+        // Simplified D2GAME_DropTC_6FC51360: returns the (treasure class, entry) pairs in the order they are picked
+        std::vector<std::pair<int, int>> Drop(D2SeedStrc* pSeed, int nTC, bool bExpansion, uint32_t nPlayerCount, bool bLegacy)
+        {
+            std::vector<std::pair<int, int>> aDrops;
+
+            struct Frame { D2TCExShortStrc* pTC; int nPicks; } aStack[64] = {};
+            aStack[0] = { &aTCs[nTC], std::max(std::abs(aTCs[nTC].nPicks), 1) };
+            int nCounter = 1;
+            while (nCounter)
+            {
+                --nCounter;
+                while (aStack[nCounter].pTC)
+                {
+                    D2TCExShortStrc* pTC = aStack[nCounter].pTC;
+                    int32_t nChance = bExpansion ? pTC->nProb : pTC->nClassic;
+                    if (!nChance || !aStack[nCounter].nPicks)
+                    {
+                        break;
+                    }
+
+                    int32_t nRand = 0;
+                    if (pTC->nPicks < 0)
+                    {
+                        nRand = -pTC->nPicks - aStack[nCounter].nPicks;
+                        if (nRand >= nChance)
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        int32_t nNoDrop = pTC->nNoDrop;
+                        if (nNoDrop && nPlayerCount > 1)
+                        {
+                            nNoDrop = bLegacy ? Legacy::ComputeNoDrop(nChance, nNoDrop, nPlayerCount) : DATATBLS_GetTreasureClassNoDrop(pTC, bExpansion, nPlayerCount);
+                        }
+
+                        nChance += nNoDrop;
+                        nRand = SEED_RollLimitedRandomNumber(pSeed, nChance);
+                        if (nRand < nNoDrop)
+                        {
+                            --aStack[nCounter].nPicks;
+                            continue;
+                        }
+                        nRand -= nNoDrop;
+                    }
+
+                    --aStack[nCounter].nPicks;
+
+                    const int nIndex = bLegacy ? Legacy::PickEntry(pTC, bExpansion, nRand) : DATATBLS_PickTreasureClassEntry(pTC, bExpansion, nRand);
+                    aDrops.emplace_back((int)(pTC - aTCs.data()), nIndex);
+                    if (nIndex < pTC->nTypes && (pTC->pInfo[nIndex].nFlags & 4))
+                    {
+                        D2TCExShortStrc* pNestedTC = &aTCs[pTC->pInfo[nIndex].nItemId];
+                        if (aStack[nCounter].nPicks > 0)
+                        {
+                            ++nCounter;
+                        }
+                        REQUIRE(nCounter < 64);
+                        aStack[nCounter] = { pNestedTC, std::max(std::abs(pNestedTC->nPicks), 1) };
+                    }
+                }
+            }
+
+            return aDrops;
+        }
+    };
+}
+
+TEST_CASE("DATATBLS treasure class rolls match the original drops")
+{
+    std::mt19937 tRand(0x6FC51360);
+
+    for (int nIteration = 0; nIteration < 100; ++nIteration)
+    {
+        TestTreasureClasses tTCs(tRand, 50);
+
+        // Every entry for every possible roll
+        for (D2TCExShortStrc& tTC : tTCs.aTCs)
+        {
+            for (int bExpansion = 0; bExpansion < 2; ++bExpansion)
+            {
+                const int nChance = bExpansion ? tTC.nProb : tTC.nClassic;
+                for (int nRand = 0; nRand < nChance + 2; ++nRand)
+                {
+                    REQUIRE(DATATBLS_PickTreasureClassEntry(&tTC, bExpansion, nRand) == Legacy::PickEntry(&tTC, bExpansion, nRand));
+                }
+
+                for (uint32_t nPlayerCount = 0; nPlayerCount <= 10; ++nPlayerCount)
+                {
+                    REQUIRE(DATATBLS_GetTreasureClassNoDrop(&tTC, bExpansion, nPlayerCount) == Legacy::ComputeNoDrop(nChance, tTC.nNoDrop, nPlayerCount));
+                }
+            }
+        }
+
+        // Full drop sequences for a sweep of seeds
+        for (int nSeed = 0; nSeed < 200; ++nSeed)
+        {
+            const int nTC = tRand() % 50;
+            const bool bExpansion = tRand() % 2;
+            const uint32_t nPlayerCount = 1 + tRand() % 8;
+            D2SeedStrc tSeed = {};
+            D2SeedStrc tExpectedSeed = {};
+            SEED_InitLowSeed(&tSeed, nSeed);
+            SEED_InitLowSeed(&tExpectedSeed, nSeed);
+            CAPTURE(nIteration);
+            CAPTURE(nSeed);
+            REQUIRE(tTCs.Drop(&tSeed, nTC, bExpansion, nPlayerCount, false) == tTCs.Drop(&tExpectedSeed, nTC, bExpansion, nPlayerCount, true));
+        }
+    }
+}
+
+TEST_CASE("DATATBLS treasure class rolls benchmark")
+{
+    // Drops of the last treasure classes, which nest the most, in a full game
+    std::mt19937 tRand(0x6FC51770);
+    TestTreasureClasses tTCs(tRand, 200);
+
+    for (int bLegacy = 1; bLegacy >= 0; --bLegacy)
+    {
+        D2SeedStrc tSeed = {};
+        SEED_InitLowSeed(&tSeed, 0x1234);
+        size_t nDrops = 0;
+        const auto tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < 20000; ++i)
+        {
+            nDrops += tTCs.Drop(&tSeed, 150 + i % 50, i % 2, 8, bLegacy).size();
+        }
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+        MESSAGE(bLegacy ? "Original rolls: " : "Precomputed rolls: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us for ", nDrops, " picks");
+    }
+}
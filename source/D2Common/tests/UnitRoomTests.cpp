@@ -0,0 +1,205 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <D2Dungeon.h>
+#include <Path/Path.h>
+#include <Units/UnitRoom.h>
+#include <Units/Units.h>
+
+namespace
+{
+    // Original version of UNITROOM_SortUnitListByTargetY, used as a reference.
+    namespace Legacy
+    {
+        void SortUnitListByTargetY(D2ActiveRoomStrc* pRoom)
+        {
+            D2UnitStrc** ppUnitFirst = NULL;
+            D2UnitStrc** ppUnit = NULL;
+            D2UnitStrc* pPreviousUnit = NULL;
+            D2UnitStrc* pNextUnit = NULL;
+            D2UnitStrc* pUnit = NULL;
+            bool bContinue = false;
+
+            ppUnit = DUNGEON_GetUnitListFromRoom(pRoom);
+            pUnit = *ppUnit;
+            ppUnitFirst = ppUnit;
+
+            if (pUnit)
+            {
+                pNextUnit = pUnit->pRoomNext;
+                do
+                {
+                    bContinue = false;
+
+                    while (pNextUnit)
+                    {
+                        if (UNITS_GetClientCoordY(pUnit) <= UNITS_GetClientCoordY(pNextUnit))
+                        {
+                            pPreviousUnit = pUnit;
+                            pUnit = pNextUnit;
+                            pNextUnit = pNextUnit->pRoomNext;
+                        }
+                        else
+                        {
+                            if (pPreviousUnit)
+                            {
+                                pPreviousUnit->pRoomNext = pNextUnit;
+                            }
+                            else
+                            {
+                                *ppUnitFirst = pNextUnit;
+                            }
+
+                            pPreviousUnit = pNextUnit;
+                            pUnit->pRoomNext = pNextUnit->pRoomNext;
+                            pNextUnit->pRoomNext = pUnit;
+                            pNextUnit = pUnit->pRoomNext;
+                            bContinue = true;
+                        }
+                    }
+                }
+                while (bContinue);
+            }
+        }
+    }
+
+    // Room with units using static paths, so that UNITS_GetClientCoordY only needs the path
+    struct TestRoom
+    {
+        D2ActiveRoomStrc tRoom = {};
+        std::vector<D2UnitStrc> aUnits;
+        std::vector<D2StaticPathStrc> aPaths;
+
+        TestRoom(std::mt19937& tRand, int nUnits, int nMaxY)
+            : aUnits(nUnits), aPaths(nUnits)
+        {
+            for (int i = 0; i < nUnits; ++i)
+            {
+                aUnits[i] = {};
+                aUnits[i].dwUnitType = (i % 2) ? UNIT_OBJECT : UNIT_ITEM;
+                aUnits[i].pStaticPath = &aPaths[i];
+                aPaths[i] = {};
+                aPaths[i].dwClientCoordY = tRand() % nMaxY; // Small ranges to get ties
+                aUnits[i].pRoomNext = i + 1 < nUnits ? &aUnits[i + 1] : nullptr;
+            }
+            tRoom.pUnitFirst = nUnits ? &aUnits[0] : nullptr;
+        }
+
+        void Move(std::mt19937& tRand, int nMaxY)
+        {
+            // A few units move between two calls
+            for (D2StaticPathStrc& tPath : aPaths)
+            {
+                if (tRand() % 8 == 0)
+                {
+                    tPath.dwClientCoordY = tRand() % nMaxY;
+                }
+            }
+        }
+
+        std::vector<D2UnitStrc*> GetOrder() const
+        {
+            std::vector<D2UnitStrc*> aOrder;
+            for (D2UnitStrc* pUnit = tRoom.pUnitFirst; pUnit; pUnit = pUnit->pRoomNext)
+            {
+                aOrder.push_back(pUnit);
+            }
+            return aOrder;
+        }
+
+        std::vector<int> GetOrderIndices() const
+        {
+            std::vector<int> aIndices;
+            for (D2UnitStrc* pUnit : GetOrder())
+            {
+                aIndices.push_back((int)(pUnit - aUnits.data()));
+            }
+            return aIndices;
+        }
+    };
+}
+
+TEST_CASE("UNITROOM_SortUnitListByTargetY matches the original version")
+{
+    std::mt19937 tRand(0x6FDBD1B0);
+
+    for (int nIteration = 0; nIteration < 500; ++nIteration)
+    {
+        const int nUnits = tRand() % 64;
+        const int nMaxY = 1 + tRand() % 32;
+        const uint32_t nSeed = tRand();
+        std::mt19937 tRoomRand(nSeed);
+        std::mt19937 tExpectedRoomRand(nSeed);
+        TestRoom tRoom(tRoomRand, nUnits, nMaxY);
+        TestRoom tExpectedRoom(tExpectedRoomRand, nUnits, nMaxY);
+
+        for (int nCall = 0; nCall < 20; ++nCall)
+        {
+            CAPTURE(nIteration);
+            CAPTURE(nCall);
+            UNITROOM_SortUnitListByTargetY(&tRoom.tRoom);
+            Legacy::SortUnitListByTargetY(&tExpectedRoom.tRoom);
+            REQUIRE(tRoom.GetOrderIndices() == tExpectedRoom.GetOrderIndices());
+
+            if (nCall % 2)
+            {
+                tRoom.Move(tRoomRand, nMaxY);
+                tExpectedRoom.Move(tExpectedRoomRand, nMaxY);
+            }
+        }
+    }
+
+    // Units that do not move are sorted after as many calls as there are units, and ties keep their order
+    TestRoom tRoom(tRand, 100, 10);
+    for (int nCall = 0; nCall < 100; ++nCall)
+    {
+        UNITROOM_SortUnitListByTargetY(&tRoom.tRoom);
+    }
+    const std::vector<D2UnitStrc*> aOrder = tRoom.GetOrder();
+    for (size_t i = 1; i < aOrder.size(); ++i)
+    {
+        REQUIRE(aOrder[i - 1]->pStaticPath->dwClientCoordY <= aOrder[i]->pStaticPath->dwClientCoordY);
+        if (aOrder[i - 1]->pStaticPath->dwClientCoordY == aOrder[i]->pStaticPath->dwClientCoordY)
+        {
+            REQUIRE(aOrder[i - 1] < aOrder[i]);
+        }
+    }
+}
+
+TEST_CASE("UNITROOM_SortUnitListByTargetY benchmark")
+{
+    // Crowded rooms, the list is sorted every time the first unit of the room is requested while some units move (only the sorts are timed)
+    for (int nUnits : { 50, 100, 200, 500 })
+    {
+        constexpr int nCalls = 2000;
+        constexpr int nMaxY = 200;
+        std::mt19937 tRand(0x6FDBD250);
+        TestRoom tExpectedRoom(tRand, nUnits, nMaxY);
+        std::chrono::steady_clock::duration tLegacyElapsed = {};
+        for (int nCall = 0; nCall < nCalls; ++nCall)
+        {
+            const auto tLegacyStart = std::chrono::steady_clock::now();
+            Legacy::SortUnitListByTargetY(&tExpectedRoom.tRoom);
+            tLegacyElapsed += std::chrono::steady_clock::now() - tLegacyStart;
+            tExpectedRoom.Move(tRand, nMaxY);
+        }
+
+        tRand.seed(0x6FDBD250);
+        TestRoom tRoom(tRand, nUnits, nMaxY);
+        std::chrono::steady_clock::duration tElapsed = {};
+        for (int nCall = 0; nCall < nCalls; ++nCall)
+        {
+            const auto tStart = std::chrono::steady_clock::now();
+            UNITROOM_SortUnitListByTargetY(&tRoom.tRoom);
+            tElapsed += std::chrono::steady_clock::now() - tStart;
+            tRoom.Move(tRand, nMaxY);
+        }
+
+        CHECK(tRoom.GetOrderIndices() == tExpectedRoom.GetOrderIndices());
+        MESSAGE(nUnits, " units, original sort: ", std::chrono::duration_cast<std::chrono::microseconds>(tLegacyElapsed).count(), "us");
+        MESSAGE(nUnits, " units, single read sort: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+    }
+}
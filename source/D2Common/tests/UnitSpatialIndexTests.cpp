@@ -0,0 +1,244 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <D2Dungeon.h>
+#include <Drlg/D2DrlgDrlg.h>
+#include <Path/Path.h>
+#include <Units/UnitFinds.h>
+#include <Units/UnitSpatialIndex.h>
+#include <Units/Units.h>
+
+namespace
+{
+    constexpr int nRoomsPerSide = 3;
+    constexpr int nRoomSize = 40;
+    constexpr int nAreaSize = nRoomsPerSide * nRoomSize;
+
+    // Grid of rooms sharing an act, with units linked to the rooms and to a spatial index owned by the test, so that nothing is allocated with Fog
+    struct TestArea
+    {
+        D2DrlgActStrc tAct = {};
+        std::unique_ptr<D2UnitSpatialIndexStrc> pIndex = std::make_unique<D2UnitSpatialIndexStrc>();
+        std::vector<D2UnitSpatialCellStrc> aCells;
+        std::vector<D2UnitSpatialEntryStrc> aEntries;
+        std::vector<D2ActiveRoomStrc> aRooms;
+        std::vector<std::vector<D2ActiveRoomStrc*>> aAdjacentRooms;
+        std::vector<D2UnitStrc> aUnits;
+        std::vector<D2StaticPathStrc> aStaticPaths;
+        std::vector<D2DynamicPathStrc> aDynamicPaths;
+
+        TestArea(std::mt19937& tRand, int nUnits)
+            : aEntries(nUnits), aRooms(nRoomsPerSide * nRoomsPerSide), aAdjacentRooms(aRooms.size()), aUnits(nUnits), aStaticPaths(nUnits), aDynamicPaths(nUnits)
+        {
+            *pIndex = {};
+            tAct.pSpatialIndex = pIndex.get();
+
+            // Every cell a unit can move to exists beforehand
+            const int nCellsPerSide = (nAreaSize >> UNITSPATIAL_CELL_SIZE_SHIFT) + 1;
+            aCells.resize(nCellsPerSide * nCellsPerSide);
+            for (int nCellY = 0; nCellY < nCellsPerSide; ++nCellY)
+            {
+                for (int nCellX = 0; nCellX < nCellsPerSide; ++nCellX)
+                {
+                    UNITSPATIAL_AddCell(pIndex.get(), &aCells[nCellY * nCellsPerSide + nCellX], nCellX, nCellY);
+                }
+            }
+
+            for (D2UnitSpatialEntryStrc& rEntry : aEntries)
+            {
+                rEntry = {};
+                rEntry.pUnitHashNext = pIndex->pFreeEntries;
+                pIndex->pFreeEntries = &rEntry;
+            }
+
+            for (int nRoom = 0; nRoom < (int)aRooms.size(); ++nRoom)
+            {
+                D2ActiveRoomStrc& rRoom = aRooms[nRoom];
+                rRoom = {};
+                rRoom.pAct = &tAct;
+                rRoom.tCoords.nSubtileX = (nRoom % nRoomsPerSide) * nRoomSize;
+                rRoom.tCoords.nSubtileY = (nRoom / nRoomsPerSide) * nRoomSize;
+                rRoom.tCoords.nSubtileWidth = nRoomSize;
+                rRoom.tCoords.nSubtileHeight = nRoomSize;
+
+                // The room itself, then its neighbours in a shuffled order
+                aAdjacentRooms[nRoom].push_back(&rRoom);
+                for (int nOtherRoom = 0; nOtherRoom < (int)aRooms.size(); ++nOtherRoom)
+                {
+                    if (nOtherRoom != nRoom
+                        && std::abs(nOtherRoom % nRoomsPerSide - nRoom % nRoomsPerSide) <= 1
+                        && std::abs(nOtherRoom / nRoomsPerSide - nRoom / nRoomsPerSide) <= 1)
+                    {
+                        aAdjacentRooms[nRoom].push_back(&aRooms[nOtherRoom]);
+                    }
+                }
+                std::shuffle(aAdjacentRooms[nRoom].begin() + 1, aAdjacentRooms[nRoom].end(), tRand);
+                rRoom.ppRoomList = aAdjacentRooms[nRoom].data();
+                rRoom.nNumRooms = (int32_t)aAdjacentRooms[nRoom].size();
+            }
+
+            for (int i = 0; i < nUnits; ++i)
+            {
+                D2UnitStrc& rUnit = aUnits[i];
+                rUnit = {};
+                rUnit.dwUnitId = i;
+                D2ActiveRoomStrc* pRoom = &aRooms[std::uniform_int_distribution<int>(0, (int)aRooms.size() - 1)(tRand)];
+                const int nX = pRoom->tCoords.nSubtileX + GetRandomOffset(tRand);
+                const int nY = pRoom->tCoords.nSubtileY + GetRandomOffset(tRand);
+                if (i % 2)
+                {
+                    rUnit.dwUnitType = UNIT_OBJECT;
+                    rUnit.pStaticPath = &aStaticPaths[i];
+                    aStaticPaths[i] = {};
+                    aStaticPaths[i].pRoom = pRoom;
+                    aStaticPaths[i].tGameCoords.nX = nX;
+                    aStaticPaths[i].tGameCoords.nY = nY;
+                }
+                else
+                {
+                    rUnit.dwUnitType = UNIT_MONSTER;
+                    rUnit.pDynamicPath = &aDynamicPaths[i];
+                    aDynamicPaths[i] = {};
+                    aDynamicPaths[i].pUnit = &rUnit;
+                    aDynamicPaths[i].pRoom = pRoom;
+                    aDynamicPaths[i].tGameCoords.dwPrecisionX = PATH_ToFP16Center(nX);
+                    aDynamicPaths[i].tGameCoords.dwPrecisionY = PATH_ToFP16Center(nY);
+                }
+
+                // Same as UNITROOM_AddUnitToRoomEx
+                rUnit.pRoomNext = pRoom->pUnitFirst;
+                pRoom->pUnitFirst = &rUnit;
+                UNITSPATIAL_InsertUnit(pIndex.get(), &rUnit, nX, nY);
+            }
+        }
+
+        // Units are on even subtiles, to get units at the same distance
+        static int GetRandomOffset(std::mt19937& tRand)
+        {
+            return 2 * std::uniform_int_distribution<int>(0, nRoomSize / 2 - 1)(tRand);
+        }
+
+        // Units stay in their room list, only their coordinates change, through the same setters as the game
+        void MoveUnit(std::mt19937& tRand, D2UnitStrc* pUnit)
+        {
+            D2ActiveRoomStrc* pRoom = UNITS_GetRoom(pUnit);
+            const int nX = pRoom->tCoords.nSubtileX + GetRandomOffset(tRand);
+            const int nY = pRoom->tCoords.nSubtileY + GetRandomOffset(tRand);
+            if (pUnit->dwUnitType == UNIT_OBJECT)
+            {
+                UNITS_SetXForStaticUnit(pUnit, nX);
+                UNITS_SetYForStaticUnit(pUnit, nY);
+            }
+            else
+            {
+                PATH_SetPrecisionX(pUnit->pDynamicPath, PATH_ToFP16Center(nX));
+                PATH_SetPrecisionY(pUnit->pDynamicPath, PATH_ToFP16Center(nY));
+            }
+        }
+    };
+
+    struct TestQuery
+    {
+        D2UnitStrc* pUnit;
+        int nX;
+        int nY;
+        int nSize;
+        int nTestedUnits;
+    };
+
+    TestQuery* gpTestQuery = nullptr;
+
+    // Accepts some of the units in range, as the game callbacks would
+    int32_t __fastcall TestFindUnit(D2UnitStrc* pUnit, D2UnitFindArgStrc* pUnitFindArg)
+    {
+        ++gpTestQuery->nTestedUnits;
+        return (int)UNITS_GetDistanceToCoordinates(pUnit, gpTestQuery->nX, gpTestQuery->nY) < gpTestQuery->nSize && pUnit->dwUnitId % 3 != 0;
+    }
+
+    int __fastcall TestNearestUnit(D2UnitStrc* pUnit, D2UnitStrc* pSearchingUnit)
+    {
+        ++gpTestQuery->nTestedUnits;
+        return pUnit != pSearchingUnit && pUnit->dwUnitId % 3 != 0;
+    }
+
+    std::vector<D2UnitStrc*> FindAllMatchingUnits(TestQuery& rQuery)
+    {
+        std::vector<D2UnitStrc*> aUnitsArray(4096);
+        D2UnitFindDataStrc tUnitFindData = {};
+        tUnitFindData.pUnitsArray = aUnitsArray.data();
+        tUnitFindData.nMaxArrayEntries = (int32_t)aUnitsArray.size();
+        tUnitFindData.pRoom = UNITS_GetRoom(rQuery.pUnit);
+        tUnitFindData.nX = rQuery.nX;
+        tUnitFindData.nY = rQuery.nY;
+        tUnitFindData.nSize = rQuery.nSize;
+        tUnitFindData.pfnUnitTest = TestFindUnit;
+
+        gpTestQuery = &rQuery;
+        UNITFINDS_FindAllMatchingUnitsInNeighboredRooms(&tUnitFindData);
+        gpTestQuery = nullptr;
+        REQUIRE(tUnitFindData.nIndex < (int)aUnitsArray.size());
+        return std::vector<D2UnitStrc*>(aUnitsArray.begin(), aUnitsArray.begin() + tUnitFindData.nIndex);
+    }
+
+    D2UnitStrc* GetNearestTestedUnit(TestQuery& rQuery)
+    {
+        gpTestQuery = &rQuery;
+        D2UnitStrc* pNearestUnit = UNITFINDS_GetNearestTestedUnit(rQuery.pUnit, rQuery.nX, rQuery.nY, rQuery.nSize, TestNearestUnit);
+        gpTestQuery = nullptr;
+        return pNearestUnit;
+    }
+}
+
+TEST_CASE("UNITFINDS queries using the spatial index match the rooms walk")
+{
+    std::mt19937 tRand(0x6FDBCA80);
+
+    constexpr int nUnits = 600;
+    constexpr int nQueries = 2000;
+
+    TestArea tArea(tRand, nUnits);
+    REQUIRE(tArea.pIndex->nUnits == nUnits);
+
+    int nIndexedTests = 0;
+    int nRoomsWalkTests = 0;
+    for (int nQuery = 0; nQuery < nQueries; ++nQuery)
+    {
+        CAPTURE(nQuery);
+
+        // Move a few units between two queries
+        for (int i = 0; i < 20; ++i)
+        {
+            tArea.MoveUnit(tRand, &tArea.aUnits[std::uniform_int_distribution<int>(0, nUnits - 1)(tRand)]);
+        }
+
+        D2UnitStrc* pUnit = &tArea.aUnits[std::uniform_int_distribution<int>(0, nUnits - 1)(tRand)];
+        D2CoordStrc tCoords = {};
+        UNITS_GetCoords(pUnit, &tCoords);
+        TestQuery tIndexedQuery = { pUnit, tCoords.nX, tCoords.nY, std::uniform_int_distribution<int>(1, 30)(tRand), 0 };
+        TestQuery tRoomsWalkQuery = tIndexedQuery;
+        CAPTURE(tIndexedQuery.nSize);
+
+        const std::vector<D2UnitStrc*> aIndexedUnits = FindAllMatchingUnits(tIndexedQuery);
+        D2UnitStrc* pIndexedNearestUnit = GetNearestTestedUnit(tIndexedQuery);
+
+        tArea.tAct.pSpatialIndex = nullptr;
+        const std::vector<D2UnitStrc*> aRoomsWalkUnits = FindAllMatchingUnits(tRoomsWalkQuery);
+        D2UnitStrc* pRoomsWalkNearestUnit = GetNearestTestedUnit(tRoomsWalkQuery);
+        tArea.tAct.pSpatialIndex = tArea.pIndex.get();
+
+        // Same units in the same order, and the same unit among the nearest ones
+        REQUIRE(aIndexedUnits == aRoomsWalkUnits);
+        REQUIRE(pIndexedNearestUnit == pRoomsWalkNearestUnit);
+
+        nIndexedTests += tIndexedQuery.nTestedUnits;
+        nRoomsWalkTests += tRoomsWalkQuery.nTestedUnits;
+    }
+
+    MESSAGE("Tested units: ", nIndexedTests, " with the index, ", nRoomsWalkTests, " walking the rooms");
+    CHECK(nIndexedTests < nRoomsWalkTests);
+}
@@ -896,6 +896,8 @@ struct D2GSPacketSrv26Args
 	D2GSPacketSrv26* pPacket26;		//0x00
 	D2GSPacketClt15* pPacket15;		//0x04
 	int32_t nUnitId;				//0x08
+	int32_t bReceiverInGame;		//0x0C D2Moo only, was the global gbWhispReceiverInGame_6FD4DC20
+	int32_t bReceiverNotListening;	//0x10 D2Moo only, was the global gbWhispReceiverNotListening_6FD4DC24
 };
 
 struct D2GSPacketSrv27		//size of 0x28
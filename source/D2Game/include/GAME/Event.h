@@ -67,7 +67,16 @@ struct D2TimerArgStrc
 	uint32_t dwUnitId;
 };
 
+enum D2C_EventTimerWheelConstants
+{
+	EVENT_WHEEL_SLOT_BITS = 6,
+	EVENT_WHEEL_SLOTS = 1 << EVENT_WHEEL_SLOT_BITS,	// Each level spans 64 times the frames of the previous one (64, 4096, 262144)
+	EVENT_WHEEL_LEVELS = 3,							// Timers expiring after the last level wait in tOverflow
+	EVENT_TIMER_LISTS = 5,							// One set of lists per unit type, see EVENT_MapUnitTypeToIndex
+};
+
 using EventTimerCallback = int32_t(__fastcall*)(D2GameStrc*, D2UnitStrc*, int32_t, int32_t, int32_t);
+struct D2EventTimerListStrc;
 struct D2EventTimerStrc
 {
 	int8_t nEvent;
@@ -79,11 +88,13 @@ struct D2EventTimerStrc
 	int32_t nUnitType;
 	int32_t nSkillId;
 	int32_t nSkillLevel;
-	D2EventTimerStrc* pNextFreeEventTimer;
-	D2EventTimerStrc* unk0x20;
+	D2EventTimerStrc* pNextFreeEventTimer;		// Also next timer of pTimerList
+	D2EventTimerStrc* unk0x20;					// Previous timer of pTimerList
 	D2EventTimerStrc* pNext;
 	D2EventTimerStrc* pPrevious;
 	EventTimerCallback pCallback;
+	D2EventTimerListStrc* pTimerList;			// D2Moo only: List holding the timer, for O(1) removal
+	uint32_t nSequence;							// D2Moo only: Insertion order, keeps the original execution order when timers cascade between wheel levels
 };
 
 struct D2EventTimerSlabListStrc
@@ -93,13 +104,26 @@ struct D2EventTimerSlabListStrc
 	D2EventTimerSlabListStrc* pNextSlab;
 };
 
+struct D2EventTimerListStrc
+{
+	D2EventTimerStrc* pHead;
+	D2EventTimerStrc* pTail;
+};
+
+// Note: The original game used a single wheel of 64 frames (nExpireFrame % 64) per unit type,
+// which made every lap scan the timers expiring later. D2Moo uses a hierarchical timing wheel instead,
+// level 0 only contains timers expiring during the next 64 frames, and the other levels cascade down when the wheel wraps.
 struct D2EventTimerQueueStrc
 {
 	int32_t nArrayIndex;
-	D2EventTimerStrc* unk0x04[10][64];
-	D2EventTimerStrc* unk0xA04[5];
-	D2EventTimerStrc* unk0xA18;
+	int32_t nWheelFrame;														// Frame of the current level 0 slot
+	uint32_t nNextSequence;
+	D2EventTimerListStrc tWheels[EVENT_TIMER_LISTS][EVENT_WHEEL_LEVELS][EVENT_WHEEL_SLOTS];
+	D2EventTimerListStrc tOverflow[EVENT_TIMER_LISTS];
+	D2EventTimerListStrc tPermanentTimers[EVENT_TIMER_LISTS];					// nExpireFrame == -1, executed every frame
+	D2EventTimerStrc* pNextTimerToExecute;
 	D2EventTimerSlabListStrc* pSlabListHead;
+	uint32_t nTimersVisited;													// Number of timers visited by EVENT_IterateEvents, for profiling
 };
 
 
@@ -139,7 +163,7 @@ void __fastcall EVENT_SetEvent(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nTi
 //D2Game.0x6FC351D0
 void __fastcall D2GAME_InitTimer_6FC351D0(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nTimerType, int32_t nExpireFrame, EventTimerCallback pfCallBack, int32_t nSkillId, int32_t nSkillLevel);
 //D2Game.0x6FC353D0
-D2EventTimerStrc** __fastcall sub_6FC353D0(D2GameStrc* pGame, int32_t nUnitType, int32_t nExpireFrame);
+D2EventTimerListStrc* __fastcall sub_6FC353D0(D2GameStrc* pGame, int32_t nUnitType, int32_t nExpireFrame);
 //D2Game.0x6FC35410
 D2EventTimerSlabListStrc* __fastcall EVENT_AllocTimerSlab(D2GameStrc* pGame);
 //D2Game.0x6FC35460
@@ -3,6 +3,7 @@
 #include <Units/Units.h>
 
 #include "D2PacketDef.h"
+#include "UNIT/SUnitGuidIndex.h"
 
 #pragma warning(push)
 #pragma warning(disable: 4820)
@@ -200,6 +201,8 @@ struct D2GameStrc : TSHashObject<D2GameStrc, HASHKEY_NONE> // called SGAMEDATA i
 	uint32_t unk0x1DD4;								//0x1DD4
 	uint32_t unk0x1DD8;								//0x1DD8
 	uint32_t unk0x1DDC;								//0x1DDC
+	D2UnitGuidIndexStrc tUnitGuidIndex[5];			//0x1DE0 D2Moo only, indexed like pUnitList. See SUNIT_GetServerUnit
+	uint32_t nHitClassCounter;						//0x1E30 D2Moo only, was a static of SUNITDMG_GetHitClass shared by all games
 };
 
 struct D2GameDataTableStrc
@@ -327,6 +330,8 @@ void __fastcall GAME_PopulateRoom(D2GameStrc* pGame, D2ActiveRoomStrc* pRoom);
 void __fastcall D2GAME_UpdateAllClients_6FC389C0(D2GameStrc* pGame);
 //D2Game.0x6FC38E00
 void __fastcall sub_6FC38E00();
+// Helper function
+BOOL __fastcall GAME_UpdateGameFrame(D2GameGUID nGameGUID, uint32_t nSysTimeMs);
 //D2Game.0x6FC38E20 (#10004)
 D2GAME_DLL_DECL int32_t __stdcall GAME_UpdateGamesProgress(int32_t a1);
 //D2Game.0x6FC39030
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Units/Units.h>
+
+#include "GAME/Game.h"
+
+// D2Moo only: optional worker pool running the games ticks of GAME_UpdateGamesProgress in parallel.
+// A game is only updated by one thread at a time, with its lpCriticalSection held, and uses its own memory pool.
+// Games still share some state during GAME_UpdateProgress, it must either be read-only once loaded (data tables, cached item ids),
+// per game (see D2GameStrc::nHitClassCounter), per thread (scratch buffers), or updated with Interlocked functions (statistics),
+// and lists shared by all the games (clients, level files) keep their own locks.
+// The serial path stays the default (0 workers).
+// Workers can be enabled with the D2_GAME_WORKERS environment variable or GAMESCHED_SetWorkerCount.
+
+enum D2C_GameSchedulerConstants
+{
+	GAMESCHED_MAX_WORKERS = 32,
+	GAMESCHED_MAX_GAMES_PER_WORKER = 1024,
+	GAMESCHED_FRAMETIME_SAMPLES = 256, // Number of frames kept per worker to compute the percentiles
+};
+
+// Updates one game, returns FALSE if the game does not exist anymore. See GAME_UpdateGameFrame.
+typedef BOOL(__fastcall* GAMESCHEDUPDATEGAMEFN)(D2GameGUID nGameGUID, uint32_t nSysTimeMs);
+
+#pragma pack(push, 1)
+struct D2GameSchedulerStatsStrc
+{
+	uint32_t nFramesCount;				// Frames in which this worker had at least one game to update
+	uint32_t nGamesUpdated;				// Total number of game ticks run by this worker
+	uint32_t nFrameTimeP50Us;			// Time spent by the worker on its games for one frame, in microseconds
+	uint32_t nFrameTimeP95Us;
+	uint32_t nFrameTimeP99Us;
+	uint32_t nFrameTimeMaxUs;
+};
+
+struct D2GameSchedulerWorkerStrc
+{
+	HANDLE hThread;										//0x00
+	HANDLE hStartEvent;									//0x04
+	volatile LONG bShutdown;							//0x08
+	// Filled by the scheduling thread before hStartEvent is signaled
+	int32_t nGames;										//0x0C
+	D2GameGUID aGameGUIDs[GAMESCHED_MAX_GAMES_PER_WORKER];	//0x10
+	BOOL bUpdatedAnyGame;								//0x1010
+	CRITICAL_SECTION tStatsLock;						//0x1014
+	// Protected by tStatsLock
+	uint32_t aFrameTimesUs[GAMESCHED_FRAMETIME_SAMPLES];	//0x102C
+	uint32_t nFramesCount;								//0x142C
+	uint32_t nGamesUpdated;								//0x1430
+};
+#pragma pack(pop)
+
+// Helper function
+void __fastcall GAMESCHED_Initialize();
+// Helper function
+void __fastcall GAMESCHED_Release();
+// Helper function: Restarts the worker pool with nWorkers threads. 0 means games are updated serially on the calling thread.
+// Must be called from the thread running GAME_UpdateGamesProgress.
+int32_t __fastcall GAMESCHED_SetWorkerCount(int32_t nWorkers);
+// Helper function
+int32_t __fastcall GAMESCHED_GetWorkerCount();
+// Helper function: Starts the thread of pWorker and adds it to the pool, pWorker must be zeroed. Returns FALSE if the thread could not be started.
+BOOL __fastcall GAMESCHED_StartWorker(D2GameSchedulerWorkerStrc* pWorker);
+// Helper function: Stops the thread of the last worker of the pool and removes it. Returns the worker, to be freed by the caller, or nullptr if the pool is empty.
+D2GameSchedulerWorkerStrc* __fastcall GAMESCHED_StopLastWorker();
+// Helper function: Runs pfnUpdateGame for every valid game GUID on the worker pool and waits for all of them.
+// A game is always assigned to the same worker (GUID % workers count) so that its data stays in the same core caches,
+// and the games of a worker are updated in the order of pGameGUIDs, as the serial loop of GAME_UpdateGamesProgress does.
+// Returns TRUE if at least one game was updated.
+BOOL __fastcall GAMESCHED_UpdateGames(const int32_t* pGameGUIDs, int32_t nGameGUIDs, uint32_t nSysTimeMs, GAMESCHEDUPDATEGAMEFN pfnUpdateGame);
+// Helper function: Computes the frame time percentiles over the last GAMESCHED_FRAMETIME_SAMPLES frames of a worker
+BOOL __fastcall GAMESCHED_GetWorkerStats(int32_t nWorker, D2GameSchedulerStatsStrc* pStats);
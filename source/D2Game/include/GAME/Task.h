@@ -6,7 +6,10 @@
 #pragma pack(push, 1)
 
 enum D2C_TaskConstants {
-    TASKQSLOTS = 0x20
+    TASKQSLOTS = 0x20,
+    TASK_GAME_FRAME_MS = 40,            // Delay between two TASK_ProcessGame of the same game
+    TASK_BUDGET_RATIO_ONTIME = 1024,    // nCreationTimeMs_Or_CPUTargetRatioFP10 of a game updated exactly on time
+    TASK_STEAL_THRESHOLD_FP10 = 2048,   // Minimum load difference between two queues before an idle worker steals a game
 };
 
 enum D2C_TaskTypes
@@ -29,6 +32,16 @@ struct D2TaskStrc
 	D2LinkStrc pTaskQueueLink;					//0x10
 };
 
+// Game tasks are stored right after their D2GameStrc (&pGame[1]) and only share the first 0x0C bytes with D2TaskStrc.
+// Their queue link is at 0x0C, which is why the original code accesses them through CONTAINING_RECORD(pLink, D2TaskStrc, pTaskQueueLink)->nType.
+struct D2GameTaskStrc
+{
+	int32_t nDueTimeMs;							//0x00 Clock time at which the game should be processed next
+	int32_t nType;								//0x04 D2C_TaskTypes
+	uint32_t nGameHashKey;						//0x08
+	D2LinkStrc pQueueLink;						//0x0C Link in the pTaskBalanceLink list of the owning queue slot, sorted by nDueTimeMs
+};
+
 struct CRITICAL_SECTION_WRAPPER
 {
     CRITICAL_SECTION cs;
@@ -41,6 +54,10 @@ struct CRITICAL_SECTION_WRAPPER
 
 //D2Game.0x6FC404E0 (#10039)
 void __stdcall TASK_InitializeClock();
+// Helper function: Uses ptTask as the queue of the worker nTaskSlotIndex, the slot must be free
+void __fastcall TASK_AddQueueSlot(int32_t nTaskSlotIndex, D2TaskStrc* ptTask);
+// Helper function: Removes the queue of the worker nTaskSlotIndex, and returns it to be freed by the caller. Its games are dropped.
+D2TaskStrc* __fastcall TASK_RemoveQueueSlot(int32_t nTaskSlotIndex);
 //D2Game.0x6FC40500 (#10040)
 void __stdcall TASK_FreeAllQueueSlots();
 //D2Game.0x6FC405B0 (#10041)
@@ -48,6 +65,7 @@ int32_t __cdecl D2Game_10041_TASK_Create();
 //D2Game.0x6FC407A0 (#10042)
 BOOL __fastcall D2Game_10042(D2TaskStrc* pTask, int nTaskType, D2LinkStrc* pPrevTaskBalanceLink);
 //D2Game.0x6FC40930 (#10043)
+// Note: pOutBalanceTaskType receives the address of the D2GameTaskStrc to give to TASK_ProcessGame, or 0 if none is due yet.
 int32_t __fastcall D2Game_10043(int8_t a1, int32_t* pOutBalanceTaskType);
 //D2Game.0x6FC40A40 (#10044)
 int32_t __fastcall D2Game_10044(int8_t nTaskNumber);
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <D2BasicTypes.h>
+
+// D2Moo only: background thread writing the save files of D2GAME_SAVE_WriteFile_6FC8A500, so that the game tick only pays for the serialization.
+// Each file is written to "<name>.tmp", flushed to the disk, then renamed over the previous save, so a crash never leaves a truncated save.
+// Saves of a character that are still queued are replaced by the newest one, and D2GAME_SAVE_ReadFile_6FC8C9D0 reads the queued data
+// instead of the file while a save is pending.
+// A failed write is kept until a later write of the same file succeeds, and the next PLRSAVEWRITER_WriteFile of that file returns FALSE.
+// The thread can be disabled with the D2_SAVE_WRITER_THREAD=0 environment variable, saves are then written directly to the file on the game thread, as in the original game.
+
+enum D2C_PlrSaveWriterConstants
+{
+	PLRSAVEWRITER_MAX_SAVE_SIZE = 0x2000,
+	PLRSAVEWRITER_LATENCY_SAMPLES = 256, // Number of writes kept to compute the percentiles
+};
+
+#pragma pack(push, 1)
+struct D2PlrSaveWriterStatsStrc
+{
+	uint32_t nQueueDepth;				// Saves waiting to be written, including the one being written
+	uint32_t nPeakQueueDepth;
+	uint32_t nWritesCount;				// Saves written to the disk
+	uint32_t nCoalescedCount;			// Saves replaced by a newer save of the same character before being written
+	uint32_t nFailedCount;
+	uint32_t nWriteTimeP50Us;			// Time from the queuing of a save to its rename, in microseconds
+	uint32_t nWriteTimeP99Us;
+	uint32_t nWriteTimeMaxUs;
+};
+
+struct D2PlrSaveWriterEntryStrc
+{
+	D2PlrSaveWriterEntryStrc* pNext;					//0x00
+	BOOL bWriting;										//0x04 Set while the writer thread owns the data, a newer save must then be queued after it
+	LARGE_INTEGER tQueuedTime;							//0x08
+	uint32_t nFailures;									//0x10 Failed writes of the file in a row, for the entries of pFailedEntries
+	DWORD dwLastError;									//0x14 Error of the last failed write, for the entries of pFailedEntries
+	char szFileName[500];								//0x18
+	uint32_t nSize;										//0x20C
+	uint8_t pData[PLRSAVEWRITER_MAX_SAVE_SIZE];			//0x210
+};
+
+struct D2PlrSaveWriterStrc
+{
+	LARGE_INTEGER tPerformanceFrequency;				//0x00
+	HANDLE hThread;										//0x08
+	HANDLE hWakeEvent;									//0x0C
+	CRITICAL_SECTION tCriticalSection;					//0x10
+	volatile LONG bShutdown;							//0x28
+	// Protected by tCriticalSection
+	D2PlrSaveWriterEntryStrc* pFirstEntry;				//0x2C
+	D2PlrSaveWriterEntryStrc* pLastEntry;				//0x30
+	D2PlrSaveWriterEntryStrc* pFreeEntries;				//0x34 Entries already written, reused before allocating new ones
+	D2PlrSaveWriterEntryStrc* pFailedEntries;			//0x38 Last failed write of each file, until a write of the file succeeds
+	D2PlrSaveWriterStatsStrc tStats;					//0x3C
+	uint32_t aLatenciesUs[PLRSAVEWRITER_LATENCY_SAMPLES];	//0x5C
+};
+#pragma pack(pop)
+
+// Helper function: Starts the thread of pWriter, pWriter must be zeroed or stopped
+BOOL __fastcall PLRSAVEWRITER_StartThread(D2PlrSaveWriterStrc* pWriter);
+// Helper function: Writes the queued saves, then stops the thread. The free and failed entries are kept, and can still be read without the thread.
+void __fastcall PLRSAVEWRITER_StopThread(D2PlrSaveWriterStrc* pWriter);
+// Helper function: Queues the save, the entry is taken from pFreeEntries when possible. Returns FALSE if the last write of the file failed.
+BOOL __fastcall PLRSAVEWRITER_QueueFile(D2PlrSaveWriterStrc* pWriter, const char* szFileName, const uint8_t* pData, uint32_t nSize);
+// Helper function: Copies the queued save of szFileName to pBuffer. Returns its size, or 0 if no save of this file is pending.
+uint32_t __fastcall PLRSAVEWRITER_ReadQueuedFile(D2PlrSaveWriterStrc* pWriter, const char* szFileName, uint8_t* pBuffer, uint32_t nBufferSize);
+// Helper function: Returns the number of failed writes of szFileName since its last successful write, and the error of the last one
+uint32_t __fastcall PLRSAVEWRITER_GetWriteFailures(D2PlrSaveWriterStrc* pWriter, const char* szFileName, DWORD* pLastError);
+// Helper function
+void __fastcall PLRSAVEWRITER_GetWriterStats(D2PlrSaveWriterStrc* pWriter, D2PlrSaveWriterStatsStrc* pStats);
+
+// Helper function
+void __fastcall PLRSAVEWRITER_Initialize();
+// Helper function: Writes the queued saves, then stops the thread and traces its statistics
+void __fastcall PLRSAVEWRITER_Release();
+// Helper function: Queues the save, or writes it immediately if the thread is not running.
+// Returns FALSE if the synchronous write failed, or if the last write of this file by the thread failed.
+BOOL __fastcall PLRSAVEWRITER_WriteFile(const char* szFileName, const uint8_t* pData, uint32_t nSize);
+// Helper function: Copies the queued save of szFileName to pBuffer. Returns its size, or 0 if no save of this file is pending.
+uint32_t __fastcall PLRSAVEWRITER_ReadPendingFile(const char* szFileName, uint8_t* pBuffer, uint32_t nBufferSize);
+// Helper function: Returns the number of failed writes of szFileName by the thread since its last successful write, and the error of the last one
+uint32_t __fastcall PLRSAVEWRITER_GetFileWriteFailures(const char* szFileName, DWORD* pLastError);
+// Helper function: Leaves pStats zeroed if the thread is not running
+void __fastcall PLRSAVEWRITER_GetStats(D2PlrSaveWriterStatsStrc* pStats);
+// Helper function
+void __fastcall PLRSAVEWRITER_TraceStats(const char* szContext, const D2PlrSaveWriterStatsStrc* pStats);
@@ -244,6 +244,32 @@ struct D2QuestTimerStrc
 	D2QuestTimerStrc* pNext;				//0x10
 };
 
+// D2Moo only: quests that registered a callback for each event, so that QUESTS_EventCallback does not walk every quest of the game.
+// The masks only grow: a quest is added when one of its callbacks is set (at init, or later through QUESTS_SetCallback), and callbacks set back to nullptr are skipped by the dispatch.
+enum D2C_QuestSubscribersConstants
+{
+	QUESTSUBSCRIBERS_MAX_QUESTS = 64,		// One bit per quest in the masks
+	QUESTSUBSCRIBERS_EVENTS = 15,			// Size of D2QuestDataStrc::pfCallback
+	QUESTSUBSCRIBERS_ACTS = 5,				// ACT_I to ACT_V
+};
+
+struct D2QuestEventStatsStrc
+{
+	uint32_t nDispatchCount;				// Calls of QUESTS_EventCallback
+	uint32_t nQuestCount;					// Quests that the full walk of the quest list would have checked
+	uint32_t nScannedCount;					// Subscribed quests checked
+	uint32_t nInvokedCount;					// Callbacks called
+};
+
+struct D2QuestSubscribersStrc
+{
+	D2QuestDataStrc* pQuests[QUESTSUBSCRIBERS_MAX_QUESTS];			//0x000 In the order of pLastQuest and pPrev
+	int32_t nQuests;												//0x100
+	uint64_t nEventQuests[QUESTSUBSCRIBERS_EVENTS];					//0x104 Bit n is set when pQuests[n] registered a callback for the event
+	uint64_t nActQuests[QUESTSUBSCRIBERS_ACTS];						//0x17C Bit n is set when pQuests[n] belongs to the act
+	D2QuestEventStatsStrc tStats[QUESTSUBSCRIBERS_EVENTS];			//0x1A4
+};
+
 struct D2QuestInfoStrc
 {
 	D2QuestDataStrc* pLastQuest;			//0x00
@@ -255,6 +281,7 @@ struct D2QuestInfoStrc
 	D2SeedStrc pSeed;						//0x18
 	uint8_t unk0x20;						//0x20
 	uint8_t unk0x21[3];						//0x21
+	D2QuestSubscribersStrc* pSubscribers;	//0x24 D2Moo only, see QUESTS_EventCallback
 };
 
 #pragma pack()
@@ -283,6 +310,10 @@ void __fastcall QUESTS_StatusCycler(D2QuestArgStrc* pArgs, bool bForceActive);
 void __fastcall QUESTS_ChangeLevel(D2GameStrc* pGame, int32_t nOldLevelId, int32_t nTargetLevelId, D2UnitStrc* pUnit);
 //D2Game.0x6FC942D0
 void __fastcall QUESTS_EventCallback(D2QuestArgStrc* pArgs, bool bCheckActive, bool bCheckAct);
+// Helper function: Sets a callback of the quest, callbacks set after QUESTS_QuestInit must use it so that the quest receives the event
+void __fastcall QUESTS_SetCallback(D2QuestDataStrc* pQuest, int32_t nEvent, QUESTCALLBACK pfCallback);
+// Helper function: Copies the dispatch counters of nEvent, returns FALSE if the game has no quests
+BOOL __fastcall QUESTS_GetEventStats(D2GameStrc* pGame, int32_t nEvent, D2QuestEventStatsStrc* pStats);
 //D2Game.0x6FC94390
 void __fastcall QUESTS_PlayerDroppedWithQuestItem(D2GameStrc* pGame, D2UnitStrc* pPlayer);
 //D2Game.0x6FC944B0
@@ -188,7 +188,7 @@ void __fastcall SUNITDMG_ExecuteMissileDamage(D2GameStrc* pGame, D2UnitStrc* pAt
 //D2Game.0x6FCC1870
 int32_t __fastcall sub_6FCC1870(D2UnitStrc* pUnit, D2DamageStrc* pDamage, int32_t nHitClass);
 //D2Game.0x6FCC1A50
-int32_t __fastcall SUNITDMG_GetHitClass(D2DamageStrc* pDamage, uint32_t nBaseHitClass);
+int32_t __fastcall SUNITDMG_GetHitClass(D2GameStrc* pGame, D2DamageStrc* pDamage, uint32_t nBaseHitClass);
 //D2Game.0x6FCC1AC0
 void __fastcall SUNITDMG_DrainItemDurability(D2GameStrc* pGame, D2UnitStrc* pAttacker, D2UnitStrc* pDefender, int32_t nUnused);
 //D2Game.0x6FCC1D70
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <D2BasicTypes.h>
+
+struct D2UnitStrc;
+
+#pragma pack(push, 1)
+
+// D2Moo only: GUID -> unit lookup table of a unit type, used by SUNIT_GetServerUnit instead of walking D2GameStrc::pUnitList.
+// Open addressing with Robin Hood insertion and backward shift deletion, so that a lookup usually reads one or two slots.
+// D2GameStrc::pUnitList is still maintained as in the original game and used for iteration.
+struct D2UnitGuidIndexSlotStrc
+{
+	D2UnitStrc* pUnit;						//0x00 nullptr if the slot is empty
+	D2UnitGUID nUnitGUID;					//0x04
+};
+
+struct D2UnitGuidIndexStrc
+{
+	D2UnitGuidIndexSlotStrc* pSlots;		//0x00
+	uint32_t nCapacity;						//0x04 Power of 2
+	uint32_t nHashShift;					//0x08 32 - log2(nCapacity)
+	uint32_t nCount;						//0x0C
+};
+
+#pragma pack(pop)
+
+// Helper function
+D2UnitStrc* __fastcall SUNITGUIDINDEX_Find(const D2UnitGuidIndexStrc* pIndex, D2UnitGUID nUnitGUID);
+// Helper function: The GUID must not already be in the index
+void __fastcall SUNITGUIDINDEX_Insert(void* pMemPool, D2UnitGuidIndexStrc* pIndex, D2UnitStrc* pUnit);
+// Helper function: Does nothing if the unit is not in the index
+void __fastcall SUNITGUIDINDEX_Remove(D2UnitGuidIndexStrc* pIndex, D2UnitStrc* pUnit);
+// Helper function: Moves the entries to pNewSlots, which must be zeroed and hold nNewCapacity slots (power of 2). Returns the previous slots, to be freed by the caller.
+D2UnitGuidIndexSlotStrc* __fastcall SUNITGUIDINDEX_Rehash(D2UnitGuidIndexStrc* pIndex, D2UnitGuidIndexSlotStrc* pNewSlots, uint32_t nNewCapacity);
+// Helper function: Returns the capacity needed to insert one more unit, or 0 if the index is large enough
+uint32_t __fastcall SUNITGUIDINDEX_GetGrownCapacity(const D2UnitGuidIndexStrc* pIndex);
+// Helper function
+void __fastcall SUNITGUIDINDEX_Free(void* pMemPool, D2UnitGuidIndexStrc* pIndex);
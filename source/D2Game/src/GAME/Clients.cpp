@@ -879,13 +879,17 @@ void __fastcall CLIENTS_RefreshUnitsUpdateList(D2ClientStrc* pClient, uint32_t n
 
     for (int32_t nCurrentRoom = 0; nCurrentRoom < nNumRooms; nCurrentRoom++)
     {
-        for (D2UnitStrc* pRoomUnit = pAdjacentRoomsList[nCurrentRoom]->pUnitFirst; pRoomUnit != nullptr; pRoomUnit = pRoomUnit->pRoomNext)
+        // D2Moo only: only players are candidates, so rooms are walked until all of their players were found
+        int32_t nRemainingPlayers = pAdjacentRoomsList[nCurrentRoom]->nPlayerUnits;
+        for (D2UnitStrc* pRoomUnit = pAdjacentRoomsList[nCurrentRoom]->pUnitFirst; pRoomUnit != nullptr && nRemainingPlayers > 0; pRoomUnit = pRoomUnit->pRoomNext)
         {
             if (pRoomUnit->dwUnitType != UNIT_PLAYER)
             {
                 continue;
             }
 
+            --nRemainingPlayers;
+
             const int32_t nDeltaPosX = std::abs(tPlayerCoords.nX - CLIENTS_GetUnitX(pRoomUnit));
             const int32_t nDeltaPosY = std::abs(tPlayerCoords.nY - CLIENTS_GetUnitY(pRoomUnit));
 
@@ -21,35 +21,70 @@ __forceinline int32_t EVENT_MapUnitTypeToIndex(int32_t nUnitType)
     return dword_6FD27D6C[nUnitType];
 }
 
-
-//D2Game.0x6FC34840
-void __fastcall D2GAME_EVENTS_Delete_6FC34840(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nEvent, int32_t nSkillId)
+// Helper function: Inserts the timer in the list, keeping the list sorted by insertion sequence.
+// Timers are almost always inserted at the tail, except when cascading between wheel levels.
+static void EVENT_LinkTimer(D2EventTimerListStrc* pList, D2EventTimerStrc* pTimer)
 {
-    D2EventTimerStrc* pEventTimer = SUNIT_GetTimerFromUnit(pUnit);
-    while (pEventTimer)
+    D2EventTimerStrc* pPrevious = pList->pTail;
+    while (pPrevious && (int32_t)(pPrevious->nSequence - pTimer->nSequence) > 0)
     {
-        D2EventTimerStrc* pNextTimer = pEventTimer->pNext;
-        if (pEventTimer->nEvent == nEvent && (!nSkillId || pEventTimer->nSkillId == nSkillId))
-        {
-            sub_6FC34890(pGame, pEventTimer);
-        }
+        pPrevious = pPrevious->unk0x20;
+    }
 
-        pEventTimer = pNextTimer;
+    D2EventTimerStrc* pNext = pPrevious ? pPrevious->pNextFreeEventTimer : pList->pHead;
+    pTimer->unk0x20 = pPrevious;
+    pTimer->pNextFreeEventTimer = pNext;
+    if (pPrevious)
+    {
+        pPrevious->pNextFreeEventTimer = pTimer;
     }
+    else
+    {
+        pList->pHead = pTimer;
+    }
+
+    if (pNext)
+    {
+        pNext->unk0x20 = pTimer;
+    }
+    else
+    {
+        pList->pTail = pTimer;
+    }
+
+    pTimer->pTimerList = pList;
 }
 
-//D2Game.0x6FC34890
-void __fastcall sub_6FC34890(D2GameStrc* pGame, D2EventTimerStrc* pTimer)
+// Helper function
+static void EVENT_PushFrontTimer(D2EventTimerListStrc* pList, D2EventTimerStrc* pTimer)
 {
-    if (pTimer->nFlags & EVENTFLAG_0x1)
+    pTimer->unk0x20 = nullptr;
+    pTimer->pNextFreeEventTimer = pList->pHead;
+    if (pList->pHead)
     {
-        pTimer->nFlags |= EVENTFLAG_0x8;
-        return;
+        pList->pHead->unk0x20 = pTimer;
+    }
+    else
+    {
+        pList->pTail = pTimer;
     }
 
-    if (pTimer == pGame->pTimerQueue->unk0xA18)
+    pList->pHead = pTimer;
+    pTimer->pTimerList = pList;
+}
+
+// Helper function
+static void EVENT_UnlinkTimer(D2EventTimerQueueStrc* pTimerQueue, D2EventTimerStrc* pTimer)
+{
+    if (pTimer == pTimerQueue->pNextTimerToExecute)
     {
-        pGame->pTimerQueue->unk0xA18 = pTimer->pNextFreeEventTimer;
+        pTimerQueue->pNextTimerToExecute = pTimer->pNextFreeEventTimer;
+    }
+
+    D2EventTimerListStrc* pList = pTimer->pTimerList;
+    if (!pList)
+    {
+        return;
     }
 
     if (pTimer->unk0x20)
@@ -58,22 +93,112 @@ void __fastcall sub_6FC34890(D2GameStrc* pGame, D2EventTimerStrc* pTimer)
     }
     else
     {
-        D2EventTimerStrc** ppEventTimer = sub_6FC353D0(pGame, pTimer->nUnitType, pTimer->nExpireFrame);
-        *ppEventTimer = pTimer->pNextFreeEventTimer;
+        pList->pHead = pTimer->pNextFreeEventTimer;
     }
 
     if (pTimer->pNextFreeEventTimer)
     {
         pTimer->pNextFreeEventTimer->unk0x20 = pTimer->unk0x20;
     }
-    else if (pTimer->nExpireFrame != -1)
+    else
+    {
+        pList->pTail = pTimer->unk0x20;
+    }
+
+    pTimer->pTimerList = nullptr;
+    pTimer->pNextFreeEventTimer = nullptr;
+    pTimer->unk0x20 = nullptr;
+}
+
+// Helper function: Returns the wheel slot of a timer, relative to the current wheel frame
+static D2EventTimerListStrc* EVENT_GetWheelList(D2EventTimerQueueStrc* pTimerQueue, int32_t nListIndex, int32_t nExpireFrame)
+{
+    // Note: D2GAME_InitTimer_6FC351D0 never schedules timers for the current frame, only cascading timers can land in the current slot
+    if (nExpireFrame < pTimerQueue->nWheelFrame)
+    {
+        nExpireFrame = pTimerQueue->nWheelFrame;
+    }
+
+    const uint32_t nDelta = nExpireFrame - pTimerQueue->nWheelFrame;
+    for (int32_t nLevel = 0; nLevel < EVENT_WHEEL_LEVELS; ++nLevel)
+    {
+        const int32_t nShift = nLevel * EVENT_WHEEL_SLOT_BITS;
+        if (nDelta < (1u << (nShift + EVENT_WHEEL_SLOT_BITS)))
+        {
+            return &pTimerQueue->tWheels[nListIndex][nLevel][(nExpireFrame >> nShift) & (EVENT_WHEEL_SLOTS - 1)];
+        }
+    }
+
+    return &pTimerQueue->tOverflow[nListIndex];
+}
+
+// Helper function: Moves the timers of a higher level slot to the lower levels
+static void EVENT_CascadeTimerList(D2EventTimerQueueStrc* pTimerQueue, int32_t nListIndex, D2EventTimerListStrc* pList)
+{
+    D2EventTimerStrc* pTimer = pList->pHead;
+    pList->pHead = nullptr;
+    pList->pTail = nullptr;
+
+    while (pTimer)
+    {
+        D2EventTimerStrc* pNext = pTimer->pNextFreeEventTimer;
+        EVENT_LinkTimer(EVENT_GetWheelList(pTimerQueue, nListIndex, pTimer->nExpireFrame), pTimer);
+        pTimer = pNext;
+    }
+}
+
+// Helper function
+static void EVENT_AdvanceWheels(D2EventTimerQueueStrc* pTimerQueue)
+{
+    const int32_t nFrame = ++pTimerQueue->nWheelFrame;
+    if (nFrame & (EVENT_WHEEL_SLOTS - 1))
     {
-        D2EventTimerStrc** ppEventTimer = &pGame->pTimerQueue->unk0x04[5][pTimer->nExpireFrame % 64 + (EVENT_MapUnitTypeToIndex(pTimer->nUnitType) << 6)];
-        if (ppEventTimer && *ppEventTimer == pTimer)
+        return;
+    }
+
+    const int32_t nLevel1Slot = (nFrame >> EVENT_WHEEL_SLOT_BITS) & (EVENT_WHEEL_SLOTS - 1);
+    const int32_t nLevel2Slot = (nFrame >> (2 * EVENT_WHEEL_SLOT_BITS)) & (EVENT_WHEEL_SLOTS - 1);
+    for (int32_t nListIndex = 0; nListIndex < EVENT_TIMER_LISTS; ++nListIndex)
+    {
+        if (nLevel1Slot == 0)
+        {
+            if (nLevel2Slot == 0)
+            {
+                EVENT_CascadeTimerList(pTimerQueue, nListIndex, &pTimerQueue->tOverflow[nListIndex]);
+            }
+            EVENT_CascadeTimerList(pTimerQueue, nListIndex, &pTimerQueue->tWheels[nListIndex][2][nLevel2Slot]);
+        }
+        EVENT_CascadeTimerList(pTimerQueue, nListIndex, &pTimerQueue->tWheels[nListIndex][1][nLevel1Slot]);
+    }
+}
+
+
+//D2Game.0x6FC34840
+void __fastcall D2GAME_EVENTS_Delete_6FC34840(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nEvent, int32_t nSkillId)
+{
+    D2EventTimerStrc* pEventTimer = SUNIT_GetTimerFromUnit(pUnit);
+    while (pEventTimer)
+    {
+        D2EventTimerStrc* pNextTimer = pEventTimer->pNext;
+        if (pEventTimer->nEvent == nEvent && (!nSkillId || pEventTimer->nSkillId == nSkillId))
         {
-            *ppEventTimer = pTimer->unk0x20;
+            sub_6FC34890(pGame, pEventTimer);
         }
+
+        pEventTimer = pNextTimer;
     }
+}
+
+//D2Game.0x6FC34890
+void __fastcall sub_6FC34890(D2GameStrc* pGame, D2EventTimerStrc* pTimer)
+{
+    if (pTimer->nFlags & EVENTFLAG_0x1)
+    {
+        pTimer->nFlags |= EVENTFLAG_0x8;
+        return;
+    }
+
+    EVENT_UnlinkTimer(pGame->pTimerQueue, pTimer);
 
     if (pTimer->pUnit)
     {
@@ -171,6 +296,7 @@ void __fastcall EVENT_AllocEventQueue(D2GameStrc* pGame)
     D2EventTimerQueueStrc* pTimerQueue = D2_CALLOC_STRC_POOL(pGame->pMemoryPool, D2EventTimerQueueStrc);
 
     pTimerQueue->pSlabListHead = EVENT_AllocTimerSlab(pGame);
+    pTimerQueue->nWheelFrame = pGame->dwGameFrame;
     pGame->pTimerQueue = pTimerQueue;
 }
 
@@ -179,27 +305,33 @@ void __fastcall EVENT_IterateEvents(D2GameStrc* pGame)
 {
     D2EventTimerQueueStrc* pTimerQueue = pGame->pTimerQueue;
 
-    pTimerQueue->nArrayIndex = pGame->dwGameFrame % 64;
+    // Note: dwGameFrame is incremented once before each call, so this normally advances the wheels by one slot
+    while (pTimerQueue->nWheelFrame < pGame->dwGameFrame)
+    {
+        EVENT_AdvanceWheels(pTimerQueue);
+    }
+
+    pTimerQueue->nArrayIndex = pGame->dwGameFrame & (EVENT_WHEEL_SLOTS - 1);
 
     const int nMissileEventIdx = EVENT_MapUnitTypeToIndex(UNIT_MISSILE);
-    EVENT_ExecuteMissileEvents(pGame, pTimerQueue, pTimerQueue->unk0xA04[nMissileEventIdx], 0);
-    EVENT_ExecuteMissileEvents(pGame, pTimerQueue, pTimerQueue->unk0x04 [nMissileEventIdx][pTimerQueue->nArrayIndex], 1);
+    EVENT_ExecuteMissileEvents(pGame, pTimerQueue, pTimerQueue->tPermanentTimers[nMissileEventIdx].pHead, 0);
+    EVENT_ExecuteMissileEvents(pGame, pTimerQueue, pTimerQueue->tWheels[nMissileEventIdx][0][pTimerQueue->nArrayIndex].pHead, 1);
 
     const int nPlayerEventIdx = EVENT_MapUnitTypeToIndex(UNIT_PLAYER);
-    EVENT_ExecutePlayerEvents(pGame, pTimerQueue, pTimerQueue->unk0xA04[nPlayerEventIdx], 0);
-    EVENT_ExecutePlayerEvents(pGame, pTimerQueue, pTimerQueue->unk0x04 [nPlayerEventIdx][pTimerQueue->nArrayIndex], 1);
+    EVENT_ExecutePlayerEvents(pGame, pTimerQueue, pTimerQueue->tPermanentTimers[nPlayerEventIdx].pHead, 0);
+    EVENT_ExecutePlayerEvents(pGame, pTimerQueue, pTimerQueue->tWheels[nPlayerEventIdx][0][pTimerQueue->nArrayIndex].pHead, 1);
 
     const int nMonsterEventIdx = EVENT_MapUnitTypeToIndex(UNIT_MONSTER);
-    EVENT_ExecuteMonsterEvents(pGame, pTimerQueue, pTimerQueue->unk0xA04[nMonsterEventIdx], 0);
-    EVENT_ExecuteMonsterEvents(pGame, pTimerQueue, pTimerQueue->unk0x04 [nMonsterEventIdx][pTimerQueue->nArrayIndex], 1);
+    EVENT_ExecuteMonsterEvents(pGame, pTimerQueue, pTimerQueue->tPermanentTimers[nMonsterEventIdx].pHead, 0);
+    EVENT_ExecuteMonsterEvents(pGame, pTimerQueue, pTimerQueue->tWheels[nMonsterEventIdx][0][pTimerQueue->nArrayIndex].pHead, 1);
 
     const int nObjectEventIdx = EVENT_MapUnitTypeToIndex(UNIT_OBJECT);
-    EVENT_ExecuteObjectEvents(pGame, pTimerQueue, pTimerQueue->unk0xA04[nObjectEventIdx], 0);
-    EVENT_ExecuteObjectEvents(pGame, pTimerQueue, pTimerQueue->unk0x04 [nObjectEventIdx][pTimerQueue->nArrayIndex], 1);
+    EVENT_ExecuteObjectEvents(pGame, pTimerQueue, pTimerQueue->tPermanentTimers[nObjectEventIdx].pHead, 0);
+    EVENT_ExecuteObjectEvents(pGame, pTimerQueue, pTimerQueue->tWheels[nObjectEventIdx][0][pTimerQueue->nArrayIndex].pHead, 1);
 
     const int nItemEventIdx = EVENT_MapUnitTypeToIndex(UNIT_ITEM);
-    EVENT_ExecuteItemEvents(pGame, pTimerQueue, pTimerQueue->unk0xA04[nItemEventIdx], 0);
-    EVENT_ExecuteItemEvents(pGame, pTimerQueue, pTimerQueue->unk0x04 [nItemEventIdx][pTimerQueue->nArrayIndex], 1);
+    EVENT_ExecuteItemEvents(pGame, pTimerQueue, pTimerQueue->tPermanentTimers[nItemEventIdx].pHead, 0);
+    EVENT_ExecuteItemEvents(pGame, pTimerQueue, pTimerQueue->tWheels[nItemEventIdx][0][pTimerQueue->nArrayIndex].pHead, 1);
 }
 
 // Only differs from EventTimerCallback by return type
@@ -207,14 +339,15 @@ using ExecuteEventCallback = void(__fastcall*)(D2GameStrc*, D2UnitStrc*, int32_t
 // Helper function
 static void __fastcall EVENT_ExecuteEventsImpl(ExecuteEventCallback pDefaultCallback, D2GameStrc* pGame, D2EventTimerQueueStrc* pTimerQueue, D2EventTimerStrc* pEventTimer, int32_t a4)
 {
-    pTimerQueue->unk0xA18 = nullptr;
+    pTimerQueue->pNextTimerToExecute = nullptr;
 
     D2EventTimerStrc* pTimer = pEventTimer;
     if (a4)
     {
         while (pTimer)
         {
-            pTimerQueue->unk0xA18 = pTimer->pNextFreeEventTimer;
+            ++pTimerQueue->nTimersVisited;
+            pTimerQueue->pNextTimerToExecute = pTimer->pNextFreeEventTimer;
             if (pTimer->nExpireFrame == pGame->dwGameFrame)
             {
                 pTimer->nFlags |= EVENTFLAG_0x1;
@@ -231,14 +364,15 @@ static void __fastcall EVENT_ExecuteEventsImpl(ExecuteEventCallback pDefaultCall
                 sub_6FC34890(pGame, pTimer);
             }
 
-            pTimer = pTimerQueue->unk0xA18;
+            pTimer = pTimerQueue->pNextTimerToExecute;
         }
     }
     else
     {
         while (pTimer)
         {
-            pTimerQueue->unk0xA18 = pTimer->pNextFreeEventTimer;
+            ++pTimerQueue->nTimersVisited;
+            pTimerQueue->pNextTimerToExecute = pTimer->pNextFreeEventTimer;
 
             pTimer->nFlags |= EVENTFLAG_0x1;
             if (pTimer->pCallback)
@@ -256,7 +390,7 @@ static void __fastcall EVENT_ExecuteEventsImpl(ExecuteEventCallback pDefaultCall
                 sub_6FC34890(pGame, pTimer);
             }
 
-            pTimer = pTimerQueue->unk0xA18;
+            pTimer = pTimerQueue->pNextTimerToExecute;
         }
     }
 }
@@ -335,14 +469,12 @@ void __fastcall EVENT_SetEvent(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nTi
 //D2Game.0x6FC351D0
 void __fastcall D2GAME_InitTimer_6FC351D0(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nTimerType, int32_t nExpireFrame, EventTimerCallback pfCallBack, int32_t nSkillId, int32_t nSkillLevel)
 {
-    // TODO: v19
     if (nTimerType >= 15)
     {
         return;
     }
 
     D2EventTimerStrc* pEventTimer = nullptr;
-    D2EventTimerStrc** ppEventTimer = nullptr;
     if (nExpireFrame == -1)
     {
         pEventTimer = sub_6FC35460(pGame, pUnit);
@@ -353,15 +485,7 @@ void __fastcall D2GAME_InitTimer_6FC351D0(D2GameStrc* pGame, D2UnitStrc* pUnit,
         pEventTimer->nSkillId = nSkillId;
         pEventTimer->pCallback = nullptr;
 
-        ppEventTimer = sub_6FC353D0(pGame, pUnit ? pUnit->dwUnitType : 6, -1);
-        pEventTimer->unk0x20 = nullptr;
-        pEventTimer->pNextFreeEventTimer = *ppEventTimer;
-        if (*ppEventTimer)
-        {
-            (*ppEventTimer)->unk0x20 = pEventTimer;
-        }
-
-        *ppEventTimer = pEventTimer;
+        EVENT_PushFrontTimer(sub_6FC353D0(pGame, pUnit ? pUnit->dwUnitType : 6, -1), pEventTimer);
         return;
     }
 
@@ -382,33 +506,20 @@ void __fastcall D2GAME_InitTimer_6FC351D0(D2GameStrc* pGame, D2UnitStrc* pUnit,
     pEventTimer->nExpireFrame = nExpireFrame;
     pEventTimer->pCallback = pfCallBack;
 
-    D2EventTimerStrc** v19 = &pGame->pTimerQueue->unk0x04[5][nExpireFrame % 64 + (EVENT_MapUnitTypeToIndex(pEventTimer->nUnitType) << 6)];
-
-    pEventTimer->pNextFreeEventTimer = nullptr;
-    pEventTimer->unk0x20 = *v19;
-    if (*v19)
-    {
-        (*v19)->pNextFreeEventTimer = pEventTimer;
-    }
-    *v19 = pEventTimer;
-
-    ppEventTimer = sub_6FC353D0(pGame, pEventTimer->nUnitType, pEventTimer->nExpireFrame);
-    if (!*ppEventTimer)
-    {
-        *ppEventTimer = pEventTimer;
-    }
+    pEventTimer->nSequence = pGame->pTimerQueue->nNextSequence++;
+    EVENT_LinkTimer(sub_6FC353D0(pGame, pEventTimer->nUnitType, pEventTimer->nExpireFrame), pEventTimer);
 }
 
 //D2Game.0x6FC353D0
-D2EventTimerStrc** __fastcall sub_6FC353D0(D2GameStrc* pGame, int32_t nUnitType, int32_t nExpireFrame)
+D2EventTimerListStrc* __fastcall sub_6FC353D0(D2GameStrc* pGame, int32_t nUnitType, int32_t nExpireFrame)
 {
     const int32_t nIndex = EVENT_MapUnitTypeToIndex(nUnitType);
     if (nExpireFrame == -1)
     {
-        return &pGame->pTimerQueue->unk0xA04[nIndex];
+        return &pGame->pTimerQueue->tPermanentTimers[nIndex];
     }
 
-    return (D2EventTimerStrc**)((char*)pGame->pTimerQueue->unk0x04 + 4 * (nExpireFrame % 64 + (nIndex << 6)));
+    return EVENT_GetWheelList(pGame->pTimerQueue, nIndex, nExpireFrame);
 }
 
 //D2Game.0x6FC35410
@@ -549,15 +660,7 @@ void __fastcall sub_6FC35570(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nEven
     pNewTimer->nSkillLevel = nSkillLevel;
     pNewTimer->pCallback = nullptr;
 
-    D2EventTimerStrc** ppEventTimer = sub_6FC353D0(pGame, pUnit ? pUnit->dwUnitType : 6, -1);
-    pNewTimer->unk0x20 = nullptr;
-    pNewTimer->pNextFreeEventTimer = *ppEventTimer;
-    if (pNewTimer->pNextFreeEventTimer)
-    {
-        pNewTimer->pNextFreeEventTimer->unk0x20 = pNewTimer;
-    }
-
-    *ppEventTimer = pNewTimer;
+    EVENT_PushFrontTimer(sub_6FC353D0(pGame, pUnit ? pUnit->dwUnitType : 6, -1), pNewTimer);
 }
 
 //D2Game.0x6FC351D0
@@ -28,6 +28,7 @@
 #include "GAME/Event.h"
 #include "GAME/Level.h"
 #include "GAME/SCmd.h"
+#include "GAME/Scheduler.h"
 #include "GAME/Task.h"
 #include "ITEMS/ItemMode.h"
 #include "ITEMS/Items.h"
@@ -38,6 +39,7 @@
 #include "PLAYER/PlayerList.h"
 #include "PLAYER/PlrMsg.h"
 #include "PLAYER/PlrSave.h"
+#include "PLAYER/PlrSaveWriter.h"
 #include "QUESTS/Quests.h"
 #include "UNIT/Party.h"
 #include "UNIT/SUnit.h"
@@ -63,10 +65,10 @@ int32_t dword_6FD45820;
 int32_t dword_6FD4581C;
 int32_t gnTargetFrameRate_6FD2CA60 = DEFAULT_FRAMES_PER_SECOND;
 int32_t gnTargetMsPerFrame_6FD457F8;
-int32_t gnFrameRate_6FD2CA14;
-int32_t gnPeakMemoryUsageInLast10s_6FD45828;
+volatile LONG gnFrameRate_6FD2CA14; // D2Moo: written with Interlocked functions, games may be updated by GAMESCHED workers
+volatile LONG gnPeakMemoryUsageInLast10s_6FD45828;
 DWORD dword_6FD4582C;
-uint32_t gnPreviousMemUsageUpdateTickCount_6FD45840;
+volatile LONG gnPreviousMemUsageUpdateTickCount_6FD45840;
 uint32_t dword_6FD45844;
 uint32_t dword_6FD45848;
 int32_t dword_6FD2CA10 = 1;
@@ -90,6 +92,30 @@ constexpr void(__fastcall* gpfGetDescription_6FD2CA64[5])(char*, int32_t) =
     GAME_GetMissileDescription
 };
 
+// D2Moo only: SERVER_FlushClientBatch (#10041) and SERVER_GetClientNetStats (#10042) are not exported by the original D2Net.dll.
+// They are resolved at runtime instead of being imported, so that D2Game still loads with it.
+using D2Net_FlushClientBatchFunctionType = BOOL(__stdcall*)(int32_t nClientId);
+using D2Net_GetClientNetStatsFunctionType = BOOL(__stdcall*)(int32_t nClientId, D2ServerClientNetStatsStrc* pStats);
+
+static FARPROC GAME_GetOptionalD2NetFunction(int32_t nOrdinal)
+{
+    HMODULE hD2Net = GetModuleHandleA("D2Net.dll");
+    return hD2Net ? GetProcAddress(hD2Net, (LPCSTR)nOrdinal) : nullptr;
+}
+
+// Without batch compression support, packets are sent by D2NET_10006 and there is nothing to flush
+static BOOL GAME_FlushClientBatch(int32_t nClientId)
+{
+    static const D2Net_FlushClientBatchFunctionType pfFlushClientBatch = (D2Net_FlushClientBatchFunctionType)GAME_GetOptionalD2NetFunction(10041);
+    return !pfFlushClientBatch || pfFlushClientBatch(nClientId);
+}
+
+static BOOL GAME_GetClientNetStats(int32_t nClientId, D2ServerClientNetStatsStrc* pStats)
+{
+    static const D2Net_GetClientNetStatsFunctionType pfGetClientNetStats = (D2Net_GetClientNetStatsFunctionType)GAME_GetOptionalD2NetFunction(10042);
+    return pfGetClientNetStats && pfGetClientNetStats(nClientId, pStats);
+}
+
 
 
 //D2Game.0x6FC356D0
@@ -138,12 +164,16 @@ int32_t __stdcall D2Game_10046()
     CLIENTS_Initialize();
     D2NET_10019(sub_6FC36B20);
     SUNITPROXY_FillGlobalItemCache();
+    GAMESCHED_Initialize(); // D2Moo only
+    PLRSAVEWRITER_Initialize(); // D2Moo only
     return TRUE;
 }
 
 //D2Game.0x6FC35810
 int32_t __stdcall D2Game_10050()
 {
+    GAMESCHED_Release(); // D2Moo only
+    PLRSAVEWRITER_Release(); // D2Moo only
     CLIENTS_Release();
     DeleteCriticalSection(&gCriticalSection_6FD45800);
     SUNITPROXY_ClearGlobalItemCache();
@@ -417,6 +447,7 @@ BOOL __stdcall GAME_CreateNewEmptyGame(char* szGameName, const char* szPassword,
     memset(pGame->pUnitList[2], 0, sizeof(pGame->pUnitList[2]));
     memset(pGame->pUnitList[3], 0, sizeof(pGame->pUnitList[3]));
     memset(pGame->pUnitList[4], 0, sizeof(pGame->pUnitList[4]));
+    memset(pGame->tUnitGuidIndex, 0, sizeof(pGame->tUnitGuidIndex));
 
     memset(pGame->dwUniqueFlags, 0, sizeof(pGame->dwUniqueFlags));
 
@@ -626,6 +657,7 @@ void __fastcall GAME_SendGameInit(int32_t nClientId, char* szGameName, uint8_t n
     memset(pGame->pUnitList[2], 0, sizeof(pGame->pUnitList[2]));
     memset(pGame->pUnitList[3], 0, sizeof(pGame->pUnitList[3]));
     memset(pGame->pUnitList[4], 0, sizeof(pGame->pUnitList[4]));
+    memset(pGame->tUnitGuidIndex, 0, sizeof(pGame->tUnitGuidIndex));
 
     memset(pGame->dwUniqueFlags, 0, sizeof(pGame->dwUniqueFlags));
 
@@ -1138,6 +1170,14 @@ void __fastcall GAME_FreeGame(D2GameGUID nGameGUID, D2GameStrc* pGame)
     if (pGame)
     {
         GAME_LogMessage(6, "[SERVER]  SrvFreeGame:           freeing game %d '%s'", pGame->nGameId, pGame->szGameName);
+
+        // D2Moo only
+        D2PlrSaveWriterStatsStrc tSaveWriterStats = {};
+        PLRSAVEWRITER_GetStats(&tSaveWriterStats);
+        if (tSaveWriterStats.nWritesCount || tSaveWriterStats.nQueueDepth || tSaveWriterStats.nFailedCount)
+        {
+            PLRSAVEWRITER_TraceStats("SrvFreeGame", &tSaveWriterStats);
+        }
     }
 	_Analysis_assume_(pGame != nullptr);
 
@@ -1173,6 +1213,11 @@ void __fastcall GAME_FreeGame(D2GameGUID nGameGUID, D2GameStrc* pGame)
         }
     }
 
+    for (int32_t i = 0; i < 5; ++i)
+    {
+        SUNITGUIDINDEX_Free(pGame->pMemoryPool, &pGame->tUnitGuidIndex[i]);
+    }
+
     if (pGame->pMemoryPool)
     {
         FOG_DestroyMemoryPoolSystem(pGame->pMemoryPool);
@@ -1254,6 +1299,14 @@ void __fastcall GAME_DisconnectClient(D2GameStrc* pGame, D2ClientStrc* pClient,
     sub_6FC84D40(pGame, &packet5A);
 
     GAME_LogMessage(6, "[SERVER]  SrvDisconnectClient:   disconnect client %d '%s' from game %d '%s'", nClientId, packet5A.szText, pGame->nGameId, pGame->szGameName);
+
+    D2ServerClientNetStatsStrc tNetStats = {};
+    if (GAME_GetClientNetStats(nClientId, &tNetStats))
+    {
+        GAME_LogMessage(6, "[SERVER]  SrvDisconnectClient:   client %d sent %llu bytes (%llu before compression) in %u sends for %u messages",
+            nClientId, tNetStats.nSentBytes, tNetStats.nUncompressedBytes, tNetStats.nSends, tNetStats.nMessages);
+    }
+
     CLIENTS_RemoveClientFromGame(pGame, nClientId, 1);
     sub_6FC3C690(nClientId);
     D2NET_10016(nClientId);
@@ -1810,18 +1863,29 @@ void __fastcall GAME_UpdateProgress(D2GameStrc* pGame)
         pGame->nFramesSinceLastFrameRateUpdate = 0;
         pGame->nPreviousUpdateTickCount = nTickCount;
         pGame->nFrameRate = nTicksPerSec * nFrames / nTickDiff;
-        gnFrameRate_6FD2CA14 = pGame->nFrameRate;
+        InterlockedExchange(&gnFrameRate_6FD2CA14, (LONG)pGame->nFrameRate);
 
-        const uint32_t nMemoryUsage = FOG_GetMemoryUsage(pGame->pMemoryPool);
-        if ((nTickCount - gnPreviousMemUsageUpdateTickCount_6FD45840) > (10 * nTicksPerSec))
+        const LONG nMemoryUsage = (LONG)FOG_GetMemoryUsage(pGame->pMemoryPool);
+        const LONG nPreviousMemUsageUpdateTickCount = gnPreviousMemUsageUpdateTickCount_6FD45840;
+        if ((nTickCount - (uint32_t)nPreviousMemUsageUpdateTickCount) > (10 * nTicksPerSec)
+            && InterlockedCompareExchange(&gnPreviousMemUsageUpdateTickCount_6FD45840, (LONG)nTickCount, nPreviousMemUsageUpdateTickCount) == nPreviousMemUsageUpdateTickCount)
         {
             // "Forget" previous results every 10s
-            gnPreviousMemUsageUpdateTickCount_6FD45840 = nTickCount;
-            gnPeakMemoryUsageInLast10s_6FD45828 = nMemoryUsage;
+            InterlockedExchange(&gnPeakMemoryUsageInLast10s_6FD45828, nMemoryUsage);
         }
-        else if (nMemoryUsage > gnPeakMemoryUsageInLast10s_6FD45828)
+        else
         {
-            gnPeakMemoryUsageInLast10s_6FD45828 = nMemoryUsage;
+            LONG nPeakMemoryUsage = gnPeakMemoryUsageInLast10s_6FD45828;
+            while (nMemoryUsage > nPeakMemoryUsage)
+            {
+                const LONG nPreviousPeakMemoryUsage = InterlockedCompareExchange(&gnPeakMemoryUsageInLast10s_6FD45828, nMemoryUsage, nPeakMemoryUsage);
+                if (nPreviousPeakMemoryUsage == nPeakMemoryUsage)
+                {
+                    break;
+                }
+
+                nPeakMemoryUsage = nPreviousPeakMemoryUsage;
+            }
         }
     }
 
@@ -2102,6 +2166,36 @@ void __fastcall sub_6FC38E00()
     gnTargetMsPerFrame_6FD457F8 = 1000 / gnTargetFrameRate_6FD2CA60;
 }
 
+// Helper function: Body of the games loop of GAME_UpdateGamesProgress, may be called from GAMESCHED worker threads
+BOOL __fastcall GAME_UpdateGameFrame(D2GameGUID nGameGUID, uint32_t nSysTimeMs)
+{
+    D2GameStrc* pGame = GAME_LockGame(nGameGUID);
+    if (!pGame)
+    {
+        return FALSE;
+    }
+
+    if (dword_6FD2CA10)
+    {
+        pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 = 1024;
+    }
+    else
+    {
+        if (pGame->nLastUpdateSystemTimeMs)
+        {
+            const uint32_t nTimeSinceLastUpdateMs = nSysTimeMs - pGame->nLastUpdateSystemTimeMs;
+            pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 = D2Clamp((nTimeSinceLastUpdateMs << 10) / gnTargetMsPerFrame_6FD457F8, 10u, 2048u);
+        }
+
+        pGame->nLastUpdateSystemTimeMs = nSysTimeMs;
+    }
+
+    GAME_UpdateProgress(pGame);
+
+    D2_UNLOCK(pGame->lpCriticalSection);
+    return TRUE;
+}
+
 //D2Game.0x6FC38E20 (#10004)
 int32_t __stdcall GAME_UpdateGamesProgress(int32_t a1)
 {
@@ -2129,33 +2223,18 @@ int32_t __stdcall GAME_UpdateGamesProgress(int32_t a1)
     dword_6FD45844 = nSysTimeMs - v5;
     
     int32_t bQueryPerformance = 0;
-    for (int32_t i = 0; i < std::size(gnGamesGUIDs_6FD447F8); ++i)
+    if (GAMESCHED_GetWorkerCount() > 0) // D2Moo only
     {
-        const int32_t nGUID = gnGamesGUIDs_6FD447F8[i];
-        if (nGUID && nGUID != -1)
+        bQueryPerformance = GAMESCHED_UpdateGames(gnGamesGUIDs_6FD447F8, std::size(gnGamesGUIDs_6FD447F8), nSysTimeMs, GAME_UpdateGameFrame);
+    }
+    else
+    {
+        for (int32_t i = 0; i < std::size(gnGamesGUIDs_6FD447F8); ++i)
         {
-            if (D2GameStrc* pGame = GAME_LockGame(nGUID))
+            const int32_t nGUID = gnGamesGUIDs_6FD447F8[i];
+            if (nGUID && nGUID != -1 && GAME_UpdateGameFrame(nGUID, nSysTimeMs))
             {
                 bQueryPerformance = 1;
-
-                if (dword_6FD2CA10)
-                {
-                    pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 = 1024;
-                }
-                else
-                {
-                    if (pGame->nLastUpdateSystemTimeMs)
-                    {
-                        const uint32_t nTimeSinceLastUpdateMs = nSysTimeMs - pGame->nLastUpdateSystemTimeMs;
-                        pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 = D2Clamp((nTimeSinceLastUpdateMs << 10) / gnTargetMsPerFrame_6FD457F8, 10u, 2048u);
-                    }
-
-                    pGame->nLastUpdateSystemTimeMs = nSysTimeMs;
-                }
-
-                GAME_UpdateProgress(pGame);
-
-                D2_UNLOCK(pGame->lpCriticalSection);
             }
         }
     }
@@ -2266,6 +2345,18 @@ void __fastcall sub_6FC39030(D2GameStrc* pGame, D2ClientStrc* pClient, int32_t a
         }
     }
     while ((pGame->nGameType != 1 && pGame->nGameType != 2 || nCounter < 3) && !bError);
+
+    // D2Moo only: with batch compression, the packets above were only queued, they are compressed and sent now.
+    // A failed flush is handled like a failed send, D2Net keeps the frames and sends them before the next packets.
+    if (!bError && !GAME_FlushClientBatch(pClient->dwClientId))
+    {
+        SERVER_WSAGetLastError();
+        ++pClient->nSaveHeaderSendFailures;
+        if (pClient->nSaveHeaderSendFailures >= 3)
+        {
+            GAME_DisconnectClient(pGame, pClient, EVENTTYPE_DISCONNECT);
+        }
+    }
 }
 
 //D2Game.0x6FC39270
@@ -0,0 +1,250 @@
+#include "GAME/Scheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+#include <Fog.h>
+#include <D2Math.h>
+
+
+D2GameSchedulerWorkerStrc* gpSchedulerWorkers[GAMESCHED_MAX_WORKERS];
+int32_t gnSchedulerWorkers;
+HANDLE ghSchedulerDoneEvent;
+volatile LONG gnSchedulerPendingWorkers;
+uint32_t gnSchedulerSysTimeMs;
+GAMESCHEDUPDATEGAMEFN gpfnSchedulerUpdateGame;
+LARGE_INTEGER gSchedulerPerformanceFrequency;
+
+
+static DWORD WINAPI GAMESCHED_WorkerThreadProc(LPVOID lpParameter)
+{
+    D2GameSchedulerWorkerStrc* pWorker = (D2GameSchedulerWorkerStrc*)lpParameter;
+
+    while (WaitForSingleObject(pWorker->hStartEvent, INFINITE) == WAIT_OBJECT_0 && !pWorker->bShutdown)
+    {
+        LARGE_INTEGER start = {};
+        QueryPerformanceCounter(&start);
+
+        pWorker->bUpdatedAnyGame = FALSE;
+        for (int32_t i = 0; i < pWorker->nGames; ++i)
+        {
+            if (gpfnSchedulerUpdateGame(pWorker->aGameGUIDs[i], gnSchedulerSysTimeMs))
+            {
+                pWorker->bUpdatedAnyGame = TRUE;
+            }
+        }
+
+        if (pWorker->nGames)
+        {
+            LARGE_INTEGER end = {};
+            QueryPerformanceCounter(&end);
+            const uint64_t nElapsedUs = (uint64_t)(end.QuadPart - start.QuadPart) * 1000000 / gSchedulerPerformanceFrequency.QuadPart;
+
+            EnterCriticalSection(&pWorker->tStatsLock);
+            pWorker->aFrameTimesUs[pWorker->nFramesCount % GAMESCHED_FRAMETIME_SAMPLES] = (uint32_t)std::min<uint64_t>(nElapsedUs, UINT32_MAX);
+            ++pWorker->nFramesCount;
+            pWorker->nGamesUpdated += pWorker->nGames;
+            LeaveCriticalSection(&pWorker->tStatsLock);
+        }
+
+        if (InterlockedDecrement(&gnSchedulerPendingWorkers) == 0)
+        {
+            SetEvent(ghSchedulerDoneEvent);
+        }
+    }
+
+    return 0;
+}
+
+static void GAMESCHED_StopWorkers()
+{
+    while (D2GameSchedulerWorkerStrc* pWorker = GAMESCHED_StopLastWorker())
+    {
+        D2_FREE(pWorker);
+    }
+}
+
+// Helper function
+void __fastcall GAMESCHED_Initialize()
+{
+    QueryPerformanceFrequency(&gSchedulerPerformanceFrequency);
+    ghSchedulerDoneEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+
+    char* szWorkers = nullptr;
+    size_t nBufferSize = 0;
+    if (0 == _dupenv_s(&szWorkers, &nBufferSize, "D2_GAME_WORKERS") && szWorkers)
+    {
+        GAMESCHED_SetWorkerCount(atoi(szWorkers));
+        free(szWorkers);
+    }
+}
+
+// Helper function
+void __fastcall GAMESCHED_Release()
+{
+    GAMESCHED_StopWorkers();
+
+    if (ghSchedulerDoneEvent)
+    {
+        CloseHandle(ghSchedulerDoneEvent);
+        ghSchedulerDoneEvent = nullptr;
+    }
+}
+
+// Helper function
+int32_t __fastcall GAMESCHED_SetWorkerCount(int32_t nWorkers)
+{
+    GAMESCHED_StopWorkers();
+
+    nWorkers = D2Clamp(nWorkers, 0, (int32_t)GAMESCHED_MAX_WORKERS);
+    if (!ghSchedulerDoneEvent)
+    {
+        return 0;
+    }
+
+    for (int32_t i = 0; i < nWorkers; ++i)
+    {
+        D2GameSchedulerWorkerStrc* pWorker = D2_CALLOC_STRC(D2GameSchedulerWorkerStrc);
+        if (!GAMESCHED_StartWorker(pWorker))
+        {
+            D2_FREE(pWorker);
+            break;
+        }
+    }
+
+    return gnSchedulerWorkers;
+}
+
+// Helper function
+int32_t __fastcall GAMESCHED_GetWorkerCount()
+{
+    return gnSchedulerWorkers;
+}
+
+// Helper function
+BOOL __fastcall GAMESCHED_StartWorker(D2GameSchedulerWorkerStrc* pWorker)
+{
+    if (gnSchedulerWorkers >= GAMESCHED_MAX_WORKERS)
+    {
+        return FALSE;
+    }
+
+    InitializeCriticalSection(&pWorker->tStatsLock);
+    pWorker->hStartEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    pWorker->hThread = CreateThread(nullptr, 0, GAMESCHED_WorkerThreadProc, pWorker, 0, nullptr);
+    if (!pWorker->hThread)
+    {
+        CloseHandle(pWorker->hStartEvent);
+        DeleteCriticalSection(&pWorker->tStatsLock);
+        return FALSE;
+    }
+
+    wchar_t szThreadName[32] = {};
+    swprintf_s(szThreadName, L"D2GameWorkerThread%d", gnSchedulerWorkers);
+    SetThreadDescription(pWorker->hThread, szThreadName);
+
+    gpSchedulerWorkers[gnSchedulerWorkers] = pWorker;
+    ++gnSchedulerWorkers;
+    return TRUE;
+}
+
+// Helper function
+D2GameSchedulerWorkerStrc* __fastcall GAMESCHED_StopLastWorker()
+{
+    if (!gnSchedulerWorkers)
+    {
+        return nullptr;
+    }
+
+    --gnSchedulerWorkers;
+    D2GameSchedulerWorkerStrc* pWorker = gpSchedulerWorkers[gnSchedulerWorkers];
+    gpSchedulerWorkers[gnSchedulerWorkers] = nullptr;
+
+    InterlockedExchange(&pWorker->bShutdown, TRUE);
+    SetEvent(pWorker->hStartEvent);
+    WaitForSingleObject(pWorker->hThread, INFINITE);
+    CloseHandle(pWorker->hThread);
+    CloseHandle(pWorker->hStartEvent);
+    DeleteCriticalSection(&pWorker->tStatsLock);
+    return pWorker;
+}
+
+// Helper function
+BOOL __fastcall GAMESCHED_UpdateGames(const int32_t* pGameGUIDs, int32_t nGameGUIDs, uint32_t nSysTimeMs, GAMESCHEDUPDATEGAMEFN pfnUpdateGame)
+{
+    D2_ASSERT(gnSchedulerWorkers > 0);
+
+    for (int32_t i = 0; i < gnSchedulerWorkers; ++i)
+    {
+        gpSchedulerWorkers[i]->nGames = 0;
+    }
+
+    for (int32_t i = 0; i < nGameGUIDs; ++i)
+    {
+        const int32_t nGUID = pGameGUIDs[i];
+        if (nGUID && nGUID != -1)
+        {
+            D2GameSchedulerWorkerStrc* pWorker = gpSchedulerWorkers[(D2GameGUID)nGUID % gnSchedulerWorkers];
+            D2_ASSERT(pWorker->nGames < std::size(pWorker->aGameGUIDs));
+            pWorker->aGameGUIDs[pWorker->nGames++] = nGUID;
+        }
+    }
+
+    gnSchedulerSysTimeMs = nSysTimeMs;
+    gpfnSchedulerUpdateGame = pfnUpdateGame;
+    InterlockedExchange(&gnSchedulerPendingWorkers, gnSchedulerWorkers);
+
+    for (int32_t i = 0; i < gnSchedulerWorkers; ++i)
+    {
+        SetEvent(gpSchedulerWorkers[i]->hStartEvent);
+    }
+
+    WaitForSingleObject(ghSchedulerDoneEvent, INFINITE);
+
+    BOOL bUpdatedAnyGame = FALSE;
+    for (int32_t i = 0; i < gnSchedulerWorkers; ++i)
+    {
+        if (gpSchedulerWorkers[i]->bUpdatedAnyGame)
+        {
+            bUpdatedAnyGame = TRUE;
+        }
+    }
+
+    return bUpdatedAnyGame;
+}
+
+// Helper function
+BOOL __fastcall GAMESCHED_GetWorkerStats(int32_t nWorker, D2GameSchedulerStatsStrc* pStats)
+{
+    if (nWorker < 0 || nWorker >= gnSchedulerWorkers || !pStats)
+    {
+        return FALSE;
+    }
+
+    D2GameSchedulerWorkerStrc* pWorker = gpSchedulerWorkers[nWorker];
+
+    uint32_t aFrameTimesUs[GAMESCHED_FRAMETIME_SAMPLES];
+    EnterCriticalSection(&pWorker->tStatsLock);
+    const uint32_t nSamples = std::min<uint32_t>(pWorker->nFramesCount, GAMESCHED_FRAMETIME_SAMPLES);
+    memcpy(aFrameTimesUs, pWorker->aFrameTimesUs, nSamples * sizeof(uint32_t));
+    pStats->nFramesCount = pWorker->nFramesCount;
+    pStats->nGamesUpdated = pWorker->nGamesUpdated;
+    LeaveCriticalSection(&pWorker->tStatsLock);
+
+    if (!nSamples)
+    {
+        pStats->nFrameTimeP50Us = 0;
+        pStats->nFrameTimeP95Us = 0;
+        pStats->nFrameTimeP99Us = 0;
+        pStats->nFrameTimeMaxUs = 0;
+        return TRUE;
+    }
+
+    std::sort(aFrameTimesUs, aFrameTimesUs + nSamples);
+    pStats->nFrameTimeP50Us = aFrameTimesUs[(nSamples - 1) * 50 / 100];
+    pStats->nFrameTimeP95Us = aFrameTimesUs[(nSamples - 1) * 95 / 100];
+    pStats->nFrameTimeP99Us = aFrameTimesUs[(nSamples - 1) * 99 / 100];
+    pStats->nFrameTimeMaxUs = aFrameTimesUs[nSamples - 1];
+    return TRUE;
+}
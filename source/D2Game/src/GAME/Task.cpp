@@ -1,5 +1,9 @@
 #include "GAME/Task.h"
 
+#include <algorithm>
+
+#include <D2Math.h>
+
 #include "GAME/Clients.h"
 #include "GAME/Game.h"
 #include "GAME/SCmd.h"
@@ -19,6 +23,14 @@ CRITICAL_SECTION_WRAPPER gtTaskQueuesCriticalSections[TASKQSLOTS];
 D2TaskStrc* gtTaskSlots[TASKQSLOTS];
 // D2Game.0x6FD45868
 D2LinkStrc gpTaskQueueLink;
+// Sum of the budget ratios (nCreationTimeMs_Or_CPUTargetRatioFP10) of the games owned by each queue slot.
+// Games run late on an overloaded worker, which increases this value and lets idle workers steal from it.
+volatile LONG gnTaskQueuesLoadFP10[TASKQSLOTS];
+// Copy of D2TaskStrc::nType (number of games) of each queue slot, read without locking the queues when choosing one.
+// The slots themselves may be freed or changed by another worker, so they are only read under their queue lock.
+volatile LONG gnTaskQueuesGamesCount[TASKQSLOTS];
+
+static_assert(offsetof(D2GameTaskStrc, pQueueLink) == offsetof(D2TaskStrc, pTaskBalanceLink.pNext), "Game tasks links must alias D2TaskStrc::pTaskBalanceLink.pNext");
 
 
 //D2Game.0x6FC404E0 (#10039)
@@ -42,6 +54,80 @@ static int32_t TASK_GetClockTime()
 }
 
 
+static D2GameTaskStrc* TASK_GetGameTaskFromLink(D2LinkStrc* pLink)
+{
+    return CONTAINING_RECORD(pLink, D2GameTaskStrc, pQueueLink);
+}
+
+static D2GameStrc* TASK_GetGameFromGameTask(D2GameTaskStrc* pGameTask)
+{
+    // Game tasks are allocated right after their game, see GAME_CreateNewEmptyGame
+    return ((D2GameStrc*)pGameTask) - 1;
+}
+
+// Note: Only valid while the game task is queued (nobody processes it) or when the game is locked
+static int32_t TASK_GetGameBudgetRatio(D2GameStrc* pGame)
+{
+    // nCreationTimeMs_Or_CPUTargetRatioFP10 still holds the creation time until the first TASK_ProcessGame
+    return pGame->nLastUpdateSystemTimeMs ? pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 : TASK_BUDGET_RATIO_ONTIME;
+}
+
+static bool TASK_LinkList_IsEmpty(D2LinkStrc* pListLink)
+{
+    return pListLink->pNext == pListLink;
+}
+
+// Note: The queue lock must be held
+static void TASK_InsertGameTask(D2TaskStrc* ptTaskQ, D2GameTaskStrc* pGameTask)
+{
+    TASK_QueueIncrement(ptTaskQ, &pGameTask->nDueTimeMs, 0);
+}
+
+
+// Helper function
+void __fastcall TASK_AddQueueSlot(int32_t nTaskSlotIndex, D2TaskStrc* ptTask)
+{
+    EnterCriticalSection(&gTaskSlotsCriticalSection.cs);
+    if (!gpTaskQueueLink.pPrev)
+    {
+        gpTaskQueueLink.pPrev = &gpTaskQueueLink;
+        gpTaskQueueLink.pNext = &gpTaskQueueLink;
+    }
+
+    EnterCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIndex].cs);
+    D2_ASSERT(!gtTaskSlots[nTaskSlotIndex]);
+    ptTask->nTaskQ = nTaskSlotIndex;
+    ptTask->nType = 0; // Number of games in the queue
+    ptTask->pTaskBalanceLink.pPrev = &ptTask->pTaskBalanceLink;
+    ptTask->pTaskBalanceLink.pNext = &ptTask->pTaskBalanceLink;
+    InterlockedExchange(&gnTaskQueuesLoadFP10[nTaskSlotIndex], 0);
+    InterlockedExchange(&gnTaskQueuesGamesCount[nTaskSlotIndex], 0);
+    gtTaskSlots[nTaskSlotIndex] = ptTask;
+    TASK_LinkList_PushFront(&gpTaskQueueLink, &ptTask->pTaskQueueLink);
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIndex].cs);
+    LeaveCriticalSection(&gTaskSlotsCriticalSection.cs);
+}
+
+// Helper function
+D2TaskStrc* __fastcall TASK_RemoveQueueSlot(int32_t nTaskSlotIndex)
+{
+    EnterCriticalSection(&gTaskSlotsCriticalSection.cs);
+    EnterCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIndex].cs);
+
+    D2TaskStrc* pTask = gtTaskSlots[nTaskSlotIndex];
+    if (pTask)
+    {
+        TASK_LinkList_Remove(&pTask->pTaskQueueLink);
+        gtTaskSlots[nTaskSlotIndex] = nullptr;
+    }
+    InterlockedExchange(&gnTaskQueuesLoadFP10[nTaskSlotIndex], 0);
+    InterlockedExchange(&gnTaskQueuesGamesCount[nTaskSlotIndex], 0);
+
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIndex].cs);
+    LeaveCriticalSection(&gTaskSlotsCriticalSection.cs);
+    return pTask;
+}
+
 //D2Game.0x6FC40500 (#10040)
 void __stdcall TASK_FreeAllQueueSlots()
 {
@@ -49,16 +135,10 @@ void __stdcall TASK_FreeAllQueueSlots()
     
     for (int32_t i = 0; i < TASKQSLOTS; ++i)
     {
-        EnterCriticalSection(&gtTaskQueuesCriticalSections[i].cs);
-
-        if (D2TaskStrc* pTask = gtTaskSlots[i])
+        if (D2TaskStrc* pTask = TASK_RemoveQueueSlot(i))
         {
-            TASK_LinkList_Remove(&pTask->pTaskQueueLink);
-            D2_FREE_POOL(nullptr, gtTaskSlots[i]);
-            gtTaskSlots[i] = nullptr;
+            D2_FREE_POOL(nullptr, pTask);
         }
-
-        LeaveCriticalSection(&gtTaskQueuesCriticalSections[i].cs);
     }
 
     gnNumberOfTasksCreated = 0;
@@ -66,162 +146,131 @@ void __stdcall TASK_FreeAllQueueSlots()
     LeaveCriticalSection(&gTaskSlotsCriticalSection.cs);
 }
 
+// Note: The original game moved games from the existing queues into the new one here.
+// Queues are now balanced lazily: the new (empty) queue will steal games from the busiest queues in D2Game_10043.
 //D2Game.0x6FC405B0 (#10041) 
-int __cdecl D2Game_10041_TASK_Create()
+int32_t __cdecl D2Game_10041_TASK_Create()
 {
-    UNIMPLEMENTED();
     EnterCriticalSection(&gTaskSlotsCriticalSection.cs);
-    if (!gpTaskQueueLink.pPrev)
-    {
-        gpTaskQueueLink.pPrev = &gpTaskQueueLink;
-        gpTaskQueueLink.pNext = &gpTaskQueueLink;
-    }
-    int nTaskSlotIndex = gnNumberOfTasksCreated++ & 0x1F;
-    CRITICAL_SECTION* pTaskQueueCriticalSection = &gtTaskQueuesCriticalSections[nTaskSlotIndex].cs;
-    EnterCriticalSection(pTaskQueueCriticalSection);
+    // Slots are only added and removed with gTaskSlotsCriticalSection held
+    const int32_t nTaskSlotIndex = gnNumberOfTasksCreated++ & (TASKQSLOTS - 1);
     if (!gtTaskSlots[nTaskSlotIndex])
     {
-        D2TaskStrc* ptTask = D2_ALLOC_STRC_POOL(nullptr, D2TaskStrc);
-        D2LinkStrc* pTaskBalanceLink = &ptTask->pTaskBalanceLink;
-        ptTask->nTaskQ = nTaskSlotIndex;
-        ptTask->nType = 0;
-        ptTask->pTaskBalanceLink.pPrev = &ptTask->pTaskBalanceLink;
-        ptTask->pTaskBalanceLink.pNext = &ptTask->pTaskBalanceLink;
-        int v6 = gnNumberOfTasksCreated;
-        uint32_t v4 = gnGamesCount / (uint32_t)gnNumberOfTasksCreated;
-        uint32_t v5 = gnGamesCount % (uint32_t)gnNumberOfTasksCreated;
-        gtTaskSlots[nTaskSlotIndex] = ptTask;
-        int v7 = v6 - 1;
-        if (v6 - 1 >= (unsigned int)TASKQSLOTS)
-            v7 = 32;
-        int v21 = v7 - v5;
-        for (D2LinkStrc* pLink = gpTaskQueueLink.pNext; pLink != &gpTaskQueueLink; pLink = pLink->pNext)
-        {
-            bool v9 = (int)--v21 < 0;
-#define D2_PAIR64(high, low) ((uint64_t(uint32_t(high)) << 32) |(uint32_t(low)))
-            int v10 = (D2_PAIR64(CONTAINING_RECORD(pLink, D2TaskStrc, pTaskQueueLink)->nType, v4 + !v9) - 1) >> 32;
-            EnterCriticalSection(&gtTaskQueuesCriticalSections[CONTAINING_RECORD( pLink, D2TaskStrc, pTaskQueueLink)->nTaskQ].cs);
-            D2LinkStrc* pTaskBalanceIterator = pLink[-1].pPrev;
-            D2LinkStrc* pTaskBalancePrevLink = pLink - 1;
-            D2LinkStrc* i = pTaskBalanceIterator;
-            for (; v10; pTaskBalanceIterator = pTaskBalanceIterator->pNext)
-            {
-                --v10;
-                if (pTaskBalanceIterator == pTaskBalancePrevLink)
-                    break;
-            }
-            D2LinkStrc* pTaskBalanceIteratorpNext = pTaskBalanceIterator->pNext;
-            pTaskBalanceIterator->pNext = pTaskBalancePrevLink;
-            pTaskBalancePrevLink->pPrev = pTaskBalanceIterator;
-            LeaveCriticalSection(&gtTaskQueuesCriticalSections[CONTAINING_RECORD( pLink, D2TaskStrc, pTaskQueueLink)->nTaskQ].cs);
-            if (pTaskBalanceIteratorpNext != pTaskBalancePrevLink)
-            {
-                D2LinkStrc* v14 = i;
-                i->pNext = 0;
-                D2LinkStrc* nPreviousTypeTaskLink;
-                for (nPreviousTypeTaskLink = pTaskBalanceLink->pPrev;
-                    nPreviousTypeTaskLink != pTaskBalanceLink;
-                    nPreviousTypeTaskLink = nPreviousTypeTaskLink->pPrev)
-                {
-                    if ((char*)pTaskBalanceIteratorpNext[-2].pNext - (char*)nPreviousTypeTaskLink[-2].pNext >= 0)// CONTAINING_RECORD(pLink,D2TaskStrc,pTaskBalanceLink)->nTaskQ
-                        break;
-                }
-                if (nPreviousTypeTaskLink->pNext == pTaskBalanceLink)
-                {
-                LABEL_22:
-                    pTaskBalanceIteratorpNext->pPrev = nPreviousTypeTaskLink;
-                    v14->pNext = pTaskBalanceLink;
-                    nPreviousTypeTaskLink->pNext = pTaskBalanceIteratorpNext;
-                    pTaskBalanceLink->pPrev = v14;
-                }
-                else
-                {
-                    while (1)
-                    {
-                        D2LinkStrc* v16 = pTaskBalanceIteratorpNext->pNext;
-                        pTaskBalanceIteratorpNext->pPrev = nPreviousTypeTaskLink;
-                        D2LinkStrc* v17 = nPreviousTypeTaskLink->pNext;
-                        pTaskBalanceIteratorpNext->pNext = v17;
-                        v17->pPrev = pTaskBalanceIteratorpNext;
-                        nPreviousTypeTaskLink->pNext = pTaskBalanceIteratorpNext;
-                        if (!v16)
-                            break;
-                        nPreviousTypeTaskLink = pTaskBalanceIteratorpNext;
-                        pTaskBalanceIteratorpNext = v16;
-                        D2LinkStrc* v18 = nPreviousTypeTaskLink->pNext;
-                        if (v18 != pTaskBalanceLink)
-                        {
-                            D2LinkStrc* v19 = v16[-2u].pNext; // NOLINT TODO proper list
-                            do
-                            {
-                                if ((char*)v19 - (char*)v18[-2].pNext <= 0) // NOLINT TODO proper list
-                                    break;
-                                nPreviousTypeTaskLink = v18;
-                                v18 = v18->pNext;
-                            } while (v18 != pTaskBalanceLink);
-                        }
-                        if (nPreviousTypeTaskLink->pNext == pTaskBalanceLink)
-                        {
-                            v14 = i;
-                            goto LABEL_22;
-                        }
-                    }
-                }
-            }
-        }
-        TASK_LinkList_PushFront(&gpTaskQueueLink, &ptTask->pTaskQueueLink);
+        TASK_AddQueueSlot(nTaskSlotIndex, D2_ALLOC_STRC_POOL(nullptr, D2TaskStrc));
     }
-    LeaveCriticalSection(pTaskQueueCriticalSection);
     LeaveCriticalSection(&gTaskSlotsCriticalSection.cs);
     return nTaskSlotIndex;
 }
 
+// Note: The original game used a round-robin on the queues list under a global lock.
+// We now pick the least loaded queue and only lock this one.
 //D2Game.0x6FC407A0 (#10042) --------------------------------------------------------
 BOOL __fastcall D2Game_10042(D2TaskStrc* pTask, int nTaskType, D2LinkStrc* pPrevTaskBalanceLink)
 {
-    BOOL nResult = FALSE;
-    
-    pTask->nTaskQ = TASK_GetClockTime();
-    pTask->nType = nTaskType;
-    pTask->pTaskBalanceLink.pPrev = pPrevTaskBalanceLink;
-    EnterCriticalSection(&gTaskSlotsCriticalSection.cs);
-    if (gpTaskQueueLink.pPrev)
+    D2GameTaskStrc* pGameTask = (D2GameTaskStrc*)pTask;
+    pGameTask->nDueTimeMs = TASK_GetClockTime();
+    pGameTask->nType = nTaskType;
+    pGameTask->nGameHashKey = (uint32_t)pPrevTaskBalanceLink;
+
+    int32_t nBestSlotIdx = -1;
+    for (int32_t i = 0; i < TASKQSLOTS; ++i)
     {
-        D2LinkStrc* pTaskQueueHeadLink = gpTaskQueueLink.pNext;
-        if (gpTaskQueueLink.pNext != &gpTaskQueueLink && gpTaskQueueLink.pNext)
+        if (!gtTaskSlots[i])
         {
-            D2TaskStrc* ptTask = CONTAINING_RECORD(gpTaskQueueLink.pNext, D2TaskStrc, pTaskQueueLink);
-            EnterCriticalSection(&gtTaskQueuesCriticalSections[ptTask->nTaskQ].cs);
-            D2TaskStrc* ptTaskQueueHead = CONTAINING_RECORD(pTaskQueueHeadLink, D2TaskStrc, pTaskQueueLink);
+            continue;
+        }
+
+        if (nBestSlotIdx < 0
+            || gnTaskQueuesLoadFP10[i] < gnTaskQueuesLoadFP10[nBestSlotIdx]
+            || (gnTaskQueuesLoadFP10[i] == gnTaskQueuesLoadFP10[nBestSlotIdx] && gnTaskQueuesGamesCount[i] < gnTaskQueuesGamesCount[nBestSlotIdx]))
+        {
+            nBestSlotIdx = i;
+        }
+    }
+
+    if (nBestSlotIdx < 0)
+    {
+        return FALSE;
+    }
 
-            TASK_LinkList_PushFront(&ptTaskQueueHead->pTaskBalanceLink, (D2LinkStrc*)&pTask->pTaskBalanceLink.pNext);
+    EnterCriticalSection(&gtTaskQueuesCriticalSections[nBestSlotIdx].cs);
+    D2TaskStrc* ptTaskQ = gtTaskSlots[nBestSlotIdx];
+    if (!ptTaskQ)
+    {
+        LeaveCriticalSection(&gtTaskQueuesCriticalSections[nBestSlotIdx].cs);
+        return FALSE;
+    }
 
-            LeaveCriticalSection(&gtTaskQueuesCriticalSections[ptTask->nTaskQ].cs);
-            ++ptTask->nType;
-            ++gnGamesCount;
-            TASK_LinkList_Remove(pTaskQueueHeadLink);
-            TASK_LinkList_Insert(gpTaskQueueLink.pPrev, pTaskQueueHeadLink);
+    TASK_InsertGameTask(ptTaskQ, pGameTask);
+    ++ptTaskQ->nType;
+    InterlockedIncrement(&gnTaskQueuesGamesCount[nBestSlotIdx]);
+    InterlockedExchangeAdd(&gnTaskQueuesLoadFP10[nBestSlotIdx], TASK_BUDGET_RATIO_ONTIME);
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nBestSlotIdx].cs);
 
-            nResult = TRUE;
+    InterlockedIncrement((volatile LONG*)&gnGamesCount);
+    return TRUE;
+}
+
+// Moves the last due game of the busiest queue to the queue nThiefIdx.
+// Queues are locked in index order so that two workers stealing from each other can not deadlock.
+static BOOL TASK_StealGame(int32_t nThiefIdx)
+{
+    const LONG nThiefLoad = gnTaskQueuesLoadFP10[nThiefIdx];
+
+    int32_t nVictimIdx = -1;
+    for (int32_t i = 0; i < TASKQSLOTS; ++i)
+    {
+        if (i != nThiefIdx && gtTaskSlots[i] && gnTaskQueuesGamesCount[i] > 1
+            && (nVictimIdx < 0 || gnTaskQueuesLoadFP10[i] > gnTaskQueuesLoadFP10[nVictimIdx]))
+        {
+            nVictimIdx = i;
         }
     }
-    else
+
+    if (nVictimIdx < 0 || gnTaskQueuesLoadFP10[nVictimIdx] - nThiefLoad <= TASK_STEAL_THRESHOLD_FP10)
     {
-        gpTaskQueueLink.pPrev = &gpTaskQueueLink;
-        gpTaskQueueLink.pNext = &gpTaskQueueLink;
+        return FALSE;
     }
-    LeaveCriticalSection(&gTaskSlotsCriticalSection.cs);
-    return nResult;
+
+    const int32_t nFirstLockIdx = std::min(nThiefIdx, nVictimIdx);
+    const int32_t nSecondLockIdx = std::max(nThiefIdx, nVictimIdx);
+    EnterCriticalSection(&gtTaskQueuesCriticalSections[nFirstLockIdx].cs);
+    EnterCriticalSection(&gtTaskQueuesCriticalSections[nSecondLockIdx].cs);
+
+    BOOL bStolen = FALSE;
+    D2TaskStrc* ptThiefTaskQ = gtTaskSlots[nThiefIdx];
+    D2TaskStrc* ptVictimTaskQ = gtTaskSlots[nVictimIdx];
+    if (ptThiefTaskQ && ptVictimTaskQ && ptVictimTaskQ->nType > 1 && !TASK_LinkList_IsEmpty(&ptVictimTaskQ->pTaskBalanceLink))
+    {
+        // Steal from the back of the queue, the owner pops from the front
+        D2GameTaskStrc* pGameTask = TASK_GetGameTaskFromLink(ptVictimTaskQ->pTaskBalanceLink.pPrev);
+        const int32_t nGameRatio = TASK_GetGameBudgetRatio(TASK_GetGameFromGameTask(pGameTask));
+
+        // Do not steal if it would only move the imbalance to the thief
+        if (nThiefLoad + nGameRatio < gnTaskQueuesLoadFP10[nVictimIdx] - nGameRatio)
+        {
+            TASK_LinkList_Remove(&pGameTask->pQueueLink);
+            --ptVictimTaskQ->nType;
+            InterlockedDecrement(&gnTaskQueuesGamesCount[nVictimIdx]);
+            InterlockedExchangeAdd(&gnTaskQueuesLoadFP10[nVictimIdx], -nGameRatio);
+
+            TASK_InsertGameTask(ptThiefTaskQ, pGameTask);
+            ++ptThiefTaskQ->nType;
+            InterlockedIncrement(&gnTaskQueuesGamesCount[nThiefIdx]);
+            InterlockedExchangeAdd(&gnTaskQueuesLoadFP10[nThiefIdx], nGameRatio);
+            bStolen = TRUE;
+        }
+    }
+
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nSecondLockIdx].cs);
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nFirstLockIdx].cs);
+    return bStolen;
 }
 
-//D2Game.0x6FC40930 (#10043)
-int32_t __fastcall D2Game_10043(int8_t a1, int32_t* pOutBalanceTaskType)
+// Pops the first game task of the queue if it is due, and returns the time until it is due otherwise.
+static int32_t TASK_PopDueGameTask(int32_t nIndex, int32_t* pOutGameTask)
 {
-    const int8_t nIndex = a1 & 31;
     int32_t nResult = 100;
-
-    *pOutBalanceTaskType = 0;
-
     EnterCriticalSection(&gtTaskQueuesCriticalSections[nIndex].cs);
 
     if (D2TaskStrc* pTask = gtTaskSlots[nIndex])
@@ -229,23 +278,42 @@ int32_t __fastcall D2Game_10043(int8_t a1, int32_t* pOutBalanceTaskType)
         D2LinkStrc* pLink = pTask->pTaskBalanceLink.pNext;
         if (pLink != &pTask->pTaskBalanceLink && pLink)
         {
-            const int64_t nTickCount = TASK_GetClockTime();
-            nResult = CONTAINING_RECORD(pLink, D2TaskStrc, pTaskQueueLink)->nType - nTickCount;
+            D2GameTaskStrc* pGameTask = TASK_GetGameTaskFromLink(pLink);
+            nResult = pGameTask->nDueTimeMs - TASK_GetClockTime();
             if (nResult <= 0)
             {
                 TASK_LinkList_Remove(pLink);
-                *pOutBalanceTaskType = CONTAINING_RECORD(pLink, D2TaskStrc, pTaskQueueLink)->nType;
+                *pOutGameTask = (int32_t)pGameTask;
             }
         }
 
-        D2_ASSERT(pTask->nTaskQ < 32);
+        D2_ASSERT(pTask->nTaskQ < TASKQSLOTS);
+    }
+
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nIndex].cs);
+    return nResult;
+}
+
+//D2Game.0x6FC40930 (#10043)
+int32_t __fastcall D2Game_10043(int8_t a1, int32_t* pOutBalanceTaskType)
+{
+    const int8_t nIndex = a1 & 31;
+
+    *pOutBalanceTaskType = 0;
 
-        LeaveCriticalSection(&gtTaskQueuesCriticalSections[pTask->nTaskQ].cs);
+    const int32_t nResult = TASK_PopDueGameTask(nIndex, pOutBalanceTaskType);
+    if (nResult <= 0)
+    {
         return nResult;
     }
 
-    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nIndex].cs);
-    return 100;
+    // Nothing to do for now, help the busiest worker
+    if (TASK_StealGame(nIndex))
+    {
+        return TASK_PopDueGameTask(nIndex, pOutBalanceTaskType);
+    }
+
+    return nResult;
 }
 
 //D2Game.0x6FC40A40 (#10044)
@@ -260,89 +328,60 @@ int32_t __fastcall D2Game_10044(int8_t nTaskNumber)
         D2LinkStrc* pLink = pTask->pTaskBalanceLink.pNext;
         if (pLink != &pTask->pTaskBalanceLink && pLink)
         {
-            const int64_t nTickCount = TASK_GetClockTime();
-            nResult = CONTAINING_RECORD(pLink, D2TaskStrc, pTaskQueueLink)->nType - nTickCount;
+            nResult = TASK_GetGameTaskFromLink(pLink)->nDueTimeMs - TASK_GetClockTime();
         }
 
         D2_ASSERT(pTask->nTaskQ < 32);
-
-        LeaveCriticalSection(&gtTaskQueuesCriticalSections[pTask->nTaskQ].cs);
-        return nResult;
     }
 
     LeaveCriticalSection(&gtTaskQueuesCriticalSections[nIndex].cs);
     return nResult;
 }
 
-static D2TaskStrc* TASK_GetTaskFromTaskQueueLink(D2LinkStrc* pInTaskQueueLink)
-{
-    return CONTAINING_RECORD(pInTaskQueueLink, D2TaskStrc, pTaskQueueLink);
-}
-static D2TaskStrc* TASK_GetTaskFromTaskType(int32_t* pTaskType)
+static void TASK_CloseGame(uint32_t nGameHashKey, char nTaskNumber, int32_t nGameRatio)
 {
-    return CONTAINING_RECORD(pTaskType, D2TaskStrc, nType);
-}
+    GAME_CloseGame(nGameHashKey);
 
-static bool TASK_LinkList_IsEmpty(D2LinkStrc* pListLink)
-{
-    return pListLink->pNext != pListLink;
-}
+    const int32_t nTaskSlotIdx = nTaskNumber & 0x1F;
+    EnterCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIdx].cs);
+    if (D2TaskStrc* pTaskSlot = gtTaskSlots[nTaskSlotIdx])
+    {
+        --pTaskSlot->nType;
+        InterlockedDecrement(&gnTaskQueuesGamesCount[nTaskSlotIdx]);
+        InterlockedExchangeAdd(&gnTaskQueuesLoadFP10[nTaskSlotIdx], -nGameRatio);
+    }
+    LeaveCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIdx].cs);
 
-static D2LinkStrc* TASK_GetLastTaskFromListHead(D2LinkStrc* pListHead)
-{
-    return TASK_LinkList_IsEmpty(pListHead) ? pListHead->pPrev : nullptr;
+    InterlockedDecrement((volatile LONG*)&gnGamesCount);
 }
 
-static void TASK_CloseGame(uint32_t nGameHashKey, char nTaskNumber)
+//D2Game.0x6FC40B30 (#10045) --------------------------------------------------------
+void __fastcall TASK_ProcessGame(char nTaskNumber, D2TaskStrc* ptTask)
 {
-    GAME_CloseGame(nGameHashKey);
-    EnterCriticalSection(&gTaskSlotsCriticalSection.cs);
+    D2_ASSERT(ptTask->nType == TASK_PROCESSGAME);
 
-    if (D2TaskStrc* pTaskSlot = gtTaskSlots[nTaskNumber & 0x1F])
+    D2GameTaskStrc* pGameTask = (D2GameTaskStrc*)ptTask;
+    const int32_t nTaskSlotIdx = nTaskNumber & 0x1F;
+    const uint32_t nGameHashKey = pGameTask->nGameHashKey;
+    if (D2GameStrc* pGame = GAME_LockGame(nGameHashKey))
     {
-        D2LinkStrc* ptTaskQTailLink = TASK_GetLastTaskFromListHead(&gpTaskQueueLink);
-        D2_ASSERT(ptTaskQTailLink);
-
-        const int32_t nTaskSlotType = pTaskSlot->nType;
-        D2TaskStrc* ptTaskQTail = TASK_GetTaskFromTaskQueueLink(gpTaskQueueLink.pPrev);
-
-        D2LinkStrc* pNewTaskLink = nullptr;
-        if (TASK_GetTaskFromTaskQueueLink(gpTaskQueueLink.pNext)->nType == (nTaskSlotType + 1))
+        // Budget ratio used for balancing: how late this game is compared to its frame time
+        const int32_t nPreviousRatio = TASK_GetGameBudgetRatio(pGame);
+        const uint32_t nClockTime = TASK_GetClockTime();
+        if (pGame->nLastUpdateSystemTimeMs)
         {
-            EnterCriticalSection(&gtTaskQueuesCriticalSections[ptTaskQTail->nTaskQ].cs);
-
-            D2LinkStrc* ptTaskBalanceLink = TASK_GetLastTaskFromListHead(&ptTaskQTail->pTaskBalanceLink);
-            D2_ASSERT(ptTaskBalanceLink);
-
-            TASK_LinkList_Remove(ptTaskBalanceLink);
-            LeaveCriticalSection(&gtTaskQueuesCriticalSections[ptTaskQTail->nTaskQ].cs);
-            EnterCriticalSection(&gtTaskQueuesCriticalSections[pTaskSlot->nTaskQ].cs);
-            TASK_QueueIncrement(pTaskSlot, &(TASK_GetTaskFromTaskQueueLink(ptTaskBalanceLink)->nType), 0);
-            LeaveCriticalSection(&gtTaskQueuesCriticalSections[pTaskSlot->nTaskQ].cs);
-            --ptTaskQTail->nType;
-            TASK_LinkList_Remove(ptTaskQTailLink);
-            pNewTaskLink = ptTaskQTailLink;
+            const uint32_t nTimeSinceLastUpdateMs = nClockTime - pGame->nLastUpdateSystemTimeMs;
+            pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 = D2Clamp((nTimeSinceLastUpdateMs << 10) / TASK_GAME_FRAME_MS, 10u, 2048u);
         }
         else
         {
-            pTaskSlot->nType = nTaskSlotType - 1;
-            pNewTaskLink = &pTaskSlot->pTaskQueueLink;
-            TASK_LinkList_Remove(pNewTaskLink);
+            pGame->nCreationTimeMs_Or_CPUTargetRatioFP10 = TASK_BUDGET_RATIO_ONTIME;
         }
-        TASK_LinkList_PushFront(&gpTaskQueueLink, pNewTaskLink);
-    }
-    --gnGamesCount;
-    LeaveCriticalSection(&gTaskSlotsCriticalSection.cs);
-}
+        pGame->nLastUpdateSystemTimeMs = nClockTime ? nClockTime : 1;
 
-//D2Game.0x6FC40B30 (#10045) --------------------------------------------------------
-void __fastcall TASK_ProcessGame(char nTaskNumber, D2TaskStrc* ptTask)
-{
-    D2_ASSERT(ptTask->nType == TASK_PROCESSGAME);
+        const int32_t nGameRatio = pGame->nCreationTimeMs_Or_CPUTargetRatioFP10;
+        InterlockedExchangeAdd(&gnTaskQueuesLoadFP10[nTaskSlotIdx], nGameRatio - nPreviousRatio);
 
-    const uint32_t nGameHashKey = (uint32_t)ptTask->pTaskBalanceLink.pPrev;
-    if (D2GameStrc* pGame = GAME_LockGame(nGameHashKey))
-    {
         GAME_UpdateProgress(pGame);
         sub_6FC39270(pGame, 0);
         const int32_t v7 = FOG_10055_GetSyncTime();
@@ -357,7 +396,7 @@ void __fastcall TASK_ProcessGame(char nTaskNumber, D2TaskStrc* ptTask)
             }
             GAME_LogMessage(6, "[SERVER]  Deleting game from sSrvTaskProcessGame(), I/O timeout");
             GAME_LeaveGamesCriticalSection(pGame);
-            TASK_CloseGame(nGameHashKey, nTaskNumber);
+            TASK_CloseGame(nGameHashKey, nTaskNumber, nGameRatio);
             return;
         }
         int32_t nTick = GetTickCount();
@@ -374,51 +413,41 @@ void __fastcall TASK_ProcessGame(char nTaskNumber, D2TaskStrc* ptTask)
             {
                 GAME_LogMessage(6, "[SERVER]  Deleting game from sSrvTaskProcessGame(), empty game");
                 GAME_LeaveGamesCriticalSection(pGame);
-                TASK_CloseGame(nGameHashKey, nTaskNumber);
+                TASK_CloseGame(nGameHashKey, nTaskNumber, nGameRatio);
                 return;
             }
         }
         
         GAME_LeaveGamesCriticalSection(pGame);
-        const int32_t nTaskSlotIdx = nTaskNumber & 0x1F;
         EnterCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIdx].cs);
 
+        // The game now belongs to the queue of the worker that processed it (it may have been stolen)
         if (D2TaskStrc* ptTaskQ = gtTaskSlots[nTaskSlotIdx])
         {
-            ptTask->nTaskQ += 40;
-            D2LinkStrc* pTaskBalancePrevLink;
-            for (pTaskBalancePrevLink = ptTaskQ->pTaskBalanceLink.pPrev; pTaskBalancePrevLink != &ptTaskQ->pTaskBalanceLink; pTaskBalancePrevLink = pTaskBalancePrevLink->pPrev)
-            {
-                if (TASK_GetTaskFromTaskQueueLink(pTaskBalancePrevLink)->nType <= ptTask->nTaskQ)
-                    break;
-            }
-            // Something weird is going on here
-            TASK_LinkList_Insert(pTaskBalancePrevLink, (D2LinkStrc*)&ptTask->pTaskBalanceLink.pNext);
+            TASK_QueueIncrement(ptTaskQ, &pGameTask->nDueTimeMs, TASK_GAME_FRAME_MS);
             
             D2_ASSERT(ptTaskQ->nTaskQ < TASKQSLOTS);
-            LeaveCriticalSection(&gtTaskQueuesCriticalSections[ptTaskQ->nTaskQ].cs);
-        }
-        else
-        {
-            LeaveCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIdx].cs);
         }
+
+        LeaveCriticalSection(&gtTaskQueuesCriticalSections[nTaskSlotIdx].cs);
     }
 }
 
 //D2Game.0x6FC40E40
 void __fastcall TASK_QueueIncrement(D2TaskStrc* ptTaskQueue, int32_t* pTaskType, int nTaskTypeIncrement)
 {
+    // Note: pTaskType is the nDueTimeMs of a game task
+    D2GameTaskStrc* pGameTask = CONTAINING_RECORD(pTaskType, D2GameTaskStrc, nDueTimeMs);
     D2LinkStrc* ptTaskBalanceLink = &ptTaskQueue->pTaskBalanceLink;
     *pTaskType += nTaskTypeIncrement;
     D2LinkStrc* ptPrev;
     for (ptPrev = ptTaskBalanceLink->pPrev; ptPrev != ptTaskBalanceLink; ptPrev = ptPrev->pPrev)
     {
-        if (TASK_GetTaskFromTaskQueueLink(ptPrev)->nType <= *pTaskType)
+        if (TASK_GetGameTaskFromLink(ptPrev)->nDueTimeMs <= *pTaskType)
             break;
     }
     
-    D2TaskStrc* pTask = TASK_GetTaskFromTaskType(pTaskType);
-    TASK_LinkList_Insert(ptPrev, &pTask->pTaskQueueLink);
+    TASK_LinkList_Insert(ptPrev, &pGameTask->pQueueLink);
 }
 
 
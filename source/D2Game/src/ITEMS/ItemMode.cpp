@@ -56,10 +56,8 @@ struct D2UnkUniqueItemStrc
 #pragma pack(pop)
 
 
-bool gbBoxItemIdInitialized;
-int32_t gnBoxItemId;
-
-D2UnkUniqueItemStrc stru_6FD45C18[4096];
+// D2Moo: one buffer per thread, games may be updated in parallel by GAMESCHED workers
+thread_local D2UnkUniqueItemStrc stru_6FD45C18[4096];
 
 
 //D2Game.0x6FC41900
@@ -3302,14 +3300,11 @@ int32_t __fastcall sub_6FC46D40(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nC
     const uint8_t nInvPage = ITEMS_GetInvPage(pGridItem);
     if (nInvPage == INVPAGE_CUBE)
     {
-        if (!gbBoxItemIdInitialized)
+        // D2Moo: was lazily initialized in globals, a local static is initialized once even if several threads get here
+        static const int32_t gnBoxItemId = DATATBLS_GetItemIdFromItemCode(' xob');
+        if (gnBoxItemId < 0)
         {
-            if (!DATATBLS_GetItemRecordFromItemCode(' xob', &gnBoxItemId))
-            {
-                return 0;
-            }
-
-            gbBoxItemIdInitialized = 1;
+            return 0;
         }
 
         if (pCursorItem->dwClassId == gnBoxItemId)
@@ -47,11 +47,6 @@ struct D2TCArrayStrc
 #pragma pack(pop)
 
 
-bool gbGoldItemIdInitialized;
-int32_t gnGoldItemId;
-int32_t dword_6FD4DC18;
-
-
 //D2Game.0x6FC4D470
 D2UniqueItemsTxt* __fastcall ITEMS_GetUniqueItemsTxtRecord(int32_t nUniqueItemId)
 {
@@ -1049,11 +1044,8 @@ int32_t __fastcall sub_6FC4F4A0(D2GameStrc* pGame, D2SeedStrc* pSeed, int32_t nL
 {
     constexpr int32_t BASE_GOLD_RAND = 65;
 
-    if (!gbGoldItemIdInitialized)
-    {
-        gbGoldItemIdInitialized = true;
-        gnGoldItemId = DATATBLS_GetItemIdFromItemCode(' dlg');
-    }
+    // D2Moo: thread-safe initialization, was a global set after its initialization flag
+    static const int32_t gnGoldItemId = DATATBLS_GetItemIdFromItemCode(' dlg');
 
     D2_ASSERT(gnGoldItemId != -1);
     D2_ASSERT(gnGoldItemId != 0);
@@ -1110,10 +1102,8 @@ void __fastcall sub_6FC4F640(D2GameStrc* pGame, D2ActiveRoomStrc* pRoom, D2Coord
         pSeed = &pRoom->pSeed;
     }
 
-    if (!dword_6FD4DC18)
-    {
-        DATATBLS_GetItemRecordFromItemCode(' dlg', &dword_6FD4DC18);
-    }
+    // D2Moo: thread-safe initialization of the former global, 0 if the item does not exist
+    static const int32_t dword_6FD4DC18 = std::max(DATATBLS_GetItemIdFromItemCode(' dlg'), 0);
 
     D2CoordStrc coords1 = {};
     D2CoordStrc coords2 = {};
@@ -2145,23 +2135,8 @@ void __fastcall D2GAME_DropTC_6FC51360(D2GameStrc* pGame, D2UnitStrc* pMonster,
 
                     if (nPlayerCount > 1)
                     {
-                        double noDropRatio = (double)nNoDrop / (double)(nChance + nNoDrop);
-                        const double baseRatio = noDropRatio;
-
-                        for (int32_t i = nPlayerCount - 1; i > 0; --i)
-                        {
-                            noDropRatio *= baseRatio;
-                        }
-
-                        const double inverseRatio = 1.0 - noDropRatio;
-                        if (inverseRatio == 0.0)
-                        {
-                            nNoDrop = 0;
-                        }
-                        else
-                        {
-                            nNoDrop = (int32_t)((double)nChance / inverseRatio * (1.0 - inverseRatio));
-                        }
+                        // D2Moo only: precomputed when the treasure classes are loaded
+                        nNoDrop = DATATBLS_GetTreasureClassNoDrop(pTC, pGame->bExpansion, nPlayerCount);
                     }
                 }
 
@@ -2186,42 +2161,8 @@ void __fastcall D2GAME_DropTC_6FC51360(D2GameStrc* pGame, D2UnitStrc* pMonster,
 
             --tcArray[nCounter].nPicks;
 
-            int32_t nIndex = 0;
-            if (!pGame->bExpansion)
-            {
-                while (nIndex < pTC->nTypes)
-                {
-                    if (!(pTC->pInfo[nIndex].nFlags & 0x10) && (nIndex >= pTC->nTypes - 1 || pTC->pInfo[nIndex + 1].nClassic > nRand))
-                    {
-                        break;
-                    }
-
-                    ++nIndex;
-                }
-            }
-            else
-            {
-                int32_t nLowerBound = 0;
-                int32_t nUpperBound = pTC->nTypes;
-                while (nLowerBound < nUpperBound)
-                {
-                    nIndex = nLowerBound + (nUpperBound - nLowerBound) / 2;
-                    if (nRand > pTC->pInfo[nIndex].nProb)
-                    {
-                        nLowerBound = nIndex + 1;
-                    }
-                    else if (nRand < pTC->pInfo[nIndex].nProb)
-                    {
-                        nUpperBound = nIndex;
-                    }
-                    else // nRand == pTC->pInfo[nIndex].nProb
-                    {
-                        break;
-                    }
-                }
-
-                nIndex = std::max(nLowerBound - 1, 0);
-            }
+            // D2Moo only: binary search in the cumulative probabilities for both classic and expansion
+            const int32_t nIndex = DATATBLS_PickTreasureClassEntry(pTC, pGame->bExpansion, nRand);
 
             if (nIndex < pTC->nTypes)
             {
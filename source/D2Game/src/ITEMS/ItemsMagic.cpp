@@ -244,20 +244,19 @@ int16_t __fastcall ITEMS_RollMagicAffixesNew(D2UnitStrc* pItem, int32_t bRequire
 
     // By default, use prefixes only
     const D2MagicAffixTxt* pMagicAffixTableBegin = pMagicAffixDataTables->pMagicPrefix;
-    const D2MagicAffixTxt* pMagicAffixTableEnd = pMagicAffixDataTables->pAutoMagic;
+    int32_t nAffixCandidatesList = AFFIXCANDIDATES_MAGICPREFIX;
 
     if (nAutoMagicGroup)
     {
         pMagicAffixTableBegin = pMagicAffixDataTables->pAutoMagic;
-        pMagicAffixTableEnd   = &pMagicAffixDataTables->pMagicAffixTxt[pMagicAffixDataTables->nMagicAffixTxtRecordCount];
+        nAffixCandidatesList = AFFIXCANDIDATES_AUTOMAGIC;
     }
     if (!bPrefixes)
     {
         pMagicAffixTableBegin = pMagicAffixDataTables->pMagicSuffix;
-        pMagicAffixTableEnd = pMagicAffixDataTables->pMagicPrefix;
+        nAffixCandidatesList = AFFIXCANDIDATES_MAGICSUFFIX;
     }
 
-    const int32_t nMagicAffixesCount = pMagicAffixTableEnd - pMagicAffixTableBegin;
     if (!pMagicAffixTableBegin)
     {
         return 0;
@@ -289,9 +288,12 @@ int16_t __fastcall ITEMS_RollMagicAffixesNew(D2UnitStrc* pItem, int32_t bRequire
     const int32_t nPotentialMagicAffixesSize = 512;
     D2MagicAffixIndexAndPtrStrc tPotentialMagicAffixes[nPotentialMagicAffixesSize];
 
-    int32_t nMagicAffixIndex;
-    for (nMagicAffixIndex = 0; nMagicAffixIndex < nMagicAffixesCount; nMagicAffixIndex++)
+    // D2Moo only: only the affixes whose type, frequency and levels allow them on this item are checked, in the order of the table
+    int32_t nMagicAffixCandidatesCount = 0;
+    const uint16_t* pMagicAffixCandidates = DATATBLS_GetMagicAffixCandidates(pItem->dwClassId, nAffixCandidatesList, nItemAffixLevel, &nMagicAffixCandidatesCount);
+    for (int32_t nCandidate = 0; nCandidate < nMagicAffixCandidatesCount; nCandidate++)
     {
+        const int32_t nMagicAffixIndex = pMagicAffixCandidates[nCandidate];
         const D2MagicAffixTxt& rAffix = pMagicAffixTableBegin[nMagicAffixIndex];
         if ((bRequireSpawnableAffix && !rAffix.wSpawnable) || !(rAffix.wVersion < 100u || nItemFormat >= 100u))
         {
@@ -575,20 +577,16 @@ int16_t __fastcall D2GAME_RollRareAffix_6FC53610(D2UnitStrc* pItem, int32_t bPre
     }
 
     const int32_t nAffixIndex = pRareAffixTxtRecord - pRareAffixDataTbl->pRareAffixTxt;
+
+    // D2Moo only: only the affixes whose type allow them on this item are checked, in the order of the table
     int32_t nCount = 0;
-    if (bPrefix)
-    {
-        nCount = &pRareAffixDataTbl->pRareAffixTxt[pRareAffixDataTbl->nRareAffixTxtRecordCount] - pRareAffixDataTbl->pRarePrefix;
-    }
-    else
-    {
-        nCount = pRareAffixDataTbl->pRarePrefix - pRareAffixDataTbl->pRareSuffix;
-    }
+    const uint16_t* pRareAffixCandidates = DATATBLS_GetRareAffixCandidates(pItem ? pItem->dwClassId : -1, bPrefix, &nCount);
 
     D2RareAffixIndexAndPtrStrc data[512] = {};
     int32_t nMax = 0;
-    for (int32_t i = 0; i < nCount; ++i)
+    for (int32_t nCandidate = 0; nCandidate < nCount; ++nCandidate)
     {
+        const int32_t i = pRareAffixCandidates[nCandidate];
         if (ITEMMODS_CanItemHaveRareAffix(pItem, &pRareAffixTxtRecord[i]) && nMax < 511)
         {
             data[nMax].nIndex = nAffixIndex + i;
@@ -67,10 +67,6 @@ struct D2ServerPacketTableStrc
 };
 
 
-int32_t gbWhispReceiverInGame_6FD4DC20;
-int32_t gbWhispReceiverNotListening_6FD4DC24;
-
-
 #pragma pack(push, 1)
 using PlrMsgFunc = void(__fastcall*)(D2GameStrc*, D2UnitStrc*, D2ClientStrc*, int32_t);
 struct D2UnkPlrMsgStrc
@@ -1606,12 +1602,12 @@ void __fastcall D2GAME_PACKETS_HandleWhisper_6FC848A0(D2ClientStrc* pClient, voi
             D2UnitStrc* pLocalPlayer = CLIENTS_GetPlayerFromClient(pClient, 0);
             if (pReceiver && pLocalPlayer && (PLAYERLIST_CheckFlag(pLocalPlayer, pReceiver, 4) || PLAYERLIST_CheckFlag(pReceiver, pLocalPlayer, 2)))
             {
-                gbWhispReceiverNotListening_6FD4DC24 = 1;
+                pPacket26Args->bReceiverNotListening = 1;
                 return;
             }
         }
 
-        gbWhispReceiverInGame_6FD4DC20 = 1;
+        pPacket26Args->bReceiverInGame = 1;
         D2GAME_PACKETS_SendPacket0x26_ServerMessage_6FC3DDF0(pClient, pPacket26Args->pPacket26);
     }
 }
@@ -1692,9 +1688,6 @@ int32_t __fastcall D2GAME_PACKETCALLBACK_Rcv0x15_HandleChatMessage_6FC84950(D2Ga
         pFn = D2GAME_PACKETS_HandlePlayerMessage_6FC847B0;
     }
 
-    gbWhispReceiverInGame_6FD4DC20 = 0;
-    gbWhispReceiverNotListening_6FD4DC24 = 0;
-
     D2GSPacketSrv26Args packet26Args = {};
     
     packet26Args.pPacket26 = &packet26;
@@ -1712,7 +1705,7 @@ int32_t __fastcall D2GAME_PACKETCALLBACK_Rcv0x15_HandleChatMessage_6FC84950(D2Ga
 
     if (packet26.nMessageType == 2)
     {
-        if (gbWhispReceiverNotListening_6FD4DC24)
+        if (packet26Args.bReceiverNotListening)
         {
             D2GSPacketSrv5A packet5A = {};
 
@@ -1726,7 +1719,7 @@ int32_t __fastcall D2GAME_PACKETCALLBACK_Rcv0x15_HandleChatMessage_6FC84950(D2Ga
             return 0;
         }
 
-        if (!gbWhispReceiverInGame_6FD4DC20)
+        if (!packet26Args.bReceiverInGame)
         {
             D2GSPacketSrv5A packet5A = {};
 
@@ -26,6 +26,7 @@
 #include "PLAYER/PlayerStats.h"
 #include "PLAYER/PlrIntro.h"
 #include "PLAYER/PlrSave2.h"
+#include "PLAYER/PlrSaveWriter.h"
 #include "PLAYER/PlrTrade.h"
 #include "QUESTS/Quests.h"
 #include "SKILLS/Skills.h"
@@ -35,7 +36,7 @@
 
 
 int32_t gbWriteSaveFile_6FD30E08;
-int32_t dword_6FD4DC28;
+volatile LONG dword_6FD4DC28; // D2Moo: shared by all the games, incremented with InterlockedIncrement
 
 
 //D2Game.0x6FC895D0 (#10036)
@@ -601,7 +602,7 @@ int32_t __fastcall D2GAME_SAVE_WriteFileOnRealm_6FC8A1B0(D2GameStrc* pGame, D2Un
 
             if (bDataMismatch)
             {
-                ++dword_6FD4DC28;
+                InterlockedIncrement(&dword_6FD4DC28);
 
                 if (gpD2EventCallbackTable_6FD45830 && gpD2EventCallbackTable_6FD45830->pfRelockDatabaseCharacter)
                 {
@@ -706,17 +707,14 @@ int32_t __fastcall D2GAME_SAVE_WriteFile_6FC8A500(D2GameStrc* pGame, D2UnitStrc*
         return 1;
     }
 
-    FILE* pFile = fopen(szFileName, "wb"); // NOLINT(clang-diagnostic-deprecated-declarations)
-    if (pFile)
+    // D2Moo only: the file is written by the save writer thread, whose failed writes are reported by the next save of the character
+    if (!PLRSAVEWRITER_WriteFile(szFileName, pSaveData, nFileSize))
     {
-        FileLockAndWrite(pSaveData, nFileSize, 1u, pFile);
-        fclose(pFile);
-    }
-    else
-    {
-        FOG_Trace("Unable to open player save file %s", szFileName);
+        DWORD dwLastError = 0;
+        const uint32_t nWriteFailures = PLRSAVEWRITER_GetFileWriteFailures(szFileName, &dwLastError);
+        GAME_LogMessage(6, "[SAVE]  %s: unable to write the save file, %u failed writes (error %u)", szName, nWriteFailures, dwLastError);
+        return 0;
     }
-
     return 1;
 }
 
@@ -2236,15 +2234,20 @@ int32_t __fastcall D2GAME_SAVE_ReadFile_6FC8C9D0(D2GameStrc* pGame, D2ClientStrc
     char szFileName[500] = {};
     sprintf_s(szFileName, "%s%s.d2s", szPath, szName);
 
-    FILE* pSaveFile = fopen(szFileName, "rb"); // NOLINT(clang-diagnostic-deprecated-declarations)
-    if (!pSaveFile)
+    uint8_t saveFile[0x2000] = {};
+    // D2Moo only: a save still queued by the save writer thread is newer than the file
+    uint32_t nFileSize = PLRSAVEWRITER_ReadPendingFile(szFileName, saveFile, sizeof(saveFile));
+    if (!nFileSize)
     {
-        return SYSERROR_UNK_14;
-    }
+        FILE* pSaveFile = fopen(szFileName, "rb"); // NOLINT(clang-diagnostic-deprecated-declarations)
+        if (!pSaveFile)
+        {
+            return SYSERROR_UNK_14;
+        }
 
-    uint8_t saveFile[0x2000] = {};
-    const uint32_t nFileSize = FileLockAndRead(saveFile, 1u, 0x2000u, pSaveFile);
-    fclose(pSaveFile);
+        nFileSize = FileLockAndRead(saveFile, 1u, 0x2000u, pSaveFile);
+        fclose(pSaveFile);
+    }
     
     if (!nFileSize)
     {
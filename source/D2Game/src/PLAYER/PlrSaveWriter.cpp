@@ -0,0 +1,418 @@
+#include "PLAYER/PlrSaveWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <io.h>
+
+#include <Fog.h>
+#include <File.h>
+
+
+D2PlrSaveWriterStrc gSaveWriter;
+
+
+// Helper function: Same as the original D2GAME_SAVE_WriteFile_6FC8A500, used when the thread is not running
+static BOOL PLRSAVEWRITER_WriteDirectly(const char* szFileName, const uint8_t* pData, uint32_t nSize)
+{
+    FILE* pFile = fopen(szFileName, "wb"); // NOLINT(clang-diagnostic-deprecated-declarations)
+    if (!pFile)
+    {
+        FOG_Trace("Unable to open player save file %s", szFileName);
+        return FALSE;
+    }
+
+    FileLockAndWrite((void*)pData, nSize, 1u, pFile);
+    fclose(pFile);
+    return TRUE;
+}
+
+// Helper function: Runs on the writer thread, the failures are reported to the game by PLRSAVEWRITER_WriteFile
+static BOOL PLRSAVEWRITER_WriteToDisk(const char* szFileName, const uint8_t* pData, uint32_t nSize, DWORD* pLastError)
+{
+    char szTempFileName[520] = {};
+    sprintf_s(szTempFileName, "%s.tmp", szFileName);
+
+    FILE* pFile = fopen(szTempFileName, "wb"); // NOLINT(clang-diagnostic-deprecated-declarations)
+    if (!pFile)
+    {
+        *pLastError = GetLastError();
+        return FALSE;
+    }
+
+    const BOOL bWritten = FileLockAndWrite((void*)pData, nSize, 1u, pFile) == 1 && fflush(pFile) == 0 && _commit(_fileno(pFile)) == 0;
+    fclose(pFile);
+
+    if (!bWritten || !MoveFileExA(szTempFileName, szFileName, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        *pLastError = bWritten ? GetLastError() : ERROR_WRITE_FAULT;
+        DeleteFileA(szTempFileName);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Helper function: The lock only exists while the thread runs, and nothing changes once it is stopped
+static void PLRSAVEWRITER_Lock(D2PlrSaveWriterStrc* pWriter)
+{
+    if (pWriter->hThread)
+    {
+        EnterCriticalSection(&pWriter->tCriticalSection);
+    }
+}
+
+// Helper function
+static void PLRSAVEWRITER_Unlock(D2PlrSaveWriterStrc* pWriter)
+{
+    if (pWriter->hThread)
+    {
+        LeaveCriticalSection(&pWriter->tCriticalSection);
+    }
+}
+
+// Helper function: Must be called with the lock held
+static D2PlrSaveWriterEntryStrc** PLRSAVEWRITER_FindFailedEntry(D2PlrSaveWriterStrc* pWriter, const char* szFileName)
+{
+    D2PlrSaveWriterEntryStrc** ppEntry = &pWriter->pFailedEntries;
+    while (*ppEntry && _stricmp((*ppEntry)->szFileName, szFileName))
+    {
+        ppEntry = &(*ppEntry)->pNext;
+    }
+    return ppEntry;
+}
+
+static DWORD WINAPI PLRSAVEWRITER_ThreadProc(LPVOID lpParameter)
+{
+    D2PlrSaveWriterStrc* pWriter = (D2PlrSaveWriterStrc*)lpParameter;
+
+    while (true)
+    {
+        // Entries are only appended, so the first one stays first until it is removed below
+        EnterCriticalSection(&pWriter->tCriticalSection);
+        D2PlrSaveWriterEntryStrc* pEntry = pWriter->pFirstEntry;
+        if (pEntry)
+        {
+            pEntry->bWriting = TRUE;
+        }
+        LeaveCriticalSection(&pWriter->tCriticalSection);
+
+        if (!pEntry)
+        {
+            if (pWriter->bShutdown)
+            {
+                break;
+            }
+
+            WaitForSingleObject(pWriter->hWakeEvent, INFINITE);
+            continue;
+        }
+
+        DWORD dwLastError = 0;
+        const BOOL bWritten = PLRSAVEWRITER_WriteToDisk(pEntry->szFileName, pEntry->pData, pEntry->nSize, &dwLastError);
+
+        LARGE_INTEGER tWrittenTime = {};
+        QueryPerformanceCounter(&tWrittenTime);
+        const uint64_t nElapsedUs = (uint64_t)(tWrittenTime.QuadPart - pEntry->tQueuedTime.QuadPart) * 1000000 / pWriter->tPerformanceFrequency.QuadPart;
+
+        EnterCriticalSection(&pWriter->tCriticalSection);
+        pWriter->pFirstEntry = pEntry->pNext;
+        if (!pWriter->pFirstEntry)
+        {
+            pWriter->pLastEntry = nullptr;
+        }
+
+        --pWriter->tStats.nQueueDepth;
+        D2PlrSaveWriterEntryStrc** ppFailedEntry = PLRSAVEWRITER_FindFailedEntry(pWriter, pEntry->szFileName);
+        D2PlrSaveWriterEntryStrc* pFailedEntry = *ppFailedEntry;
+        if (bWritten)
+        {
+            pWriter->aLatenciesUs[pWriter->tStats.nWritesCount % PLRSAVEWRITER_LATENCY_SAMPLES] = (uint32_t)std::min<uint64_t>(nElapsedUs, UINT32_MAX);
+            ++pWriter->tStats.nWritesCount;
+
+            // The file is up to date again
+            if (pFailedEntry)
+            {
+                *ppFailedEntry = pFailedEntry->pNext;
+                pFailedEntry->pNext = pWriter->pFreeEntries;
+                pWriter->pFreeEntries = pFailedEntry;
+            }
+            pEntry->pNext = pWriter->pFreeEntries;
+            pWriter->pFreeEntries = pEntry;
+        }
+        else
+        {
+            ++pWriter->tStats.nFailedCount;
+
+            // The entry is kept with the data that could not be written, in place of the previous failure of the file
+            pEntry->nFailures = pFailedEntry ? pFailedEntry->nFailures + 1 : 1;
+            pEntry->dwLastError = dwLastError;
+            if (pFailedEntry)
+            {
+                pEntry->pNext = pFailedEntry->pNext;
+                pFailedEntry->pNext = pWriter->pFreeEntries;
+                pWriter->pFreeEntries = pFailedEntry;
+            }
+            else
+            {
+                pEntry->pNext = nullptr;
+            }
+            *ppFailedEntry = pEntry;
+        }
+        LeaveCriticalSection(&pWriter->tCriticalSection);
+    }
+
+    return 0;
+}
+
+// Helper function
+BOOL __fastcall PLRSAVEWRITER_StartThread(D2PlrSaveWriterStrc* pWriter)
+{
+    QueryPerformanceFrequency(&pWriter->tPerformanceFrequency);
+    InitializeCriticalSection(&pWriter->tCriticalSection);
+    pWriter->bShutdown = FALSE;
+    pWriter->hWakeEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    pWriter->hThread = CreateThread(nullptr, 0, PLRSAVEWRITER_ThreadProc, pWriter, 0, nullptr);
+    if (!pWriter->hThread)
+    {
+        CloseHandle(pWriter->hWakeEvent);
+        DeleteCriticalSection(&pWriter->tCriticalSection);
+        pWriter->hWakeEvent = nullptr;
+        return FALSE;
+    }
+
+    SetThreadDescription(pWriter->hThread, L"D2GameSaveWriterThread");
+    return TRUE;
+}
+
+// Helper function
+void __fastcall PLRSAVEWRITER_StopThread(D2PlrSaveWriterStrc* pWriter)
+{
+    // The thread only stops once the queue is empty
+    InterlockedExchange(&pWriter->bShutdown, TRUE);
+    SetEvent(pWriter->hWakeEvent);
+    WaitForSingleObject(pWriter->hThread, INFINITE);
+
+    CloseHandle(pWriter->hThread);
+    CloseHandle(pWriter->hWakeEvent);
+    DeleteCriticalSection(&pWriter->tCriticalSection);
+    pWriter->hThread = nullptr;
+    pWriter->hWakeEvent = nullptr;
+}
+
+// Helper function
+BOOL __fastcall PLRSAVEWRITER_QueueFile(D2PlrSaveWriterStrc* pWriter, const char* szFileName, const uint8_t* pData, uint32_t nSize)
+{
+    D2_ASSERT(nSize <= PLRSAVEWRITER_MAX_SAVE_SIZE);
+
+    EnterCriticalSection(&pWriter->tCriticalSection);
+    const BOOL bLastWriteSucceeded = *PLRSAVEWRITER_FindFailedEntry(pWriter, szFileName) == nullptr;
+    for (D2PlrSaveWriterEntryStrc* pEntry = pWriter->pFirstEntry; pEntry; pEntry = pEntry->pNext)
+    {
+        if (!pEntry->bWriting && !_stricmp(pEntry->szFileName, szFileName))
+        {
+            // Keeps its place in the queue and its queuing time, so that a character saved continuously still gets written
+            memcpy(pEntry->pData, pData, nSize);
+            pEntry->nSize = nSize;
+            ++pWriter->tStats.nCoalescedCount;
+            LeaveCriticalSection(&pWriter->tCriticalSection);
+            return bLastWriteSucceeded;
+        }
+    }
+
+    D2PlrSaveWriterEntryStrc* pNewEntry = pWriter->pFreeEntries;
+    if (pNewEntry)
+    {
+        pWriter->pFreeEntries = pNewEntry->pNext;
+    }
+    LeaveCriticalSection(&pWriter->tCriticalSection);
+
+    if (!pNewEntry)
+    {
+        pNewEntry = D2_ALLOC_STRC(D2PlrSaveWriterEntryStrc);
+    }
+    pNewEntry->pNext = nullptr;
+    pNewEntry->bWriting = FALSE;
+    QueryPerformanceCounter(&pNewEntry->tQueuedTime);
+    pNewEntry->nFailures = 0;
+    pNewEntry->dwLastError = 0;
+    strcpy_s(pNewEntry->szFileName, szFileName);
+    pNewEntry->nSize = nSize;
+    memcpy(pNewEntry->pData, pData, nSize);
+
+    EnterCriticalSection(&pWriter->tCriticalSection);
+    if (pWriter->pLastEntry)
+    {
+        pWriter->pLastEntry->pNext = pNewEntry;
+    }
+    else
+    {
+        pWriter->pFirstEntry = pNewEntry;
+    }
+    pWriter->pLastEntry = pNewEntry;
+
+    ++pWriter->tStats.nQueueDepth;
+    pWriter->tStats.nPeakQueueDepth = std::max(pWriter->tStats.nPeakQueueDepth, pWriter->tStats.nQueueDepth);
+    LeaveCriticalSection(&pWriter->tCriticalSection);
+
+    SetEvent(pWriter->hWakeEvent);
+    return bLastWriteSucceeded;
+}
+
+// Helper function
+uint32_t __fastcall PLRSAVEWRITER_ReadQueuedFile(D2PlrSaveWriterStrc* pWriter, const char* szFileName, uint8_t* pBuffer, uint32_t nBufferSize)
+{
+    uint32_t nSize = 0;
+    PLRSAVEWRITER_Lock(pWriter);
+    // The newest save of the file is the last one of the queue
+    for (D2PlrSaveWriterEntryStrc* pEntry = pWriter->pFirstEntry; pEntry; pEntry = pEntry->pNext)
+    {
+        if (!_stricmp(pEntry->szFileName, szFileName))
+        {
+            nSize = std::min(pEntry->nSize, nBufferSize);
+            memcpy(pBuffer, pEntry->pData, nSize);
+        }
+    }
+    PLRSAVEWRITER_Unlock(pWriter);
+
+    return nSize;
+}
+
+// Helper function
+uint32_t __fastcall PLRSAVEWRITER_GetWriteFailures(D2PlrSaveWriterStrc* pWriter, const char* szFileName, DWORD* pLastError)
+{
+    PLRSAVEWRITER_Lock(pWriter);
+    const D2PlrSaveWriterEntryStrc* pFailedEntry = *PLRSAVEWRITER_FindFailedEntry(pWriter, szFileName);
+    const uint32_t nFailures = pFailedEntry ? pFailedEntry->nFailures : 0;
+    *pLastError = pFailedEntry ? pFailedEntry->dwLastError : 0;
+    PLRSAVEWRITER_Unlock(pWriter);
+
+    return nFailures;
+}
+
+// Helper function
+void __fastcall PLRSAVEWRITER_GetWriterStats(D2PlrSaveWriterStrc* pWriter, D2PlrSaveWriterStatsStrc* pStats)
+{
+    uint32_t aLatenciesUs[PLRSAVEWRITER_LATENCY_SAMPLES];
+    PLRSAVEWRITER_Lock(pWriter);
+    *pStats = pWriter->tStats;
+    const uint32_t nSamples = std::min<uint32_t>(pWriter->tStats.nWritesCount, PLRSAVEWRITER_LATENCY_SAMPLES);
+    memcpy(aLatenciesUs, pWriter->aLatenciesUs, nSamples * sizeof(uint32_t));
+    PLRSAVEWRITER_Unlock(pWriter);
+
+    if (!nSamples)
+    {
+        return;
+    }
+
+    std::sort(aLatenciesUs, aLatenciesUs + nSamples);
+    pStats->nWriteTimeP50Us = aLatenciesUs[(nSamples - 1) * 50 / 100];
+    pStats->nWriteTimeP99Us = aLatenciesUs[(nSamples - 1) * 99 / 100];
+    pStats->nWriteTimeMaxUs = aLatenciesUs[nSamples - 1];
+}
+
+// Helper function
+void __fastcall PLRSAVEWRITER_Initialize()
+{
+    if (gSaveWriter.hThread)
+    {
+        return;
+    }
+
+    char* szValue = nullptr;
+    size_t nBufferSize = 0;
+    if (0 == _dupenv_s(&szValue, &nBufferSize, "D2_SAVE_WRITER_THREAD") && szValue)
+    {
+        const BOOL bEnabled = atoi(szValue) != 0;
+        free(szValue);
+        if (!bEnabled)
+        {
+            return;
+        }
+    }
+
+    memset(&gSaveWriter, 0x00, sizeof(gSaveWriter));
+    PLRSAVEWRITER_StartThread(&gSaveWriter);
+}
+
+// Helper function
+void __fastcall PLRSAVEWRITER_Release()
+{
+    if (!gSaveWriter.hThread)
+    {
+        return;
+    }
+
+    PLRSAVEWRITER_StopThread(&gSaveWriter);
+
+    D2PlrSaveWriterStatsStrc tStats = {};
+    PLRSAVEWRITER_GetWriterStats(&gSaveWriter, &tStats);
+    PLRSAVEWRITER_TraceStats("Release", &tStats);
+
+    for (D2PlrSaveWriterEntryStrc* pEntry = gSaveWriter.pFailedEntries; pEntry; pEntry = gSaveWriter.pFailedEntries)
+    {
+        FOG_Trace("[SAVE WRITER]  Release:  %s was not saved, %u failed writes (error %u)", pEntry->szFileName, pEntry->nFailures, pEntry->dwLastError);
+        gSaveWriter.pFailedEntries = pEntry->pNext;
+        D2_FREE(pEntry);
+    }
+
+    while (D2PlrSaveWriterEntryStrc* pEntry = gSaveWriter.pFreeEntries)
+    {
+        gSaveWriter.pFreeEntries = pEntry->pNext;
+        D2_FREE(pEntry);
+    }
+}
+
+// Helper function
+BOOL __fastcall PLRSAVEWRITER_WriteFile(const char* szFileName, const uint8_t* pData, uint32_t nSize)
+{
+    if (!gSaveWriter.hThread)
+    {
+        return PLRSAVEWRITER_WriteDirectly(szFileName, pData, nSize);
+    }
+
+    return PLRSAVEWRITER_QueueFile(&gSaveWriter, szFileName, pData, nSize);
+}
+
+// Helper function
+uint32_t __fastcall PLRSAVEWRITER_ReadPendingFile(const char* szFileName, uint8_t* pBuffer, uint32_t nBufferSize)
+{
+    if (!gSaveWriter.hThread)
+    {
+        return 0;
+    }
+
+    return PLRSAVEWRITER_ReadQueuedFile(&gSaveWriter, szFileName, pBuffer, nBufferSize);
+}
+
+// Helper function
+uint32_t __fastcall PLRSAVEWRITER_GetFileWriteFailures(const char* szFileName, DWORD* pLastError)
+{
+    if (!gSaveWriter.hThread)
+    {
+        *pLastError = 0;
+        return 0;
+    }
+
+    return PLRSAVEWRITER_GetWriteFailures(&gSaveWriter, szFileName, pLastError);
+}
+
+// Helper function
+void __fastcall PLRSAVEWRITER_GetStats(D2PlrSaveWriterStatsStrc* pStats)
+{
+    memset(pStats, 0x00, sizeof(D2PlrSaveWriterStatsStrc));
+    if (!gSaveWriter.hThread)
+    {
+        return;
+    }
+
+    PLRSAVEWRITER_GetWriterStats(&gSaveWriter, pStats);
+}
+
+// Helper function
+void __fastcall PLRSAVEWRITER_TraceStats(const char* szContext, const D2PlrSaveWriterStatsStrc* pStats)
+{
+    FOG_Trace("[SAVE WRITER]  %s:  queued:%u (peak %u)  written:%u  coalesced:%u  failed:%u  write time p50:%uus p99:%uus max:%uus",
+        szContext, pStats->nQueueDepth, pStats->nPeakQueueDepth, pStats->nWritesCount, pStats->nCoalescedCount, pStats->nFailedCount,
+        pStats->nWriteTimeP50Us, pStats->nWriteTimeP99Us, pStats->nWriteTimeMaxUs);
+}
@@ -409,7 +409,7 @@ int32_t __fastcall PLRTRADE_CheckCubeInput(D2GameStrc* pGame, D2InventoryStrc* p
                             {
                                 if (pItemsTxtRecord->dwUberCode != '    ')
                                 {
-                                    const int32_t nClassId = FOG_GetLinkIndex(sgptDataTables->pItemsLinker, pItemsTxtRecord->dwUberCode, 0);
+                                    const int32_t nClassId = DATATBLS_GetItemIdFromItemCode(pItemsTxtRecord->dwUberCode);
                                     if (nClassId >= 0)
                                     {
                                         D2ItemsTxt* pLinkItemsTxtRecord = DATATBLS_GetItemsTxtRecord(nClassId);
@@ -424,7 +424,7 @@ int32_t __fastcall PLRTRADE_CheckCubeInput(D2GameStrc* pGame, D2InventoryStrc* p
                             {
                                 if (pItemsTxtRecord->dwUltraCode != '    ')
                                 {
-                                    const int32_t nClassId = FOG_GetLinkIndex(sgptDataTables->pItemsLinker, pItemsTxtRecord->dwUltraCode, 0);
+                                    const int32_t nClassId = DATATBLS_GetItemIdFromItemCode(pItemsTxtRecord->dwUltraCode);
                                     if (nClassId >= 0)
                                     {
                                         D2ItemsTxt* pLinkItemsTxtRecord = DATATBLS_GetItemsTxtRecord(nClassId);
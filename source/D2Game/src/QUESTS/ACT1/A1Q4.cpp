@@ -918,7 +918,7 @@ int32_t __fastcall OBJECTS_OperateFunction12_InifussTree(D2ObjOperateFnStrc* pOp
 	D2UnitStrc* pItem = D2GAME_DropItemAtUnit_6FC4FEC0(pOp->pGame, pObject, ITEMQUAL_NORMAL, &nItemLevel, 0, -1, 0);
 	if (pItem)
 	{
-		pQuestData->pfCallback[QUESTEVENT_PLAYERDROPPEDWITHQUESTITEM] = ACT1Q4_Callback09_PlayerDroppedWithQuestItem;
+		QUESTS_SetCallback(pQuestData, QUESTEVENT_PLAYERDROPPEDWITHQUESTITEM, ACT1Q4_Callback09_PlayerDroppedWithQuestItem);
 		pQuestData->dwFlags &= 0xFFFFFF00;
 		QUESTS_UnitIterate(pQuestData, 2, pOp->pPlayer, ACT1Q4_UnitIterate_StatusCyclerEx, 1);
 		pQuestDataEx->unk0x4B = 1;
@@ -704,7 +704,7 @@ void __fastcall ACT1Q5_Callback08_MonsterKilled(D2QuestDataStrc* pQuestData, D2Q
 
 		if (pQuestDataEx->nUnitCount2)
 		{
-			pQuestData->pfCallback[QUESTEVENT_PLAYERLEAVESGAME] = ACT1Q5_Callback10_PlayerLeavesGame;
+			QUESTS_SetCallback(pQuestData, QUESTEVENT_PLAYERLEAVESGAME, ACT1Q5_Callback10_PlayerLeavesGame);
 		}
 		else
 		{
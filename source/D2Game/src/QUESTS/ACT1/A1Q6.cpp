@@ -572,7 +572,7 @@ void __fastcall ACT1Q6_Callback08_MonsterKilled(D2QuestDataStrc* pQuestData, D2Q
 
 	pQuestDataEx->bAndarielKilled = 1;
 	QUESTS_StateDebug(pQuestData, 4, __FILE__, __LINE__);
-	pQuestData->pfCallback[QUESTEVENT_PLAYERLEAVESGAME] = ACT1Q6_Callback10_PlayerLeavesGame;
+	QUESTS_SetCallback(pQuestData, QUESTEVENT_PLAYERLEAVESGAME, ACT1Q6_Callback10_PlayerLeavesGame);
 	pQuestData->pfCallback[QUESTEVENT_MONSTERKILLED] = nullptr;
 }
 
@@ -618,7 +618,7 @@ void __fastcall ACT2Q6_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 
 				pQuestDataEx->bPortalToLutGholeinOpened = 1;
 				pQuestDataEx->bTyraelActivated = 1;
-				pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT2Q6_Callback02_NpcDeactivate;
+				QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT2Q6_Callback02_NpcDeactivate);
 			}
 
 			pQuestDataEx->bPortalIsOpening = 0;
@@ -632,7 +632,7 @@ void __fastcall ACT2Q6_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 			QUESTS_StateDebug(pQuestData, 2, __FILE__, __LINE__);
 			D2QuestDataStrc* pQuest = QUESTS_GetQuestData(pQuestData->pGame, QUEST_A2Q3_TAINTEDSUN);
 			pQuestDataEx->bInitJerhynActivated = 1;
-			pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT2Q6_Callback02_NpcDeactivate;
+			QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT2Q6_Callback02_NpcDeactivate);
 			if (pQuest)
 			{
 				if (IsBadCodePtr((FARPROC)pQuestData->pfSeqFilter))
@@ -652,7 +652,7 @@ void __fastcall ACT2Q6_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 					QUESTS_StateDebug(pQuestData, 5, __FILE__, __LINE__);
 				}
 				pQuestDataEx->bEndJerhynActivated = 1;
-				pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT2Q6_Callback02_NpcDeactivate;
+				QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT2Q6_Callback02_NpcDeactivate);
 				QUESTRECORD_SetQuestState(pQuestFlags, QUESTSTATEFLAG_A2Q6, QFLAG_ENTERAREA);
 				QUESTRECORD_ClearQuestState(pQuestFlags, QUESTSTATEFLAG_A2Q6, QFLAG_LEAVETOWN);
 				QUESTS_NPCActivateSpeeches(pQuestArg->pGame, pQuestArg->pPlayer, pQuestArg->pTarget);
@@ -82,7 +82,7 @@ void __fastcall ACT2Q7_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 	if (pQuestArg->nMessageIndex == 59 || pQuestArg->nMessageIndex == 60)
 	{
 		QUESTRECORD_SetQuestState(pQuestFlags, QUESTSTATEFLAG_A2Q7, QFLAG_PRIMARYGOALDONE);
-		pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT2Q7_Callback02_NpcDeactivate;
+		QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT2Q7_Callback02_NpcDeactivate);
 	}
 	else
 	{
@@ -138,8 +138,8 @@ int32_t __fastcall OBJECTS_OperateFunction28_LamEsenTome(D2ObjOperateFnStrc* pOp
 	pQuestDataEx->nTomeObjectMode = OBJMODE_OPENED;
 	pQuestDataEx->nTomeGUID = pObject->dwUnitId;
 
-	pQuestData->pfCallback[QUESTEVENT_NPCACTIVATE] = ACT3Q1_Callback00_NpcActivate;
-	pQuestData->pfCallback[QUESTEVENT_SCROLLMESSAGE] = ACT3Q1_Callback11_ScrollMessage;
+	QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCACTIVATE, ACT3Q1_Callback00_NpcActivate);
+	QUESTS_SetCallback(pQuestData, QUESTEVENT_SCROLLMESSAGE, ACT3Q1_Callback11_ScrollMessage);
 
 	if (pQuestData->fState != 3)
 	{
@@ -246,7 +246,7 @@ void __fastcall ACT3Q1_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 
 			pQuestDataEx->nPlayerWithTomeGUID = pQuestArg->pPlayer ? pQuestArg->pPlayer->dwUnitId : -1;
 
-			pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q1_Callback02_NpcDeactivate;
+			QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q1_Callback02_NpcDeactivate);
 		}
 
 		if (pQuestDataEx->bCanGetReward == 1)
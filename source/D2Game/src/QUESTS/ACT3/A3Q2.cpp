@@ -444,7 +444,7 @@ void __fastcall ACT3Q2_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 			QUESTS_StateDebug(pQuestData, 2, __FILE__, __LINE__);
 			QUESTRECORD_SetQuestState(pQuestFlags, QUESTSTATEFLAG_A3Q2, QFLAG_STARTED);
 			((D2Act3Quest2Strc*)pQuestData->pQuestDataEx)->bInitiallyTalkedToCain = 1;
-			pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q2_Callback02_NpcDeactivate;
+			QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q2_Callback02_NpcDeactivate);
 			break;
 
 		case 545:
@@ -897,7 +897,7 @@ bool __fastcall ACT3Q3_SpawnGidbinnBoss(D2GameStrc* pGame, D2QuestDataStrc* pQue
 					pQuestDataEx->nFetishBossGUID = pFetishBoss->dwUnitId;
 				}
 				pQuestDataEx->bBossIsSpawning = 0;
-				pQuestData->pfCallback[QUESTEVENT_MONSTERKILLED] = ACT3Q3_Callback08_MonsterKilled;
+				QUESTS_SetCallback(pQuestData, QUESTEVENT_MONSTERKILLED, ACT3Q3_Callback08_MonsterKilled);
 			}
 		}
 	}
@@ -347,7 +347,7 @@ void __fastcall ACT3Q4_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 			{
 				QUESTS_StateDebug(pQuestData, 2, __FILE__, __LINE__);
 				pQuestDataEx->bTalkedToCainOnce = 1;
-				pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q4_Callback02_NpcDeactivate;
+				QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q4_Callback02_NpcDeactivate);
 			}
 			QUESTS_NPCActivateSpeeches(pQuestArg->pGame, pQuestArg->pPlayer, pQuestArg->pTarget);
 			pQuestDataEx->nCurrentQuestFlag = QFLAG_STARTED;
@@ -390,7 +390,7 @@ void __fastcall ACT3Q4_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 
 				QUESTRECORD_SetQuestState(pQuestFlags, QUESTSTATEFLAG_A3Q4, QFLAG_REWARDPENDING);
 				pQuestDataEx->bTalkedToAlkor = 1;
-				pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q4_Callback02_NpcDeactivate;
+				QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q4_Callback02_NpcDeactivate);
 				pQuestDataEx->nCurrentQuestFlag = QFLAG_REWARDPENDING;
 				
 				const int16_t nPartyId = SUNIT_GetPartyId(pQuestArg->pPlayer);
@@ -443,7 +443,7 @@ void __fastcall ACT3Q4_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 		{
 			if (ITEMS_FindQuestItem(pQuestArg->pGame, pQuestArg->pPlayer, ' 43j'))
 			{
-				pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q4_Callback02_NpcDeactivate;
+				QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q4_Callback02_NpcDeactivate);
 				QUESTS_DeleteItem(pQuestArg->pGame, pQuestArg->pPlayer, ' 43j');
 				--pQuestDataEx->nGoldenBirdsInGame;
 				if (QUESTS_CreateItem(pQuestArg->pGame, pQuestArg->pPlayer, ' 43g', 0, ITEMQUAL_NORMAL, 1))
@@ -451,7 +451,7 @@ void __fastcall ACT3Q4_Callback11_ScrollMessage(D2QuestDataStrc* pQuestData, D2Q
 					++pQuestDataEx->nGoldenBirdsInGame;
 					QUESTS_StateDebug(pQuestData, 3, __FILE__, __LINE__);
 					pQuestDataEx->bTalkedToMeshif = 1;
-					pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q4_Callback02_NpcDeactivate;
+					QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q4_Callback02_NpcDeactivate);
 				}
 			}
 		}
@@ -704,7 +704,7 @@ int32_t __fastcall ACT3Q4_UnitIterate_SetGoldenBirdBoss(D2QuestDataStrc* pQuestD
 	}
 
 	QUESTS_CreateChainRecord(pQuestData->pGame, pUnit, QUEST_A3Q4_GOLDENBIRD);
-	pQuestData->pfCallback[QUESTEVENT_MONSTERKILLED] = ACT3Q4_Callback08_MonsterKilled;
+	QUESTS_SetCallback(pQuestData, QUESTEVENT_MONSTERKILLED, ACT3Q4_Callback08_MonsterKilled);
 	pQuestDataEx->unk0x01 = 0;
 	pQuestDataEx->unk0x02 = 1;
 
@@ -514,7 +514,7 @@ void __fastcall ACT3Q5_Callback03_ChangedLevel(D2QuestDataStrc* pQuestData, D2Qu
 	if (pQuestArg->nNewLevel == LEVEL_KURASTCAUSEWAY && pQuestData->bNotIntro && !pQuestData->fState)
 	{
 		pQuestData->fState = 1;
-		pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q5_Callback02_NpcDeactivate;
+		QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q5_Callback02_NpcDeactivate);
 	}
 
 	if (pQuestArg->nOldLevel != LEVEL_KURASTDOCKTOWN)
@@ -316,7 +316,7 @@ void __fastcall ACT3Q6_Callback03_ChangedLevel(D2QuestDataStrc* pQuestData, D2Qu
 	if (pQuestArg->nNewLevel >= LEVEL_RUINEDFANE && pQuestData->bNotIntro && !pQuestData->fState)
 	{
 		pQuestData->fState = 1;
-		pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q6_Callback02_NpcDeactivate;
+		QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q6_Callback02_NpcDeactivate);
 	}
 
 	if (pQuestArg->nNewLevel == LEVEL_DURANCEOFHATELEV1)
@@ -517,7 +517,7 @@ void __fastcall ACT3Q6_Callback08_MonsterKilled(D2QuestDataStrc* pQuestData, D2Q
 	QUESTS_StateDebug(pQuestData, 6, __FILE__, __LINE__);
 
 	D2Act3Quest6Strc* pQuestDataEx = (D2Act3Quest6Strc*)pQuestData->pQuestDataEx;
-	pQuestData->pfCallback[QUESTEVENT_PLAYERLEAVESGAME] = ACT3Q6_Callback10_PlayerLeavesGame;
+	QUESTS_SetCallback(pQuestData, QUESTEVENT_PLAYERLEAVESGAME, ACT3Q6_Callback10_PlayerLeavesGame);
 	if (pQuestData->bNotIntro)
 	{
 		if (pQuestArg->pPlayer)
@@ -673,7 +673,7 @@ bool __fastcall ACT3Q6_SeqCallback(D2QuestDataStrc* pQuestData)
 	if (!pQuestData->fState && pQuestData->bNotIntro)
 	{
 		pQuestData->fState = 1;
-		pQuestData->pfCallback[QUESTEVENT_NPCDEACTIVATE] = ACT3Q6_Callback02_NpcDeactivate;
+		QUESTS_SetCallback(pQuestData, QUESTEVENT_NPCDEACTIVATE, ACT3Q6_Callback02_NpcDeactivate);
 	}
 
 	return true;
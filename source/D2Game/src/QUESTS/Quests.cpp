@@ -404,6 +404,26 @@ void __fastcall QUESTS_QuestInit(D2GameStrc* pGame)
 
 	pQuestInfo->pQuestFlags = QUESTRECORD_AllocRecord(pGame->pMemoryPool);
 
+	// D2Moo only
+	D2QuestSubscribersStrc* pSubscribers = D2_CALLOC_STRC_POOL(pGame->pMemoryPool, D2QuestSubscribersStrc);
+	for (D2QuestDataStrc* pQuest = pQuestInfo->pLastQuest; pQuest; pQuest = pQuest->pPrev)
+	{
+		D2_ASSERT(pSubscribers->nQuests < QUESTSUBSCRIBERS_MAX_QUESTS && pQuest->nActNo < QUESTSUBSCRIBERS_ACTS);
+
+		const uint64_t nQuestMask = 1ull << pSubscribers->nQuests;
+		for (int32_t nEvent = 0; nEvent < QUESTSUBSCRIBERS_EVENTS; ++nEvent)
+		{
+			if (pQuest->pfCallback[nEvent])
+			{
+				pSubscribers->nEventQuests[nEvent] |= nQuestMask;
+			}
+		}
+		pSubscribers->nActQuests[pQuest->nActNo] |= nQuestMask;
+		pSubscribers->pQuests[pSubscribers->nQuests] = pQuest;
+		++pSubscribers->nQuests;
+	}
+	pQuestInfo->pSubscribers = pSubscribers;
+
 	pGame->pQuestControl = pQuestInfo;
 }
 
@@ -438,6 +458,21 @@ void __fastcall QUESTS_QuestFree(D2GameStrc* pGame)
 	}
 
 	QUESTRECORD_FreeRecord(pGame->pMemoryPool, pQuestControl->pQuestFlags);
+	if (pQuestControl->pSubscribers)
+	{
+		// D2Moo only: reports how many quests each dispatched event checked, compared to the full walk of the quest list
+		for (int32_t nEvent = 0; nEvent < QUESTSUBSCRIBERS_EVENTS; ++nEvent)
+		{
+			D2QuestEventStatsStrc tStats = {};
+			if (QUESTS_GetEventStats(pGame, nEvent, &tStats) && tStats.nDispatchCount)
+			{
+				FOG_Trace("[QUEST EVENTS]  event %d:  dispatched:%u  quests:%u  scanned:%u  invoked:%u",
+					nEvent, tStats.nDispatchCount, tStats.nQuestCount, tStats.nScannedCount, tStats.nInvokedCount);
+			}
+		}
+
+		D2_FREE_POOL(pGame->pMemoryPool, pQuestControl->pSubscribers);
+	}
 	D2_FREE_POOL(pGame->pMemoryPool, pQuestControl);
 }
 
@@ -586,10 +621,32 @@ void __fastcall QUESTS_EventCallback(D2QuestArgStrc* pArgs, bool bCheckActive, b
 		}
 	}
 
-	D2QuestDataStrc* pQuestData = pArgs->pGame->pQuestControl->pLastQuest;
-	while(pQuestData)
+	// D2Moo only: walks the quests that registered a callback for the event, in the order of the quest list.
+	// The mask is read again after each callback, so that quests registering during the dispatch are still called when they come later in the list.
+	D2QuestSubscribersStrc* pSubscribers = pArgs->pGame->pQuestControl->pSubscribers;
+	D2_ASSERT(pArgs->nEvent >= 0 && pArgs->nEvent < QUESTSUBSCRIBERS_EVENTS);
+
+	uint64_t nActMask = ~0ull;
+	if (nAct != -1)
+	{
+		nActMask = nAct >= 0 && nAct < QUESTSUBSCRIBERS_ACTS ? pSubscribers->nActQuests[nAct] : 0;
+	}
+
+	D2QuestEventStatsStrc* pStats = &pSubscribers->tStats[pArgs->nEvent];
+	++pStats->nDispatchCount;
+	pStats->nQuestCount += pSubscribers->nQuests;
+
+	uint64_t nQuestMask = pSubscribers->nEventQuests[pArgs->nEvent] & nActMask;
+	for (int32_t nSlot = 0; nSlot < pSubscribers->nQuests && (nQuestMask >> nSlot); ++nSlot)
 	{
-		if (pQuestData->pfCallback[pArgs->nEvent] && (bCheckActive || pQuestData->bActive) && (nAct == -1 || nAct == pQuestData->nActNo))
+		if (!((nQuestMask >> nSlot) & 1))
+		{
+			continue;
+		}
+
+		D2QuestDataStrc* pQuestData = pSubscribers->pQuests[nSlot];
+		++pStats->nScannedCount;
+		if (pQuestData->pfCallback[pArgs->nEvent] && (bCheckActive || pQuestData->bActive))
 		{
 			if (IsBadCodePtr((FARPROC)pQuestData->pfCallback[pArgs->nEvent]))
 			{
@@ -597,11 +654,48 @@ void __fastcall QUESTS_EventCallback(D2QuestArgStrc* pArgs, bool bCheckActive, b
 				exit(-1);
 			}
 
+			++pStats->nInvokedCount;
 			pQuestData->pfCallback[pArgs->nEvent](pQuestData, pArgs);
+			nQuestMask = pSubscribers->nEventQuests[pArgs->nEvent] & nActMask;
 		}
+	}
+}
+
+// Helper function
+void __fastcall QUESTS_SetCallback(D2QuestDataStrc* pQuest, int32_t nEvent, QUESTCALLBACK pfCallback)
+{
+	D2_ASSERT(nEvent >= 0 && nEvent < QUESTSUBSCRIBERS_EVENTS);
 
-		pQuestData = pQuestData->pPrev;
+	pQuest->pfCallback[nEvent] = pfCallback;
+
+	if (!pfCallback || !pQuest->pGame || !pQuest->pGame->pQuestControl)
+	{
+		// Quests being initialized are registered by QUESTS_QuestInit
+		return;
 	}
+
+	D2QuestSubscribersStrc* pSubscribers = pQuest->pGame->pQuestControl->pSubscribers;
+	for (int32_t nSlot = 0; nSlot < pSubscribers->nQuests; ++nSlot)
+	{
+		if (pSubscribers->pQuests[nSlot] == pQuest)
+		{
+			pSubscribers->nEventQuests[nEvent] |= 1ull << nSlot;
+			return;
+		}
+	}
+}
+
+// Helper function
+BOOL __fastcall QUESTS_GetEventStats(D2GameStrc* pGame, int32_t nEvent, D2QuestEventStatsStrc* pStats)
+{
+	memset(pStats, 0x00, sizeof(D2QuestEventStatsStrc));
+	if (!pGame || !pGame->pQuestControl || nEvent < 0 || nEvent >= QUESTSUBSCRIBERS_EVENTS)
+	{
+		return FALSE;
+	}
+
+	*pStats = pGame->pQuestControl->pSubscribers->tStats[nEvent];
+	return TRUE;
 }
 
 //D2Game.0x6FC94390
@@ -109,6 +109,7 @@ void __fastcall SUNIT_RemoveUnit(D2GameStrc* pGame, D2UnitStrc* pUnit)
     else
     {
         ppUnitList = SUNIT_GetUnitList(pUnit->dwUnitType, pGame, pUnit->dwUnitId);
+        SUNITGUIDINDEX_Remove(&pGame->tUnitGuidIndex[GAME_RemapUnitTypeToListIndex((D2C_UnitTypes)pUnit->dwUnitType)], pUnit);
     }
 
     D2UnitStrc* pPrevious = nullptr;
@@ -595,6 +596,12 @@ D2UnitStrc* __fastcall SUNIT_GetServerUnit(D2GameStrc* pGame, int32_t nUnitType,
     }
     else
     {
+        // D2Moo only: same result as walking the list, without the pointer chasing
+        if (nUnitType >= UNIT_PLAYER && nUnitType < UNIT_TILE)
+        {
+            return SUNITGUIDINDEX_Find(&pGame->tUnitGuidIndex[GAME_RemapUnitTypeToListIndex((D2C_UnitTypes)nUnitType)], nUnitGUID);
+        }
+
         ppUnitList = SUNIT_GetUnitList(nUnitType, pGame, nUnitGUID);
     }
 
@@ -752,6 +759,11 @@ void __fastcall SUNIT_Add(D2UnitStrc* pUnit, int32_t nX, int32_t nY, D2GameStrc*
         *ppUnitList = pUnit;
     }
 
+    if (pUnit->dwUnitType != UNIT_TILE)
+    {
+        SUNITGUIDINDEX_Insert(pGame->pMemoryPool, &pGame->tUnitGuidIndex[GAME_RemapUnitTypeToListIndex((D2C_UnitTypes)pUnit->dwUnitType)], pUnit);
+    }
+
     if (UNITS_GetRoom(pUnit))
     {
         UNITROOM_RefreshUnit(pUnit);
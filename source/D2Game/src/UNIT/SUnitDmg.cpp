@@ -1949,7 +1949,7 @@ void __fastcall SUNITDMG_ExecuteMissileDamage(D2GameStrc* pGame, D2UnitStrc* pAt
 	{
 		if (!pDamage->nHitClassActiveSet && !(pDamage->dwHitClass & 0xF0))
 		{
-			pDamage->dwHitClass = SUNITDMG_GetHitClass(pDamage, pDamage->dwHitClass);
+			pDamage->dwHitClass = SUNITDMG_GetHitClass(pGame, pDamage, pDamage->dwHitClass);
 		}
 		pUnit->dwLastHitClass = pDamage->dwHitClass;
 	}
@@ -2225,7 +2225,7 @@ int32_t __fastcall sub_6FCC1870(D2UnitStrc* pUnit, D2DamageStrc* pDamage, int32_
 }
 
 //D2Game.0x6FCC1A50
-int32_t __fastcall SUNITDMG_GetHitClass(D2DamageStrc* pDamage, uint32_t nBaseHitClass)
+int32_t __fastcall SUNITDMG_GetHitClass(D2GameStrc* pGame, D2DamageStrc* pDamage, uint32_t nBaseHitClass)
 {
 	constexpr D2DamageHitClassMappingStrc sgDamageHitClassMapping[] =
 	{
@@ -2239,12 +2239,11 @@ int32_t __fastcall SUNITDMG_GetHitClass(D2DamageStrc* pDamage, uint32_t nBaseHit
 		{ offsetof(D2DamageStrc, dwPoisDamage), 0x50 },
 	};
 
-	static int32_t dword_6FD4DC44;
-
-	int32_t nIndex = dword_6FD4DC44 % 4;
+	// D2Moo: the counter (dword_6FD4DC44) was shared by all games, it is now per game so that games can be updated in parallel
+	int32_t nIndex = pGame->nHitClassCounter % 4;
 	const int32_t nEnd = nIndex + 4;
 
-	++dword_6FD4DC44;
+	++pGame->nHitClassCounter;
 
 	uint32_t nHitClass = 0;
 	while (nIndex < nEnd)
@@ -0,0 +1,178 @@
+#include "UNIT/SUnitGuidIndex.h"
+
+#include <Fog.h>
+#include <Units/Units.h>
+
+
+constexpr uint32_t SUNITGUIDINDEX_MIN_CAPACITY = 64;
+
+
+// Helper function: GUIDs are mostly sequential, Fibonacci hashing spreads them over the whole table
+static inline uint32_t SUNITGUIDINDEX_GetHomeSlot(const D2UnitGuidIndexStrc* pIndex, D2UnitGUID nUnitGUID)
+{
+	return (nUnitGUID * 0x9E3779B1u) >> pIndex->nHashShift;
+}
+
+// Helper function
+static inline uint32_t SUNITGUIDINDEX_GetProbeDistance(const D2UnitGuidIndexStrc* pIndex, uint32_t nSlot)
+{
+	return (nSlot - SUNITGUIDINDEX_GetHomeSlot(pIndex, pIndex->pSlots[nSlot].nUnitGUID)) & (pIndex->nCapacity - 1);
+}
+
+// Helper function
+static void SUNITGUIDINDEX_InsertSlot(D2UnitGuidIndexStrc* pIndex, D2UnitGuidIndexSlotStrc tSlot)
+{
+	const uint32_t nMask = pIndex->nCapacity - 1;
+	uint32_t nSlot = SUNITGUIDINDEX_GetHomeSlot(pIndex, tSlot.nUnitGUID);
+	uint32_t nDistance = 0;
+	while (pIndex->pSlots[nSlot].pUnit)
+	{
+		// Take the place of entries closer to their home slot, this keeps the probe sequences short
+		const uint32_t nExistingDistance = SUNITGUIDINDEX_GetProbeDistance(pIndex, nSlot);
+		if (nExistingDistance < nDistance)
+		{
+			const D2UnitGuidIndexSlotStrc tDisplaced = pIndex->pSlots[nSlot];
+			pIndex->pSlots[nSlot] = tSlot;
+			tSlot = tDisplaced;
+			nDistance = nExistingDistance;
+		}
+
+		nSlot = (nSlot + 1) & nMask;
+		++nDistance;
+	}
+
+	pIndex->pSlots[nSlot] = tSlot;
+}
+
+// Helper function
+D2UnitGuidIndexSlotStrc* __fastcall SUNITGUIDINDEX_Rehash(D2UnitGuidIndexStrc* pIndex, D2UnitGuidIndexSlotStrc* pNewSlots, uint32_t nNewCapacity)
+{
+	D2UnitGuidIndexSlotStrc* pOldSlots = pIndex->pSlots;
+	const uint32_t nOldCapacity = pIndex->nCapacity;
+
+	uint32_t nHashShift = 32;
+	for (uint32_t nCapacity = nNewCapacity; nCapacity > 1; nCapacity >>= 1)
+	{
+		--nHashShift;
+	}
+
+	pIndex->pSlots = pNewSlots;
+	pIndex->nCapacity = nNewCapacity;
+	pIndex->nHashShift = nHashShift;
+
+	for (uint32_t i = 0; i < nOldCapacity; ++i)
+	{
+		if (pOldSlots[i].pUnit)
+		{
+			SUNITGUIDINDEX_InsertSlot(pIndex, pOldSlots[i]);
+		}
+	}
+
+	return pOldSlots;
+}
+
+// Helper function
+uint32_t __fastcall SUNITGUIDINDEX_GetGrownCapacity(const D2UnitGuidIndexStrc* pIndex)
+{
+	// Keep the load factor under 7/8
+	if ((pIndex->nCount + 1) * 8 > pIndex->nCapacity * 7)
+	{
+		return pIndex->nCapacity ? 2 * pIndex->nCapacity : SUNITGUIDINDEX_MIN_CAPACITY;
+	}
+
+	return 0;
+}
+
+// Helper function
+D2UnitStrc* __fastcall SUNITGUIDINDEX_Find(const D2UnitGuidIndexStrc* pIndex, D2UnitGUID nUnitGUID)
+{
+	if (!pIndex->nCount)
+	{
+		return nullptr;
+	}
+
+	const uint32_t nMask = pIndex->nCapacity - 1;
+	uint32_t nSlot = SUNITGUIDINDEX_GetHomeSlot(pIndex, nUnitGUID);
+	for (uint32_t nDistance = 0; pIndex->pSlots[nSlot].pUnit; ++nDistance)
+	{
+		if (pIndex->pSlots[nSlot].nUnitGUID == nUnitGUID)
+		{
+			return pIndex->pSlots[nSlot].pUnit;
+		}
+
+		// The GUID would have been stored before any entry closer to its home slot
+		if (SUNITGUIDINDEX_GetProbeDistance(pIndex, nSlot) < nDistance)
+		{
+			return nullptr;
+		}
+
+		nSlot = (nSlot + 1) & nMask;
+	}
+
+	return nullptr;
+}
+
+// Helper function
+void __fastcall SUNITGUIDINDEX_Insert(void* pMemPool, D2UnitGuidIndexStrc* pIndex, D2UnitStrc* pUnit)
+{
+	D2_ASSERT(pUnit);
+
+	if (const uint32_t nNewCapacity = SUNITGUIDINDEX_GetGrownCapacity(pIndex))
+	{
+		D2UnitGuidIndexSlotStrc* pOldSlots = SUNITGUIDINDEX_Rehash(pIndex, (D2UnitGuidIndexSlotStrc*)D2_CALLOC_POOL(pMemPool, sizeof(D2UnitGuidIndexSlotStrc) * nNewCapacity), nNewCapacity);
+		if (pOldSlots)
+		{
+			D2_FREE_POOL(pMemPool, pOldSlots);
+		}
+	}
+
+	D2UnitGuidIndexSlotStrc tSlot = {};
+	tSlot.pUnit = pUnit;
+	tSlot.nUnitGUID = pUnit->dwUnitId;
+	SUNITGUIDINDEX_InsertSlot(pIndex, tSlot);
+	++pIndex->nCount;
+}
+
+// Helper function
+void __fastcall SUNITGUIDINDEX_Remove(D2UnitGuidIndexStrc* pIndex, D2UnitStrc* pUnit)
+{
+	if (!pIndex->nCount)
+	{
+		return;
+	}
+
+	const uint32_t nMask = pIndex->nCapacity - 1;
+	uint32_t nSlot = SUNITGUIDINDEX_GetHomeSlot(pIndex, pUnit->dwUnitId);
+	for (uint32_t nDistance = 0; pIndex->pSlots[nSlot].pUnit != pUnit; ++nDistance)
+	{
+		if (!pIndex->pSlots[nSlot].pUnit || SUNITGUIDINDEX_GetProbeDistance(pIndex, nSlot) < nDistance)
+		{
+			return;
+		}
+
+		nSlot = (nSlot + 1) & nMask;
+	}
+
+	// Shift the following entries back instead of leaving a tombstone
+	uint32_t nNextSlot = (nSlot + 1) & nMask;
+	while (pIndex->pSlots[nNextSlot].pUnit && SUNITGUIDINDEX_GetProbeDistance(pIndex, nNextSlot) > 0)
+	{
+		pIndex->pSlots[nSlot] = pIndex->pSlots[nNextSlot];
+		nSlot = nNextSlot;
+		nNextSlot = (nNextSlot + 1) & nMask;
+	}
+
+	pIndex->pSlots[nSlot] = {};
+	--pIndex->nCount;
+}
+
+// Helper function
+void __fastcall SUNITGUIDINDEX_Free(void* pMemPool, D2UnitGuidIndexStrc* pIndex)
+{
+	if (pIndex->pSlots)
+	{
+		D2_FREE_POOL(pMemPool, pIndex->pSlots);
+	}
+
+	*pIndex = {};
+}
@@ -42,7 +42,7 @@
 #pragma warning(disable: 28159)
 
 
-int32_t gnNpcGUID_6FD4DC48;
+volatile LONG gnNpcGUID_6FD4DC48; // D2Moo: shared by all the games, written with InterlockedExchange
 
 //D2Game.0x6FCC67D0
 void __fastcall D2GAME_NPC_FirstFn_6FCC67D0(D2GameStrc* pGame, int32_t nVendorId, D2NpcRecordStrc* pNpcRecord)
@@ -2422,8 +2422,9 @@ void __fastcall D2GAME_NPC_IdentifyBoughtItem_6FCCA990(D2GameStrc* pGame, D2Unit
 //D2Game.0x6FCCA9F0
 void __fastcall D2GAME_STORES_FillGamble_6FCCA9F0(D2GameStrc* pGame, D2UnitStrc* pNpc, D2UnitStrc* pUnit, D2NpcRecordStrc* pNpcRecord)
 {
-    static int32_t gnRingItemId = 0;
-    static int32_t gnAmuItemId = 0;
+    // D2Moo: initialized once in a thread-safe way, they were lazily initialized by every call
+    static const int32_t gnRingItemId = std::max(DATATBLS_GetItemIdFromItemCode(' nir'), 0);
+    static const int32_t gnAmuItemId = std::max(DATATBLS_GetItemIdFromItemCode(' uma'), 0);
 
     D2GambleDataTbl* pGambleDataTbl = DATATBLS_GetGambleDataTables();
     if (!pGambleDataTbl)
@@ -2439,16 +2440,6 @@ void __fastcall D2GAME_STORES_FillGamble_6FCCA9F0(D2GameStrc* pGame, D2UnitStrc*
 
     const uint32_t nHighQualityChance = pDifficultyLevelsTxtRecord->dwGambleUniq + pDifficultyLevelsTxtRecord->dwGambleSet + pDifficultyLevelsTxtRecord->dwGambleRare;
 
-    if (!gnRingItemId)
-    {
-        DATATBLS_GetItemRecordFromItemCode(' nir', &gnRingItemId);
-    }
-
-    if (!gnAmuItemId)
-    {
-        DATATBLS_GetItemRecordFromItemCode(' uma', &gnAmuItemId);
-    }
-
     D2NpcGambleStrc* pGamble = D2_ALLOC_STRC_POOL(pGame->pMemoryPool, D2NpcGambleStrc);
     if (!pGamble)
     {
@@ -2785,7 +2776,7 @@ void __fastcall D2GAME_NPC_Heal_6FCCB220(D2GameStrc* pGame, D2UnitStrc* pUnit, D
 {
     if (pNpc)
     {
-        gnNpcGUID_6FD4DC48 = pNpc->dwUnitId;
+        InterlockedExchange(&gnNpcGUID_6FD4DC48, (LONG)pNpc->dwUnitId);
 
         switch (pNpc->dwClassId)
         {
@@ -2803,7 +2794,7 @@ void __fastcall D2GAME_NPC_Heal_6FCCB220(D2GameStrc* pGame, D2UnitStrc* pUnit, D
     }
     else
     {
-        gnNpcGUID_6FD4DC48 = -1;
+        InterlockedExchange(&gnNpcGUID_6FD4DC48, -1);
     }
 }
 
@@ -46,9 +46,6 @@ constexpr uint32_t MAX_NPC_INVENTORY = 17;
 uint8_t gbUnitProxyItemCacheInitialized[MAX_NPC_INVENTORY] = {};
 D2UnitProxyStrc gUnitProxyItemCache[MAX_NPC_INVENTORY] = {};
 
-int32_t dword_6FD4DD80;
-int32_t dword_6FD4DD84;
-
 
 //D2Game.0x6FCCB8A0
 D2NpcRecordStrc* __fastcall SUNITPROXY_GetNpcRecordFromClassId(D2GameStrc* pGame, int32_t nNpcClassId, int32_t* pIndex)
@@ -156,15 +153,9 @@ void __fastcall SUNITPROXY_InitializeNpcControl(D2GameStrc* pGame)
     SEED_InitSeed(&pNpcControl->pSeed);
     SEED_InitLowSeed(&pNpcControl->pSeed, ITEMS_RollRandomNumber(&pGame->pGameSeed));
 
-    if (!dword_6FD4DD80)
-    {
-        DATATBLS_GetItemRecordFromItemCode(' vqc', &dword_6FD4DD80);
-    }
-
-    if (!dword_6FD4DD84)
-    {
-        DATATBLS_GetItemRecordFromItemCode(' vqa', &dword_6FD4DD84);
-    }
+    // D2Moo: were globals lazily initialized by every game, local statics are initialized once in a thread-safe way
+    static const int32_t dword_6FD4DD80 = std::max(DATATBLS_GetItemIdFromItemCode(' vqc'), 0);
+    static const int32_t dword_6FD4DD84 = std::max(DATATBLS_GetItemIdFromItemCode(' vqa'), 0);
 
     D2ItemDataTbl* pItemDataTbl = DATATBLS_GetItemDataTables();
     uint32_t nIndex = 0;
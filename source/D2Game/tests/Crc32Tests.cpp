@@ -0,0 +1,117 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <CRC.h>
+
+namespace
+{
+    // Bytewise CRC32_Compute, used as a reference.
+    namespace Legacy
+    {
+        struct LookupTable
+        {
+            uint32_t table[256];
+
+            LookupTable()
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    uint32_t nCRC32 = i;
+                    for (int nBit = 0; nBit < 8; ++nBit)
+                    {
+                        nCRC32 = (nCRC32 & 1) ? (nCRC32 >> 1) ^ 0xEDB88320u : (nCRC32 >> 1);
+                    }
+                    table[i] = nCRC32;
+                }
+            }
+        };
+
+        const LookupTable sgCrc32LookupTable;
+
+        uint32_t CRC32_Compute(const void* pData, size_t dwSize)
+        {
+            uint32_t nCRC32 = 0xFFFFFFFFu;
+            for (size_t i = 0; i < dwSize; i++)
+            {
+                nCRC32 = sgCrc32LookupTable.table[(nCRC32 ^ ((const uint8_t*)pData)[i]) & 0xFF] ^ (nCRC32 >> 8);
+            }
+            return nCRC32;
+        }
+    }
+}
+
+TEST_CASE("CRC32_Compute vectors")
+{
+    // CRC-32 without the final inversion
+    char szCheck[] = "123456789";
+    CHECK(CRC32_Compute(szCheck, strlen(szCheck)) == ~0xCBF43926u);
+    char szA[] = "a";
+    CHECK(CRC32_Compute(szA, 1) == ~0xE8B7BE43u);
+
+    std::vector<uint8_t> aZeroes(256);
+    CHECK(CRC32_Compute(aZeroes.data(), aZeroes.size()) == Legacy::CRC32_Compute(aZeroes.data(), aZeroes.size()));
+}
+
+TEST_CASE("CRC32_Compute matches the bytewise implementation")
+{
+    std::mt19937 tRand(0x6FD269D3);
+    std::vector<uint8_t> aData(1024);
+    for (uint8_t& nByte : aData)
+    {
+        nByte = (uint8_t)tRand();
+    }
+
+    // Every alignment and length around the 8 bytes steps
+    for (size_t nStart = 0; nStart < 16; ++nStart)
+    {
+        for (size_t nSize = 1; nSize < 80; ++nSize)
+        {
+            CAPTURE(nStart);
+            CAPTURE(nSize);
+            REQUIRE(CRC32_Compute(&aData[nStart], nSize) == Legacy::CRC32_Compute(&aData[nStart], nSize));
+        }
+    }
+
+    for (int nIteration = 0; nIteration < 1000; ++nIteration)
+    {
+        const size_t nStart = tRand() % aData.size();
+        const size_t nSize = 1 + tRand() % (aData.size() - nStart);
+        REQUIRE(CRC32_Compute(&aData[nStart], nSize) == Legacy::CRC32_Compute(&aData[nStart], nSize));
+    }
+}
+
+TEST_CASE("CRC32_Compute benchmark")
+{
+    // Save files are a few KB, several of them are checked per autosave
+    std::mt19937 tRand(0x6FD2A248);
+    std::vector<uint8_t> aData(8192);
+    for (uint8_t& nByte : aData)
+    {
+        nByte = (uint8_t)tRand();
+    }
+
+    constexpr int nPasses = 2048;
+    uint32_t nExpectedSum = 0;
+    const auto tLegacyStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        nExpectedSum += Legacy::CRC32_Compute(&aData[nPass % 8], aData.size() - 8);
+    }
+    const auto tLegacyElapsed = std::chrono::steady_clock::now() - tLegacyStart;
+
+    uint32_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        nSum += CRC32_Compute(&aData[nPass % 8], aData.size() - 8);
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Bytewise: ", std::chrono::duration_cast<std::chrono::microseconds>(tLegacyElapsed).count(), "us for ", nPasses * 8, "KB");
+    MESSAGE("Slicing-by-8: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us for ", nPasses * 8, "KB");
+}
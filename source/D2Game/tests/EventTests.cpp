@@ -0,0 +1,148 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <GAME/Event.h>
+#include <GAME/Game.h>
+
+namespace
+{
+    // Simulates the cost of the original implementation: a single 64 slots wheel where every timer of the slot is visited.
+    struct TimerBenchmarkContext
+    {
+        std::mt19937 tRand{ 0x6FC351D0 };
+        int32_t aPendingTimersPerSlot[64] = {};
+        int32_t nNextSequence = 0;
+        int32_t nLastFiredSequence = -1;
+        int32_t nLastFiredFrame = -1;
+        int32_t nFiredTimers = 0;
+        int32_t nScheduledTimers = 0;
+        int32_t nRearmBudget = 0;
+        int32_t nWrongFrameTimers = 0;
+        int32_t nOutOfOrderTimers = 0;
+    };
+
+    TimerBenchmarkContext* gpTimerBenchmarkContext = nullptr;
+
+    int32_t __fastcall TimerBenchmarkCallback(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nEvent, int32_t nSequence, int32_t nExpectedFrame);
+
+    void ScheduleBenchmarkTimer(D2GameStrc* pGame, int32_t nEvent, int32_t nExpireFrame)
+    {
+        TimerBenchmarkContext* pContext = gpTimerBenchmarkContext;
+        ++pContext->aPendingTimersPerSlot[nExpireFrame % 64];
+        ++pContext->nScheduledTimers;
+        D2GAME_InitTimer_6FC351D0(pGame, nullptr, nEvent, nExpireFrame, TimerBenchmarkCallback, pContext->nNextSequence++, nExpireFrame);
+    }
+
+    int32_t __fastcall TimerBenchmarkCallback(D2GameStrc* pGame, D2UnitStrc* pUnit, int32_t nEvent, int32_t nSequence, int32_t nExpectedFrame)
+    {
+        TimerBenchmarkContext* pContext = gpTimerBenchmarkContext;
+        ++pContext->nFiredTimers;
+        --pContext->aPendingTimersPerSlot[nExpectedFrame % 64];
+
+        if (nExpectedFrame != pGame->dwGameFrame)
+        {
+            ++pContext->nWrongFrameTimers;
+        }
+
+        // Timers of the same frame must be executed in insertion order, as in the original game
+        if (pContext->nLastFiredFrame == pGame->dwGameFrame && nSequence < pContext->nLastFiredSequence)
+        {
+            ++pContext->nOutOfOrderTimers;
+        }
+        pContext->nLastFiredFrame = pGame->dwGameFrame;
+        pContext->nLastFiredSequence = nSequence;
+
+        // Monsters think again a few frames later
+        if (nEvent == UNITEVENTCALLBACK_AITHINK && pContext->nRearmBudget > 0)
+        {
+            --pContext->nRearmBudget;
+            ScheduleBenchmarkTimer(pGame, nEvent, pGame->dwGameFrame + 1 + pContext->tRand() % 25);
+        }
+        return 0;
+    }
+
+    // Fog allocations are not available in tests, so we provide the timers storage ourselves
+    D2EventTimerSlabListStrc* AllocBenchmarkTimerSlabs(std::vector<std::unique_ptr<D2EventTimerSlabListStrc>>& tSlabs, int32_t nSlabs)
+    {
+        for (int32_t nSlab = 0; nSlab < nSlabs; ++nSlab)
+        {
+            std::unique_ptr<D2EventTimerSlabListStrc> pSlab = std::make_unique<D2EventTimerSlabListStrc>();
+            memset(pSlab.get(), 0, sizeof(D2EventTimerSlabListStrc));
+            const int32_t nLastEventTimerIdx = ARRAY_SIZE(pSlab->tEventTimersStorage) - 1;
+            for (int32_t i = 0; i < nLastEventTimerIdx; ++i)
+            {
+                pSlab->tEventTimersStorage[i].pNextFreeEventTimer = &pSlab->tEventTimersStorage[i + 1];
+            }
+            pSlab->pFreeEventTimerListHead = &pSlab->tEventTimersStorage[0];
+            pSlab->pNextSlab = tSlabs.empty() ? nullptr : tSlabs.back().get();
+            tSlabs.push_back(std::move(pSlab));
+        }
+        return tSlabs.back().get();
+    }
+}
+
+TEST_CASE("EVENT timing wheel benchmark")
+{
+    constexpr int32_t nAIThinkTimers = 40000;
+    constexpr int32_t nRegenTimers = 30000;
+    constexpr int32_t nSkillTimers = 30000;
+
+    std::vector<uint8_t> tGameStorage(sizeof(D2GameStrc));
+    D2GameStrc* pGame = reinterpret_cast<D2GameStrc*>(tGameStorage.data());
+    std::unique_ptr<D2EventTimerQueueStrc> pTimerQueue = std::make_unique<D2EventTimerQueueStrc>();
+    memset(pTimerQueue.get(), 0, sizeof(D2EventTimerQueueStrc));
+    std::vector<std::unique_ptr<D2EventTimerSlabListStrc>> tSlabs;
+    pTimerQueue->pSlabListHead = AllocBenchmarkTimerSlabs(tSlabs, 256);
+    pTimerQueue->nWheelFrame = pGame->dwGameFrame;
+    pGame->pTimerQueue = pTimerQueue.get();
+
+    TimerBenchmarkContext tContext;
+    tContext.nRearmBudget = 2 * nAIThinkTimers;
+    gpTimerBenchmarkContext = &tContext;
+
+    std::uniform_int_distribution<int32_t> tAIThinkDelay(1, 25);
+    std::uniform_int_distribution<int32_t> tRegenDelay(1, 10 * DEFAULT_FRAMES_PER_SECOND);
+    std::uniform_int_distribution<int32_t> tSkillDelay(DEFAULT_FRAMES_PER_SECOND, 5 * 60 * DEFAULT_FRAMES_PER_SECOND);
+    for (int32_t i = 0; i < nAIThinkTimers; ++i)
+    {
+        ScheduleBenchmarkTimer(pGame, UNITEVENTCALLBACK_AITHINK, tAIThinkDelay(tContext.tRand));
+    }
+    for (int32_t i = 0; i < nRegenTimers; ++i)
+    {
+        ScheduleBenchmarkTimer(pGame, UNITEVENTCALLBACK_STATREGEN, tRegenDelay(tContext.tRand));
+    }
+    for (int32_t i = 0; i < nSkillTimers; ++i)
+    {
+        // A few very long timers (such as skill durations of summons) to exercise the overflow list
+        const int32_t nDelay = (i % 1000) ? tSkillDelay(tContext.tRand) : 300000 + i;
+        ScheduleBenchmarkTimer(pGame, UNITEVENTCALLBACK_REMOVESTATE, nDelay);
+    }
+
+    uint64_t nVisitedBefore = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    while (tContext.nFiredTimers < tContext.nScheduledTimers)
+    {
+        ++pGame->dwGameFrame;
+        nVisitedBefore += tContext.aPendingTimersPerSlot[pGame->dwGameFrame % 64];
+        EVENT_IterateEvents(pGame);
+        REQUIRE(pGame->dwGameFrame < 400000);
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(tContext.nWrongFrameTimers == 0);
+    CHECK(tContext.nOutOfOrderTimers == 0);
+    CHECK(pTimerQueue->nTimersVisited == tContext.nFiredTimers);
+    CHECK(pTimerQueue->nTimersVisited < nVisitedBefore);
+
+    MESSAGE("Frames: ", pGame->dwGameFrame, " Timers: ", tContext.nFiredTimers);
+    MESSAGE("Timers visited per frame, 64 slots wheel: ", double(nVisitedBefore) / pGame->dwGameFrame);
+    MESSAGE("Timers visited per frame, hierarchical wheel: ", double(pTimerQueue->nTimersVisited) / pGame->dwGameFrame);
+    MESSAGE("Hierarchical wheel time: ", std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count(), "ms");
+
+    gpTimerBenchmarkContext = nullptr;
+    pGame->pTimerQueue = nullptr;
+}
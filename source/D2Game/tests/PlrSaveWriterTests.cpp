@@ -0,0 +1,196 @@
+#include <doctest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <PLAYER/PlrSaveWriter.h>
+
+namespace
+{
+    // Writer using test-owned entries, so that nothing is allocated with Fog.
+    // The spare entries are used by PLRSAVEWRITER_QueueFile, and given back once written.
+    struct TestSaveWriter
+    {
+        std::unique_ptr<D2PlrSaveWriterStrc> pWriter = std::make_unique<D2PlrSaveWriterStrc>();
+        std::vector<std::unique_ptr<D2PlrSaveWriterEntryStrc>> aSpareEntries;
+
+        explicit TestSaveWriter(size_t nSpareEntries)
+        {
+            memset(pWriter.get(), 0x00, sizeof(D2PlrSaveWriterStrc));
+            for (size_t i = 0; i < nSpareEntries; ++i)
+            {
+                aSpareEntries.push_back(std::make_unique<D2PlrSaveWriterEntryStrc>());
+                aSpareEntries.back()->pNext = pWriter->pFreeEntries;
+                pWriter->pFreeEntries = aSpareEntries.back().get();
+            }
+            REQUIRE(PLRSAVEWRITER_StartThread(pWriter.get()));
+        }
+
+        ~TestSaveWriter()
+        {
+            if (pWriter->hThread)
+            {
+                PLRSAVEWRITER_StopThread(pWriter.get());
+            }
+        }
+
+        size_t GetFreeEntriesCount() const
+        {
+            size_t nCount = 0;
+            for (D2PlrSaveWriterEntryStrc* pEntry = pWriter->pFreeEntries; pEntry; pEntry = pEntry->pNext)
+            {
+                ++nCount;
+            }
+            return nCount;
+        }
+    };
+
+    std::string GetTestFileName(const char* szName)
+    {
+        char szTempPath[MAX_PATH] = {};
+        REQUIRE(GetTempPathA(sizeof(szTempPath), szTempPath));
+        return std::string(szTempPath) + "D2GameTests_" + std::to_string(GetCurrentProcessId()) + "_" + szName;
+    }
+
+    std::vector<uint8_t> ReadTestFile(const std::string& szFileName)
+    {
+        std::vector<uint8_t> aData;
+        if (FILE* pFile = fopen(szFileName.c_str(), "rb")) // NOLINT(clang-diagnostic-deprecated-declarations)
+        {
+            uint8_t pBuffer[256];
+            size_t nRead = 0;
+            while ((nRead = fread(pBuffer, 1, sizeof(pBuffer), pFile)) != 0)
+            {
+                aData.insert(aData.end(), pBuffer, pBuffer + nRead);
+            }
+            fclose(pFile);
+        }
+        return aData;
+    }
+
+    void WriteTestFile(const std::string& szFileName, const std::vector<uint8_t>& aData)
+    {
+        FILE* pFile = fopen(szFileName.c_str(), "wb"); // NOLINT(clang-diagnostic-deprecated-declarations)
+        REQUIRE(pFile);
+        fwrite(aData.data(), 1, aData.size(), pFile);
+        fclose(pFile);
+    }
+
+    bool DoesTestFileExist(const std::string& szFileName)
+    {
+        return GetFileAttributesA(szFileName.c_str()) != INVALID_FILE_ATTRIBUTES;
+    }
+
+    std::vector<uint8_t> MakeSave(uint8_t nValue, uint32_t nSize)
+    {
+        std::vector<uint8_t> aData(nSize);
+        for (uint32_t i = 0; i < nSize; ++i)
+        {
+            aData[i] = (uint8_t)(nValue + i);
+        }
+        return aData;
+    }
+}
+
+TEST_CASE("PLRSAVEWRITER coalesces the queued saves and renames the newest one over the file")
+{
+    const std::string szFirstFileName = GetTestFileName("First.d2s");
+    const std::string szSecondFileName = GetTestFileName("Second.d2s");
+    const std::vector<uint8_t> aPreviousSave = MakeSave(0xA0, 700);
+    WriteTestFile(szFirstFileName, aPreviousSave);
+    DeleteFileA(szSecondFileName.c_str());
+
+    TestSaveWriter tTestWriter(4);
+    D2PlrSaveWriterStrc* pWriter = tTestWriter.pWriter.get();
+
+    const std::vector<uint8_t> aFirstSaves[] = { MakeSave(1, 500), MakeSave(2, 600), MakeSave(3, 400) };
+    const std::vector<uint8_t> aSecondSave = MakeSave(4, 300);
+    {
+        // The thread can not take an entry while the test holds the lock, so every save of the first file is queued before it gets written
+        EnterCriticalSection(&pWriter->tCriticalSection);
+        CHECK(PLRSAVEWRITER_QueueFile(pWriter, szFirstFileName.c_str(), aFirstSaves[0].data(), (uint32_t)aFirstSaves[0].size()));
+        CHECK(PLRSAVEWRITER_QueueFile(pWriter, szSecondFileName.c_str(), aSecondSave.data(), (uint32_t)aSecondSave.size()));
+        CHECK(PLRSAVEWRITER_QueueFile(pWriter, szFirstFileName.c_str(), aFirstSaves[1].data(), (uint32_t)aFirstSaves[1].size()));
+        CHECK(PLRSAVEWRITER_QueueFile(pWriter, szFirstFileName.c_str(), aFirstSaves[2].data(), (uint32_t)aFirstSaves[2].size()));
+        CHECK(pWriter->tStats.nQueueDepth == 2);
+        CHECK(pWriter->tStats.nCoalescedCount == 2);
+
+        // Reads see the newest save, the file still holds the previous one
+        uint8_t pBuffer[PLRSAVEWRITER_MAX_SAVE_SIZE] = {};
+        const uint32_t nSize = PLRSAVEWRITER_ReadQueuedFile(pWriter, szFirstFileName.c_str(), pBuffer, sizeof(pBuffer));
+        CHECK(std::vector<uint8_t>(pBuffer, pBuffer + nSize) == aFirstSaves[2]);
+        CHECK(ReadTestFile(szFirstFileName) == aPreviousSave);
+        LeaveCriticalSection(&pWriter->tCriticalSection);
+    }
+
+    PLRSAVEWRITER_StopThread(pWriter);
+
+    // Each file was written once, with its newest save, and no temporary file is left
+    CHECK(ReadTestFile(szFirstFileName) == aFirstSaves[2]);
+    CHECK(ReadTestFile(szSecondFileName) == aSecondSave);
+    CHECK_FALSE(DoesTestFileExist(szFirstFileName + ".tmp"));
+    CHECK_FALSE(DoesTestFileExist(szSecondFileName + ".tmp"));
+
+    D2PlrSaveWriterStatsStrc tStats = {};
+    PLRSAVEWRITER_GetWriterStats(pWriter, &tStats);
+    CHECK(tStats.nQueueDepth == 0);
+    CHECK(tStats.nPeakQueueDepth == 2);
+    CHECK(tStats.nWritesCount == 2);
+    CHECK(tStats.nCoalescedCount == 2);
+    CHECK(tStats.nFailedCount == 0);
+    CHECK(tTestWriter.GetFreeEntriesCount() == 4);
+
+    uint8_t pBuffer[PLRSAVEWRITER_MAX_SAVE_SIZE] = {};
+    CHECK(PLRSAVEWRITER_ReadQueuedFile(pWriter, szFirstFileName.c_str(), pBuffer, sizeof(pBuffer)) == 0);
+
+    DeleteFileA(szFirstFileName.c_str());
+    DeleteFileA(szSecondFileName.c_str());
+}
+
+TEST_CASE("PLRSAVEWRITER reports the failed writes until the file is written again")
+{
+    const std::string szDirectory = GetTestFileName("Saves");
+    const std::string szFileName = szDirectory + "\\Failed.d2s";
+    RemoveDirectoryA(szDirectory.c_str());
+
+    TestSaveWriter tTestWriter(4);
+    D2PlrSaveWriterStrc* pWriter = tTestWriter.pWriter.get();
+
+    // The directory does not exist, the temporary file can not be created
+    const std::vector<uint8_t> aSaves[] = { MakeSave(1, 100), MakeSave(2, 200), MakeSave(3, 300), MakeSave(4, 400) };
+    CHECK(PLRSAVEWRITER_QueueFile(pWriter, szFileName.c_str(), aSaves[0].data(), (uint32_t)aSaves[0].size()));
+    PLRSAVEWRITER_StopThread(pWriter);
+
+    DWORD dwLastError = 0;
+    CHECK(PLRSAVEWRITER_GetWriteFailures(pWriter, szFileName.c_str(), &dwLastError) == 1);
+    CHECK(dwLastError != 0);
+    CHECK(pWriter->tStats.nFailedCount == 1);
+
+    // The next save is still queued, but reports the failure to the game
+    REQUIRE(PLRSAVEWRITER_StartThread(pWriter));
+    CHECK_FALSE(PLRSAVEWRITER_QueueFile(pWriter, szFileName.c_str(), aSaves[1].data(), (uint32_t)aSaves[1].size()));
+    PLRSAVEWRITER_StopThread(pWriter);
+    CHECK(PLRSAVEWRITER_GetWriteFailures(pWriter, szFileName.c_str(), &dwLastError) == 2);
+    CHECK_FALSE(DoesTestFileExist(szFileName));
+
+    // Once a write succeeds, the file is not reported anymore
+    REQUIRE(CreateDirectoryA(szDirectory.c_str(), nullptr));
+    REQUIRE(PLRSAVEWRITER_StartThread(pWriter));
+    CHECK_FALSE(PLRSAVEWRITER_QueueFile(pWriter, szFileName.c_str(), aSaves[2].data(), (uint32_t)aSaves[2].size()));
+    PLRSAVEWRITER_StopThread(pWriter);
+    CHECK(PLRSAVEWRITER_GetWriteFailures(pWriter, szFileName.c_str(), &dwLastError) == 0);
+    CHECK(dwLastError == 0);
+    CHECK(ReadTestFile(szFileName) == aSaves[2]);
+    CHECK(pWriter->pFailedEntries == nullptr);
+    CHECK(tTestWriter.GetFreeEntriesCount() == 4);
+
+    REQUIRE(PLRSAVEWRITER_StartThread(pWriter));
+    CHECK(PLRSAVEWRITER_QueueFile(pWriter, szFileName.c_str(), aSaves[3].data(), (uint32_t)aSaves[3].size()));
+    PLRSAVEWRITER_StopThread(pWriter);
+    CHECK(ReadTestFile(szFileName) == aSaves[3]);
+
+    DeleteFileA(szFileName.c_str());
+    RemoveDirectoryA(szDirectory.c_str());
+}
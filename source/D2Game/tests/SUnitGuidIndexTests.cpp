@@ -0,0 +1,131 @@
+#include <doctest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <UNIT/SUnitGuidIndex.h>
+#include <Units/Units.h>
+
+namespace
+{
+    // Index growing into test-owned slots, as SUNITGUIDINDEX_Insert would with Fog
+    struct TestGuidIndex
+    {
+        D2UnitGuidIndexStrc tIndex = {};
+        std::vector<std::unique_ptr<D2UnitGuidIndexSlotStrc[]>> aSlotBlocks;
+
+        void Insert(D2UnitStrc* pUnit)
+        {
+            if (const uint32_t nNewCapacity = SUNITGUIDINDEX_GetGrownCapacity(&tIndex))
+            {
+                aSlotBlocks.emplace_back(new D2UnitGuidIndexSlotStrc[nNewCapacity]{});
+                SUNITGUIDINDEX_Rehash(&tIndex, aSlotBlocks.back().get(), nNewCapacity);
+            }
+            SUNITGUIDINDEX_Insert(nullptr, &tIndex, pUnit);
+        }
+    };
+
+    // Walk of the units, as SUNIT_GetServerUnit did over D2GameStrc::pUnitList
+    D2UnitStrc* FindLinear(const std::vector<D2UnitStrc*>& aLiveUnits, D2UnitGUID nUnitGUID)
+    {
+        for (D2UnitStrc* pUnit : aLiveUnits)
+        {
+            if (pUnit->dwUnitId == nUnitGUID)
+            {
+                return pUnit;
+            }
+        }
+        return nullptr;
+    }
+}
+
+TEST_CASE("SUNITGUIDINDEX lookups match a linear lookup across inserts and removes")
+{
+    std::mt19937 tRand(0x6FC40B30);
+
+    constexpr int nUnits = 4096;
+    constexpr int nOperations = 100000;
+
+    std::vector<D2UnitStrc> aUnits(nUnits);
+    std::vector<D2UnitStrc*> aFreeUnits;
+    for (D2UnitStrc& rUnit : aUnits)
+    {
+        rUnit = {};
+        aFreeUnits.push_back(&rUnit);
+    }
+
+    TestGuidIndex tTestIndex;
+    std::vector<D2UnitStrc*> aLiveUnits;
+    D2UnitGUID nNextUnitGUID = 1;
+
+    for (int nOperation = 0; nOperation < nOperations; ++nOperation)
+    {
+        CAPTURE(nOperation);
+        const int nAction = std::uniform_int_distribution<int>(0, 9)(tRand);
+        if (nAction < 4 && !aFreeUnits.empty())
+        {
+            // GUIDs are mostly sequential, but also test arbitrary ones colliding in the table
+            D2UnitGUID nUnitGUID = nNextUnitGUID++;
+            if (std::uniform_int_distribution<int>(0, 7)(tRand) == 0)
+            {
+                nUnitGUID = std::uniform_int_distribution<D2UnitGUID>()(tRand);
+                if (FindLinear(aLiveUnits, nUnitGUID))
+                {
+                    continue;
+                }
+            }
+
+            D2UnitStrc* pUnit = aFreeUnits.back();
+            aFreeUnits.pop_back();
+            pUnit->dwUnitId = nUnitGUID;
+            tTestIndex.Insert(pUnit);
+            aLiveUnits.push_back(pUnit);
+        }
+        else if (nAction < 7 && !aLiveUnits.empty())
+        {
+            const size_t nLiveUnit = std::uniform_int_distribution<size_t>(0, aLiveUnits.size() - 1)(tRand);
+            D2UnitStrc* pUnit = aLiveUnits[nLiveUnit];
+            SUNITGUIDINDEX_Remove(&tTestIndex.tIndex, pUnit);
+            aLiveUnits[nLiveUnit] = aLiveUnits.back();
+            aLiveUnits.pop_back();
+            aFreeUnits.push_back(pUnit);
+
+            // Removing a unit twice does nothing
+            if (std::uniform_int_distribution<int>(0, 15)(tRand) == 0)
+            {
+                SUNITGUIDINDEX_Remove(&tTestIndex.tIndex, pUnit);
+            }
+        }
+        else
+        {
+            // Live, removed and never used GUIDs
+            const D2UnitGUID nUnitGUID = std::uniform_int_distribution<D2UnitGUID>(0, nNextUnitGUID + 16)(tRand);
+            CAPTURE(nUnitGUID);
+            REQUIRE(SUNITGUIDINDEX_Find(&tTestIndex.tIndex, nUnitGUID) == FindLinear(aLiveUnits, nUnitGUID));
+        }
+
+        REQUIRE(tTestIndex.tIndex.nCount == aLiveUnits.size());
+    }
+
+    for (D2UnitStrc* pUnit : aLiveUnits)
+    {
+        REQUIRE(SUNITGUIDINDEX_Find(&tTestIndex.tIndex, pUnit->dwUnitId) == pUnit);
+    }
+    for (D2UnitStrc* pUnit : aFreeUnits)
+    {
+        REQUIRE(SUNITGUIDINDEX_Find(&tTestIndex.tIndex, pUnit->dwUnitId) == FindLinear(aLiveUnits, pUnit->dwUnitId));
+    }
+    MESSAGE(aLiveUnits.size(), " units, capacity ", tTestIndex.tIndex.nCapacity);
+
+    // Emptying the index leaves every slot free
+    for (D2UnitStrc* pUnit : aLiveUnits)
+    {
+        SUNITGUIDINDEX_Remove(&tTestIndex.tIndex, pUnit);
+    }
+    CHECK(tTestIndex.tIndex.nCount == 0);
+    for (uint32_t i = 0; i < tTestIndex.tIndex.nCapacity; ++i)
+    {
+        CHECK(tTestIndex.tIndex.pSlots[i].pUnit == nullptr);
+    }
+}
@@ -0,0 +1,178 @@
+#include <doctest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <GAME/Game.h>
+#include <GAME/Scheduler.h>
+#include <UNIT/SUnitDmg.h>
+
+namespace
+{
+    // Game hit by a few attacks every frame, as SUNITDMG_ExecuteMissileDamage would
+    struct TestGame
+    {
+        std::vector<uint8_t> tGameStorage = std::vector<uint8_t>(sizeof(D2GameStrc));
+        D2GameStrc* pGame = reinterpret_cast<D2GameStrc*>(tGameStorage.data());
+        std::mt19937 tRand;
+        std::vector<uint32_t> aSysTimesMs;
+        std::vector<int32_t> aHitClasses;
+    };
+
+    std::vector<TestGame>* gpTestGames = nullptr;
+
+    // Same as GAME_UpdateGameFrame, without the game lock
+    BOOL __fastcall TestUpdateGame(D2GameGUID nGameGUID, uint32_t nSysTimeMs)
+    {
+        // Some games were freed, as when GAME_LockGame fails
+        if (nGameGUID % 5 == 0)
+        {
+            return FALSE;
+        }
+
+        TestGame& rGame = (*gpTestGames)[nGameGUID];
+        rGame.aSysTimesMs.push_back(nSysTimeMs);
+        ++rGame.pGame->dwGameFrame;
+
+        const int32_t nHits = std::uniform_int_distribution<int32_t>(0, 8)(rGame.tRand);
+        for (int32_t i = 0; i < nHits; ++i)
+        {
+            D2DamageStrc tDamage = {};
+            tDamage.dwFireDamage = rGame.tRand() % 2;
+            tDamage.dwLtngDamage = rGame.tRand() % 2;
+            tDamage.dwColdDamage = rGame.tRand() % 2;
+            tDamage.dwPoisDamage = rGame.tRand() % 2;
+            if (rGame.tRand() % 4 == 0)
+            {
+                tDamage.wResultFlags |= DAMAGERESULTFLAG_CRITICALSTRIKE;
+            }
+            rGame.aHitClasses.push_back(SUNITDMG_GetHitClass(rGame.pGame, &tDamage, 0));
+        }
+        return TRUE;
+    }
+
+    // Worker pool using test-owned workers, so that nothing is allocated with Fog
+    struct TestScheduler
+    {
+        std::vector<std::unique_ptr<D2GameSchedulerWorkerStrc>> aWorkers;
+
+        explicit TestScheduler(int32_t nWorkers)
+        {
+            GAMESCHED_Initialize();
+            REQUIRE(GAMESCHED_GetWorkerCount() == 0);
+            for (int32_t i = 0; i < nWorkers; ++i)
+            {
+                aWorkers.push_back(std::make_unique<D2GameSchedulerWorkerStrc>());
+                REQUIRE(GAMESCHED_StartWorker(aWorkers.back().get()));
+            }
+        }
+
+        ~TestScheduler()
+        {
+            while (GAMESCHED_StopLastWorker())
+            {
+            }
+            GAMESCHED_Release();
+        }
+    };
+
+    // Slots of the games table, with empty (0) and removed (-1) slots as in gnGamesGUIDs_6FD447F8
+    std::vector<int32_t> MakeGameGUIDs(int32_t nGames)
+    {
+        std::vector<int32_t> aGameGUIDs;
+        for (int32_t nGUID = 1; nGUID <= nGames; ++nGUID)
+        {
+            aGameGUIDs.push_back(nGUID);
+            if (nGUID % 9 == 0)
+            {
+                aGameGUIDs.push_back(0);
+            }
+            else if (nGUID % 13 == 0)
+            {
+                aGameGUIDs.push_back(-1);
+            }
+        }
+        return aGameGUIDs;
+    }
+
+    std::vector<TestGame> RunGames(const std::vector<int32_t>& aGameGUIDs, int32_t nGames, int32_t nFrames, int32_t nWorkers)
+    {
+        std::vector<TestGame> aGames(nGames + 1);
+        for (int32_t nGUID = 0; nGUID <= nGames; ++nGUID)
+        {
+            aGames[nGUID].tRand.seed(0x6FC38E20 + nGUID);
+        }
+        gpTestGames = &aGames;
+
+        std::unique_ptr<TestScheduler> pScheduler = nWorkers ? std::make_unique<TestScheduler>(nWorkers) : nullptr;
+        for (int32_t nFrame = 0; nFrame < nFrames; ++nFrame)
+        {
+            const uint32_t nSysTimeMs = 1000 + nFrame * 40;
+            BOOL bUpdatedAnyGame = FALSE;
+            if (nWorkers)
+            {
+                bUpdatedAnyGame = GAMESCHED_UpdateGames(aGameGUIDs.data(), (int32_t)aGameGUIDs.size(), nSysTimeMs, TestUpdateGame);
+            }
+            else
+            {
+                // Serial loop of GAME_UpdateGamesProgress
+                for (const int32_t nGUID : aGameGUIDs)
+                {
+                    if (nGUID && nGUID != -1 && TestUpdateGame(nGUID, nSysTimeMs))
+                    {
+                        bUpdatedAnyGame = TRUE;
+                    }
+                }
+            }
+            CHECK(bUpdatedAnyGame);
+        }
+
+        if (nWorkers)
+        {
+            uint32_t nGamesUpdated = 0;
+            for (int32_t nWorker = 0; nWorker < nWorkers; ++nWorker)
+            {
+                D2GameSchedulerStatsStrc tStats = {};
+                REQUIRE(GAMESCHED_GetWorkerStats(nWorker, &tStats));
+                CHECK(tStats.nFramesCount == (uint32_t)nFrames);
+                nGamesUpdated += tStats.nGamesUpdated;
+            }
+            CHECK(nGamesUpdated == (uint32_t)(nGames * nFrames));
+            CHECK_FALSE(GAMESCHED_GetWorkerStats(nWorkers, nullptr));
+        }
+
+        gpTestGames = nullptr;
+        return aGames;
+    }
+}
+
+TEST_CASE("GAMESCHED workers give the same results as the serial games loop")
+{
+    constexpr int32_t nGames = 200;
+    constexpr int32_t nFrames = 100;
+    constexpr int32_t nWorkers = 4;
+
+    const std::vector<int32_t> aGameGUIDs = MakeGameGUIDs(nGames);
+    const std::vector<TestGame> aSerialGames = RunGames(aGameGUIDs, nGames, nFrames, 0);
+    const std::vector<TestGame> aThreadedGames = RunGames(aGameGUIDs, nGames, nFrames, nWorkers);
+
+    size_t nHits = 0;
+    for (int32_t nGUID = 1; nGUID <= nGames; ++nGUID)
+    {
+        CAPTURE(nGUID);
+        const TestGame& rSerialGame = aSerialGames[nGUID];
+        const TestGame& rThreadedGame = aThreadedGames[nGUID];
+
+        // Every existing game was updated once per frame, with the time of the frame
+        CHECK(rSerialGame.aSysTimesMs.size() == (nGUID % 5 ? nFrames : 0));
+        CHECK(rThreadedGame.aSysTimesMs == rSerialGame.aSysTimesMs);
+        CHECK(rThreadedGame.pGame->dwGameFrame == rSerialGame.pGame->dwGameFrame);
+
+        // The hit classes only depend on the game itself
+        CHECK(rThreadedGame.aHitClasses == rSerialGame.aHitClasses);
+        CHECK(rThreadedGame.pGame->nHitClassCounter == rSerialGame.pGame->nHitClassCounter);
+        nHits += rSerialGame.aHitClasses.size();
+    }
+    MESSAGE(nHits, " hits in ", nGames, " games over ", nFrames, " frames");
+}
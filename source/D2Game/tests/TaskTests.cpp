@@ -0,0 +1,237 @@
+#include <doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <GAME/Game.h>
+#include <GAME/Task.h>
+
+namespace
+{
+    // Game tasks are stored right after their game, see TASK_GetGameFromGameTask
+    struct TestGame
+    {
+        std::unique_ptr<uint8_t[]> pMemory{ new uint8_t[sizeof(D2GameStrc) + sizeof(D2GameTaskStrc)]{} };
+        D2GameStrc* pGame = (D2GameStrc*)pMemory.get();
+        D2GameTaskStrc* pGameTask = (D2GameTaskStrc*)&pGame[1];
+    };
+
+    // Queue slots owned by the test, so that nothing is allocated with Fog
+    struct TestTaskQueues
+    {
+        std::unique_ptr<D2TaskStrc> aQueues[TASKQSLOTS];
+
+        TestTaskQueues()
+        {
+            TASK_InitializeClock();
+        }
+
+        ~TestTaskQueues()
+        {
+            for (int32_t i = 0; i < TASKQSLOTS; ++i)
+            {
+                if (aQueues[i])
+                {
+                    TASK_RemoveQueueSlot(i);
+                }
+            }
+
+            // Only resets the counters, the slots are already empty
+            TASK_FreeAllQueueSlots();
+        }
+
+        D2TaskStrc* Add(int32_t nTaskSlotIndex)
+        {
+            aQueues[nTaskSlotIndex] = std::make_unique<D2TaskStrc>();
+            TASK_AddQueueSlot(nTaskSlotIndex, aQueues[nTaskSlotIndex].get());
+            return aQueues[nTaskSlotIndex].get();
+        }
+    };
+
+    std::vector<D2GameTaskStrc*> GetQueuedGameTasks(D2TaskStrc* ptTaskQ)
+    {
+        std::vector<D2GameTaskStrc*> aGameTasks;
+        for (D2LinkStrc* pLink = ptTaskQ->pTaskBalanceLink.pNext; pLink != &ptTaskQ->pTaskBalanceLink; pLink = pLink->pNext)
+        {
+            aGameTasks.push_back(CONTAINING_RECORD(pLink, D2GameTaskStrc, pQueueLink));
+        }
+        return aGameTasks;
+    }
+
+    D2GameTaskStrc* PopGameTask(int32_t nTaskSlotIndex, int32_t* pResult = nullptr)
+    {
+        int32_t nGameTask = 0;
+        const int32_t nResult = D2Game_10043((int8_t)nTaskSlotIndex, &nGameTask);
+        if (pResult)
+        {
+            *pResult = nResult;
+        }
+        return (D2GameTaskStrc*)nGameTask;
+    }
+}
+
+TEST_CASE("TASK queues keep the games sorted by due time, in queuing order for equal times")
+{
+    std::mt19937 tRand(0x6FC40E40);
+
+    constexpr int nGames = 200;
+    constexpr int nReschedules = 2000;
+
+    D2TaskStrc tTaskQ = {};
+    tTaskQ.pTaskBalanceLink.pPrev = &tTaskQ.pTaskBalanceLink;
+    tTaskQ.pTaskBalanceLink.pNext = &tTaskQ.pTaskBalanceLink;
+
+    // Reference queue: a game is queued after every game due at the same time or before it
+    std::vector<D2GameTaskStrc*> aExpectedGameTasks;
+    auto QueueReference = [&aExpectedGameTasks](D2GameTaskStrc* pGameTask)
+    {
+        const auto itNext = std::upper_bound(aExpectedGameTasks.begin(), aExpectedGameTasks.end(), pGameTask->nDueTimeMs,
+            [](int32_t nDueTimeMs, const D2GameTaskStrc* pOther) { return nDueTimeMs < pOther->nDueTimeMs; });
+        aExpectedGameTasks.insert(itNext, pGameTask);
+    };
+
+    std::vector<D2GameTaskStrc> aGameTasks(nGames);
+    for (D2GameTaskStrc& rGameTask : aGameTasks)
+    {
+        rGameTask = {};
+        rGameTask.nDueTimeMs = std::uniform_int_distribution<int32_t>(0, 2 * TASK_GAME_FRAME_MS)(tRand);
+        TASK_QueueIncrement(&tTaskQ, &rGameTask.nDueTimeMs, 0);
+        QueueReference(&rGameTask);
+    }
+    REQUIRE(GetQueuedGameTasks(&tTaskQ) == aExpectedGameTasks);
+
+    // Processed games are queued again one frame later, as in TASK_ProcessGame
+    for (int nReschedule = 0; nReschedule < nReschedules; ++nReschedule)
+    {
+        CAPTURE(nReschedule);
+        D2GameTaskStrc* pGameTask = aExpectedGameTasks.front();
+        aExpectedGameTasks.erase(aExpectedGameTasks.begin());
+        TASK_LinkList_Remove(&pGameTask->pQueueLink);
+
+        const int32_t nIncrement = std::uniform_int_distribution<int32_t>(0, 7)(tRand) == 0 ? 0 : TASK_GAME_FRAME_MS;
+        TASK_QueueIncrement(&tTaskQ, &pGameTask->nDueTimeMs, nIncrement);
+        QueueReference(pGameTask);
+        REQUIRE(GetQueuedGameTasks(&tTaskQ) == aExpectedGameTasks);
+    }
+}
+
+TEST_CASE("TASK workers pop their due games in order, and steal the last game of the busiest queue")
+{
+    constexpr int nGames = 8;
+
+    TestTaskQueues tQueues;
+    D2TaskStrc* ptFirstTaskQ = tQueues.Add(0);
+
+    TestGame aGames[nGames];
+    for (int i = 0; i < nGames; ++i)
+    {
+        REQUIRE(D2Game_10042((D2TaskStrc*)aGames[i].pGameTask, TASK_PROCESSGAME, (D2LinkStrc*)(uintptr_t)(i + 1)));
+        CHECK(aGames[i].pGameTask->nGameHashKey == (uint32_t)(i + 1));
+    }
+    CHECK(ptFirstTaskQ->nType == nGames);
+
+    // The new queue is empty, its worker takes the last game of the first queue
+    D2TaskStrc* ptSecondTaskQ = tQueues.Add(1);
+    CHECK(PopGameTask(1) == aGames[nGames - 1].pGameTask);
+    CHECK(ptFirstTaskQ->nType == nGames - 1);
+    CHECK(ptSecondTaskQ->nType == 1);
+
+    // The owner pops its games from the front, in queuing order
+    for (int i = 0; i < nGames - 1; ++i)
+    {
+        CAPTURE(i);
+        CHECK(PopGameTask(0) == aGames[i].pGameTask);
+    }
+
+    // Nothing is left to pop or to steal: the second queue only owns one game
+    int32_t nResult = 0;
+    CHECK(PopGameTask(0, &nResult) == nullptr);
+    CHECK(nResult > 0);
+    CHECK(D2Game_10044(0) > 0);
+
+    // Games processed again later are not due yet
+    TASK_QueueIncrement(ptFirstTaskQ, &aGames[0].pGameTask->nDueTimeMs, 60000);
+    CHECK(PopGameTask(0, &nResult) == nullptr);
+    CHECK(nResult > TASK_GAME_FRAME_MS);
+    CHECK(D2Game_10044(0) > TASK_GAME_FRAME_MS);
+    CHECK(GetQueuedGameTasks(ptFirstTaskQ) == std::vector<D2GameTaskStrc*>{ aGames[0].pGameTask });
+}
+
+TEST_CASE("TASK workers complete every game once while stealing from each other")
+{
+    constexpr int nWorkers = 4;
+    constexpr int nGames = 400;
+
+    TestTaskQueues tQueues;
+    tQueues.Add(0);
+
+    // Every game starts on the first queue, the other workers have to steal them
+    std::vector<TestGame> aGames(nGames);
+    for (int i = 0; i < nGames; ++i)
+    {
+        REQUIRE(D2Game_10042((D2TaskStrc*)aGames[i].pGameTask, TASK_PROCESSGAME, (D2LinkStrc*)(uintptr_t)i));
+    }
+    for (int32_t nWorker = 1; nWorker < nWorkers; ++nWorker)
+    {
+        tQueues.Add(nWorker);
+    }
+
+    std::atomic<int> nCompletedGames{ 0 };
+    std::unique_ptr<std::atomic<int>[]> aCompletions(new std::atomic<int>[nGames]);
+    for (int i = 0; i < nGames; ++i)
+    {
+        aCompletions[i] = 0;
+    }
+
+    std::atomic<bool> bStarted{ false };
+    int aGamesPerWorker[nWorkers] = {};
+    std::vector<std::thread> aWorkers;
+    for (int32_t nWorker = 0; nWorker < nWorkers; ++nWorker)
+    {
+        aWorkers.emplace_back([&, nWorker]()
+        {
+            while (!bStarted)
+            {
+                std::this_thread::yield();
+            }
+
+            while (nCompletedGames < nGames)
+            {
+                if (D2GameTaskStrc* pGameTask = PopGameTask(nWorker))
+                {
+                    ++aCompletions[pGameTask->nGameHashKey];
+                    ++aGamesPerWorker[nWorker];
+                    ++nCompletedGames;
+
+                    // Processing a game takes time, which lets the other workers steal
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    bStarted = true;
+    for (std::thread& rWorker : aWorkers)
+    {
+        rWorker.join();
+    }
+
+    for (int i = 0; i < nGames; ++i)
+    {
+        CAPTURE(i);
+        CHECK(aCompletions[i] == 1);
+    }
+    MESSAGE("Games per worker: ", aGamesPerWorker[0], ", ", aGamesPerWorker[1], ", ", aGamesPerWorker[2], ", ", aGamesPerWorker[3]);
+    for (int32_t nWorker = 1; nWorker < nWorkers; ++nWorker)
+    {
+        CHECK(aGamesPerWorker[nWorker] > 0);
+    }
+}
@@ -120,24 +120,69 @@ static constexpr unsigned short sgCrc16LookupTable[CRC_LOOKUP_TABLE_COUNT] = {
     GenerateCrc(252), GenerateCrc(253), GenerateCrc(254), GenerateCrc(255),
 };
 
+/**
+ * Lookup tables used to process 8 bytes per step (slicing-by-8). The
+ * entry i of table k is the CRC-16 of the byte i followed by k zero
+ * bytes, table 0 being sgCrc16LookupTable.
+ *
+ * D2Moo only: the game processes one byte per step.
+ */
+struct Crc16SlicingTables {
+  unsigned short tables[8][CRC_LOOKUP_TABLE_COUNT];
+
+  constexpr Crc16SlicingTables() : tables() {
+    for (size_t i = 0; i < CRC_LOOKUP_TABLE_COUNT; ++i) {
+      tables[0][i] = sgCrc16LookupTable[i];
+    }
+
+    for (size_t k = 1; k < 8; ++k) {
+      for (size_t i = 0; i < CRC_LOOKUP_TABLE_COUNT; ++i) {
+        const unsigned short previous = tables[k - 1][i];
+        tables[k][i] = static_cast<unsigned short>(
+            (previous << 8) ^ sgCrc16LookupTable[previous >> 8]);
+      }
+    }
+  }
+};
+
+static constexpr Crc16SlicingTables sgCrc16SlicingTables;
+
 void __stdcall CRC16_CalculateChecksum(
     unsigned short* crc16_checksum_out,
     const unsigned char* data,
     size_t start_index,
     size_t end_index) {
+  const unsigned short (*tables)[CRC_LOOKUP_TABLE_COUNT] =
+      sgCrc16SlicingTables.tables;
+  unsigned short crc16_checksum;
   size_t i;
   unsigned char high_byte;
   size_t lookup_index;
 
   D2_ASSERT(start_index < end_index);
 
-  *crc16_checksum_out = 0xFFFF;
+  crc16_checksum = 0xFFFF;
+
+  for (i = start_index; i + 8 <= end_index; i += 8) {
+    const unsigned char* bytes = &data[i];
 
-  for (i = start_index; i < end_index; ++i) {
-    high_byte = *crc16_checksum_out >> 8;
+    crc16_checksum = tables[7][(crc16_checksum >> 8) ^ bytes[0]]
+        ^ tables[6][(crc16_checksum & 0xFF) ^ bytes[1]]
+        ^ tables[5][bytes[2]]
+        ^ tables[4][bytes[3]]
+        ^ tables[3][bytes[4]]
+        ^ tables[2][bytes[5]]
+        ^ tables[1][bytes[6]]
+        ^ tables[0][bytes[7]];
+  }
+
+  for (; i < end_index; ++i) {
+    high_byte = crc16_checksum >> 8;
     lookup_index = high_byte ^ data[i];
 
-    *crc16_checksum_out <<= 8;
-    *crc16_checksum_out ^= sgCrc16LookupTable[lookup_index];
+    crc16_checksum <<= 8;
+    crc16_checksum ^= sgCrc16LookupTable[lookup_index];
   }
+
+  *crc16_checksum_out = crc16_checksum;
 }
@@ -0,0 +1,124 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <D2Crc16.h>
+
+namespace
+{
+    // Implementation of CRC16_CalculateChecksum as it was before processing 8 bytes per step, used as a reference.
+    // Implementation of CRC16_CalculateChecksum as it was before processing 8 bytes per step, used as a reference.
+    namespace Legacy
+    {
+        struct LookupTable
+        {
+            unsigned short table[256];
+
+            LookupTable()
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    unsigned short crc = (unsigned short)i;
+                    for (int bit = 0; bit < 16; ++bit)
+                    {
+                        crc = (crc & 0x8000) ? (unsigned short)((crc << 1) ^ 0x1021) : (unsigned short)(crc << 1);
+                    }
+                    table[i] = crc;
+                }
+            }
+        };
+
+        const LookupTable sgCrc16LookupTable;
+
+        unsigned short CRC16_CalculateChecksum(const unsigned char* data, size_t start_index, size_t end_index)
+        {
+            unsigned short crc = 0xFFFF;
+            for (size_t i = start_index; i < end_index; ++i)
+            {
+                crc = (unsigned short)((crc << 8) ^ sgCrc16LookupTable.table[(crc >> 8) ^ data[i]]);
+            }
+            return crc;
+        }
+    }
+
+    unsigned short Crc16(const void* data, size_t start_index, size_t end_index)
+    {
+        unsigned short crc16_checksum = 0;
+        CRC16_CalculateChecksum(&crc16_checksum, (const unsigned char*)data, start_index, end_index);
+        return crc16_checksum;
+    }
+}
+
+TEST_CASE("CRC16_CalculateChecksum vectors")
+{
+    // CRC-16/CCITT-FALSE
+    const char szCheck[] = "123456789";
+    CHECK(Crc16(szCheck, 0, strlen(szCheck)) == 0x29B1);
+    CHECK(Crc16("A", 0, 1) == 0xB915);
+    CHECK(Crc16(szCheck, 4, strlen(szCheck)) == Legacy::CRC16_CalculateChecksum((const unsigned char*)szCheck, 4, strlen(szCheck)));
+
+    std::vector<unsigned char> aZeroes(256);
+    CHECK(Crc16(aZeroes.data(), 0, aZeroes.size()) == Legacy::CRC16_CalculateChecksum(aZeroes.data(), 0, aZeroes.size()));
+}
+
+TEST_CASE("CRC16_CalculateChecksum matches the bytewise implementation")
+{
+    std::mt19937 tRand(0x6FC13D80);
+    std::vector<unsigned char> aData(1024);
+    for (unsigned char& nByte : aData)
+    {
+        nByte = (unsigned char)tRand();
+    }
+
+    // Every alignment and length around the 8 bytes steps
+    for (size_t nStart = 0; nStart < 16; ++nStart)
+    {
+        for (size_t nEnd = nStart + 1; nEnd < nStart + 80; ++nEnd)
+        {
+            CAPTURE(nStart);
+            CAPTURE(nEnd);
+            REQUIRE(Crc16(aData.data(), nStart, nEnd) == Legacy::CRC16_CalculateChecksum(aData.data(), nStart, nEnd));
+        }
+    }
+
+    for (int nIteration = 0; nIteration < 1000; ++nIteration)
+    {
+        const size_t nStart = tRand() % aData.size();
+        const size_t nEnd = nStart + 1 + tRand() % (aData.size() - nStart);
+        REQUIRE(Crc16(aData.data(), nStart, nEnd) == Legacy::CRC16_CalculateChecksum(aData.data(), nStart, nEnd));
+    }
+}
+
+TEST_CASE("CRC16_CalculateChecksum benchmark")
+{
+    std::mt19937 tRand(0x6FC1D7F0);
+    std::vector<unsigned char> aData(1 << 20);
+    for (unsigned char& nByte : aData)
+    {
+        nByte = (unsigned char)tRand();
+    }
+
+    constexpr int nPasses = 16;
+    unsigned int nExpectedSum = 0;
+    const auto tLegacyStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        nExpectedSum += Legacy::CRC16_CalculateChecksum(aData.data(), nPass, aData.size());
+    }
+    const auto tLegacyElapsed = std::chrono::steady_clock::now() - tLegacyStart;
+
+    unsigned int nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int nPass = 0; nPass < nPasses; ++nPass)
+    {
+        nSum += Crc16(aData.data(), nPass, aData.size());
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Bytewise: ", std::chrono::duration_cast<std::chrono::microseconds>(tLegacyElapsed).count(), "us for ", nPasses, "MB");
+    MESSAGE("Slicing-by-8: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us for ", nPasses, "MB");
+}
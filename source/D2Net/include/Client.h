@@ -19,6 +19,12 @@ D2NET_DLL_DECL void __stdcall CLIENT_Release();
 D2NET_DLL_DECL int32_t __stdcall CLIENT_DequeueGamePacket(uint8_t* pBuffer, uint32_t nBufferSize);
 //D2Net.0x6FC01310 (#10008)
 D2NET_DLL_DECL int32_t __stdcall CLIENT_DequeueSystemPacket(uint8_t* pBuffer, uint32_t nBufferSize);
+// Helper function: Same as calling CLIENT_DequeueGamePacket until it fails, without copying the packets
+// Note: Not exported, the original D2Client.dll only knows CLIENT_DequeueGamePacket
+int32_t __fastcall CLIENT_DrainGamePackets(D2NET_PacketRingDrainCallback pfCallback, void* pContext);
+// Helper function: Same as calling CLIENT_DequeueSystemPacket until it fails, without copying the packets
+// Note: Not exported, the original D2Client.dll only knows CLIENT_DequeueSystemPacket
+int32_t __fastcall CLIENT_DrainSystemPackets(D2NET_PacketRingDrainCallback pfCallback, void* pContext);
 //D2Net.0x6FC01320
 DWORD __stdcall CLIENT_ThreadProc(void* a1);
 //D2Net.0x6FC015C0
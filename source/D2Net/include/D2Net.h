@@ -8,6 +8,38 @@
 
 constexpr int32_t GAME_PORT = 4000;
 
+// D2Moo only
+constexpr uint32_t NET_PACKET_RING_SIZE = 512; // Must be a power of 2
+
+
+#pragma pack(push, 1)
+// D2Moo only: Slot of a D2PacketRingStrc, nSequence tells whether the slot is free or published for a given position
+struct D2PacketRingSlotStrc
+{
+	volatile LONG nSequence;					//0x00
+	uint32_t nPacketSize;						//0x04
+	uint32_t dwTickCount;						//0x08
+	uint8_t data[MAX_MSG_SIZE];					//0x0C
+};
+
+// D2Moo only: Bounded multi-producer/single-consumer queue of packets (Vyukov's algorithm).
+// Producers never wait for the consumer: when the ring is full, packets go to an overflow list (allocated, locked) until it is drained.
+struct D2PacketRingStrc
+{
+	D2PacketRingSlotStrc* pSlots;				//0x00
+	volatile LONG nEnqueuePos;					//0x04
+	uint8_t pad0x08[56];						//0x08 Keep producers and consumer on different cache lines
+	LONG nDequeuePos;							//0x40 Only used by the consumer
+	volatile LONG nOverflowCount;				//0x44
+	D2PacketStrc* pOverflowList;				//0x48
+	D2PacketStrc* pSpareOverflowPackets;		//0x4C Overflow packets already consumed, reused instead of being freed
+	CRITICAL_SECTION tOverflowCriticalSection;	//0x50 Guards pOverflowList and pSpareOverflowPackets
+};
+#pragma pack(pop)
+
+// D2Moo only: Called by NET_PacketRing_Drain for each packet, the data is only valid during the call
+using D2NET_PacketRingDrainCallback = void(__fastcall*)(void* pContext, const uint8_t* pData, uint32_t nPacketSize);
+
 
 //D2Net.0x6FC01A00
 int32_t __stdcall sub_6FC01A00();
@@ -17,3 +49,20 @@ void __fastcall sub_6FC01A20(int32_t a1);
 int32_t __fastcall NET_DequeueFirstPacketFromList(CRITICAL_SECTION* pCriticalSection, D2PacketStrc** ppPacketList, uint8_t* pBuffer, uint32_t nBufferSize);
 //D2Net.0x6FC01AE0
 int32_t __fastcall NET_FreePacketList(CRITICAL_SECTION* pCriticalSection, D2PacketStrc** ppPacketList);
+// Helper function
+void __fastcall NET_PacketRing_Initialize(D2PacketRingStrc* pRing);
+// Helper function: pSlots must hold NET_PACKET_RING_SIZE slots, and is freed by NET_PacketRing_Release
+void __fastcall NET_PacketRing_InitializeWithSlots(D2PacketRingStrc* pRing, D2PacketRingSlotStrc* pSlots);
+// Helper function: Must not be called while the ring is used
+void __fastcall NET_PacketRing_Release(D2PacketRingStrc* pRing);
+// Helper function: Thread safe, returns FALSE without blocking if the packet must go to the overflow list (ring full, or packets already waiting there)
+BOOL __fastcall NET_PacketRing_TryPush(D2PacketRingStrc* pRing, const uint8_t* pData, uint32_t nPacketSize, uint32_t dwTickCount);
+// Helper function: Thread safe, appends a packet to the overflow list, which takes ownership of it
+void __fastcall NET_PacketRing_PushOverflowPacket(D2PacketRingStrc* pRing, D2PacketStrc* pPacket);
+// Helper function: Thread safe, can be called from any thread
+void __fastcall NET_PacketRing_Push(D2PacketRingStrc* pRing, const uint8_t* pData, uint32_t nPacketSize, uint32_t dwTickCount);
+// Helper function: Same as NET_DequeueFirstPacketFromList, must only be called by the consumer thread
+int32_t __fastcall NET_PacketRing_Pop(D2PacketRingStrc* pRing, uint8_t* pBuffer, uint32_t nBufferSize);
+// Helper function: Calls pfCallback for all the packets available, in order, and returns their number. Must only be called by the consumer thread.
+// The packets of the ring are read in place, and the overflow list is taken with a single lock.
+int32_t __fastcall NET_PacketRing_Drain(D2PacketRingStrc* pRing, D2NET_PacketRingDrainCallback pfCallback, void* pContext);
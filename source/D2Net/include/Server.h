@@ -10,6 +10,33 @@ using D2NET_Unk_Callback = void (__stdcall*) (int32_t nClientId, const char* szF
 using D2NET_CLIENT_SendFunctionType = int32_t (__stdcall*) (int32_t nUnused, const uint8_t* pBuffer, int32_t nBufferSize);
 using D2NET_SERVER_GetClientGameGUIDFunctionType = int32_t(__stdcall*)(int32_t nClientId);
 
+// D2Moo only: Size of the largest message sent by D2NET_10006, a batch of frames is never sent in larger chunks.
+constexpr uint32_t SERVER_BATCH_SEND_BUFFER_SIZE = 1036;
+constexpr uint32_t SERVER_CLIENT_BATCH_BUCKETS = 256;
+
+#pragma pack(push, 1)
+// D2Moo only: Network statistics of a client, kept with or without SERVER_IsBatchCompressionEnabled
+struct D2ServerClientNetStatsStrc
+{
+	uint64_t nUncompressedBytes;						//0x00 Size of the packets given to D2NET_10006
+	uint64_t nSentBytes;								//0x08 Size of the data given to the socket, frame headers included
+	uint32_t nMessages;									//0x10 Number of calls to D2NET_10006
+	uint32_t nSends;									//0x14 Number of calls to FOG_10157 (one send syscall each)
+};
+
+// D2Moo only: Network statistics of a client, and its outgoing packets waiting to be compressed and sent when SERVER_IsBatchCompressionEnabled
+struct D2ServerClientBatchStrc
+{
+	int32_t nClientId;									//0x00
+	uint32_t nRawSize;									//0x04
+	uint32_t nSendSize;									//0x08
+	D2ServerClientNetStatsStrc tStats;					//0x0C
+	uint8_t pRawData[MAX_MSG_SIZE];						//0x24 Packets compressed together as a single frame
+	uint8_t pSendData[SERVER_BATCH_SEND_BUFFER_SIZE];	//0x228 Compressed frames sent together
+	D2ServerClientBatchStrc* pNext;						//0x634
+};
+#pragma pack(pop)
+
 //D2Net.0x6FC01B30 (#10024)
 D2NET_DLL_DECL int32_t __stdcall SERVER_WSAGetLastError();
 //D2Net.0x6FC01B60 (#10030)
@@ -80,6 +107,14 @@ D2NET_DLL_DECL int32_t __stdcall SERVER_SetClientGameGUID(int32_t nClientId, int
 D2NET_DLL_DECL int32_t __stdcall SERVER_GetClientGameGUID(int32_t nClientId);
 //D2Net.0x6FC025A0
 int32_t __fastcall SERVER_EnqueuePacketToMessageList(const uint8_t* pBuffer, int32_t nBufferSize);
+// Helper function
+BOOL __fastcall SERVER_IsBatchCompressionEnabled();
+// Helper function: Compresses and sends the packets queued for the client by D2NET_10006, returns FALSE if the send failed (the frames are sent again by the next call)
+// Note: Not exported by the original D2Net.dll, D2Game resolves it at runtime
+D2NET_DLL_DECL BOOL __stdcall SERVER_FlushClientBatch(int32_t nClientId);
+// Helper function: Returns FALSE if nothing was ever sent to the client
+// Note: Not exported by the original D2Net.dll, D2Game resolves it at runtime
+D2NET_DLL_DECL BOOL __stdcall SERVER_GetClientNetStats(int32_t nClientId, D2ServerClientNetStatsStrc* pStats);
 //D2Net.0x6FC025F0 (#10022)
 D2NET_DLL_DECL int32_t __stdcall D2NET_10022(uint32_t dwMilliseconds);
 //D2Net.0x6FC02610 (#10028)
@@ -14,9 +14,9 @@
 
 
 CRITICAL_SECTION gCriticalSection;
-D2PacketStrc* gpSystemPacketList;
+D2PacketRingStrc gSystemPacketRing; // D2Moo only, was a D2PacketStrc* list
 sockaddr_in gHostSockAddr;
-D2PacketStrc* gpGamePacketList;
+D2PacketRingStrc gGamePacketRing; // D2Moo only, was a D2PacketStrc* list
 D2PacketBufferStrc* gpPacketBuffer;
 HANDLE ghClientThread;
 SOCKET gClientSocket;
@@ -115,8 +115,8 @@ int32_t __stdcall D2NET_10025()
 //D2Net.0x6FC011B0 (#10000)
 void __stdcall CLIENT_Initialize(int32_t a1, const char* szIpAddress)
 {
-	gpGamePacketList = nullptr;
-	gpSystemPacketList = nullptr;
+	NET_PacketRing_Initialize(&gGamePacketRing);
+	NET_PacketRing_Initialize(&gSystemPacketRing);
 
 	InitializeCriticalSection(&gCriticalSection);
 
@@ -152,8 +152,8 @@ void __stdcall CLIENT_Release()
 
 	WaitForSingleObject(ghClientThread, 6000u);
 
-	NET_FreePacketList(&gCriticalSection, &gpSystemPacketList);
-	NET_FreePacketList(&gCriticalSection, &gpGamePacketList);
+	NET_PacketRing_Release(&gSystemPacketRing);
+	NET_PacketRing_Release(&gGamePacketRing);
 
 #ifdef NO_BUG_FIX
 	// Original game would lock the CS here, but it is actually undefined behaviour to then delete it.
@@ -181,13 +181,25 @@ void __stdcall CLIENT_Release()
 //D2Net.0x6FC01300 (#10007)
 int32_t __stdcall CLIENT_DequeueGamePacket(uint8_t* pBuffer, uint32_t nBufferSize)
 {
-	return NET_DequeueFirstPacketFromList(&gCriticalSection, &gpGamePacketList, pBuffer, nBufferSize);
+	return NET_PacketRing_Pop(&gGamePacketRing, pBuffer, nBufferSize);
 }
 
 //D2Net.0x6FC01310 (#10008)
 int32_t __stdcall CLIENT_DequeueSystemPacket(uint8_t* pBuffer, uint32_t nBufferSize)
 {
-	return NET_DequeueFirstPacketFromList(&gCriticalSection, &gpSystemPacketList, pBuffer, nBufferSize);
+	return NET_PacketRing_Pop(&gSystemPacketRing, pBuffer, nBufferSize);
+}
+
+// Helper function
+int32_t __fastcall CLIENT_DrainGamePackets(D2NET_PacketRingDrainCallback pfCallback, void* pContext)
+{
+	return NET_PacketRing_Drain(&gGamePacketRing, pfCallback, pContext);
+}
+
+// Helper function
+int32_t __fastcall CLIENT_DrainSystemPackets(D2NET_PacketRingDrainCallback pfCallback, void* pContext)
+{
+	return NET_PacketRing_Drain(&gSystemPacketRing, pfCallback, pContext);
 }
 
 //D2Net.0x6FC01320
@@ -342,12 +354,8 @@ int32_t __stdcall CLIENT_ReadPacketsFromStream()
 			break;
 		}
 
-		D2PacketStrc* pPacket = D2_ALLOC_STRC(D2PacketStrc);
-		pPacket->nPacketSize = nSize;
-		pPacket->dwTickCount = 0;
-		pPacket->pNext = nullptr;
-
-		memcpy(&pPacket->data, pPacketBuffer->data, nSize);
+		const uint8_t* pPacketData = pPacketBuffer->data;
+		uint8_t pPatchedPacketData[MAX_MSG_SIZE];
 
 		if (pPacketBuffer->data[0] == 0xAE && pPacketBuffer->data[1])
 		{
@@ -370,25 +378,20 @@ int32_t __stdcall CLIENT_ReadPacketsFromStream()
 		}
 		else if (pPacketBuffer->data[0] == 0x8F)
 		{
-			*(uint32_t*)&pPacket->data[13] = GetTickCount();
+			memcpy(pPatchedPacketData, pPacketBuffer->data, nSize);
+			*(uint32_t*)&pPatchedPacketData[13] = GetTickCount();
+			pPacketData = pPatchedPacketData;
 		}
 
-		D2PacketStrc** ppLast = nullptr;
 		if (pPacketBuffer->data[0] >= 0xAEu)
 		{
-			ppLast = &gpSystemPacketList;
+			NET_PacketRing_Push(&gSystemPacketRing, pPacketData, nSize, 0);
 		}
 		else
 		{
-			ppLast = &gpGamePacketList;
+			NET_PacketRing_Push(&gGamePacketRing, pPacketData, nSize, 0);
 		}
 
-		for (D2PacketStrc* i = *ppLast; i; i = i->pNext)
-		{
-			ppLast = &i->pNext;
-		}
-		*ppLast = pPacket;
-
 		pPacketBuffer = (D2PacketBufferStrc*)((char*)pPacketBuffer + nSize);
 		nUsedBytes -= nSize;
 	}
@@ -443,8 +446,6 @@ void __fastcall CLIENT_ReadPacketFromBuffer(D2PacketBufferStrc* pBuffer, int32_t
 
 	while (nRemainingBytes > 0)
 	{
-		D2PacketStrc* pPacket = D2_ALLOC_STRC(D2PacketStrc);
-
 		int32_t nSize = 0;
 		if (!SERVER_GetServerPacketSize(pPacketBuffer, nRemainingBytes, &nSize))
 		{
@@ -454,12 +455,6 @@ void __fastcall CLIENT_ReadPacketFromBuffer(D2PacketBufferStrc* pBuffer, int32_t
 		D2_ASSERT(nSize <= MAX_MSG_SIZE);
 		D2_ASSERT(nSize > 0);
 
-		memcpy(&pPacket->data, pPacketBuffer->data, nSize);
-
-		pPacket->nPacketSize = nSize;
-		pPacket->dwTickCount = GetTickCount();
-		pPacket->pNext = nullptr;
-
 		const uint8_t nHeader = pPacketBuffer->data[0];
 		if (nHeader >= 0xB4u)
 		{
@@ -467,40 +462,13 @@ void __fastcall CLIENT_ReadPacketFromBuffer(D2PacketBufferStrc* pBuffer, int32_t
 			exit(-1);
 		}
 
-		D2PacketStrc* pLast = nullptr;
 		if (nHeader >= 0xAEu)
 		{
-			pLast = gpSystemPacketList;
-		}
-		else
-		{
-			pLast = gpGamePacketList;
-		}
-
-		if (pLast)
-		{
-			for (D2PacketStrc* i = pLast->pNext; i; i = i->pNext)
-			{
-				pLast = i;
-			}
-			pLast->pNext = pPacket;
+			NET_PacketRing_Push(&gSystemPacketRing, pPacketBuffer->data, nSize, GetTickCount());
 		}
 		else
 		{
-			if (nHeader >= 0xB4u)
-			{
-				FOG_DisplayHalt("Bad message type", __FILE__, __LINE__);
-				exit(-1);
-			}
-
-			if (nHeader >= 0xAEu)
-			{
-				gpSystemPacketList = pPacket;
-			}
-			else
-			{
-				gpGamePacketList = pPacket;
-			}
+			NET_PacketRing_Push(&gGamePacketRing, pPacketBuffer->data, nSize, GetTickCount());
 		}
 
 		pPacketBuffer = (D2PacketBufferStrc*)((char*)pPacketBuffer + nSize);
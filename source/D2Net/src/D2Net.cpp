@@ -61,3 +61,247 @@ int32_t __fastcall NET_FreePacketList(CRITICAL_SECTION* pCriticalSection, D2Pack
 	D2_UNLOCK(pCriticalSection);
 	return 1;
 }
+
+// Helper function
+static inline LONG NET_PacketRing_Load(volatile LONG* pValue)
+{
+	return InterlockedCompareExchange(pValue, 0, 0);
+}
+
+// Helper function: Lag simulation, as done by NET_DequeueFirstPacketFromList
+static inline BOOL NET_PacketRing_IsPacketDelayed(uint32_t dwTickCount)
+{
+	return dword_6FC0B264 == 2 && GetTickCount() - dwTickCount < 500;
+}
+
+// Helper function
+void __fastcall NET_PacketRing_Initialize(D2PacketRingStrc* pRing)
+{
+	NET_PacketRing_InitializeWithSlots(pRing, (D2PacketRingSlotStrc*)D2_ALLOC(sizeof(D2PacketRingSlotStrc) * NET_PACKET_RING_SIZE));
+}
+
+// Helper function
+void __fastcall NET_PacketRing_InitializeWithSlots(D2PacketRingStrc* pRing, D2PacketRingSlotStrc* pSlots)
+{
+	memset(pRing, 0x00, sizeof(D2PacketRingStrc));
+	pRing->pSlots = pSlots;
+	for (uint32_t i = 0; i < NET_PACKET_RING_SIZE; ++i)
+	{
+		pRing->pSlots[i].nSequence = i;
+	}
+	InitializeCriticalSection(&pRing->tOverflowCriticalSection);
+}
+
+// Helper function
+void __fastcall NET_PacketRing_Release(D2PacketRingStrc* pRing)
+{
+	if (!pRing->pSlots)
+	{
+		return;
+	}
+
+	NET_FreePacketList(&pRing->tOverflowCriticalSection, &pRing->pOverflowList);
+	NET_FreePacketList(&pRing->tOverflowCriticalSection, &pRing->pSpareOverflowPackets);
+	DeleteCriticalSection(&pRing->tOverflowCriticalSection);
+	D2_FREE(pRing->pSlots);
+	pRing->pSlots = nullptr;
+}
+
+// Helper function
+BOOL __fastcall NET_PacketRing_TryPush(D2PacketRingStrc* pRing, const uint8_t* pData, uint32_t nPacketSize, uint32_t dwTickCount)
+{
+	D2_ASSERT(nPacketSize <= MAX_MSG_SIZE);
+
+	// Once packets overflowed, the next ones must wait behind them to keep the order
+	if (NET_PacketRing_Load(&pRing->nOverflowCount))
+	{
+		return FALSE;
+	}
+
+	LONG nPos = NET_PacketRing_Load(&pRing->nEnqueuePos);
+	while (true)
+	{
+		D2PacketRingSlotStrc* pSlot = &pRing->pSlots[nPos & (NET_PACKET_RING_SIZE - 1)];
+		const LONG nDiff = NET_PacketRing_Load(&pSlot->nSequence) - nPos;
+		if (nDiff == 0)
+		{
+			if (InterlockedCompareExchange(&pRing->nEnqueuePos, nPos + 1, nPos) == nPos)
+			{
+				memcpy(pSlot->data, pData, nPacketSize);
+				pSlot->nPacketSize = nPacketSize;
+				pSlot->dwTickCount = dwTickCount;
+				InterlockedExchange(&pSlot->nSequence, nPos + 1);
+				return TRUE;
+			}
+		}
+		else if (nDiff < 0)
+		{
+			return FALSE; // Full
+		}
+		nPos = NET_PacketRing_Load(&pRing->nEnqueuePos);
+	}
+}
+
+// Helper function
+void __fastcall NET_PacketRing_PushOverflowPacket(D2PacketRingStrc* pRing, D2PacketStrc* pPacket)
+{
+	pPacket->pNext = nullptr;
+
+	D2_LOCK(&pRing->tOverflowCriticalSection);
+	D2PacketStrc** ppLast = &pRing->pOverflowList;
+	while (*ppLast)
+	{
+		ppLast = &(*ppLast)->pNext;
+	}
+	*ppLast = pPacket;
+	InterlockedIncrement(&pRing->nOverflowCount);
+	D2_UNLOCK(&pRing->tOverflowCriticalSection);
+}
+
+// Helper function
+void __fastcall NET_PacketRing_Push(D2PacketRingStrc* pRing, const uint8_t* pData, uint32_t nPacketSize, uint32_t dwTickCount)
+{
+	if (NET_PacketRing_TryPush(pRing, pData, nPacketSize, dwTickCount))
+	{
+		return;
+	}
+
+	D2_LOCK(&pRing->tOverflowCriticalSection);
+	D2PacketStrc* pPacket = pRing->pSpareOverflowPackets;
+	if (pPacket)
+	{
+		pRing->pSpareOverflowPackets = pPacket->pNext;
+	}
+	D2_UNLOCK(&pRing->tOverflowCriticalSection);
+
+	if (!pPacket)
+	{
+		pPacket = D2_ALLOC_STRC(D2PacketStrc);
+	}
+
+	memcpy(pPacket->data, pData, nPacketSize);
+	pPacket->nPacketSize = nPacketSize;
+	pPacket->dwTickCount = dwTickCount;
+	NET_PacketRing_PushOverflowPacket(pRing, pPacket);
+}
+
+// Helper function: Overflowed packets are newer than the packets of the ring, they must wait until the ring is really empty
+// (a producer may still be writing the next slot). Must be called with the overflow lock held: a producer that filled
+// the ring after the check can then only add its next packets to the list once the consumer took the previous ones.
+static BOOL NET_PacketRing_CanReadOverflowList(D2PacketRingStrc* pRing)
+{
+	return NET_PacketRing_Load(&pRing->nEnqueuePos) == pRing->nDequeuePos;
+}
+
+// Helper function
+int32_t __fastcall NET_PacketRing_Pop(D2PacketRingStrc* pRing, uint8_t* pBuffer, uint32_t nBufferSize)
+{
+	const LONG nPos = pRing->nDequeuePos;
+	D2PacketRingSlotStrc* pSlot = &pRing->pSlots[nPos & (NET_PACKET_RING_SIZE - 1)];
+	if (NET_PacketRing_Load(&pSlot->nSequence) == nPos + 1)
+	{
+		if (NET_PacketRing_IsPacketDelayed(pSlot->dwTickCount))
+		{
+			return -1;
+		}
+
+		memcpy(pBuffer, pSlot->data, std::min(nBufferSize, MAX_MSG_SIZE));
+		const int32_t nPacketSize = pSlot->nPacketSize;
+
+		pRing->nDequeuePos = nPos + 1;
+		InterlockedExchange(&pSlot->nSequence, nPos + NET_PACKET_RING_SIZE);
+		return nPacketSize;
+	}
+
+	if (!NET_PacketRing_Load(&pRing->nOverflowCount))
+	{
+		return -1;
+	}
+
+	D2_LOCK(&pRing->tOverflowCriticalSection);
+
+	D2PacketStrc* pPacket = pRing->pOverflowList;
+	if (!pPacket || !NET_PacketRing_CanReadOverflowList(pRing) || NET_PacketRing_IsPacketDelayed(pPacket->dwTickCount))
+	{
+		D2_UNLOCK(&pRing->tOverflowCriticalSection);
+		return -1;
+	}
+
+	memcpy(pBuffer, pPacket->data, std::min(nBufferSize, MAX_MSG_SIZE));
+	const int32_t nPacketSize = pPacket->nPacketSize;
+
+	pRing->pOverflowList = pPacket->pNext;
+	pPacket->pNext = pRing->pSpareOverflowPackets;
+	pRing->pSpareOverflowPackets = pPacket;
+	InterlockedDecrement(&pRing->nOverflowCount);
+
+	D2_UNLOCK(&pRing->tOverflowCriticalSection);
+	return nPacketSize;
+}
+
+// Helper function
+int32_t __fastcall NET_PacketRing_Drain(D2PacketRingStrc* pRing, D2NET_PacketRingDrainCallback pfCallback, void* pContext)
+{
+	int32_t nPackets = 0;
+	while (true)
+	{
+		const LONG nPos = pRing->nDequeuePos;
+		D2PacketRingSlotStrc* pSlot = &pRing->pSlots[nPos & (NET_PACKET_RING_SIZE - 1)];
+		if (NET_PacketRing_Load(&pSlot->nSequence) != nPos + 1)
+		{
+			break;
+		}
+
+		if (NET_PacketRing_IsPacketDelayed(pSlot->dwTickCount))
+		{
+			return nPackets;
+		}
+
+		pfCallback(pContext, pSlot->data, pSlot->nPacketSize);
+		++nPackets;
+
+		pRing->nDequeuePos = nPos + 1;
+		InterlockedExchange(&pSlot->nSequence, nPos + NET_PACKET_RING_SIZE);
+	}
+
+	if (!NET_PacketRing_Load(&pRing->nOverflowCount))
+	{
+		return nPackets;
+	}
+
+	// Detach the packets that can be read, producers keep appending behind them
+	D2_LOCK(&pRing->tOverflowCriticalSection);
+	const BOOL bCanReadOverflowList = NET_PacketRing_CanReadOverflowList(pRing);
+	D2PacketStrc* pFirstPacket = pRing->pOverflowList;
+	D2PacketStrc** ppLast = &pFirstPacket;
+	LONG nOverflowPackets = 0;
+	while (bCanReadOverflowList && *ppLast && !NET_PacketRing_IsPacketDelayed((*ppLast)->dwTickCount))
+	{
+		ppLast = &(*ppLast)->pNext;
+		++nOverflowPackets;
+	}
+	pRing->pOverflowList = *ppLast;
+	*ppLast = nullptr;
+	D2_UNLOCK(&pRing->tOverflowCriticalSection);
+
+	if (!pFirstPacket)
+	{
+		return nPackets;
+	}
+
+	D2PacketStrc* pLastPacket = nullptr;
+	for (D2PacketStrc* pPacket = pFirstPacket; pPacket; pPacket = pPacket->pNext)
+	{
+		pfCallback(pContext, pPacket->data, pPacket->nPacketSize);
+		pLastPacket = pPacket;
+	}
+
+	// Producers only go back to the ring once the count reaches 0, after the packets were read
+	D2_LOCK(&pRing->tOverflowCriticalSection);
+	pLastPacket->pNext = pRing->pSpareOverflowPackets;
+	pRing->pSpareOverflowPackets = pFirstPacket;
+	InterlockedExchangeAdd(&pRing->nOverflowCount, -nOverflowPackets);
+	D2_UNLOCK(&pRing->tOverflowCriticalSection);
+
+	return nPackets + nOverflowPackets;
+}
@@ -13,6 +13,8 @@
 
 QServer* gpServer;
 int32_t gnLocalClientGameGuid_6FC0B26C;
+CRITICAL_SECTION gClientBatchesCriticalSection;
+D2ServerClientBatchStrc* gpClientBatches[SERVER_CLIENT_BATCH_BUCKETS];
 
 
 constexpr int32_t VARIABLE_PACKET_SIZE = -1;
@@ -732,6 +734,7 @@ int32_t __stdcall SERVER_WaitForSingleObject(uint32_t dwMilliseconds)
 //D2Net.0x6FC02150 (#10003)
 void __stdcall SERVER_Initialize(int32_t a1, int32_t a2)
 {
+	InitializeCriticalSection(&gClientBatchesCriticalSection);
 	gpServer = FOG_InitializeServer(a1, 3, GAME_PORT, a2, SERVER_ValidateClientPacket, sub_6FC020B0, sub_6FC020E0, SERVER_ReadPacketFromBufferCallback);
 }
 
@@ -772,6 +775,16 @@ void __stdcall SERVER_Release()
 	FOG_10152(gpServer, data, sizeof(data));
 
 	gpServer = nullptr;
+
+	for (int32_t i = 0; i < SERVER_CLIENT_BATCH_BUCKETS; ++i)
+	{
+		while (D2ServerClientBatchStrc* pBatch = gpClientBatches[i])
+		{
+			gpClientBatches[i] = pBatch->pNext;
+			D2_FREE(pBatch);
+		}
+	}
+	DeleteCriticalSection(&gClientBatchesCriticalSection);
 }
 
 // TODO: Better name
@@ -795,7 +808,168 @@ int32_t __stdcall SERVER_ReadFromMessageList2(uint8_t* pBuffer, int32_t nBufferS
 	return FOG_10156(gpServer, 2, pBuffer, nBufferSize);
 }
 
+// Helper function
+BOOL __fastcall SERVER_IsBatchCompressionEnabled()
+{
+	static const BOOL bEnabled = []()
+	{
+		char* szValue = nullptr;
+		size_t nBufferSize = 0;
+		BOOL bResult = FALSE;
+		if (0 == _dupenv_s(&szValue, &nBufferSize, "D2_NET_BATCH_COMPRESSION") && szValue)
+		{
+			bResult = atoi(szValue) != 0;
+			free(szValue);
+		}
+		return bResult;
+	}();
+	return bEnabled;
+}
+
+// Helper function
+static D2ServerClientBatchStrc* SERVER_GetClientBatch(int32_t nClientId, BOOL bCreate)
+{
+	D2_LOCK(&gClientBatchesCriticalSection);
+
+	D2ServerClientBatchStrc** ppBucket = &gpClientBatches[(uint32_t)nClientId % SERVER_CLIENT_BATCH_BUCKETS];
+	D2ServerClientBatchStrc* pBatch = *ppBucket;
+	while (pBatch && pBatch->nClientId != nClientId)
+	{
+		pBatch = pBatch->pNext;
+	}
+
+	if (!pBatch && bCreate)
+	{
+		pBatch = D2_ALLOC_STRC(D2ServerClientBatchStrc);
+		memset(pBatch, 0x00, sizeof(D2ServerClientBatchStrc));
+		pBatch->nClientId = nClientId;
+		pBatch->pNext = *ppBucket;
+		*ppBucket = pBatch;
+	}
+
+	D2_UNLOCK(&gClientBatchesCriticalSection);
+	return pBatch;
+}
+
+// Helper function
+static void SERVER_FreeClientBatch(int32_t nClientId)
+{
+	D2_LOCK(&gClientBatchesCriticalSection);
+
+	D2ServerClientBatchStrc** ppBatch = &gpClientBatches[(uint32_t)nClientId % SERVER_CLIENT_BATCH_BUCKETS];
+	while (*ppBatch && (*ppBatch)->nClientId != nClientId)
+	{
+		ppBatch = &(*ppBatch)->pNext;
+	}
+
+	if (D2ServerClientBatchStrc* pBatch = *ppBatch)
+	{
+		*ppBatch = pBatch->pNext;
+		D2_FREE(pBatch);
+	}
+
+	D2_UNLOCK(&gClientBatchesCriticalSection);
+}
+
+// Helper function
+static BOOL SERVER_SendToClient(int32_t nClientId, D2ServerClientBatchStrc* pBatch, const uint8_t* pData, uint32_t nSize)
+{
+	++pBatch->tStats.nSends;
+	pBatch->tStats.nSentBytes += nSize;
+	return FOG_10157(gpServer, nClientId, pData, nSize) != 0;
+}
+
+// Helper function: Frames use the same header as the messages of D2NET_10006, so that clients do not see any difference
+static uint32_t SERVER_CompressFrame(uint8_t* pFrame, const uint8_t* pBuffer, uint32_t nBufferSize)
+{
+	const uint32_t nSize = FOG_10223(&pFrame[2], 1032, pBuffer, nBufferSize);
+	D2_ASSERT(nSize);
+
+	if (nSize + 1 < 0xF0)
+	{
+		pFrame[0] = nSize + 1;
+		memmove(&pFrame[1], &pFrame[2], nSize);
+		return nSize + 1;
+	}
+
+	const uint32_t nFrameSize = nSize + 2;
+	pFrame[0] = BYTE1(nFrameSize) | 0xF0;
+	pFrame[1] = nFrameSize;
+	return nFrameSize;
+}
+
+// Helper function: The frames are kept when the send fails, and sent again by the next flush
+static BOOL SERVER_SendBatchFrames(D2ServerClientBatchStrc* pBatch)
+{
+	if (!pBatch->nSendSize)
+	{
+		return TRUE;
+	}
+
+	if (!SERVER_SendToClient(pBatch->nClientId, pBatch, pBatch->pSendData, pBatch->nSendSize))
+	{
+		return FALSE;
+	}
+
+	pBatch->nSendSize = 0;
+	return TRUE;
+}
+
+// Helper function: Compresses the queued packets as a single frame, they are kept queued if the frame can not be stored
+static BOOL SERVER_CloseBatchFrame(D2ServerClientBatchStrc* pBatch)
+{
+	if (!pBatch->nRawSize)
+	{
+		return TRUE;
+	}
+
+	uint8_t pFrame[SERVER_BATCH_SEND_BUFFER_SIZE];
+	const uint32_t nFrameSize = SERVER_CompressFrame(pFrame, pBatch->pRawData, pBatch->nRawSize);
+	if (pBatch->nSendSize + nFrameSize > sizeof(pBatch->pSendData) && !SERVER_SendBatchFrames(pBatch))
+	{
+		return FALSE;
+	}
+
+	memcpy(&pBatch->pSendData[pBatch->nSendSize], pFrame, nFrameSize);
+	pBatch->nSendSize += nFrameSize;
+	pBatch->nRawSize = 0;
+	return TRUE;
+}
+
+// Helper function
+static BOOL SERVER_FlushBatch(D2ServerClientBatchStrc* pBatch)
+{
+	return SERVER_CloseBatchFrame(pBatch) && SERVER_SendBatchFrames(pBatch);
+}
+
+// Helper function
+BOOL __stdcall SERVER_FlushClientBatch(int32_t nClientId)
+{
+	if (sub_6FC01A00() || !SERVER_IsBatchCompressionEnabled())
+	{
+		return TRUE;
+	}
+
+	D2ServerClientBatchStrc* pBatch = SERVER_GetClientBatch(nClientId, FALSE);
+	return !pBatch || SERVER_FlushBatch(pBatch);
+}
+
+// Helper function
+BOOL __stdcall SERVER_GetClientNetStats(int32_t nClientId, D2ServerClientNetStatsStrc* pStats)
+{
+	D2ServerClientBatchStrc* pBatch = SERVER_GetClientBatch(nClientId, FALSE);
+	if (!pBatch)
+	{
+		return FALSE;
+	}
+
+	*pStats = pBatch->tStats;
+	return TRUE;
+}
+
 //D2Net.0x6FC022B0 (#10006)
+// D2Moo: when SERVER_IsBatchCompressionEnabled, the packets sent with a1 == 1 (the packets queued by the game during a frame)
+// are compressed together and sent when the frame ends, see SERVER_FlushClientBatch. The statistics of the client are kept in both modes.
 uint32_t __stdcall D2NET_10006(int8_t a1, int32_t nClientId, void* pBufferArg, uint32_t nBufferSize)
 {
 	const uint8_t* pBuffer = (const uint8_t*)pBufferArg;
@@ -808,15 +982,42 @@ uint32_t __stdcall D2NET_10006(int8_t a1, int32_t nClientId, void* pBufferArg, u
 		return nBufferSize;
 	}
 
+	D2ServerClientBatchStrc* pBatch = SERVER_GetClientBatch(nClientId, TRUE);
+	const BOOL bBatchCompression = SERVER_IsBatchCompressionEnabled();
+	if (bBatchCompression)
+	{
+		// Keep the packets order: frames that failed to be sent go first, and the queued packets go before the other messages.
+		// On failure the packet is not queued, the caller sends it again later as with a failed send.
+		if (a1 == 1 ? !SERVER_SendBatchFrames(pBatch) : !SERVER_FlushBatch(pBatch))
+		{
+			return 0;
+		}
+	}
+
+	++pBatch->tStats.nMessages;
+	pBatch->tStats.nUncompressedBytes += nBufferSize;
+
 	if (!a1 && *pBuffer == 0xAE)
 	{
-		return FOG_10157(gpServer, nClientId, pBuffer, nBufferSize) != 0 ? nBufferSize : 0;
+		return SERVER_SendToClient(nClientId, pBatch, pBuffer, nBufferSize) ? nBufferSize : 0;
 	}
 
 	FOG_10222(pBuffer, nBufferSize);
 	if (a1 == 2)
 	{
-		return FOG_10157(gpServer, nClientId, pBuffer, nBufferSize) != 0 ? nBufferSize : 0;
+		return SERVER_SendToClient(nClientId, pBatch, pBuffer, nBufferSize) ? nBufferSize : 0;
+	}
+
+	if (bBatchCompression)
+	{
+		if (pBatch->nRawSize + nBufferSize > sizeof(pBatch->pRawData) && !SERVER_CloseBatchFrame(pBatch))
+		{
+			return 0;
+		}
+
+		memcpy(&pBatch->pRawData[pBatch->nRawSize], pBuffer, nBufferSize);
+		pBatch->nRawSize += nBufferSize;
+		return nBufferSize;
 	}
 
 	uint8_t data[1036] = {};
@@ -826,13 +1027,13 @@ uint32_t __stdcall D2NET_10006(int8_t a1, int32_t nClientId, void* pBufferArg, u
 	if (nSize + 1 < 0xF0)
 	{
 		data[1] = nSize + 1;
-		return FOG_10157(gpServer, nClientId, &data[1], nSize + 1) != 0 ? nSize + 1 : 0;
+		return SERVER_SendToClient(nClientId, pBatch, &data[1], nSize + 1) ? nSize + 1 : 0;
 	}
 
 	const uint32_t v6 = nSize + 2;
 	data[0] = BYTE1(v6) | 0xF0;
 	data[1] = nSize + 2;
-	return FOG_10157(gpServer, nClientId, data, v6) != 0 ? v6 : 0;
+	return SERVER_SendToClient(nClientId, pBatch, data, v6) ? v6 : 0;
 }
 
 //D2Net.0x6FC02410 (#10014)
@@ -880,6 +1081,13 @@ int32_t __stdcall D2NET_10034(int32_t nClientId, int32_t a2, int32_t a3)
 //D2Net.0x6FC024F0 (#10016)
 void __stdcall D2NET_10016(int32_t nClientId)
 {
+	// D2Moo only
+	if (D2ServerClientBatchStrc* pBatch = SERVER_GetClientBatch(nClientId, FALSE))
+	{
+		SERVER_FlushBatch(pBatch);
+		SERVER_FreeClientBatch(nClientId);
+	}
+
 	FOG_10165(gpServer, nClientId, __FILE__, __LINE__);
 }
 
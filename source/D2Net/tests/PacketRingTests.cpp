@@ -0,0 +1,160 @@
+#include <doctest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <D2Net.h>
+
+namespace
+{
+    // Ring using test-owned memory, so that nothing is allocated with Fog.
+    // The spare packets are used by NET_PacketRing_Push when the ring overflows.
+    struct TestRing
+    {
+        D2PacketRingStrc tRing = {};
+        std::vector<D2PacketRingSlotStrc> aSlots;
+        std::vector<D2PacketStrc> aSparePackets;
+
+        explicit TestRing(size_t nSparePackets)
+            : aSlots(NET_PACKET_RING_SIZE), aSparePackets(nSparePackets)
+        {
+            NET_PacketRing_InitializeWithSlots(&tRing, aSlots.data());
+            for (D2PacketStrc& tPacket : aSparePackets)
+            {
+                tPacket.pNext = tRing.pSpareOverflowPackets;
+                tRing.pSpareOverflowPackets = &tPacket;
+            }
+        }
+
+        ~TestRing()
+        {
+            // Not NET_PacketRing_Release, which would free the memory of the test
+            DeleteCriticalSection(&tRing.tOverflowCriticalSection);
+        }
+
+        size_t GetSparePacketsCount() const
+        {
+            size_t nCount = 0;
+            for (D2PacketStrc* pPacket = tRing.pSpareOverflowPackets; pPacket; pPacket = pPacket->pNext)
+            {
+                ++nCount;
+            }
+            return nCount;
+        }
+    };
+
+    struct TestPacket
+    {
+        uint32_t nProducer;
+        uint32_t nSequence;
+    };
+
+    void PushTestPacket(D2PacketRingStrc* pRing, uint32_t nProducer, uint32_t nSequence)
+    {
+        const TestPacket tPacket = { nProducer, nSequence };
+        NET_PacketRing_Push(pRing, (const uint8_t*)&tPacket, sizeof(tPacket), 0);
+    }
+
+    void __fastcall CollectTestPacket(void* pContext, const uint8_t* pData, uint32_t nPacketSize)
+    {
+        REQUIRE(nPacketSize == sizeof(TestPacket));
+        TestPacket tPacket = {};
+        memcpy(&tPacket, pData, sizeof(tPacket));
+        ((std::vector<TestPacket>*)pContext)->push_back(tPacket);
+    }
+}
+
+TEST_CASE("NET_PacketRing spills into the overflow list and keeps the order")
+{
+    constexpr uint32_t nOverflowPackets = 10;
+    TestRing tTestRing(2 * nOverflowPackets);
+    D2PacketRingStrc* pRing = &tTestRing.tRing;
+
+    uint32_t nPushed = 0;
+    for (; nPushed < NET_PACKET_RING_SIZE + nOverflowPackets; ++nPushed)
+    {
+        PushTestPacket(pRing, 0, nPushed);
+    }
+    CHECK(pRing->nOverflowCount == nOverflowPackets);
+    CHECK(tTestRing.GetSparePacketsCount() == nOverflowPackets);
+
+    // The ring has room again, but the next packets must still wait behind the overflowed ones
+    uint8_t pBuffer[MAX_MSG_SIZE] = {};
+    REQUIRE(NET_PacketRing_Pop(pRing, pBuffer, sizeof(pBuffer)) == sizeof(TestPacket));
+    CHECK(((TestPacket*)pBuffer)->nSequence == 0);
+    CHECK_FALSE(NET_PacketRing_TryPush(pRing, pBuffer, sizeof(TestPacket), 0));
+    PushTestPacket(pRing, 0, nPushed++);
+    CHECK(pRing->nOverflowCount == nOverflowPackets + 1);
+
+    std::vector<TestPacket> aPackets;
+    CHECK(NET_PacketRing_Drain(pRing, CollectTestPacket, &aPackets) == (int32_t)nPushed - 1);
+    REQUIRE(aPackets.size() == nPushed - 1);
+    for (uint32_t i = 0; i < aPackets.size(); ++i)
+    {
+        CHECK(aPackets[i].nSequence == i + 1);
+    }
+
+    // The overflow packets are reused, and the ring is used again
+    CHECK(pRing->nOverflowCount == 0);
+    CHECK(pRing->pOverflowList == nullptr);
+    CHECK(tTestRing.GetSparePacketsCount() == 2 * nOverflowPackets);
+    CHECK(NET_PacketRing_TryPush(pRing, pBuffer, sizeof(TestPacket), 0));
+    CHECK(NET_PacketRing_Drain(pRing, CollectTestPacket, &aPackets) == 1);
+    CHECK(NET_PacketRing_Pop(pRing, pBuffer, sizeof(pBuffer)) == -1);
+    CHECK(NET_PacketRing_Drain(pRing, CollectTestPacket, &aPackets) == 0);
+}
+
+TEST_CASE("NET_PacketRing keeps the order of each producer")
+{
+    constexpr uint32_t nProducers = 4;
+    constexpr uint32_t nPacketsPerProducer = 20000;
+    // Enough spare packets for the worst case, where the consumer does not run until everything was pushed
+    TestRing tTestRing(nProducers * nPacketsPerProducer);
+    D2PacketRingStrc* pRing = &tTestRing.tRing;
+
+    std::vector<std::thread> aProducers;
+    for (uint32_t nProducer = 0; nProducer < nProducers; ++nProducer)
+    {
+        aProducers.emplace_back([pRing, nProducer]()
+        {
+            for (uint32_t nSequence = 0; nSequence < nPacketsPerProducer; ++nSequence)
+            {
+                PushTestPacket(pRing, nProducer, nSequence);
+            }
+        });
+    }
+
+    std::vector<TestPacket> aPackets;
+    aPackets.reserve(nProducers * nPacketsPerProducer);
+    uint32_t nDrains = 0;
+    while (aPackets.size() < nProducers * nPacketsPerProducer)
+    {
+        if (NET_PacketRing_Drain(pRing, CollectTestPacket, &aPackets))
+        {
+            ++nDrains;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& tProducer : aProducers)
+    {
+        tProducer.join();
+    }
+
+    uint32_t aNextSequences[nProducers] = {};
+    for (const TestPacket& tPacket : aPackets)
+    {
+        REQUIRE(tPacket.nProducer < nProducers);
+        REQUIRE(tPacket.nSequence == aNextSequences[tPacket.nProducer]);
+        ++aNextSequences[tPacket.nProducer];
+    }
+
+    CHECK(NET_PacketRing_Drain(pRing, CollectTestPacket, &aPackets) == 0);
+    CHECK(pRing->nOverflowCount == 0);
+    CHECK(tTestRing.GetSparePacketsCount() == nProducers * nPacketsPerProducer);
+    MESSAGE(aPackets.size(), " packets received in ", nDrains, " drains");
+}
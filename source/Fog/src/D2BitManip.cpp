@@ -1,5 +1,7 @@
 #include "D2BitManip.h"
 
+#include <cstring>
+
 
 // Fog.6FF71308
 extern "C" const uint32_t gdwBitMasks[] =
@@ -32,6 +34,36 @@ uint8_t gn_6FF7142C[] =
 };
 
 
+// Helper function: Whether the 8 bytes starting at the current byte are inside the buffer, so that they can be accessed as a single word
+static inline bool BITMANIP_CanAccessWord(const D2BitBufferStrc* pBuffer)
+{
+	return pBuffer->nPos >= 0 && pBuffer->nPos + (int32_t)sizeof(uint64_t) <= pBuffer->nBits / 8;
+}
+
+// Helper function
+static inline uint64_t BITMANIP_LoadWord(const uint8_t* pBitStream)
+{
+	// Bitstreams are little endian, as is every platform the game runs on
+	uint64_t nWord = 0;
+	memcpy(&nWord, pBitStream, sizeof(nWord));
+	return nWord;
+}
+
+// Helper function
+static inline void BITMANIP_StoreWord(uint8_t* pBitStream, uint64_t nWord)
+{
+	memcpy(pBitStream, &nWord, sizeof(nWord));
+}
+
+// Helper function
+static inline void BITMANIP_Advance(D2BitBufferStrc* pBuffer, uint32_t nBits)
+{
+	const uint32_t nTotalBits = pBuffer->nPosBits + nBits;
+	pBuffer->pBuffer += nTotalBits >> 3;
+	pBuffer->nPos += nTotalBits >> 3;
+	pBuffer->nPosBits = nTotalBits & 7;
+}
+
 /*
 Function:		BITMANIP_Initialize
 Address:		Fog.#10126
@@ -73,6 +105,25 @@ void __stdcall BITMANIP_Write(D2BitBufferStrc* pBuffer, uint32_t dwValue, uint32
 
 	if ((signed int)(dwBits + pBuffer->nPosBits + 8 * pBuffer->nPos) <= (signed int)pBuffer->nBits)
 	{
+		// D2Moo only: write the whole field at once when the next 8 bytes are in the buffer (at most 7 + 32 bits are written).
+		// Same result as the byte loop below: the bits are ORed into the current byte (cleared first when starting a new byte),
+		// and each following byte that is reached is cleared, including the byte after the field when it ends on a byte boundary.
+		if (dwBits <= 32 && BITMANIP_CanAccessWord(pBuffer))
+		{
+			const uint32_t nTotalBits = pBuffer->nPosBits + dwBits;
+			uint64_t nClearMask = ((1ull << (8 * (nTotalBits >> 3))) - 1) << 8;
+			if (!pBuffer->nPosBits)
+			{
+				nClearMask |= 0xFF;
+			}
+
+			const uint64_t nFieldMask = (1ull << dwBits) - 1;
+			const uint64_t nWord = BITMANIP_LoadWord(pBuffer->pBuffer) & ~nClearMask;
+			BITMANIP_StoreWord(pBuffer->pBuffer, nWord | ((dwValue & nFieldMask) << pBuffer->nPosBits));
+			BITMANIP_Advance(pBuffer, dwBits);
+			return;
+		}
+
 		if (!pBuffer->nPosBits)
 		{
 			*pBuffer->pBuffer = 0;
@@ -159,6 +210,15 @@ uint32_t __stdcall BITMANIP_Read(D2BitBufferStrc* pBuffer, int nBits)
 		pBuffer->bFull = TRUE;
 	}
 
+	// D2Moo only: read the whole field at once when the next 8 bytes are in the buffer (at most 7 + 32 bits are read)
+	if (dwBitsLeft > 0 && dwBitsLeft <= 32 && BITMANIP_CanAccessWord(pBuffer))
+	{
+		const uint64_t nFieldMask = (1ull << dwBitsLeft) - 1;
+		const uint32_t dwValue = (uint32_t)((BITMANIP_LoadWord(pBuffer->pBuffer) >> pBuffer->nPosBits) & nFieldMask);
+		BITMANIP_Advance(pBuffer, dwBitsLeft);
+		return dwValue;
+	}
+
 	uint32_t dwValue = 0;
 	uint32_t dw = 0;
 
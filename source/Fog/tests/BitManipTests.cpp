@@ -0,0 +1,256 @@
+#include <doctest.h>
+
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <D2BitManip.h>
+
+namespace
+{
+    // Implementation of BITMANIP_Read and BITMANIP_Write as they were before reading and writing words, used as a reference.
+    namespace Legacy
+    {
+        const uint32_t gdw_6FF71408[] =
+        {
+            0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x0000000F, 0x0000001F, 0x0000003F, 0x0000007F, 0x000000FF
+        };
+
+        const uint8_t gn_6FF7142C[] =
+        {
+            0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00
+        };
+
+        void BITMANIP_Write(D2BitBufferStrc* pBuffer, uint32_t dwValue, uint32_t dwBits)
+        {
+            uint32_t dwBitsLeft = dwBits;
+            uint32_t dwValueEx = dwValue;
+
+            if ((signed int)(dwBits + pBuffer->nPosBits + 8 * pBuffer->nPos) <= (signed int)pBuffer->nBits)
+            {
+                if (!pBuffer->nPosBits)
+                {
+                    *pBuffer->pBuffer = 0;
+                }
+
+                if (dwBits > 0)
+                {
+                    do
+                    {
+                        size_t n = 8 - pBuffer->nPosBits;
+                        if (n > dwBitsLeft)
+                        {
+                            n = dwBitsLeft;
+                        }
+
+                        *pBuffer->pBuffer |= ((uint8_t)dwValueEx & gdw_6FF71408[n]) << pBuffer->nPosBits;
+
+                        pBuffer->nPosBits += n;
+                        if (pBuffer->nPosBits != 8)
+                        {
+                            break;
+                        }
+
+                        pBuffer->pBuffer = pBuffer->pBuffer + 1;
+                        ++pBuffer->nPos;
+                        pBuffer->nPosBits = 0;
+
+                        if ((signed int)(8 * pBuffer->nPos) < (signed int)pBuffer->nBits)
+                        {
+                            *pBuffer->pBuffer = 0;
+                        }
+
+                        dwBitsLeft -= n;
+                        dwValueEx >>= n;
+                    } while (dwBitsLeft > 0);
+                }
+            }
+            else
+            {
+                pBuffer->bFull = TRUE;
+                pBuffer->nPosBits = 0;
+                pBuffer->nPos = pBuffer->nBits / 8;
+            }
+        }
+
+        uint32_t BITMANIP_Read(D2BitBufferStrc* pBuffer, int nBits)
+        {
+            int n = pBuffer->nPosBits + nBits + 8 * pBuffer->nPos - pBuffer->nBits;
+
+            if ((signed int)n < 0)
+            {
+                n = 0;
+            }
+
+            uint32_t dwBitsLeft = nBits - n;
+            if (n)
+            {
+                pBuffer->bFull = TRUE;
+            }
+
+            uint32_t dwValue = 0;
+            uint32_t dw = 0;
+
+            if (dwBitsLeft > 0)
+            {
+                do
+                {
+                    size_t i = 8 - pBuffer->nPosBits;
+                    if (i > dwBitsLeft)
+                    {
+                        i = dwBitsLeft;
+                    }
+
+                    dwBitsLeft -= i;
+                    dwValue += (gdw_6FF71408[i] & ((uint8_t)(*pBuffer->pBuffer & gn_6FF7142C[pBuffer->nPosBits]) >> pBuffer->nPosBits)) << dw;
+                    dw += i;
+                    pBuffer->nPosBits += i;
+
+                    if (pBuffer->nPosBits == 8)
+                    {
+                        ++pBuffer->nPos;
+                        pBuffer->pBuffer = pBuffer->pBuffer + 1;
+                        pBuffer->nPosBits = 0;
+                    }
+                } while (dwBitsLeft > 0);
+            }
+
+            return dwValue;
+        }
+    }
+
+    void CheckSameState(const D2BitBufferStrc& tBuffer, const uint8_t* pBitStream, const D2BitBufferStrc& tExpectedBuffer, const uint8_t* pExpectedBitStream)
+    {
+        REQUIRE(tBuffer.pBuffer - pBitStream == tExpectedBuffer.pBuffer - pExpectedBitStream);
+        REQUIRE(tBuffer.nPos == tExpectedBuffer.nPos);
+        REQUIRE(tBuffer.nPosBits == tExpectedBuffer.nPosBits);
+        REQUIRE(tBuffer.bFull == tExpectedBuffer.bFull);
+    }
+
+    // Field widths as found in item bitstreams: flags, 3/4 bits types, 9 bits stat ids, 10 bits values, codes...
+    const uint32_t gnItemFieldWidths[] = { 1, 1, 1, 2, 3, 3, 4, 4, 5, 7, 8, 8, 9, 9, 9, 10, 11, 12, 16, 32 };
+}
+
+TEST_CASE("BITMANIP word reads and writes match the byte implementation")
+{
+    std::mt19937 tRand(0x6FF71408);
+
+    for (int nIteration = 0; nIteration < 20000; ++nIteration)
+    {
+        // Small buffers so that the ends of the buffers and the overflows are tested often
+        const size_t nSize = 1 + tRand() % 64;
+        // Garbage in the buffers, to check which bits are kept and which are cleared
+        std::vector<uint8_t> aBitStream(nSize);
+        for (uint8_t& nByte : aBitStream)
+        {
+            nByte = (uint8_t)tRand();
+        }
+        std::vector<uint8_t> aExpectedBitStream = aBitStream;
+
+        D2BitBufferStrc tBuffer = {};
+        D2BitBufferStrc tExpectedBuffer = {};
+        BITMANIP_Initialize(&tBuffer, aBitStream.data(), nSize);
+        BITMANIP_Initialize(&tExpectedBuffer, aExpectedBitStream.data(), nSize);
+
+        std::vector<std::pair<uint32_t, uint32_t>> aFields;
+        while (!tExpectedBuffer.bFull)
+        {
+            const uint32_t nBits = 1 + tRand() % 32;
+            const uint32_t nValue = tRand(); // Bits above nBits must be ignored
+            CAPTURE(nBits);
+            CAPTURE(nValue);
+            BITMANIP_Write(&tBuffer, nValue, nBits);
+            Legacy::BITMANIP_Write(&tExpectedBuffer, nValue, nBits);
+            CheckSameState(tBuffer, aBitStream.data(), tExpectedBuffer, aExpectedBitStream.data());
+            REQUIRE(aBitStream == aExpectedBitStream);
+            aFields.emplace_back(nValue, nBits);
+
+            if (tRand() % 16 == 0)
+            {
+                BITMANIP_GoToNextByte(&tBuffer);
+                BITMANIP_GoToNextByte(&tExpectedBuffer);
+                aFields.emplace_back(0, 0);
+            }
+        }
+
+        BITMANIP_Initialize(&tBuffer, aBitStream.data(), nSize);
+        BITMANIP_Initialize(&tExpectedBuffer, aExpectedBitStream.data(), nSize);
+        for (const auto& tField : aFields)
+        {
+            if (tField.second == 0)
+            {
+                // BITMANIP_GoToNextByte clears the next byte, skip the padding bits instead
+                if (tBuffer.nPosBits)
+                {
+                    const int nPaddingBits = 8 - tBuffer.nPosBits;
+                    REQUIRE(BITMANIP_Read(&tBuffer, nPaddingBits) == Legacy::BITMANIP_Read(&tExpectedBuffer, nPaddingBits));
+                }
+                continue;
+            }
+
+            const uint32_t nValue = BITMANIP_Read(&tBuffer, tField.second);
+            REQUIRE(nValue == Legacy::BITMANIP_Read(&tExpectedBuffer, tField.second));
+            CheckSameState(tBuffer, aBitStream.data(), tExpectedBuffer, aExpectedBitStream.data());
+            if (!tBuffer.bFull)
+            {
+                REQUIRE(nValue == (tField.second == 32 ? tField.first : tField.first & ((1u << tField.second) - 1)));
+            }
+        }
+    }
+}
+
+TEST_CASE("BITMANIP item bitstream benchmark")
+{
+    // Synthetic item-like bitstreams (no corpus of save files is shipped with the repository)
+    std::mt19937 tRand(0x6FF7142C);
+    constexpr size_t nStreamSize = 8192;
+    constexpr int nStreams = 256;
+    std::vector<std::vector<uint8_t>> aStreams(nStreams, std::vector<uint8_t>(nStreamSize));
+    std::vector<std::vector<uint32_t>> aStreamFieldWidths(nStreams);
+    for (int i = 0; i < nStreams; ++i)
+    {
+        D2BitBufferStrc tBuffer = {};
+        BITMANIP_Initialize(&tBuffer, aStreams[i].data(), nStreamSize);
+        while (true)
+        {
+            const uint32_t nBits = gnItemFieldWidths[tRand() % std::size(gnItemFieldWidths)];
+            if (8 * tBuffer.nPos + tBuffer.nPosBits + nBits > 8 * nStreamSize)
+            {
+                break;
+            }
+            BITMANIP_Write(&tBuffer, tRand(), nBits);
+            aStreamFieldWidths[i].push_back(nBits);
+        }
+    }
+
+    uint64_t nExpectedSum = 0;
+    const auto tLegacyStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nStreams; ++i)
+    {
+        D2BitBufferStrc tBuffer = {};
+        BITMANIP_Initialize(&tBuffer, aStreams[i].data(), nStreamSize);
+        for (const uint32_t nBits : aStreamFieldWidths[i])
+        {
+            nExpectedSum += Legacy::BITMANIP_Read(&tBuffer, nBits);
+        }
+    }
+    const auto tLegacyElapsed = std::chrono::steady_clock::now() - tLegacyStart;
+
+    uint64_t nSum = 0;
+    const auto tStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nStreams; ++i)
+    {
+        D2BitBufferStrc tBuffer = {};
+        BITMANIP_Initialize(&tBuffer, aStreams[i].data(), nStreamSize);
+        for (const uint32_t nBits : aStreamFieldWidths[i])
+        {
+            nSum += BITMANIP_Read(&tBuffer, nBits);
+        }
+    }
+    const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+    CHECK(nSum == nExpectedSum);
+    MESSAGE("Byte reads: ", std::chrono::duration_cast<std::chrono::microseconds>(tLegacyElapsed).count(), "us");
+    MESSAGE("Word reads: ", std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count(), "us");
+}
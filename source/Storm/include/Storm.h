@@ -251,7 +251,7 @@ D2FUNC_DLL_NP(STORM, SFileDestroy, BOOL, __cdecl, (), 0x16dc0);  //Storm.#262
 D2FUNC_DLL_NP(STORM, SFileEnableDirectAccess, BOOL, __stdcall, (HANDLE hFile), 0x17040);  //Storm.#263
 
 /// Not imported by any .dll
-D2FUNC_DLL_NP(STORM, SFileGetFileArchive, BOOL, __stdcall, (HANDLE hFile, HANDLE archive), 0x17220);  //Storm.#264
+D2FUNC_DLL_NP(STORM, SFileGetFileArchive, BOOL, __stdcall, (HANDLE hFile, HSARCHIVE* phArchive), 0x17220);  //Storm.#264
 
 /// Imported by ['Fog.dll']
 D2FUNC_DLL_NP(STORM, SFileGetFileSize, int, __stdcall, (int, LPDWORD lpFileSizeHigh), 0x17300);  //Storm.#265